@@ -7,6 +7,95 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/* Tags of IFD0 (and IFD1) */
+#define EXIF_TAG_IMAGE_WIDTH        0x0100  /* Width of the image (SHORT or LONG) */
+#define EXIF_TAG_IMAGE_HEIGHT       0x0101  /* Height of the image (SHORT or LONG) */
+#define EXIF_TAG_COMPRESSION        0x0103  /* Compression scheme (6 for a JPEG thumbnail) */
+#define EXIF_TAG_MAKE               0x010F  /* Manufacturer of the camera (ASCII) */
+#define EXIF_TAG_MODEL              0x0110  /* Model of the camera (ASCII) */
+#define EXIF_TAG_ORIENTATION        0x0112  /* Orientation of the stored image (SHORT, 1-8) */
+#define EXIF_TAG_SOFTWARE           0x0131  /* Software that produced the image (ASCII) */
+#define EXIF_TAG_DATETIME           0x0132  /* Time the file was last changed (ASCII, "YYYY:MM:DD HH:MM:SS") */
+#define EXIF_TAG_JPEG_OFFSET        0x0201  /* Offset of the JPEG thumbnail from the TIFF header (LONG) */
+#define EXIF_TAG_JPEG_LENGTH        0x0202  /* Length of the JPEG thumbnail (LONG) */
+#define EXIF_TAG_EXIF_IFD           0x8769  /* Offset of the Exif IFD (LONG) */
+#define EXIF_TAG_GPS_IFD            0x8825  /* Offset of the GPS IFD (LONG) */
+
+/* Tags of the Exif IFD */
+#define EXIF_TAG_DATETIME_ORIGINAL  0x9003  /* Time the image was captured (ASCII) */
+#define EXIF_TAG_DATETIME_DIGITIZED 0x9004  /* Time the image was digitized (ASCII) */
+#define EXIF_TAG_MAKER_NOTE         0x927C  /* Manufacturer specific data (UNDEFINED) */
+#define EXIF_TAG_PIXEL_X_DIMENSION  0xA002  /* Valid width of the image (SHORT or LONG) */
+#define EXIF_TAG_PIXEL_Y_DIMENSION  0xA003  /* Valid height of the image (SHORT or LONG) */
+#define EXIF_TAG_INTEROP_IFD        0xA005  /* Offset of the Interoperability IFD (LONG) */
+
+/* Tags of the GPS IFD */
+#define EXIF_TAG_GPS_LATITUDE_REF   0x0001  /* 'N' or 'S' (ASCII) */
+#define EXIF_TAG_GPS_LATITUDE       0x0002  /* Degrees, minutes and seconds (3 RATIONALs) */
+#define EXIF_TAG_GPS_LONGITUDE_REF  0x0003  /* 'E' or 'W' (ASCII) */
+#define EXIF_TAG_GPS_LONGITUDE      0x0004  /* Degrees, minutes and seconds (3 RATIONALs) */
+#define EXIF_TAG_GPS_ALTITUDE_REF   0x0005  /* 0 above sea level, 1 below (BYTE) */
+#define EXIF_TAG_GPS_ALTITUDE       0x0006  /* Meters (RATIONAL) */
+#define EXIF_TAG_GPS_TIMESTAMP      0x0007  /* UTC hours, minutes and seconds (3 RATIONALs) */
+#define EXIF_TAG_GPS_DATESTAMP      0x001D  /* UTC date (ASCII, "YYYY:MM:DD") */
+
+typedef enum {
+    EXIF_BYTE       = 1,    /* 8-bit unsigned integer */
+    EXIF_ASCII      = 2,    /* 8-bit character, NUL terminated */
+    EXIF_SHORT      = 3,    /* 16-bit unsigned integer */
+    EXIF_LONG       = 4,    /* 32-bit unsigned integer */
+    EXIF_RATIONAL   = 5,    /* Two LONGs, numerator then denominator */
+    EXIF_SBYTE      = 6,    /* 8-bit signed integer */
+    EXIF_UNDEFINED  = 7,    /* 8-bit opaque byte */
+    EXIF_SSHORT     = 8,    /* 16-bit signed integer */
+    EXIF_SLONG      = 9,    /* 32-bit signed integer */
+    EXIF_SRATIONAL  = 10,   /* Two SLONGs, numerator then denominator */
+    EXIF_FLOAT      = 11,   /* IEEE single precision */
+    EXIF_DOUBLE     = 12    /* IEEE double precision */
+} ExifType_t;
+
+typedef enum {
+    EXIF_IFD_0,         /* Primary image */
+    EXIF_IFD_1,         /* Thumbnail, chained from IFD0 */
+    EXIF_IFD_EXIF,      /* Capture details, pointed to by IFD0 */
+    EXIF_IFD_GPS,       /* Location, pointed to by IFD0 */
+    EXIF_IFD_INTEROP,   /* Interoperability, pointed to by the Exif IFD */
+    EXIF_N_IFDS
+} ExifIfd_t;
+
+typedef struct {
+    const uint8_t *tiff;                /* Start of the TIFF header (a view into the caller's buffer) */
+    size_t         size;                /* Bytes from the TIFF header to the end of the EXIF data */
+    bool           big_endian;          /* Byte order of the TIFF data ("MM" rather than "II") */
+    uint32_t       ifd[EXIF_N_IFDS];    /* Offset of each IFD from the TIFF header (0 if absent) */
+} Exif_t;
+
+typedef struct {
+    uint16_t       tag;         /* Tag identifying the field */
+    ExifType_t     type;        /* Type of each value */
+    uint32_t       count;       /* Number of values */
+    const uint8_t *data;        /* First value (a view into the caller's buffer, NULL for unknown types) */
+    size_t         size;        /* Bytes spanned by all values */
+    bool           big_endian;  /* Byte order of the values */
+} ExifEntry_t;
+
+/* Forward function declarations */
+
+ImcError_t      imc_exif_parse(const uint8_t* const data, const size_t size, Exif_t *exif);
+ImcError_t      imc_exif_from_jpeg(const uint8_t* const data, const size_t size, Exif_t *exif);
+ImcError_t      imc_exif_from_png(const uint8_t* const data, const size_t size, Exif_t *exif);
+size_t          imc_exif_count(const Exif_t* const exif, const ExifIfd_t ifd);
+ImcError_t      imc_exif_entry(const Exif_t* const exif, const ExifIfd_t ifd, const size_t index, ExifEntry_t *entry);
+ImcError_t      imc_exif_find(const Exif_t* const exif, const ExifIfd_t ifd, const uint16_t tag, ExifEntry_t *entry);
+ImcError_t      imc_exif_uint(const ExifEntry_t* const entry, const size_t index, uint32_t *value);
+ImcError_t      imc_exif_sint(const ExifEntry_t* const entry, const size_t index, int32_t *value);
+ImcError_t      imc_exif_rational(const ExifEntry_t* const entry, const size_t index, int64_t *num, int64_t *den);
+ImcError_t      imc_exif_real(const ExifEntry_t* const entry, const size_t index, double *value);
+ImcError_t      imc_exif_string(const ExifEntry_t* const entry, const char **str, size_t *len);
+ImcError_t      imc_exif_orientation(const Exif_t* const exif, uint16_t *orientation);
+ImcError_t      imc_exif_gps(const Exif_t* const exif, double *latitude, double *longitude);
+ImcError_t      imc_exif_thumbnail(const Exif_t* const exif, const uint8_t **data, size_t *size);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,111 @@
+#ifndef IMC_DEFLATE_H
+#define IMC_DEFLATE_H
+
+#include "imc_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Shortest and longest match lengths representable by DEFLATE */
+#define DEFLATE_MIN_MATCH 3
+#define DEFLATE_MAX_MATCH 258
+
+/* Symbol which terminates a DEFLATE block */
+#define DEFLATE_END_OF_BLOCK 256
+
+/* Number of literal/length and distance symbols */
+#define DEFLATE_N_LITLEN 286
+#define DEFLATE_N_DIST   30
+
+/* Longest Huffman code permitted by DEFLATE */
+#define DEFLATE_MAX_CODE_LEN 15
+
+/* Compression levels of the LZ77 compressor (0 stores the input uncompressed) */
+#define DEFLATE_MIN_LEVEL     0
+#define DEFLATE_MAX_LEVEL     12
+#define DEFLATE_DEFAULT_LEVEL 6
+
+typedef struct {
+    uint64_t bitbuf;    /* Pending output bits (LSB first) */
+    uint32_t bitcount;  /* Number of pending output bits */
+} DeflateBits_t;
+
+/**
+ * Fast run-length compressor for filtered scanlines.
+ *
+ * Only two match distances are considered: 1 (runs of a repeated byte, which is
+ * what flat regions become after filtering) and the number of bytes per pixel
+ * (runs of a repeated pixel), so there is no match finder to maintain. Input is
+ * tokenized into a buffer; once a block's worth of input has been seen, Huffman
+ * tables are built from the tokens and the block is emitted in a single pass.
+ */
+typedef struct {
+    DeflateBits_t bits;                         /* Bit writer */
+    size_t    bpp;                              /* Distance of a pixel run (bytes per pixel) */
+    uint32_t *tokens;                           /* Literals and matches of the current block */
+    size_t    n_tokens;                         /* Number of tokens in the current block */
+    size_t    pending;                          /* Number of input bytes covered by the tokens */
+    uint8_t   len_slot[DEFLATE_MAX_MATCH + 1];  /* Length code (less 257) of each match length */
+} DeflateRle_t;
+
+/**
+ * LZ77 compressor for filtered scanlines.
+ *
+ * Input is gathered behind up to 32 KiB of history and tokenized a block at a time, leaving the
+ * last bytes of a block to the next unless a match reaches them. Matches are found through hash
+ * chains, which are searched deeper as the level rises, after first trying the distances a flat
+ * region produces (1 and the number of bytes per pixel). Levels 1-3 parse greedily, 4-9 lazily with
+ * zlib's settings and 10-12 pick the cheapest path through the cached matches using the costs of the
+ * previous pass. Optimal parsing starts from a level 9 parse, which is kept unless a pass improves
+ * on it, and the levels differ only in the number of passes. Tokens are then split into blocks
+ * wherever new Huffman tables pay for themselves, and each block is emitted with dynamic or fixed
+ * codes, or stored, whichever is smallest. The last block of the input is held back, so it may
+ * share tables with later input.
+ */
+typedef struct {
+    DeflateBits_t bits;                         /* Bit writer */
+    int       level;                            /* Compression level (DEFLATE_MIN_LEVEL-DEFLATE_MAX_LEVEL) */
+    size_t    bpp;                              /* Distance of a pixel run (bytes per pixel) */
+    size_t    max_chain;                        /* Most hash chain entries searched for a match */
+    size_t    good_len;                         /* Match length from which the hash chain is searched a quarter as deep */
+    size_t    lazy_len;                         /* Lazy: match length which is not deferred. Greedy: longest match whose offsets are hashed */
+    size_t    nice_len;                         /* Match length which ends the search early */
+    uint8_t   parse;                            /* Greedy, lazy or optimal parsing */
+    uint8_t   passes;                           /* Number of optimal parsing passes */
+    uint8_t  *window;                           /* History followed by the input not yet tokenized */
+    size_t    w_pos;                            /* Offset of the first byte not yet tokenized */
+    size_t    w_end;                            /* Offset one past the last byte of input */
+    int32_t  *head;                             /* Most recent offset with each hash (-1 if none) */
+    int32_t  *prev;                             /* Previous offset with the same hash as each offset */
+    uint32_t *tokens;                           /* Literals and matches of the current block */
+    uint32_t *alt;                              /* Optimal parsing: tokens of the pass being tried */
+    uint32_t *held;                             /* Tokens of the last block, held back to share tables with later input */
+    size_t    n_held;                           /* Number of tokens held back */
+    int32_t  *head_save;                        /* Optimal parsing: hash chain heads from before the seeding parses */
+    uint32_t *matches;                          /* Optimal parsing: matches found at each offset */
+    uint8_t  *n_matches;                        /* Optimal parsing: number of matches at each offset */
+    uint32_t *cost;                             /* Optimal parsing: cheapest cost from each offset to the end */
+    uint32_t *choice;                           /* Optimal parsing: token which starts the cheapest path */
+    uint8_t   len_slot[DEFLATE_MAX_MATCH + 1];  /* Length code (less 257) of each match length */
+} DeflateLz_t;
+
+/* Forward function declarations */
+
+uint32_t        imc_adler32(uint32_t adler, const uint8_t *data, size_t len);
+ImcError_t      imc_deflate_rle_init(DeflateRle_t *rle, const size_t bpp);
+void            imc_deflate_rle_destroy(DeflateRle_t *rle);
+size_t          imc_deflate_rle_bound(const size_t len);
+size_t          imc_deflate_rle_write(DeflateRle_t *rle, const uint8_t *in, const size_t len, uint8_t *out);
+size_t          imc_deflate_rle_end(DeflateRle_t *rle, uint8_t *out, const bool final);
+ImcError_t      imc_deflate_init(DeflateLz_t *lz, const int level, const size_t bpp);
+void            imc_deflate_destroy(DeflateLz_t *lz);
+size_t          imc_deflate_bound(const size_t len);
+size_t          imc_deflate_write(DeflateLz_t *lz, const uint8_t *in, const size_t len, uint8_t *out);
+size_t          imc_deflate_end(DeflateLz_t *lz, uint8_t *out, const bool final);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* IMC_DEFLATE_H */
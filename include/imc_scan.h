@@ -0,0 +1,73 @@
+#ifndef IMC_SCAN_H
+#define IMC_SCAN_H
+
+/* Required for pread(), pthreads and the types of directory entries */
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <pthread.h>
+
+#include "png_parser.h"
+#include "jfif_parser.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+typedef enum {
+    IMC_FORMAT_UNKNOWN, /* Neither a PNG nor a JPEG */
+    IMC_FORMAT_PNG,     /* PNG (or APNG) */
+    IMC_FORMAT_JPEG     /* JPEG with a JFIF, EXIF or bare SOI header */
+} ImcFormat_t;
+
+typedef struct {
+    const char *path;           /* Path of the file, only valid for the duration of the sink's call */
+    ImcError_t  status;         /* IMC_EOK if the header was read, or why it could not be */
+    ImcFormat_t format;         /* Format recognized from the file's signature */
+    uint32_t    width;          /* Width of the image (in pixels) */
+    uint32_t    height;         /* Height of the image (in pixels, 0 for a JPEG which defers it to a DNL segment) */
+    uint8_t     n_channels;     /* Number of PNG channels or JPEG components */
+    uint8_t     bit_depth;      /* Bits per sample */
+    bool        progressive;    /* True for a progressive JPEG or an interlaced PNG */
+    bool        has_exif;       /* True if the EXIF fields below were read from the file */
+    uint16_t    orientation;    /* EXIF Orientation tag (1 if absent) */
+    char        datetime[20];   /* EXIF DateTimeOriginal, or DateTime without one ("YYYY:MM:DD HH:MM:SS", "" if absent) */
+    char        make[32];       /* EXIF Make ("" if absent) */
+    char        model[32];      /* EXIF Model ("" if absent) */
+    bool        has_gps;        /* True if latitude and longitude are set */
+    double      latitude;       /* EXIF GPS latitude (in decimal degrees, negative to the south) */
+    double      longitude;      /* EXIF GPS longitude (in decimal degrees, negative to the west) */
+} ImcMetadata_t;
+
+/* Receives the metadata of one file. Calls are never concurrent. Must return IMC_EOK to continue scanning */
+typedef ImcError_t (*imc_meta_func)(
+    void *ctx,
+    const ImcMetadata_t* const meta
+);
+
+typedef struct {
+    imc_meta_func record;   /* Called with the metadata of each file, in the order the files are finished */
+    void         *ctx;      /* User data passed through to record */
+} ImcMetaSink_t;
+
+typedef struct {
+    size_t n_threads;   /* Number of threads reading files (0 for one per online CPU) */
+    bool   recursive;   /* Descend into the subdirectories of directories */
+    bool   all_files;   /* Also pass on files which are neither PNG nor JPEG, or could not be opened */
+} ImcScanOpts_t;
+
+/* Forward function declarations */
+
+ImcScanOpts_t   imc_scan_default_opts(void);
+ImcError_t      imc_read_metadata(const char* const path, ImcMetadata_t *meta);
+ImcError_t      imc_scan_metadata(const char* const* const paths, const size_t n_paths, const ImcMetaSink_t* const sink, const ImcScanOpts_t* const opts);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* IMC_SCAN_H */
@@ -0,0 +1,37 @@
+#ifndef IMC_STRIP_H
+#define IMC_STRIP_H
+
+/* Required for copy_file_range() */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <fcntl.h>
+
+#include "png_parser.h"
+#include "jfif_parser.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+typedef struct {
+    bool exif;          /* Remove the EXIF data entirely (JPEG APP1, PNG eXIf) */
+    bool gps;           /* Remove the GPS IFD from EXIF data which is kept */
+    bool maker_notes;   /* Remove the MakerNote tag from EXIF data which is kept */
+    bool xmp;           /* Remove XMP packets (JPEG APP1, PNG iTXt with the XML:com.adobe.xmp keyword) */
+    bool iptc;          /* Remove Photoshop resources, which carry IPTC (JPEG APP13) */
+    bool text;          /* Remove comments and text (JPEG COM, PNG tEXt, zTXt and iTXt) */
+} ImcStripOpts_t;
+
+/* Forward function declarations */
+
+ImcStripOpts_t  imc_strip_default_opts(void);
+ImcError_t      imc_strip_mem(uint8_t *data, size_t *size, const ImcStripOpts_t* const opts);
+ImcError_t      imc_strip_file(const char* const src, const char* const dst, const ImcStripOpts_t* const opts);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* IMC_STRIP_H */
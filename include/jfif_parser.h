@@ -1,12 +1,167 @@
 #ifndef JFIF_PARSER
 #define JFIF_PARSER
 
-#include "imc_common.h"
+/* Required for pthreads */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <pthread.h>
+
+#include "pixmap.h"
+#include "exif_parser.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
+/* Marker codes (the byte following 0xFF) */
+#define JPEG_SOF0   0xC0    /* Start of frame (baseline DCT) */
+#define JPEG_SOF1   0xC1    /* Start of frame (extended sequential DCT) */
+#define JPEG_SOF2   0xC2    /* Start of frame (progressive DCT) */
+#define JPEG_DHT    0xC4    /* Define Huffman table(s) */
+#define JPEG_RST0   0xD0    /* Restart marker 0 (RST1-RST7 follow consecutively) */
+#define JPEG_RST7   0xD7    /* Restart marker 7 */
+#define JPEG_SOI    0xD8    /* Start of image */
+#define JPEG_EOI    0xD9    /* End of image */
+#define JPEG_SOS    0xDA    /* Start of scan */
+#define JPEG_DQT    0xDB    /* Define quantization table(s) */
+#define JPEG_DNL    0xDC    /* Define number of lines */
+#define JPEG_DRI    0xDD    /* Define restart interval */
+#define JPEG_APP0   0xE0    /* Application segment 0 (JFIF) */
+#define JPEG_APP1   0xE1    /* Application segment 1 (EXIF) */
+#define JPEG_APP13  0xED    /* Application segment 13 (Photoshop IRB, IPTC) */
+#define JPEG_APP14  0xEE    /* Application segment 14 (Adobe) */
+#define JPEG_COM    0xFE    /* Comment */
+
+#define JPEG_MAX_COMPONENTS 4   /* Largest number of components in a frame */
+#define JPEG_HUFF_LOOKAHEAD 10  /* Number of bits resolved by a single Huffman table lookup */
+
+typedef enum {
+    JPEG_FMT_NATIVE,    /* 1 channel for greyscale images, RGB otherwise */
+    JPEG_FMT_RGB,       /* 3 channels, red first */
+    JPEG_FMT_RGBA,      /* 4 channels, red first, opaque alpha */
+    JPEG_FMT_BGRA,      /* 4 channels, blue first, opaque alpha */
+    JPEG_FMT_LUMA       /* 1 channel, the luma of YCbCr images without decoding their chroma */
+} JpegFormat_t;
+
+typedef struct {
+    JpegFormat_t format;            /* Channel layout of the decoded pixmap */
+    bool         simd;              /* Use the fastest SIMD kernels the CPU supports (false for the scalar reference) */
+    uint8_t      scale_denom;       /* Decode at 1/scale_denom of full size (1, 2, 4 or 8) */
+    size_t       n_threads;         /* Number of threads decoding restart intervals (1 to decode serially, 0 for one per online CPU) */
+    bool         fancy_upsampling;  /* Interpolate subsampled chroma like libjpeg (false to replicate samples) */
+    bool         preview;           /* Stop a progressive JPEG after the first DC scan of every component */
+    bool         dc_only;           /* Decode one pixel per block from its DC coefficient alone (implies 1/8 scale) */
+    bool         auto_orient;       /* Rotate or mirror the pixmap upright as the EXIF Orientation tag says (whole decodes only) */
+} JpegDecOpts_t;
+
+typedef struct {
+    uint8_t  n_planes;                      /* Number of planes, one per component in frame order (Y, Cb, Cr for YCbCr) */
+    size_t   width[JPEG_MAX_COMPONENTS];    /* Width of each plane at its own sampling (in samples) */
+    size_t   height[JPEG_MAX_COMPONENTS];   /* Height of each plane at its own sampling (in rows) */
+    uint8_t *data[JPEG_MAX_COMPONENTS];     /* First sample of each plane, allocated by the caller */
+    size_t   stride[JPEG_MAX_COMPONENTS];   /* Distance between the rows of each plane (in bytes, at least its width) */
+} JpegPlanes_t;
+
+typedef enum {
+    JPEG_SUBSAMPLE_444, /* Full resolution chroma */
+    JPEG_SUBSAMPLE_422, /* Chroma halved horizontally */
+    JPEG_SUBSAMPLE_420  /* Chroma halved horizontally and vertically */
+} JpegSubsampling_t;
+
+typedef struct {
+    uint8_t           quality;      /* IJG quality scaling of the standard quantization tables (1-100) */
+    JpegSubsampling_t subsampling;  /* Chroma subsampling of color images */
+    bool              optimize;     /* Gather symbol statistics in a first pass and write optimal Huffman tables */
+    bool              simd;         /* Use the fastest SIMD kernels the CPU supports (false for the scalar reference) */
+} JpegEncOpts_t;
+
+typedef enum {
+    JPEG_XFORM_NONE,        /* Re-encode the coefficients unchanged */
+    JPEG_XFORM_FLIP_H,      /* Mirror left to right */
+    JPEG_XFORM_FLIP_V,      /* Mirror top to bottom */
+    JPEG_XFORM_TRANSPOSE,   /* Mirror across the top-left to bottom-right diagonal */
+    JPEG_XFORM_TRANSVERSE,  /* Mirror across the top-right to bottom-left diagonal */
+    JPEG_XFORM_ROT_90,      /* Rotate 90 degrees clockwise */
+    JPEG_XFORM_ROT_180,     /* Rotate 180 degrees */
+    JPEG_XFORM_ROT_270      /* Rotate 270 degrees clockwise (90 degrees counter-clockwise) */
+} JpegTransform_t;
+
+/* Receives the encoded JPEG bytes in order. Must return IMC_EOK on success */
+typedef ImcError_t (*jpeg_write_func)(
+    void *ctx,
+    const uint8_t *data,
+    const size_t len
+);
+
+typedef struct {
+    jpeg_write_func write;  /* Called with each block of encoded output */
+    void           *ctx;    /* User data passed through to write */
+} JpegSink_t;
+
+/* Receives a band of decoded rows, the first of which is row __y__ of the image. Must return IMC_EOK to continue decoding */
+typedef ImcError_t (*jpeg_band_func)(
+    void *ctx,
+    const Pixmap_t* const band,
+    const size_t y
+);
+
+typedef struct {
+    jpeg_band_func band;    /* Called with each band of decoded rows, from the top of the image down */
+    void          *ctx;     /* User data passed through to band */
+} JpegBandSink_t;
+
+typedef struct {
+    FILE    *fp;    /* The file handle */
+    uint8_t *data;  /* Copy of raw data */
+    size_t   size;  /* Size of data (in bytes) */
+} JpegHndl_t;
+
+typedef enum {
+    JPEG_IDCT_SCALAR,   /* Portable reference implementation */
+    JPEG_IDCT_SSE2,     /* Eight transforms per pass in 128-bit registers */
+    JPEG_IDCT_AVX2      /* Eight transforms per pass in 256-bit registers */
+} JpegIdct_t;
+
+/* Dequantizes a block of coefficients and writes its 8x8 inverse DCT */
+typedef void (*idct_func)(
+    const int16_t* const coefs,
+    const uint16_t* const qt,
+    uint8_t *out,
+    const size_t stride
+);
+
+/* Computes the forward DCT of an 8x8 block of samples and quantizes it with a table of reciprocals */
+typedef void (*fdct_func)(
+    const uint8_t* const in,
+    const size_t stride,
+    const uint16_t* const divisors,
+    int16_t *coefs
+);
+
+/* Forward function declarations */
+
+JpegDecOpts_t   imc_jpeg_default_opts(void);
+idct_func       imc_jpeg_idct_kernel(const JpegIdct_t kernel);
+JpegHndl_t     *imc_jpeg_open(const char* const path);
+ImcError_t      imc_jpeg_close(JpegHndl_t *jpeg);
+Pixmap_t       *imc_jpeg_decode_mem(const uint8_t* const data, const size_t size, const JpegDecOpts_t* const opts);
+Pixmap_t       *imc_jpeg_decode(JpegHndl_t *jpeg, const JpegDecOpts_t* const opts);
+Pixmap_t       *imc_jpeg_decode_thumbnail_mem(const uint8_t* const data, const size_t size, const JpegDecOpts_t* const opts);
+Pixmap_t       *imc_jpeg_decode_thumbnail(JpegHndl_t *jpeg, const JpegDecOpts_t* const opts);
+ImcError_t      imc_jpeg_decode_stream_mem(const uint8_t* const data, const size_t size, const JpegBandSink_t* const sink, const JpegDecOpts_t* const opts);
+ImcError_t      imc_jpeg_decode_stream(JpegHndl_t *jpeg, const JpegBandSink_t* const sink, const JpegDecOpts_t* const opts);
+ImcError_t      imc_jpeg_planes_info(const uint8_t* const data, const size_t size, const JpegDecOpts_t* const opts, JpegPlanes_t *planes);
+ImcError_t      imc_jpeg_decode_planes(const uint8_t* const data, const size_t size, const JpegDecOpts_t* const opts, JpegPlanes_t *planes);
+JpegEncOpts_t   imc_jpeg_enc_default_opts(void);
+ImcError_t      imc_jpeg_write(const Pixmap_t* const pixmap, const char* const fname, const JpegEncOpts_t* const opts);
+ImcError_t      imc_jpeg_write_mem(const Pixmap_t* const pixmap, uint8_t **data, size_t *size, const JpegEncOpts_t* const opts);
+ImcError_t      imc_jpeg_write_sink(const Pixmap_t* const pixmap, const JpegSink_t* const sink, const JpegEncOpts_t* const opts);
+ImcError_t      imc_jpeg_transform(JpegHndl_t *jpeg, const JpegTransform_t xform, const char* const fname);
+ImcError_t      imc_jpeg_transform_mem(const uint8_t* const data, const size_t size, const JpegTransform_t xform, uint8_t **out, size_t *out_size);
+ImcError_t      imc_jpeg_transform_sink(const uint8_t* const data, const size_t size, const JpegTransform_t xform, const JpegSink_t* const sink);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
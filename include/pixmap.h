@@ -16,6 +16,11 @@ typedef struct {
     uint8_t *data;       /* Raw data of the pixmap */
 } Pixmap_t;
 
+typedef struct {
+    Rgba_t   entries[256];  /* Palette colors */
+    uint16_t n_entries;     /* Number of colors in use (1-256) */
+} Palette_t;
+
 typedef enum {
     NEAREST,    /* Nearest-neighbor */
     BILINEAR,   /* Bilinear interpolation */
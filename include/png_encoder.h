@@ -0,0 +1,96 @@
+#ifndef PNG_ENCODER_H
+#define PNG_ENCODER_H
+
+/* Required for pthreads */
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <pthread.h>
+
+#include "png_parser.h"
+#include "imc_deflate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Filter selection which picks the cheapest of the five filters for each scanline */
+#define ADAPTIVE 5
+
+/* Filter used by the fast preset unless another fixed filter is requested */
+#define PNG_FAST_FILTER UP
+
+/* Default maximum length of an IDAT chunk's data segment (in bytes) */
+#define PNG_IDAT_SIZE (1 << 16)
+
+/* Receives the encoded PNG bytes in order. Must return IMC_EOK on success */
+typedef ImcError_t (*png_write_func)(
+    void *ctx,
+    const uint8_t *data,
+    const size_t len
+);
+
+typedef struct {
+    png_write_func write;   /* Called with each block of encoded output */
+    void          *ctx;     /* User data passed through to write */
+} PngSink_t;
+
+typedef struct {
+    int              level;         /* zlib compression level (0-9) */
+    int              strategy;      /* zlib compression strategy (Z_DEFAULT_STRATEGY, Z_FILTERED, Z_RLE, ...) */
+    uint8_t          filter;        /* NONE, SUB, UP, AVG, PAETH or ADAPTIVE */
+    size_t           idat_size;     /* Maximum length of an IDAT chunk's data segment (in bytes) */
+    size_t           n_threads;     /* Number of threads used to compress bands of scanlines (1 to encode serially) */
+    bool             fast;          /* Trade size for speed: fixed filter and run-length compression (level and strategy are ignored) */
+    bool             in_tree;       /* Compress with the in-tree LZ77 compressor, where level may be 0-12 (strategy is ignored) */
+    const Palette_t *palette;       /* Write an indexed-color PNG from a 1 channel pixmap of palette indices, each below n_entries (NULL if unused) */
+    const Chunk_t   *ancillary;     /* Ancillary chunks to copy into the output (CRCs are recomputed) */
+    size_t           n_ancillary;   /* Number of chunks in ancillary */
+} PngEncOpts_t;
+
+/* APNG frame disposal operations (how the frame's region is treated before the next frame is rendered) */
+#define APNG_DISPOSE_NONE       0   /* Leave the canvas as is */
+#define APNG_DISPOSE_BACKGROUND 1   /* Clear the region to transparent black */
+#define APNG_DISPOSE_PREVIOUS   2   /* Restore the region to its contents before the frame */
+
+/* APNG frame blend operations */
+#define APNG_BLEND_SOURCE 0         /* Replace the region */
+#define APNG_BLEND_OVER   1         /* Alpha composite the frame over the region */
+
+typedef struct {
+    const Pixmap_t *pixmap;     /* The complete frame (every frame must share dimensions and format) */
+    uint16_t        delay_num;  /* Numerator of the frame's display time (in seconds) */
+    uint16_t        delay_den;  /* Denominator of the frame's display time (0 is treated as 100) */
+} ApngFrame_t;
+
+/* Incremental encoder which accepts scanlines as they are produced (see imc_png_enc_begin()) */
+typedef struct PngEncHndl PngEncHndl_t;
+
+/* Used for filtering scanlines prior to compression */
+typedef void (*filter_func)(
+    const uint8_t *prev_scanline,
+    const uint8_t *curr_scanline,
+    uint8_t *out,
+    const size_t len,
+    const size_t bpp
+);
+
+/* Forward function declarations */
+
+PngEncOpts_t    imc_png_default_opts(void);
+ImcError_t      imc_png_write(const Pixmap_t* const pixmap, const char* const fname, const PngEncOpts_t* const opts);
+ImcError_t      imc_png_write_mem(const Pixmap_t* const pixmap, uint8_t **data, size_t *size, const PngEncOpts_t* const opts);
+ImcError_t      imc_png_write_sink(const Pixmap_t* const pixmap, const PngSink_t* const sink, const PngEncOpts_t* const opts);
+PngEncHndl_t   *imc_png_enc_begin(const size_t width, const size_t height, const uint8_t n_channels, const uint8_t bit_depth, const PngSink_t* const sink, const PngEncOpts_t* const opts);
+ImcError_t      imc_png_enc_write_rows(PngEncHndl_t *enc, const uint8_t *rows, const size_t n_rows);
+ImcError_t      imc_png_enc_end(PngEncHndl_t *enc);
+ImcError_t      imc_apng_write(const ApngFrame_t* const frames, const size_t n_frames, const uint32_t n_plays, const char* const fname, const PngEncOpts_t* const opts);
+ImcError_t      imc_apng_write_mem(const ApngFrame_t* const frames, const size_t n_frames, const uint32_t n_plays, uint8_t **data, size_t *size, const PngEncOpts_t* const opts);
+ImcError_t      imc_apng_write_sink(const ApngFrame_t* const frames, const size_t n_frames, const uint32_t n_plays, const PngSink_t* const sink, const PngEncOpts_t* const opts);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* PNG_ENCODER_H */
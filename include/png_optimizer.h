@@ -0,0 +1,26 @@
+#ifndef PNG_OPTIMIZER_H
+#define PNG_OPTIMIZER_H
+
+#include "png_encoder.h"
+#include "quantize.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+typedef struct {
+    size_t n_threads;       /* Number of threads running trials (0 for one per online CPU) */
+    bool   strip_ancillary; /* Drop all ancillary chunks except tRNS rather than copying them into the output */
+} PngOptOpts_t;
+
+/* Forward function declarations */
+
+PngOptOpts_t    imc_png_opt_default_opts(void);
+ImcError_t      imc_png_optimize_mem(const uint8_t* const in, const size_t in_size, uint8_t **data, size_t *size, const PngOptOpts_t* const opts);
+ImcError_t      imc_png_optimize(const char* const in_path, const char* const out_path, const PngOptOpts_t* const opts);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* PNG_OPTIMIZER_H */
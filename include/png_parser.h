@@ -75,6 +75,12 @@ extern "C" {
 #define SPLT "sPLT" /* Suggested palette */
 #define HIST "hIST" /* Palette histogram */
 #define TIME "tIME" /* Image last-modification time */
+#define EXIF "eXIf" /* Exchangeable image file format (EXIF) metadata */
+
+/* Animation (APNG) */
+#define ACTL "acTL" /* Animation control */
+#define FCTL "fcTL" /* Frame control */
+#define FDAT "fdAT" /* Frame data */
 
 typedef struct {
     uint32_t length;    /* Length of data segment */
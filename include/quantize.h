@@ -0,0 +1,26 @@
+#ifndef QUANTIZE_H
+#define QUANTIZE_H
+
+#include "pixmap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+typedef struct {
+    uint16_t max_colors;    /* Largest palette to produce (2-256) */
+    size_t   kmeans_iters;  /* Number of k-means passes refining the median cut palette (0 to skip) */
+    bool     dither;        /* Diffuse quantization error to neighbouring pixels (Floyd-Steinberg) */
+} QuantOpts_t;
+
+/* Forward function declarations */
+
+QuantOpts_t     imc_quant_default_opts(void);
+ImcError_t      imc_quant_exact(const Pixmap_t* const pixmap, const uint16_t max_colors, Palette_t *palette, uint8_t *indices);
+Pixmap_t       *imc_pixmap_quantize(const Pixmap_t* const pixmap, Palette_t *palette, const QuantOpts_t* const opts);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* QUANTIZE_H */
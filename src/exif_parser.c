@@ -1 +1,781 @@
+/**
+ * @file exif_parser.c
+ * @author Neil Kingdom
+ * @since 16-10-2026
+ * @version 1.0
+ * @brief Contains the functions necessary for reading the EXIF metadata of JPEG and PNG files.
+ *
+ * EXIF data is a TIFF structure: an 8 byte header giving the byte order and
+ * the offset of IFD0, followed by Image File Directories (IFDs) of 12 byte
+ * entries. IFD0 describes the primary image and chains to IFD1 (the
+ * thumbnail), while the Exif and GPS IFDs hang off pointer tags in IFD0 and
+ * the Interoperability IFD off a pointer tag in the Exif IFD. Nothing is
+ * copied or allocated: Exif_t and ExifEntry_t are views into the caller's
+ * buffer, so the buffer must outlive them. Every offset is checked against
+ * the end of the EXIF data before it is followed.
+ */
+
 #include "exif_parser.h"
+
+/* Size of the TIFF header */
+#define _EXIF_HEADER_SIZE 8
+
+/* Size of an IFD entry */
+#define _EXIF_ENTRY_SIZE 12
+
+/* Identifier preceding the TIFF header in a JPEG APP1 segment */
+#define _EXIF_ID        "Exif\0\0"
+#define _EXIF_ID_SIZE   6
+
+/* JPEG markers delimiting the segments searched for EXIF data */
+#define _EXIF_JPEG_SOI  0xD8
+#define _EXIF_JPEG_EOI  0xD9
+#define _EXIF_JPEG_SOS  0xDA
+#define _EXIF_JPEG_APP1 0xE1
+
+/* Compression of an IFD1 thumbnail stored as a JPEG */
+#define _EXIF_COMPRESSION_JPEG 6
+
+/* Size of each TIFF type (0 for unknown types) */
+static const uint8_t _exif_type_size[] = {
+    0, 1, 1, 2, 4, 8, 1, 1, 2, 4, 8, 4, 8
+};
+
+/*
+ * ===============================
+ *       Private Functions
+ * ===============================
+ */
+
+/**
+ * @brief Reads a 16-bit value stored in the given byte order.
+ * @since 16-10-2026
+ * @param[in] buf The location of at least 2 bytes
+ * @param[in] big_endian True if the most significant byte comes first
+ * @returns The value stored at __buf__
+ */
+static inline uint16_t _imc_exif_u16(const uint8_t* const buf, const bool big_endian) {
+    return big_endian ? (uint16_t)((buf[0] << 8) | buf[1])
+                      : (uint16_t)((buf[1] << 8) | buf[0]);
+}
+
+/**
+ * @brief Reads a 32-bit value stored in the given byte order.
+ * @since 16-10-2026
+ * @param[in] buf The location of at least 4 bytes
+ * @param[in] big_endian True if the most significant byte comes first
+ * @returns The value stored at __buf__
+ */
+static inline uint32_t _imc_exif_u32(const uint8_t* const buf, const bool big_endian) {
+    return big_endian
+        ? ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) | ((uint32_t)buf[2] << 8) | buf[3]
+        : ((uint32_t)buf[3] << 24) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[1] << 8) | buf[0];
+}
+
+/**
+ * @brief Checks that a complete IFD lies at __offset__.
+ * @since 16-10-2026
+ * @param[in] exif The parsed TIFF header
+ * @param[in] offset The offset of the IFD from the TIFF header
+ * @returns True if the entry count and every entry lie within the EXIF data
+ */
+static bool _imc_exif_ifd_valid(const Exif_t* const exif, const uint32_t offset) {
+    size_t n_entries;
+
+    if (offset < _EXIF_HEADER_SIZE || exif->size < 2 || offset > exif->size - 2) {
+        return false;
+    }
+
+    n_entries = _imc_exif_u16(exif->tiff + offset, exif->big_endian);
+    return n_entries * _EXIF_ENTRY_SIZE <= exif->size - offset - 2;
+}
+
+/**
+ * @brief Returns the offset of the IFD chained after the IFD at __offset__.
+ * @since 16-10-2026
+ * @param[in] exif The parsed TIFF header
+ * @param[in] offset The offset of a valid IFD
+ * @returns The offset of the next IFD, or 0 if there is none
+ */
+static uint32_t _imc_exif_next_ifd(const Exif_t* const exif, const uint32_t offset) {
+    size_t pos;
+
+    pos = (size_t)offset + 2 + _imc_exif_u16(exif->tiff + offset, exif->big_endian) * _EXIF_ENTRY_SIZE;
+    /* Some writers leave out the link of the last IFD */
+    if (exif->size - pos < 4) {
+        return 0;
+    }
+
+    return _imc_exif_u32(exif->tiff + pos, exif->big_endian);
+}
+
+/**
+ * @brief Decodes the IFD entry at __pos__ into a view of its values.
+ * @since 16-10-2026
+ * @param[in] exif The parsed TIFF header
+ * @param[in] pos The offset of the entry from the TIFF header
+ * @param[out] entry The decoded entry
+ * @returns IMC_EOK on success, or IMC_EOVERFLOW if the values lie outside of the EXIF data
+ */
+static ImcError_t _imc_exif_read_entry(
+    const Exif_t* const exif,
+    const size_t pos,
+    ExifEntry_t *entry
+) {
+    const uint8_t *raw = exif->tiff + pos;
+    uint64_t size;
+    uint32_t offset;
+
+    entry->tag = _imc_exif_u16(raw, exif->big_endian);
+    entry->type = (ExifType_t)_imc_exif_u16(raw + 2, exif->big_endian);
+    entry->count = _imc_exif_u32(raw + 4, exif->big_endian);
+    entry->big_endian = exif->big_endian;
+    entry->data = NULL;
+    entry->size = 0;
+
+    /* Readers are required to skip fields of types they don't know */
+    if (entry->type < EXIF_BYTE || entry->type > EXIF_DOUBLE) {
+        return IMC_EOK;
+    }
+
+    size = (uint64_t)entry->count * _exif_type_size[entry->type];
+    if (size <= 4) {
+        entry->data = raw + 8;
+    } else {
+        offset = _imc_exif_u32(raw + 8, exif->big_endian);
+        if (offset > exif->size || size > exif->size - offset) {
+            IMC_LOG("EXIF value lies outside of the EXIF data", IMC_WARNING);
+            return IMC_EOVERFLOW;
+        }
+        entry->data = exif->tiff + offset;
+    }
+    entry->size = (size_t)size;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Follows a pointer tag of the IFD at __parent__ to a sub-IFD.
+ * @since 16-10-2026
+ * @param[in] exif The parsed TIFF header, with the IFDs found so far
+ * @param[in] parent The IFD holding the pointer tag
+ * @param[in] tag The pointer tag
+ * @returns The offset of the sub-IFD, or 0 if it is absent, invalid or already in use
+ */
+static uint32_t _imc_exif_sub_ifd(const Exif_t* const exif, const ExifIfd_t parent, const uint16_t tag) {
+    ExifEntry_t entry;
+    uint32_t offset;
+    size_t i;
+
+    if (imc_exif_find(exif, parent, tag, &entry) != IMC_EOK
+        || imc_exif_uint(&entry, 0, &offset) != IMC_EOK
+        || !_imc_exif_ifd_valid(exif, offset)) {
+        return 0;
+    }
+
+    /* A pointer back to a known IFD would make two IFDs alias each other */
+    for (i = 0; i < EXIF_N_IFDS; ++i) {
+        if (exif->ifd[i] == offset) {
+            return 0;
+        }
+    }
+
+    return offset;
+}
+
+/**
+ * @brief Converts a GPS coordinate from degrees, minutes and seconds to decimal degrees.
+ * @since 16-10-2026
+ * @param[in] exif The parsed EXIF data
+ * @param[in] ref_tag The tag of the hemisphere reference
+ * @param[in] tag The tag of the coordinate
+ * @param[in] negative The reference character of the negative hemisphere ('S' or 'W')
+ * @param[out] degrees The signed coordinate
+ * @returns IMC_EOK on success, IMC_ENODATA if either tag is absent, or IMC_EINVAL if they are malformed
+ */
+static ImcError_t _imc_exif_gps_coord(
+    const Exif_t* const exif,
+    const uint16_t ref_tag,
+    const uint16_t tag,
+    const char negative,
+    double *degrees
+) {
+    ExifEntry_t ref, coord;
+    const char *str;
+    double part;
+    size_t len, i;
+    ImcError_t status;
+
+    if ((status = imc_exif_find(exif, EXIF_IFD_GPS, ref_tag, &ref)) != IMC_EOK
+        || (status = imc_exif_find(exif, EXIF_IFD_GPS, tag, &coord)) != IMC_EOK) {
+        return status;
+    }
+    if (imc_exif_string(&ref, &str, &len) != IMC_EOK || len < 1 || coord.count < 3) {
+        return IMC_EINVAL;
+    }
+
+    *degrees = 0.0;
+    for (i = 0; i < 3; ++i) {
+        if ((status = imc_exif_real(&coord, i, &part)) != IMC_EOK) {
+            return status;
+        }
+        *degrees += part / ((i == 0) ? 1.0 : ((i == 1) ? 60.0 : 3600.0));
+    }
+    if (str[0] == negative) {
+        *degrees = -*degrees;
+    }
+
+    return IMC_EOK;
+}
+
+/*
+ * ===============================
+ *        Public Functions
+ * ===============================
+ */
+
+/**
+ * @brief Parses the TIFF header of EXIF data and locates its IFDs.
+ * @since 16-10-2026
+ * @param[in] data The EXIF data, starting with the TIFF header or with the "Exif\0\0" identifier of APP1
+ * @param[in] size The size of __data__ (in bytes)
+ * @param[out] exif A view of the EXIF data, valid for as long as __data__ is
+ * @returns IMC_EOK on success, or an error code on failure
+ */
+ImcError_t imc_exif_parse(const uint8_t* const data, const size_t size, Exif_t *exif) {
+    const uint8_t *tiff = data;
+    size_t tiff_size = size;
+
+    if (data == NULL || exif == NULL) {
+        return IMC_EFAULT;
+    }
+
+    if (tiff_size >= _EXIF_ID_SIZE && memcmp(tiff, _EXIF_ID, _EXIF_ID_SIZE) == 0) {
+        tiff += _EXIF_ID_SIZE;
+        tiff_size -= _EXIF_ID_SIZE;
+    }
+
+    if (tiff_size < _EXIF_HEADER_SIZE) {
+        IMC_LOG("EXIF data is too short for a TIFF header", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+    if (tiff[0] == 'M' && tiff[1] == 'M') {
+        exif->big_endian = true;
+    } else if (tiff[0] == 'I' && tiff[1] == 'I') {
+        exif->big_endian = false;
+    } else {
+        IMC_LOG("Unknown TIFF byte order", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+    if (_imc_exif_u16(tiff + 2, exif->big_endian) != 42) {
+        IMC_LOG("Bad TIFF magic number", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    exif->tiff = tiff;
+    exif->size = tiff_size;
+    memset(exif->ifd, 0, sizeof(exif->ifd));
+
+    exif->ifd[EXIF_IFD_0] = _imc_exif_u32(tiff + 4, exif->big_endian);
+    if (!_imc_exif_ifd_valid(exif, exif->ifd[EXIF_IFD_0])) {
+        IMC_LOG("IFD0 lies outside of the EXIF data", IMC_ERROR);
+        exif->ifd[EXIF_IFD_0] = 0;
+        return IMC_EOVERFLOW;
+    }
+
+    /* A damaged sub-IFD only loses its own tags, so it is dropped rather than failing the parse */
+    exif->ifd[EXIF_IFD_1] = _imc_exif_next_ifd(exif, exif->ifd[EXIF_IFD_0]);
+    if (exif->ifd[EXIF_IFD_1] == exif->ifd[EXIF_IFD_0]
+        || !_imc_exif_ifd_valid(exif, exif->ifd[EXIF_IFD_1])) {
+        exif->ifd[EXIF_IFD_1] = 0;
+    }
+    exif->ifd[EXIF_IFD_EXIF] = _imc_exif_sub_ifd(exif, EXIF_IFD_0, EXIF_TAG_EXIF_IFD);
+    exif->ifd[EXIF_IFD_GPS] = _imc_exif_sub_ifd(exif, EXIF_IFD_0, EXIF_TAG_GPS_IFD);
+    exif->ifd[EXIF_IFD_INTEROP] = _imc_exif_sub_ifd(exif, EXIF_IFD_EXIF, EXIF_TAG_INTEROP_IFD);
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Locates the EXIF data in the APP1 segment of a JPEG and parses it.
+ * Only the marker segments before the first scan are visited, so the entropy coded data is never read.
+ * @since 16-10-2026
+ * @param[in] data The JPEG file
+ * @param[in] size The size of __data__ (in bytes)
+ * @param[out] exif A view of the EXIF data, valid for as long as __data__ is
+ * @returns IMC_EOK on success, IMC_ENODATA if the JPEG has no EXIF data, or another error code on failure
+ */
+ImcError_t imc_exif_from_jpeg(const uint8_t* const data, const size_t size, Exif_t *exif) {
+    size_t pos, len;
+    uint8_t marker;
+
+    if (data == NULL || exif == NULL) {
+        return IMC_EFAULT;
+    }
+
+    if (size < 4 || data[0] != 0xFF || data[1] != _EXIF_JPEG_SOI) {
+        IMC_LOG("Not a JPEG file", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    pos = 2;
+    while (pos < size) {
+        if (data[pos] != 0xFF) {
+            IMC_LOG("Expected a JPEG marker", IMC_ERROR);
+            return IMC_EINVAL;
+        }
+        /* Any number of fill bytes may precede a marker */
+        while (pos < size && data[pos] == 0xFF) {
+            ++pos;
+        }
+        if (pos >= size) {
+            break;
+        }
+        marker = data[pos++];
+
+        if (marker == _EXIF_JPEG_SOS || marker == _EXIF_JPEG_EOI) {
+            break;
+        }
+        /* Standalone markers carry no length */
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7)) {
+            continue;
+        }
+
+        if (size - pos < 2) {
+            break;
+        }
+        len = (size_t)((data[pos] << 8) | data[pos + 1]);
+        if (len < 2 || len > size - pos) {
+            IMC_LOG("JPEG segment runs past the end of the file", IMC_ERROR);
+            return IMC_EOVERFLOW;
+        }
+
+        /* APP1 is shared with XMP, which is told apart by its identifier */
+        if (marker == _EXIF_JPEG_APP1 && len - 2 >= _EXIF_ID_SIZE
+            && memcmp(data + pos + 2, _EXIF_ID, _EXIF_ID_SIZE) == 0) {
+            return imc_exif_parse(data + pos + 2, len - 2, exif);
+        }
+        pos += len;
+    }
+
+    return IMC_ENODATA;
+}
+
+/**
+ * @brief Locates the eXIf chunk of a PNG and parses it.
+ * Chunks are skipped by their length without reading their data or checking their CRC.
+ * @since 16-10-2026
+ * @param[in] data The PNG file
+ * @param[in] size The size of __data__ (in bytes)
+ * @param[out] exif A view of the EXIF data, valid for as long as __data__ is
+ * @returns IMC_EOK on success, IMC_ENODATA if the PNG has no eXIf chunk, or another error code on failure
+ */
+ImcError_t imc_exif_from_png(const uint8_t* const data, const size_t size, Exif_t *exif) {
+    const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    size_t pos, len;
+
+    if (data == NULL || exif == NULL) {
+        return IMC_EFAULT;
+    }
+
+    if (size < sizeof(signature) || memcmp(data, signature, sizeof(signature)) != 0) {
+        IMC_LOG("Not a PNG file", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    pos = sizeof(signature);
+    while (size - pos >= 12) {
+        len = ((size_t)data[pos] << 24) | ((size_t)data[pos + 1] << 16)
+            | ((size_t)data[pos + 2] << 8) | data[pos + 3];
+        if (len > size - pos - 12) {
+            IMC_LOG("PNG chunk runs past the end of the file", IMC_ERROR);
+            return IMC_EOVERFLOW;
+        }
+
+        if (memcmp(data + pos + 4, "eXIf", 4) == 0) {
+            return imc_exif_parse(data + pos + 8, len, exif);
+        }
+        if (memcmp(data + pos + 4, "IEND", 4) == 0) {
+            break;
+        }
+        pos += len + 12;
+    }
+
+    return IMC_ENODATA;
+}
+
+/**
+ * @brief Returns the number of entries in an IFD.
+ * @since 16-10-2026
+ * @param[in] exif The parsed EXIF data
+ * @param[in] ifd The IFD to count
+ * @returns The number of entries, or 0 if the IFD is absent
+ */
+size_t imc_exif_count(const Exif_t* const exif, const ExifIfd_t ifd) {
+    if (exif == NULL || ifd >= EXIF_N_IFDS || exif->ifd[ifd] == 0) {
+        return 0;
+    }
+
+    return _imc_exif_u16(exif->tiff + exif->ifd[ifd], exif->big_endian);
+}
+
+/**
+ * @brief Retrieves an entry of an IFD by its position.
+ * @since 16-10-2026
+ * @param[in] exif The parsed EXIF data
+ * @param[in] ifd The IFD holding the entry
+ * @param[in] index The position of the entry (less than imc_exif_count())
+ * @param[out] entry A view of the entry's values
+ * @returns IMC_EOK on success, IMC_ENODATA if there is no such entry, or IMC_EOVERFLOW if its values are out of bounds
+ */
+ImcError_t imc_exif_entry(
+    const Exif_t* const exif,
+    const ExifIfd_t ifd,
+    const size_t index,
+    ExifEntry_t *entry
+) {
+    if (exif == NULL || entry == NULL) {
+        return IMC_EFAULT;
+    }
+    if (index >= imc_exif_count(exif, ifd)) {
+        return IMC_ENODATA;
+    }
+
+    return _imc_exif_read_entry(exif, (size_t)exif->ifd[ifd] + 2 + index * _EXIF_ENTRY_SIZE, entry);
+}
+
+/**
+ * @brief Retrieves an entry of an IFD by its tag.
+ * @since 16-10-2026
+ * @param[in] exif The parsed EXIF data
+ * @param[in] ifd The IFD holding the entry
+ * @param[in] tag The tag of the entry
+ * @param[out] entry A view of the entry's values
+ * @returns IMC_EOK on success, IMC_ENODATA if the tag is absent, or IMC_EOVERFLOW if its values are out of bounds
+ */
+ImcError_t imc_exif_find(
+    const Exif_t* const exif,
+    const ExifIfd_t ifd,
+    const uint16_t tag,
+    ExifEntry_t *entry
+) {
+    size_t n_entries, pos, i;
+
+    if (exif == NULL || entry == NULL) {
+        return IMC_EFAULT;
+    }
+
+    n_entries = imc_exif_count(exif, ifd);
+    for (i = 0; i < n_entries; ++i) {
+        pos = (size_t)exif->ifd[ifd] + 2 + i * _EXIF_ENTRY_SIZE;
+        /* Entries should be sorted by tag, but plenty of writers don't bother, so every one is checked */
+        if (_imc_exif_u16(exif->tiff + pos, exif->big_endian) == tag) {
+            return _imc_exif_read_entry(exif, pos, entry);
+        }
+    }
+
+    return IMC_ENODATA;
+}
+
+/**
+ * @brief Reads an unsigned integer value of an entry.
+ * @since 16-10-2026
+ * @param[in] entry An entry of type BYTE, UNDEFINED, SHORT or LONG
+ * @param[in] index The position of the value (less than the entry's count)
+ * @param[out] value The value
+ * @returns IMC_EOK on success, or IMC_EINVAL if the entry has another type or too few values
+ */
+ImcError_t imc_exif_uint(const ExifEntry_t* const entry, const size_t index, uint32_t *value) {
+    if (entry == NULL || value == NULL) {
+        return IMC_EFAULT;
+    }
+    if (entry->data == NULL || index >= entry->count) {
+        return IMC_EINVAL;
+    }
+
+    switch (entry->type) {
+        case EXIF_BYTE:
+        case EXIF_UNDEFINED:
+            *value = entry->data[index];
+            break;
+        case EXIF_SHORT:
+            *value = _imc_exif_u16(entry->data + index * 2, entry->big_endian);
+            break;
+        case EXIF_LONG:
+            *value = _imc_exif_u32(entry->data + index * 4, entry->big_endian);
+            break;
+        default:
+            return IMC_EINVAL;
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Reads a signed integer value of an entry.
+ * @since 16-10-2026
+ * @param[in] entry An entry of type SBYTE, SSHORT or SLONG, or of the unsigned types BYTE and SHORT
+ * @param[in] index The position of the value (less than the entry's count)
+ * @param[out] value The value
+ * @returns IMC_EOK on success, or IMC_EINVAL if the entry has another type or too few values
+ */
+ImcError_t imc_exif_sint(const ExifEntry_t* const entry, const size_t index, int32_t *value) {
+    if (entry == NULL || value == NULL) {
+        return IMC_EFAULT;
+    }
+    if (entry->data == NULL || index >= entry->count) {
+        return IMC_EINVAL;
+    }
+
+    switch (entry->type) {
+        case EXIF_BYTE:
+            *value = entry->data[index];
+            break;
+        case EXIF_SBYTE:
+            *value = (int8_t)entry->data[index];
+            break;
+        case EXIF_SHORT:
+            *value = _imc_exif_u16(entry->data + index * 2, entry->big_endian);
+            break;
+        case EXIF_SSHORT:
+            *value = (int16_t)_imc_exif_u16(entry->data + index * 2, entry->big_endian);
+            break;
+        case EXIF_SLONG:
+            *value = (int32_t)_imc_exif_u32(entry->data + index * 4, entry->big_endian);
+            break;
+        default:
+            return IMC_EINVAL;
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Reads a fraction value of an entry.
+ * @since 16-10-2026
+ * @param[in] entry An entry of type RATIONAL or SRATIONAL
+ * @param[in] index The position of the value (less than the entry's count)
+ * @param[out] num The numerator
+ * @param[out] den The denominator (which may be 0 in malformed or "unknown" values)
+ * @returns IMC_EOK on success, or IMC_EINVAL if the entry has another type or too few values
+ */
+ImcError_t imc_exif_rational(
+    const ExifEntry_t* const entry,
+    const size_t index,
+    int64_t *num,
+    int64_t *den
+) {
+    const uint8_t *raw;
+
+    if (entry == NULL || num == NULL || den == NULL) {
+        return IMC_EFAULT;
+    }
+    if (entry->data == NULL || index >= entry->count) {
+        return IMC_EINVAL;
+    }
+
+    raw = entry->data + index * 8;
+    switch (entry->type) {
+        case EXIF_RATIONAL:
+            *num = _imc_exif_u32(raw, entry->big_endian);
+            *den = _imc_exif_u32(raw + 4, entry->big_endian);
+            break;
+        case EXIF_SRATIONAL:
+            *num = (int32_t)_imc_exif_u32(raw, entry->big_endian);
+            *den = (int32_t)_imc_exif_u32(raw + 4, entry->big_endian);
+            break;
+        default:
+            return IMC_EINVAL;
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Reads any numeric value of an entry as a double.
+ * @since 16-10-2026
+ * @param[in] entry An entry of any integer, fraction or floating point type
+ * @param[in] index The position of the value (less than the entry's count)
+ * @param[out] value The value
+ * @returns IMC_EOK on success, or IMC_EINVAL if the entry isn't numeric, has too few values or divides by 0
+ */
+ImcError_t imc_exif_real(const ExifEntry_t* const entry, const size_t index, double *value) {
+    const uint8_t *raw;
+    uint32_t u32;
+    int32_t s32;
+    int64_t num, den;
+    uint64_t bits;
+    float f;
+    double d;
+
+    if (entry == NULL || value == NULL) {
+        return IMC_EFAULT;
+    }
+    if (entry->data == NULL || index >= entry->count) {
+        return IMC_EINVAL;
+    }
+
+    switch (entry->type) {
+        case EXIF_BYTE:
+        case EXIF_SHORT:
+        case EXIF_LONG:
+            imc_exif_uint(entry, index, &u32);
+            *value = u32;
+            break;
+        case EXIF_SBYTE:
+        case EXIF_SSHORT:
+        case EXIF_SLONG:
+            imc_exif_sint(entry, index, &s32);
+            *value = s32;
+            break;
+        case EXIF_RATIONAL:
+        case EXIF_SRATIONAL:
+            imc_exif_rational(entry, index, &num, &den);
+            if (den == 0) {
+                return IMC_EINVAL;
+            }
+            *value = (double)num / (double)den;
+            break;
+        case EXIF_FLOAT:
+            u32 = _imc_exif_u32(entry->data + index * 4, entry->big_endian);
+            memcpy(&f, &u32, sizeof(f));
+            *value = f;
+            break;
+        case EXIF_DOUBLE:
+            raw = entry->data + index * 8;
+            bits = entry->big_endian
+                ? ((uint64_t)_imc_exif_u32(raw, true) << 32) | _imc_exif_u32(raw + 4, true)
+                : ((uint64_t)_imc_exif_u32(raw + 4, false) << 32) | _imc_exif_u32(raw, false);
+            memcpy(&d, &bits, sizeof(d));
+            *value = d;
+            break;
+        default:
+            return IMC_EINVAL;
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Returns a view of the text of an ASCII entry.
+ * @warning The text is not guaranteed to be NUL terminated, so __len__ must be respected.
+ * @since 16-10-2026
+ * @param[in] entry An entry of type ASCII
+ * @param[out] str The first character of the text (within the caller's buffer)
+ * @param[out] len The length of the text, up to its first NUL
+ * @returns IMC_EOK on success, or IMC_EINVAL if the entry has another type
+ */
+ImcError_t imc_exif_string(const ExifEntry_t* const entry, const char **str, size_t *len) {
+    const uint8_t *nul;
+
+    if (entry == NULL || str == NULL || len == NULL) {
+        return IMC_EFAULT;
+    }
+    if (entry->type != EXIF_ASCII || entry->data == NULL) {
+        return IMC_EINVAL;
+    }
+
+    nul = memchr(entry->data, '\0', entry->size);
+    *str = (const char*)entry->data;
+    *len = (nul != NULL) ? (size_t)(nul - entry->data) : entry->size;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Reads the Orientation tag of IFD0.
+ * @since 16-10-2026
+ * @param[in] exif The parsed EXIF data
+ * @param[out] orientation The orientation (1-8, where 1 means the image is stored upright)
+ * @returns IMC_EOK on success, IMC_ENODATA if the tag is absent, or IMC_EINVAL if it is out of range
+ */
+ImcError_t imc_exif_orientation(const Exif_t* const exif, uint16_t *orientation) {
+    ExifEntry_t entry;
+    uint32_t value;
+    ImcError_t status;
+
+    if (exif == NULL || orientation == NULL) {
+        return IMC_EFAULT;
+    }
+
+    if ((status = imc_exif_find(exif, EXIF_IFD_0, EXIF_TAG_ORIENTATION, &entry)) != IMC_EOK) {
+        return status;
+    }
+    if (imc_exif_uint(&entry, 0, &value) != IMC_EOK || value < 1 || value > 8) {
+        return IMC_EINVAL;
+    }
+    *orientation = (uint16_t)value;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Reads the location of the GPS IFD as decimal degrees.
+ * @since 16-10-2026
+ * @param[in] exif The parsed EXIF data
+ * @param[out] latitude The latitude (negative south of the equator)
+ * @param[out] longitude The longitude (negative west of the prime meridian)
+ * @returns IMC_EOK on success, IMC_ENODATA if the location is absent, or IMC_EINVAL if it is malformed
+ */
+ImcError_t imc_exif_gps(const Exif_t* const exif, double *latitude, double *longitude) {
+    ImcError_t status;
+
+    if (exif == NULL || latitude == NULL || longitude == NULL) {
+        return IMC_EFAULT;
+    }
+
+    status = _imc_exif_gps_coord(exif, EXIF_TAG_GPS_LATITUDE_REF, EXIF_TAG_GPS_LATITUDE, 'S', latitude);
+    if (status != IMC_EOK) {
+        return status;
+    }
+
+    return _imc_exif_gps_coord(exif, EXIF_TAG_GPS_LONGITUDE_REF, EXIF_TAG_GPS_LONGITUDE, 'W', longitude);
+}
+
+/**
+ * @brief Locates the JPEG thumbnail that IFD1 points to.
+ * The thumbnail is returned as a view of the caller's buffer, found from IFD1 alone without
+ * touching the primary image. It is a complete JPEG file which may be passed to imc_jpeg_decode_mem().
+ * @since 16-10-2026
+ * @param[in] exif The parsed EXIF data
+ * @param[out] data The first byte of the thumbnail (its SOI marker)
+ * @param[out] size The size of the thumbnail (in bytes)
+ * @returns IMC_EOK on success, IMC_ENODATA if there is no JPEG thumbnail, or another error code if it is malformed
+ */
+ImcError_t imc_exif_thumbnail(const Exif_t* const exif, const uint8_t **data, size_t *size) {
+    ExifEntry_t entry;
+    uint32_t compression, offset, length;
+
+    if (exif == NULL || data == NULL || size == NULL) {
+        return IMC_EFAULT;
+    }
+
+    /* The tag is mandatory, but a missing one is taken to mean JPEG as that is all IFD1 ever holds in practice */
+    if (imc_exif_find(exif, EXIF_IFD_1, EXIF_TAG_COMPRESSION, &entry) == IMC_EOK
+        && imc_exif_uint(&entry, 0, &compression) == IMC_EOK
+        && compression != _EXIF_COMPRESSION_JPEG) {
+        IMC_LOG("Only JPEG thumbnails are supported", IMC_WARNING);
+        return IMC_ENODATA;
+    }
+
+    if (imc_exif_find(exif, EXIF_IFD_1, EXIF_TAG_JPEG_OFFSET, &entry) != IMC_EOK
+        || imc_exif_uint(&entry, 0, &offset) != IMC_EOK
+        || imc_exif_find(exif, EXIF_IFD_1, EXIF_TAG_JPEG_LENGTH, &entry) != IMC_EOK
+        || imc_exif_uint(&entry, 0, &length) != IMC_EOK) {
+        return IMC_ENODATA;
+    }
+
+    if (offset > exif->size || length > exif->size - offset) {
+        IMC_LOG("Thumbnail lies outside of the EXIF data", IMC_ERROR);
+        return IMC_EOVERFLOW;
+    }
+    if (length < 4 || exif->tiff[offset] != 0xFF || exif->tiff[offset + 1] != _EXIF_JPEG_SOI) {
+        IMC_LOG("Thumbnail is not a JPEG", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    *data = exif->tiff + offset;
+    *size = length;
+
+    return IMC_EOK;
+}
@@ -0,0 +1,1962 @@
+/**
+ * @file imc_deflate.c
+ * @author Neil Kingdom
+ * @since 16-10-2026
+ * @version 1.0
+ * @brief Contains in-tree DEFLATE (RFC 1951) compressors specialized for filtered PNG scanlines.
+ *
+ * DeflateRle_t only codes runs and is the fastest. DeflateLz_t is a general LZ77
+ * compressor with levels ranging from faster than zlib's level 1 to smaller than
+ * its level 9. Both share the block writer. Output is raw DEFLATE. Callers which need a zlib (RFC 1950) stream add the
+ * two byte header themselves and terminate the stream with imc_adler32().
+ */
+
+#include "imc_deflate.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* Largest prime smaller than 65536 */
+#define _ADLER_BASE 65521
+
+/* Most bytes which can be summed before s2 may overflow 32 bits */
+#define _ADLER_NMAX 5552
+
+/* Bytes of slack the bit writer may scribble past the end of its output */
+#define _BITBUF_SLACK 8
+
+/* Number of input bytes the run-length compressor gathers before emitting a block */
+#define _RLE_BLOCK_SIZE (1 << 18)
+
+/* Upper bound on the size of a dynamic block header (in bytes) */
+#define _DYN_HEADER_MAX 320
+
+/* Number of code length symbols and the longest code length code */
+#define _N_CLEN 19
+#define _MAX_CLEN_CODE_LEN 7
+
+/* Size of the LZ77 window and the number of input bytes the LZ77 compressor tokenizes at once */
+#define _LZ_WINDOW_SIZE (1 << 15)
+#define _LZ_BLOCK_SIZE  (1 << 18)
+
+/* Bytes of zeros kept past the end of the LZ77 window so that hashing may read beyond the input */
+#define _LZ_WINDOW_PAD 16
+
+/* Number of bits of the match finder's hash */
+#define _LZ_HASH_BITS 16
+
+/*
+ * Number of tokens between candidate block boundaries, and so the most blocks a call to _imc_lz_block() emits
+ * (one more for the tokens held back from the previous call). Also the most tokens which may be held back
+ */
+#define _LZ_SPLIT_TOKENS 8192
+#define _LZ_MAX_BLOCKS   (_LZ_BLOCK_SIZE / _LZ_SPLIT_TOKENS + 1)
+
+/* Most matches remembered at each offset for optimal parsing */
+#define _LZ_CACHE_DEPTH 8
+
+/* Match count marking an offset inside a long match, whose single cached match is only taken whole */
+#define _LZ_CACHE_SKIP (_LZ_CACHE_DEPTH + 1)
+
+/* Farthest distance of a match of DEFLATE_MIN_MATCH bytes, which would cost more than its literals beyond it */
+#define _LZ_TOO_FAR 4096
+
+/* Most hash chain entries searched when caching the matches of each offset for optimal parsing */
+#define _LZ_CACHE_CHAIN 64
+
+/* Assumed cost (in bits) of symbols absent from the previous pass of optimal parsing */
+#define _LZ_UNUSED_COST 13
+
+/* Ways of parsing the input into tokens */
+#define _PARSE_GREEDY  0
+#define _PARSE_LAZY    1
+#define _PARSE_OPTIMAL 2
+
+/* Tokens hold a literal byte, or a flag, the match length and the match distance less 1 */
+#define _TOK_MATCH 0x80000000u
+#define _TOK(len, dist) (_TOK_MATCH | ((uint32_t)(len) << 15) | ((uint32_t)(dist) - 1))
+#define _TOK_LEN(tok)   (((tok) >> 15) & 0x1FF)
+#define _TOK_DIST(tok)  (((tok) & 0x7FFF) + 1)
+
+/* Base match length and number of extra bits of length codes 257-285 */
+static const uint16_t _imc_len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t _imc_len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+/* Base distance and number of extra bits of distance codes 0-29 */
+static const uint16_t _imc_dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t _imc_dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/* Order in which code length code lengths are transmitted */
+static const uint8_t _imc_clen_order[_N_CLEN] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+typedef struct {
+    uint16_t litlen_code[DEFLATE_N_LITLEN];     /* Bit-reversed literal/length codes */
+    uint8_t  litlen_len[DEFLATE_N_LITLEN];      /* Literal/length code lengths */
+    uint16_t dist_code[DEFLATE_N_DIST];         /* Bit-reversed distance codes */
+    uint8_t  dist_len[DEFLATE_N_DIST];          /* Distance code lengths */
+} HuffTables_t;
+
+typedef struct {
+    HuffTables_t tables;                                /* Codes of the block */
+    uint16_t     items[DEFLATE_N_LITLEN + DEFLATE_N_DIST];  /* Run-length coded code lengths */
+    size_t       n_items;                               /* Number of items */
+    uint8_t      clen_len[_N_CLEN];                     /* Code lengths of the code length alphabet */
+    size_t       n_lit;                                 /* Number of literal/length code lengths sent (HLIT + 257) */
+    size_t       n_dist;                                /* Number of distance code lengths sent (HDIST + 1) */
+    size_t       n_clen;                                /* Number of code length code lengths sent (HCLEN + 4) */
+} DynHeader_t;
+
+typedef struct {
+    uint16_t max_chain;     /* Most hash chain entries searched for a match */
+    uint16_t good_len;      /* Match length from which the hash chain is searched a quarter as deep */
+    uint16_t lazy_len;      /* Lazy: match length which is not deferred. Greedy: longest match whose offsets are hashed */
+    uint16_t nice_len;      /* Match length which ends the search early */
+    uint8_t  parse;         /* _PARSE_GREEDY, _PARSE_LAZY or _PARSE_OPTIMAL */
+    uint8_t  passes;        /* Number of optimal parsing passes */
+} LzParams_t;
+
+/*
+ * Match finder settings of each compression level (level 0 stores the input). Levels 4-9 are zlib's, while
+ * the greedy levels hash the offsets of longer matches and search deeper than zlib's levels 1-3.
+ */
+static const LzParams_t _imc_lz_params[DEFLATE_MAX_LEVEL + 1] = {
+    { 0,    0,  0,   0,   _PARSE_GREEDY,  0 },
+    { 16,   8,  16,  32,  _PARSE_GREEDY,  0 },
+    { 24,   8,  16,  32,  _PARSE_GREEDY,  0 },
+    { 32,   8,  32,  64,  _PARSE_GREEDY,  0 },
+    { 16,   4,  4,   16,  _PARSE_LAZY,    0 },
+    { 32,   8,  16,  32,  _PARSE_LAZY,    0 },
+    { 128,  8,  16,  128, _PARSE_LAZY,    0 },
+    { 256,  8,  32,  128, _PARSE_LAZY,    0 },
+    { 1024, 32, 128, 258, _PARSE_LAZY,    0 },
+    { 4096, 32, 258, 258, _PARSE_LAZY,    0 },
+    { 4096, 32, 258, 258, _PARSE_OPTIMAL, 1 },
+    { 4096, 32, 258, 258, _PARSE_OPTIMAL, 2 },
+    { 4096, 32, 258, 258, _PARSE_OPTIMAL, 3 }
+};
+
+/*
+ * ===============================
+ *       Private Functions
+ * ===============================
+ */
+
+/**
+ * @brief Appends __n__ bits of __bits__ to the bit buffer of __bw__.
+ * __bw__ points to a DeflateBits_t. At most 32 bits may be appended
+ * at once, and the buffer must be flushed before it holds more than 64.
+ */
+#define _IMC_PUT_BITS(bw, bits, n) do { \
+    (bw)->bitbuf |= (uint64_t)(bits) << (bw)->bitcount; \
+    (bw)->bitcount += (n); \
+} while (0)
+
+/**
+ * @brief Moves all whole bytes from the bit buffer of __bw__ to __out__ and advances it.
+ * Always stores 8 bytes, so __out__ must have _BITBUF_SLACK bytes of room past the data.
+ */
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define _IMC_FLUSH_BITS(bw, out) do { \
+    memcpy((void*)(out), (void*)&(bw)->bitbuf, sizeof((bw)->bitbuf)); \
+    (out) += (bw)->bitcount >> 3; \
+    (bw)->bitbuf = ((bw)->bitcount >= 64) ? 0 : (bw)->bitbuf >> ((bw)->bitcount & ~7u); \
+    (bw)->bitcount &= 7; \
+} while (0)
+#else
+#define _IMC_FLUSH_BITS(bw, out) do { \
+    while ((bw)->bitcount >= 8) { \
+        *(out)++ = (uint8_t)(bw)->bitbuf; \
+        (bw)->bitbuf >>= 8; \
+        (bw)->bitcount -= 8; \
+    } \
+} while (0)
+#endif
+
+/**
+ * @brief Reverses the order of the low __n__ bits of __code__.
+ * Huffman codes are packed starting with their most significant bit, whereas
+ * every other DEFLATE field is packed starting with its least significant bit.
+ * @since 16-10-2026
+ * @param[in] code The code to be reversed
+ * @param[in] n The length of the code (in bits)
+ * @returns The reversed code
+ */
+static uint32_t _imc_reverse_bits(uint32_t code, const uint8_t n) {
+    uint8_t i;
+    uint32_t res = 0;
+
+    for (i = 0; i < n; ++i) {
+        res = (res << 1) | (code & 1);
+        code >>= 1;
+    }
+
+    return res;
+}
+
+/**
+ * @brief Returns the index of the length code which represents match length __len__.
+ * @since 16-10-2026
+ * @param[in] len A match length (3-258)
+ * @returns An index into _imc_len_base (add 257 for the symbol)
+ */
+static uint32_t _imc_len_slot(const uint32_t len) {
+    uint32_t slot = 0;
+
+    while (slot < 28 && _imc_len_base[slot + 1] <= len) {
+        ++slot;
+    }
+
+    return slot;
+}
+
+/**
+ * @brief Returns the index of the distance code which represents distance __dist__.
+ * Past the first four, distance codes come in pairs per power of two, split by the bit below the highest.
+ * @since 16-10-2026
+ * @param[in] dist A match distance (1-32768)
+ * @returns An index into _imc_dist_base
+ */
+static inline uint32_t _imc_dist_slot(const uint32_t dist) {
+    uint32_t n, d = dist - 1;
+
+    if (d < 4) {
+        return d;
+    }
+    n = 31 - __builtin_clz(d);
+
+    return 2 * n + ((d >> (n - 1)) & 1);
+}
+
+/**
+ * @brief Sorts symbol indices by ascending frequency (insertion sort; alphabets are at most 286 symbols).
+ * @since 16-10-2026
+ * @param[in] freq The frequency of each symbol
+ * @param[in,out] syms The symbols to be sorted
+ * @param[in] n The number of symbols
+ */
+static void _imc_sort_by_freq(const uint32_t *freq, uint16_t *syms, const size_t n) {
+    size_t i, j;
+    uint16_t sym;
+
+    for (i = 1; i < n; ++i) {
+        sym = syms[i];
+        for (j = i; j > 0 && freq[syms[j - 1]] > freq[sym]; --j) {
+            syms[j] = syms[j - 1];
+        }
+        syms[j] = sym;
+    }
+}
+
+/**
+ * @brief Computes length-limited Huffman code lengths for an alphabet.
+ * An optimal (unlimited) Huffman tree is built with the two-queue method, then any
+ * codes longer than __max_len__ are shortened and the Kraft sum is repaired by
+ * lengthening the least frequent shorter codes. The resulting code is always
+ * complete, so at least two symbols are given a code (unused ones if needed),
+ * as zlib rejects incomplete literal/length and code length codes.
+ * @since 16-10-2026
+ * @param[in] freq The frequency of each symbol
+ * @param[in] n The number of symbols in the alphabet (at most DEFLATE_N_LITLEN)
+ * @param[in] max_len The longest permitted code (in bits)
+ * @param[out] lens The output location for the code length of each symbol (0 if unused)
+ */
+static void _imc_huff_lengths(
+    const uint32_t *freq,
+    const size_t n,
+    const uint8_t max_len,
+    uint8_t *lens
+) {
+    size_t i, n_used, leaf, node, n_nodes, pick;
+    uint32_t kraft, weight[2 * DEFLATE_N_LITLEN];
+    uint16_t syms[DEFLATE_N_LITLEN], parent[2 * DEFLATE_N_LITLEN];
+    uint32_t count[DEFLATE_MAX_CODE_LEN + 2] = { 0 };
+    uint32_t depth[2 * DEFLATE_N_LITLEN];
+    uint32_t adj_freq[DEFLATE_N_LITLEN];
+
+    memset((void*)lens, 0, n);
+
+    /* Guarantee two symbols so that a complete code exists */
+    memcpy((void*)adj_freq, (void*)freq, n * sizeof(*freq));
+    for (i = 0, n_used = 0; i < n; ++i) {
+        n_used += (adj_freq[i] > 0);
+    }
+    for (i = 0; i < n && n_used < 2; ++i) {
+        if (adj_freq[i] == 0) {
+            adj_freq[i] = 1;
+            ++n_used;
+        }
+    }
+
+    for (i = 0, n_used = 0; i < n; ++i) {
+        if (adj_freq[i] > 0) {
+            syms[n_used++] = i;
+        }
+    }
+    _imc_sort_by_freq(adj_freq, syms, n_used);
+
+    /*
+     * Two-queue Huffman construction. Leaves are consumed in ascending order from syms and
+     * internal nodes are created in ascending order of weight, so the two lightest items are
+     * always at the front of one of the queues. Internal nodes are numbered from n_used.
+     */
+    for (i = 0; i < n_used; ++i) {
+        weight[i] = adj_freq[syms[i]];
+    }
+
+    leaf = 0;
+    node = n_used;
+    n_nodes = n_used;
+    while (n_nodes < 2 * n_used - 1) {
+        for (i = 0; i < 2; ++i) {
+            if (leaf < n_used && (node >= n_nodes || weight[leaf] <= weight[node])) {
+                pick = leaf++;
+            } else {
+                pick = node++;
+            }
+            parent[pick] = n_nodes;
+            weight[n_nodes] = (i == 0) ? weight[pick] : weight[n_nodes] + weight[pick];
+        }
+        ++n_nodes;
+    }
+
+    /* Depths are found walking from the root, which is the last node created */
+    depth[n_nodes - 1] = 0;
+    for (i = n_nodes - 1; i-- > 0;) {
+        depth[i] = depth[parent[i]] + 1;
+    }
+
+    for (i = 0; i < n_used; ++i) {
+        count[(depth[i] > max_len) ? max_len + 1u : depth[i]]++;
+    }
+
+    /* Fold codes which are too long into max_len, then repair the Kraft sum */
+    count[max_len] += count[max_len + 1];
+    count[max_len + 1] = 0;
+    kraft = 0;
+    for (i = 1; i <= max_len; ++i) {
+        kraft += count[i] << (max_len - i);
+    }
+    while (kraft > (1u << max_len)) {
+        count[max_len]--;
+        for (i = max_len - 1; i > 0; --i) {
+            if (count[i] > 0) {
+                count[i]--;
+                count[i + 1] += 2;
+                break;
+            }
+        }
+        kraft--;
+    }
+
+    /* The most frequent symbols (at the back of syms) receive the shortest codes */
+    pick = n_used;
+    for (i = 1; i <= max_len; ++i) {
+        while (count[i]-- > 0) {
+            lens[syms[--pick]] = i;
+        }
+    }
+}
+
+/**
+ * @brief Assigns canonical Huffman codes (bit-reversed, ready for LSB-first packing) from code lengths.
+ * @since 16-10-2026
+ * @param[in] lens The code length of each symbol (0 if unused)
+ * @param[in] n The number of symbols
+ * @param[out] codes The output location for the code of each symbol
+ */
+static void _imc_huff_codes(const uint8_t *lens, const size_t n, uint16_t *codes) {
+    size_t i;
+    uint32_t code = 0;
+    uint32_t count[DEFLATE_MAX_CODE_LEN + 1] = { 0 };
+    uint32_t next[DEFLATE_MAX_CODE_LEN + 1] = { 0 };
+
+    for (i = 0; i < n; ++i) {
+        count[lens[i]]++;
+    }
+    count[0] = 0;
+
+    for (i = 1; i <= DEFLATE_MAX_CODE_LEN; ++i) {
+        code = (code + count[i - 1]) << 1;
+        next[i] = code;
+    }
+
+    for (i = 0; i < n; ++i) {
+        codes[i] = (lens[i] > 0) ? _imc_reverse_bits(next[lens[i]]++, lens[i]) : 0;
+    }
+}
+
+/**
+ * @brief Counts the symbols used by __n__ tokens, plus one end of block.
+ * @since 16-10-2026
+ * @param[in] tokens The tokens
+ * @param[in] n The number of tokens
+ * @param[in] len_slot The length code (less 257) of each match length
+ * @param[out] lit_freq The output location for the literal/length symbol frequencies
+ * @param[out] dist_freq The output location for the distance symbol frequencies
+ * @returns The number of input bytes covered by the tokens
+ */
+static size_t _imc_token_freqs(
+    const uint32_t *tokens,
+    const size_t n,
+    const uint8_t *len_slot,
+    uint32_t *lit_freq,
+    uint32_t *dist_freq
+) {
+    size_t i, len, covered = 0;
+    uint32_t tok;
+
+    memset((void*)lit_freq, 0, DEFLATE_N_LITLEN * sizeof(*lit_freq));
+    memset((void*)dist_freq, 0, DEFLATE_N_DIST * sizeof(*dist_freq));
+
+    for (i = 0; i < n; ++i) {
+        tok = tokens[i];
+        if (tok < _TOK_MATCH) {
+            lit_freq[tok]++;
+            ++covered;
+        } else {
+            len = _TOK_LEN(tok);
+            lit_freq[257 + len_slot[len]]++;
+            dist_freq[_imc_dist_slot(_TOK_DIST(tok))]++;
+            covered += len;
+        }
+    }
+    lit_freq[DEFLATE_END_OF_BLOCK] = 1;
+
+    return covered;
+}
+
+/**
+ * @brief Returns the number of bits the symbols counted in __lit_freq__ and __dist__freq__ take with the given code lengths.
+ * @since 16-10-2026
+ * @param[in] lit_len Literal/length code lengths
+ * @param[in] dist_len Distance code lengths
+ * @param[in] lit_freq Literal/length symbol frequencies
+ * @param[in] dist_freq Distance symbol frequencies
+ * @returns The size of the coded symbols, including extra bits (in bits)
+ */
+static size_t _imc_data_bits(
+    const uint8_t *lit_len,
+    const uint8_t *dist_len,
+    const uint32_t *lit_freq,
+    const uint32_t *dist_freq
+) {
+    size_t i, bits = 0;
+
+    for (i = 0; i < 257; ++i) {
+        bits += (size_t)lit_freq[i] * lit_len[i];
+    }
+    for (i = 0; i < 29; ++i) {
+        bits += (size_t)lit_freq[257 + i] * (lit_len[257 + i] + _imc_len_extra[i]);
+    }
+    for (i = 0; i < DEFLATE_N_DIST; ++i) {
+        bits += (size_t)dist_freq[i] * (dist_len[i] + _imc_dist_extra[i]);
+    }
+
+    return bits;
+}
+
+/**
+ * @brief Fills __tables__ with the fixed Huffman codes of RFC 1951 3.2.6.
+ * @since 16-10-2026
+ * @param[out] tables The output location for the codes
+ */
+static void _imc_fixed_tables(HuffTables_t *tables) {
+    size_t i;
+    uint8_t lens[DEFLATE_N_LITLEN + 2];
+    uint16_t codes[DEFLATE_N_LITLEN + 2];
+
+    /* Symbols 286 and 287 take part in the code construction even though they never occur */
+    for (i = 0; i < DEFLATE_N_LITLEN + 2; ++i) {
+        lens[i] = (i < 144) ? 8 : (i < 256) ? 9 : (i < 280) ? 7 : 8;
+    }
+    _imc_huff_codes(lens, DEFLATE_N_LITLEN + 2, codes);
+    memcpy((void*)tables->litlen_len, (void*)lens, DEFLATE_N_LITLEN);
+    memcpy((void*)tables->litlen_code, (void*)codes, DEFLATE_N_LITLEN * sizeof(*codes));
+
+    /* Distance codes all share one length, so leaving out 30 and 31 changes nothing */
+    memset((void*)tables->dist_len, 5, DEFLATE_N_DIST);
+    _imc_huff_codes(tables->dist_len, DEFLATE_N_DIST, tables->dist_code);
+}
+
+/**
+ * @brief Computes the code lengths of a dynamic block and run-length codes them for its header.
+ * The code lengths are themselves run-length coded with symbols 16 (repeat previous),
+ * 17 (short run of zeros) and 18 (long run of zeros) as described in RFC 1951 3.2.7.
+ * @since 16-10-2026
+ * @param[in] lit_freq Literal/length symbol frequencies (must include the end of block)
+ * @param[in] dist_freq Distance symbol frequencies
+ * @param[out] hdr The output location for the code lengths and header contents
+ * @returns The size of the block header (in bits)
+ */
+static size_t _imc_dynamic_build(
+    const uint32_t *lit_freq,
+    const uint32_t *dist_freq,
+    DynHeader_t *hdr
+) {
+    size_t i, j, n_lens, run, bits;
+    uint8_t lens[DEFLATE_N_LITLEN + DEFLATE_N_DIST];
+    uint32_t clen_freq[_N_CLEN] = { 0 };
+    HuffTables_t *tables = &hdr->tables;
+
+    _imc_huff_lengths(lit_freq, DEFLATE_N_LITLEN, DEFLATE_MAX_CODE_LEN, tables->litlen_len);
+    _imc_huff_lengths(dist_freq, DEFLATE_N_DIST, DEFLATE_MAX_CODE_LEN, tables->dist_len);
+
+    for (hdr->n_lit = DEFLATE_N_LITLEN; hdr->n_lit > 257 && tables->litlen_len[hdr->n_lit - 1] == 0; --hdr->n_lit);
+    for (hdr->n_dist = DEFLATE_N_DIST; hdr->n_dist > 1 && tables->dist_len[hdr->n_dist - 1] == 0; --hdr->n_dist);
+    memcpy((void*)lens, (void*)tables->litlen_len, hdr->n_lit);
+    memcpy((void*)(lens + hdr->n_lit), (void*)tables->dist_len, hdr->n_dist);
+    n_lens = hdr->n_lit + hdr->n_dist;
+
+    /* Items hold the code length symbol in the low 5 bits and its repeat count above */
+    hdr->n_items = 0;
+    for (i = 0; i < n_lens; i += run) {
+        for (run = 1; i + run < n_lens && lens[i + run] == lens[i]; ++run);
+        if (lens[i] == 0 && run >= 11) {
+            run = (run > 138) ? 138 : run;
+            hdr->items[hdr->n_items++] = 18 | ((run - 11) << 5);
+        } else if (lens[i] == 0 && run >= 3) {
+            hdr->items[hdr->n_items++] = 17 | ((run - 3) << 5);
+        } else if (run >= 4) {
+            run = (run > 7) ? 7 : run;
+            hdr->items[hdr->n_items++] = lens[i];
+            hdr->items[hdr->n_items++] = 16 | ((run - 4) << 5);
+        } else {
+            for (j = 0; j < run; ++j) {
+                hdr->items[hdr->n_items++] = lens[i];
+            }
+        }
+    }
+    for (i = 0; i < hdr->n_items; ++i) {
+        clen_freq[hdr->items[i] & 0x1F]++;
+    }
+
+    _imc_huff_lengths(clen_freq, _N_CLEN, _MAX_CLEN_CODE_LEN, hdr->clen_len);
+    for (hdr->n_clen = _N_CLEN; hdr->n_clen > 4 && hdr->clen_len[_imc_clen_order[hdr->n_clen - 1]] == 0; --hdr->n_clen);
+
+    bits = 3 + 5 + 5 + 4 + 3 * hdr->n_clen;
+    for (i = 0; i < _N_CLEN; ++i) {
+        bits += (size_t)clen_freq[i] * hdr->clen_len[i];
+    }
+    bits += 2 * clen_freq[16] + 3 * clen_freq[17] + 7 * clen_freq[18];
+
+    return bits;
+}
+
+/**
+ * @brief Assigns the codes of a dynamic block built by _imc_dynamic_build() and writes the block header.
+ * @since 16-10-2026
+ * @param[in,out] bw The bit writer
+ * @param[in,out] hdr The code lengths and header contents (codes are filled in)
+ * @param[in] final True if this is the last block of the stream
+ * @param[in,out] out The output cursor
+ * @returns The advanced output cursor
+ */
+static uint8_t *_imc_dynamic_write(
+    DeflateBits_t *bw,
+    DynHeader_t *hdr,
+    const bool final,
+    uint8_t *out
+) {
+    size_t i, j;
+    uint16_t clen_code[_N_CLEN];
+
+    _imc_huff_codes(hdr->tables.litlen_len, DEFLATE_N_LITLEN, hdr->tables.litlen_code);
+    _imc_huff_codes(hdr->tables.dist_len, DEFLATE_N_DIST, hdr->tables.dist_code);
+    _imc_huff_codes(hdr->clen_len, _N_CLEN, clen_code);
+
+    /* BFINAL, BTYPE = 10 (dynamic Huffman codes), HLIT, HDIST, HCLEN */
+    _IMC_PUT_BITS(bw, (final ? 1 : 0) | (2 << 1), 3);
+    _IMC_PUT_BITS(bw, hdr->n_lit - 257, 5);
+    _IMC_PUT_BITS(bw, hdr->n_dist - 1, 5);
+    _IMC_PUT_BITS(bw, hdr->n_clen - 4, 4);
+    _IMC_FLUSH_BITS(bw, out);
+    for (i = 0; i < hdr->n_clen; ++i) {
+        _IMC_PUT_BITS(bw, hdr->clen_len[_imc_clen_order[i]], 3);
+        _IMC_FLUSH_BITS(bw, out);
+    }
+
+    for (i = 0; i < hdr->n_items; ++i) {
+        j = hdr->items[i] & 0x1F;
+        _IMC_PUT_BITS(bw, clen_code[j], hdr->clen_len[j]);
+        if (j == 16) {
+            _IMC_PUT_BITS(bw, hdr->items[i] >> 5, 2);
+        } else if (j == 17) {
+            _IMC_PUT_BITS(bw, hdr->items[i] >> 5, 3);
+        } else if (j == 18) {
+            _IMC_PUT_BITS(bw, hdr->items[i] >> 5, 7);
+        }
+        _IMC_FLUSH_BITS(bw, out);
+    }
+
+    return out;
+}
+
+/**
+ * @brief Codes __n__ tokens followed by the end of block with __tables__.
+ * @since 16-10-2026
+ * @param[in,out] bw The bit writer
+ * @param[in] tables The codes of the block
+ * @param[in] tokens The tokens
+ * @param[in] n The number of tokens
+ * @param[in] len_slot The length code (less 257) of each match length
+ * @param[in,out] out The output cursor
+ * @returns The advanced output cursor
+ */
+static uint8_t *_imc_emit_tokens(
+    DeflateBits_t *bw,
+    const HuffTables_t* const tables,
+    const uint32_t *tokens,
+    const size_t n,
+    const uint8_t *len_slot,
+    uint8_t *out
+) {
+    size_t i;
+    uint32_t tok, len, dist, slot, dslot;
+
+    for (i = 0; i < n; ++i) {
+        tok = tokens[i];
+        if (tok < _TOK_MATCH) {
+            _IMC_PUT_BITS(bw, tables->litlen_code[tok], tables->litlen_len[tok]);
+            /* Literals are at most 15 bits, so flush every third */
+            if (i % 3 == 2) {
+                _IMC_FLUSH_BITS(bw, out);
+            }
+        } else {
+            _IMC_FLUSH_BITS(bw, out);
+            len = _TOK_LEN(tok);
+            dist = _TOK_DIST(tok);
+            slot = len_slot[len];
+            dslot = _imc_dist_slot(dist);
+            _IMC_PUT_BITS(bw, tables->litlen_code[257 + slot], tables->litlen_len[257 + slot]);
+            _IMC_PUT_BITS(bw, len - _imc_len_base[slot], _imc_len_extra[slot]);
+            _IMC_FLUSH_BITS(bw, out);
+            _IMC_PUT_BITS(bw, tables->dist_code[dslot], tables->dist_len[dslot]);
+            _IMC_PUT_BITS(bw, dist - _imc_dist_base[dslot], _imc_dist_extra[dslot]);
+            _IMC_FLUSH_BITS(bw, out);
+        }
+    }
+    _IMC_FLUSH_BITS(bw, out);
+    _IMC_PUT_BITS(bw, tables->litlen_code[DEFLATE_END_OF_BLOCK], tables->litlen_len[DEFLATE_END_OF_BLOCK]);
+    _IMC_FLUSH_BITS(bw, out);
+
+    return out;
+}
+
+/**
+ * @brief Writes __len__ bytes as stored blocks of at most 65535 bytes each.
+ * @since 16-10-2026
+ * @param[in,out] bw The bit writer
+ * @param[in] raw The bytes to be stored
+ * @param[in] len The number of bytes to be stored
+ * @param[in] final True if the last of the blocks ends the stream
+ * @param[in,out] out The output cursor
+ * @returns The advanced output cursor
+ */
+static uint8_t *_imc_emit_stored(
+    DeflateBits_t *bw,
+    const uint8_t *raw,
+    size_t len,
+    const bool final,
+    uint8_t *out
+) {
+    uint32_t n;
+
+    do {
+        n = (len < 0xFFFF) ? len : 0xFFFF;
+
+        /* BFINAL, BTYPE = 00, then LEN and NLEN on the next byte boundary */
+        _IMC_PUT_BITS(bw, (final && n == len) ? 1 : 0, 3);
+        bw->bitcount = (bw->bitcount + 7) & ~7u;
+        _IMC_FLUSH_BITS(bw, out);
+        _IMC_PUT_BITS(bw, n | ((n ^ 0xFFFFu) << 16), 32);
+        _IMC_FLUSH_BITS(bw, out);
+
+        memcpy((void*)out, (void*)raw, n);
+        out += n;
+        raw += n;
+        len -= n;
+    } while (len > 0);
+
+    return out;
+}
+
+/**
+ * @brief Returns the size of the smallest of a dynamic, fixed or stored block holding the given symbols.
+ * @since 16-10-2026
+ * @param[in] lit_freq Literal/length symbol frequencies (including the end of block)
+ * @param[in] dist_freq Distance symbol frequencies
+ * @param[in] raw_len The number of input bytes the symbols cover
+ * @param[in] can_store True if the input is still available to be stored
+ * @param[out] hdr The output location for the dynamic code lengths and header contents
+ * @param[out] btype The output location for the block type (0 stored, 1 fixed or 2 dynamic)
+ * @returns The size of the block (in bits)
+ */
+static size_t _imc_block_bits(
+    const uint32_t *lit_freq,
+    const uint32_t *dist_freq,
+    const size_t raw_len,
+    const bool can_store,
+    DynHeader_t *hdr,
+    uint8_t *btype
+) {
+    size_t dyn_bits, fixed_bits, stored_bits;
+    HuffTables_t fixed;
+
+    dyn_bits = _imc_dynamic_build(lit_freq, dist_freq, hdr);
+    dyn_bits += _imc_data_bits(hdr->tables.litlen_len, hdr->tables.dist_len, lit_freq, dist_freq);
+    _imc_fixed_tables(&fixed);
+    fixed_bits = 3 + _imc_data_bits(fixed.litlen_len, fixed.dist_len, lit_freq, dist_freq);
+    stored_bits = can_store ? (raw_len + 5 * (raw_len / 0xFFFF + 1)) * 8 + 7 : SIZE_MAX;
+
+    if (stored_bits < dyn_bits && stored_bits < fixed_bits) {
+        *btype = 0;
+        return stored_bits;
+    }
+    if (fixed_bits <= dyn_bits) {
+        *btype = 1;
+        return fixed_bits;
+    }
+
+    *btype = 2;
+    return dyn_bits;
+}
+
+/**
+ * @brief Emits __n__ tokens as one block with dynamic codes, fixed codes or stored, whichever is smallest.
+ * @since 16-10-2026
+ * @param[in,out] bw The bit writer
+ * @param[in] tokens The tokens
+ * @param[in] n The number of tokens
+ * @param[in] lit_freq Literal/length symbol frequencies of the tokens (including the end of block)
+ * @param[in] dist_freq Distance symbol frequencies of the tokens
+ * @param[in] raw The input the tokens cover, or NULL if it is no longer available (never stored)
+ * @param[in] raw_len The number of input bytes the tokens cover
+ * @param[in] len_slot The length code (less 257) of each match length
+ * @param[in] final True if this is the last block of the stream
+ * @param[in,out] out The output cursor
+ * @returns The advanced output cursor
+ */
+static uint8_t *_imc_emit_block(
+    DeflateBits_t *bw,
+    const uint32_t *tokens,
+    const size_t n,
+    const uint32_t *lit_freq,
+    const uint32_t *dist_freq,
+    const uint8_t *raw,
+    const size_t raw_len,
+    const uint8_t *len_slot,
+    const bool final,
+    uint8_t *out
+) {
+    uint8_t btype;
+    DynHeader_t hdr;
+    HuffTables_t fixed;
+
+    _imc_block_bits(lit_freq, dist_freq, raw_len, raw != NULL, &hdr, &btype);
+
+    if (btype == 0) {
+        return _imc_emit_stored(bw, raw, raw_len, final, out);
+    }
+
+    if (btype == 1) {
+        /* BFINAL, BTYPE = 01 (fixed Huffman codes) */
+        _imc_fixed_tables(&fixed);
+        _IMC_PUT_BITS(bw, (final ? 1 : 0) | (1 << 1), 3);
+        return _imc_emit_tokens(bw, &fixed, tokens, n, len_slot, out);
+    }
+
+    out = _imc_dynamic_write(bw, &hdr, final, out);
+    return _imc_emit_tokens(bw, &hdr.tables, tokens, n, len_slot, out);
+}
+
+/**
+ * @brief Ends the stream after its last block, or byte aligns it with a sync flush if it continues.
+ * @since 16-10-2026
+ * @param[in,out] bw The bit writer
+ * @param[in] final True if the stream ends here
+ * @param[in] closed True if the last block emitted was already marked final
+ * @param[in,out] out The output cursor
+ * @returns The advanced output cursor
+ */
+static uint8_t *_imc_end_stream(DeflateBits_t *bw, const bool final, const bool closed, uint8_t *out) {
+    if (final && !closed) {
+        /* BFINAL = 1, BTYPE = 01 (fixed Huffman codes) and the 7 bit end of block code (all zeros) */
+        _IMC_PUT_BITS(bw, 1 | (1 << 1), 10);
+    }
+
+    if (!final) {
+        /* BFINAL = 0, BTYPE = 00, then LEN = 0x0000 and NLEN = 0xFFFF on the next byte boundary */
+        _IMC_PUT_BITS(bw, 0, 3);
+        bw->bitcount = (bw->bitcount + 7) & ~7u;
+        _IMC_FLUSH_BITS(bw, out);
+        _IMC_PUT_BITS(bw, 0xFFFF0000u, 32);
+    }
+
+    bw->bitcount = (bw->bitcount + 7) & ~7u;
+    _IMC_FLUSH_BITS(bw, out);
+
+    bw->bitbuf = 0;
+    bw->bitcount = 0;
+
+    return out;
+}
+
+/**
+ * @brief Returns the number of leading bytes which match between __a__ and __b__, up to __max__.
+ * @since 16-10-2026
+ * @param[in] a The bytes being matched
+ * @param[in] b The earlier bytes they are compared against
+ * @param[in] max The most bytes that may be compared
+ * @returns The length of the match
+ */
+static inline size_t _imc_match_len(const uint8_t *a, const uint8_t *b, const size_t max) {
+    size_t len = 0;
+#if defined(__SSE2__)
+    uint32_t mask;
+
+    while (len + 16 <= max) {
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+            _mm_loadu_si128((const __m128i*)(a + len)),
+            _mm_loadu_si128((const __m128i*)(b + len))
+        ));
+        if (mask != 0xFFFF) {
+            return len + __builtin_ctz(~mask);
+        }
+        len += 16;
+    }
+#endif
+
+    while (len < max && a[len] == b[len]) {
+        ++len;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Emits the tokens gathered by the run-length compressor as one block.
+ * The input has usually been handed back to the caller by now, so the block is never stored.
+ * @since 16-10-2026
+ * @param[in,out] rle The compressor state
+ * @param[in] final True if this is the last block of the stream
+ * @param[in,out] out The output cursor
+ * @returns The advanced output cursor
+ */
+static uint8_t *_imc_rle_emit_block(DeflateRle_t *rle, const bool final, uint8_t *out) {
+    uint32_t lit_freq[DEFLATE_N_LITLEN];
+    uint32_t dist_freq[DEFLATE_N_DIST];
+
+    _imc_token_freqs(rle->tokens, rle->n_tokens, rle->len_slot, lit_freq, dist_freq);
+    out = _imc_emit_block(
+        &rle->bits, rle->tokens, rle->n_tokens, lit_freq, dist_freq,
+        NULL, rle->pending, rle->len_slot, final, out
+    );
+
+    rle->n_tokens = 0;
+    rle->pending = 0;
+
+    return out;
+}
+
+/**
+ * @brief Tokenizes __len__ bytes (at most what fits in the current block) as literals and runs.
+ * Matches never reach back before __in__, so each call may be given an unrelated buffer.
+ * @since 16-10-2026
+ * @param[in,out] rle The compressor state
+ * @param[in] in The bytes to be tokenized
+ * @param[in] len The number of bytes to be tokenized
+ */
+static void _imc_rle_tokenize(DeflateRle_t *rle, const uint8_t *in, const size_t len) {
+    size_t i, k, run1, runp, max;
+    uint32_t *tok = rle->tokens + rle->n_tokens;
+    const size_t bpp = rle->bpp;
+#if defined(__SSE2__)
+    __m128i v;
+    uint32_t m1, mp, starts;
+#endif
+
+    i = 0;
+    while (i < len) {
+        /* The first pixel has nothing to refer back to */
+        if (i < bpp) {
+            k = (len < bpp) ? len : bpp;
+            for (; i < k; ++i) {
+                *tok++ = in[i];
+            }
+            continue;
+        }
+
+#if defined(__SSE2__)
+        /*
+         * Find the first of the next 14 positions where a run of at least three bytes begins. Bit j of m1 (mp)
+         * is set when byte j equals the byte 1 (bpp) before it, so a run starts where bits j, j+1, j+2 are set.
+         */
+        if (i + 16 <= len) {
+            v = _mm_loadu_si128((const __m128i*)(in + i));
+            m1 = _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_loadu_si128((const __m128i*)(in + i - 1))));
+            mp = _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_loadu_si128((const __m128i*)(in + i - bpp))));
+            starts = ((m1 & (m1 >> 1) & (m1 >> 2)) | (mp & (mp >> 1) & (mp >> 2))) & 0x3FFF;
+
+            k = (starts == 0) ? 14 : (size_t)__builtin_ctz(starts);
+            if (k > 0) {
+                for (k += i; i < k; ++i) {
+                    *tok++ = in[i];
+                }
+                continue;
+            }
+        }
+#endif
+
+        max = len - i;
+        max = (max < DEFLATE_MAX_MATCH) ? max : DEFLATE_MAX_MATCH;
+        run1 = _imc_match_len(in + i, in + i - 1, max);
+        runp = (bpp > 1) ? _imc_match_len(in + i, in + i - bpp, max) : 0;
+
+        if (run1 >= DEFLATE_MIN_MATCH && run1 >= runp) {
+            *tok++ = _TOK(run1, 1);
+            i += run1;
+        } else if (runp >= DEFLATE_MIN_MATCH) {
+            *tok++ = _TOK(runp, bpp);
+            i += runp;
+        } else {
+            *tok++ = in[i];
+            ++i;
+        }
+    }
+
+    rle->n_tokens = tok - rle->tokens;
+    rle->pending += len;
+}
+
+/**
+ * @brief Hashes the three bytes at __p__ for the match finder.
+ * @since 16-10-2026
+ * @param[in] p The bytes to be hashed
+ * @returns A hash of _LZ_HASH_BITS bits
+ */
+static inline uint32_t _imc_lz_hash(const uint8_t *p) {
+    uint32_t v = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+    return (v * 0x9E3779B1u) >> (32 - _LZ_HASH_BITS);
+}
+
+/**
+ * @brief Adds offset __p__ of the window to the head of its hash chain.
+ * Offsets near the end of the input hash bytes which are not input yet; those chain entries
+ * merely fail to match, since every match is verified against the input itself.
+ * @since 16-10-2026
+ * @param[in,out] lz The compressor state
+ * @param[in] p The offset to be inserted
+ */
+static inline void _imc_lz_insert(DeflateLz_t *lz, const size_t p) {
+    uint32_t h = _imc_lz_hash(lz->window + p);
+
+    lz->prev[p] = lz->head[h];
+    lz->head[h] = (int32_t)p;
+}
+
+/**
+ * @brief Finds the longest match for offset __p__ which is longer than __best__.
+ * The distances of flat regions (1 and the number of bytes per pixel) are tried before the hash chain.
+ * @since 16-10-2026
+ * @param[in] lz The compressor state
+ * @param[in] p The offset to be matched (not yet inserted)
+ * @param[in] end The offset one past the last byte a match may cover
+ * @param[in] best Matches must be longer than this (at least DEFLATE_MIN_MATCH - 1)
+ * @param[out] dist The output location for the distance of the match
+ * @returns The length of the match, or 0 if none is longer than __best__
+ */
+static size_t _imc_lz_find(
+    const DeflateLz_t* const lz,
+    const size_t p,
+    const size_t end,
+    size_t best,
+    size_t *dist
+) {
+    int32_t cand;
+    size_t len, max, chain;
+    size_t found = 0;
+    const size_t prior = best;
+    const uint8_t *cur = lz->window + p;
+
+    max = end - p;
+    max = (max < DEFLATE_MAX_MATCH) ? max : DEFLATE_MAX_MATCH;
+    if (max <= best) {
+        return 0;
+    }
+
+    if (p >= 1) {
+        len = _imc_match_len(cur, cur - 1, max);
+        if (len > best) {
+            best = len;
+            found = 1;
+        }
+    }
+    if (lz->bpp > 1 && p >= lz->bpp && best < max) {
+        len = _imc_match_len(cur, cur - lz->bpp, max);
+        if (len > best) {
+            best = len;
+            found = lz->bpp;
+        }
+    }
+
+    /*
+     * The chain is searched a quarter as deep once the match is good: for a lazy parse, the match being
+     * deferred, and for a greedy parse, the run just found.
+     */
+    chain = (((lz->parse == _PARSE_GREEDY) ? best : prior) >= lz->good_len) ? (lz->max_chain >> 2) : lz->max_chain;
+    cand = lz->head[_imc_lz_hash(cur)];
+    for (; chain > 0 && best < lz->nice_len && best < max; --chain) {
+        if (cand < 0 || p - cand > _LZ_WINDOW_SIZE) {
+            break;
+        }
+        /* The byte just past the best match must agree for this candidate to be any longer */
+        if (lz->window[cand + best] == cur[best]) {
+            len = _imc_match_len(cur, lz->window + cand, max);
+            if (len > best) {
+                best = len;
+                found = p - cand;
+            }
+        }
+        cand = lz->prev[cand];
+    }
+
+    *dist = found;
+    return (found > 0) ? best : 0;
+}
+
+/**
+ * @brief Tokenizes the window from __pos__ until a token ends at or past __stop__, greedily or, with lazy
+ * and optimal parsing, deferring each match by a byte whenever the next offset has a longer one.
+ * @since 16-10-2026
+ * @param[in,out] lz The compressor state
+ * @param[in,out] pos The offset of the first byte to be tokenized, advanced past the last
+ * @param[in] stop The offset at which tokenizing ends
+ * @param[in] end The offset one past the last byte a match may cover (at least __stop__)
+ * @param[out] tokens The output location for the tokens
+ * @returns The number of tokens produced
+ */
+static size_t _imc_lz_parse(DeflateLz_t *lz, size_t *pos, const size_t stop, const size_t end, uint32_t *tokens) {
+    size_t k, len = 0, len2, dist = 0, dist2;
+    size_t p = *pos;
+    bool have = false;
+    uint32_t *tok = tokens;
+    const bool lazy = (lz->parse != _PARSE_GREEDY);
+
+    /* A deferred match is always taken, since its offset has already been hashed */
+    while (p < stop || have) {
+        if (!have) {
+            len = _imc_lz_find(lz, p, end, DEFLATE_MIN_MATCH - 1, &dist);
+            _imc_lz_insert(lz, p);
+            if (len == DEFLATE_MIN_MATCH && dist > _LZ_TOO_FAR) {
+                len = 0;
+            }
+        }
+        have = false;
+
+        if (len == 0) {
+            *tok++ = lz->window[p++];
+            continue;
+        }
+
+        k = 1;
+        if (lazy && len < lz->lazy_len && p + 1 < end) {
+            len2 = _imc_lz_find(lz, p + 1, end, len, &dist2);
+            _imc_lz_insert(lz, p + 1);
+            if (len2 > 0) {
+                *tok++ = lz->window[p++];
+                len = len2;
+                dist = dist2;
+                have = true;
+                continue;
+            }
+            k = 2;
+        }
+
+        *tok++ = _TOK(len, dist);
+        /* Greedy parsing leaves the offsets inside a long match out of the hash chains */
+        if (lazy || len <= lz->lazy_len) {
+            for (; k < len; ++k) {
+                _imc_lz_insert(lz, p + k);
+            }
+        }
+        p += len;
+    }
+
+    *pos = p;
+    return tok - tokens;
+}
+
+/**
+ * @brief Appends a match to the cache of an offset, dropping the shortest when it is full.
+ * Matches are found in order of increasing length, so the cache stays sorted.
+ * @since 16-10-2026
+ * @param[in,out] mc The matches cached at the offset
+ * @param[in,out] n The number of matches cached at the offset
+ * @param[in] len The length of the match
+ * @param[in] dist The distance of the match
+ */
+static inline void _imc_cache_match(uint32_t *mc, size_t *n, const size_t len, const size_t dist) {
+    if (*n == _LZ_CACHE_DEPTH) {
+        memmove((void*)mc, (void*)(mc + 1), (_LZ_CACHE_DEPTH - 1) * sizeof(*mc));
+        --*n;
+    }
+    mc[(*n)++] = ((uint32_t)len << 16) | (uint32_t)(dist - 1);
+}
+
+/**
+ * @brief Caches every match which is longer than the previous one found at each offset from __start__ to __end__.
+ * Once a match reaches nice_len, the offsets it covers are not searched; each is given the remainder
+ * of that match instead, marked with _LZ_CACHE_SKIP.
+ * @since 16-10-2026
+ * @param[in,out] lz The compressor state
+ * @param[in] start The offset of the first byte to be tokenized
+ * @param[in] end The offset one past the last byte to be tokenized
+ */
+static void _imc_lz_collect(DeflateLz_t *lz, const size_t start, const size_t end) {
+    int32_t cand;
+    size_t p, k, len, max, chain, best, dist, n;
+    uint32_t *mc;
+    const uint8_t *cur;
+    size_t dists[2];
+
+    for (p = start; p < end;) {
+        mc = lz->matches + (p - start) * _LZ_CACHE_DEPTH;
+        cur = lz->window + p;
+        n = 0;
+        best = DEFLATE_MIN_MATCH - 1;
+        max = end - p;
+        max = (max < DEFLATE_MAX_MATCH) ? max : DEFLATE_MAX_MATCH;
+
+        dists[0] = 1;
+        dists[1] = (lz->bpp > 1) ? lz->bpp : 0;
+        for (k = 0; k < 2 && max > best; ++k) {
+            if (dists[k] > 0 && p >= dists[k]) {
+                len = _imc_match_len(cur, cur - dists[k], max);
+                if (len > best) {
+                    best = len;
+                    _imc_cache_match(mc, &n, len, dists[k]);
+                }
+            }
+        }
+
+        cand = lz->head[_imc_lz_hash(cur)];
+        for (chain = lz->max_chain; chain > 0 && best < lz->nice_len && best < max; --chain) {
+            if (cand < 0 || p - cand > _LZ_WINDOW_SIZE) {
+                break;
+            }
+            if (lz->window[cand + best] == cur[best]) {
+                len = _imc_match_len(cur, lz->window + cand, max);
+                if (len > best) {
+                    best = len;
+                    _imc_cache_match(mc, &n, len, p - cand);
+                }
+            }
+            cand = lz->prev[cand];
+        }
+
+        lz->n_matches[p - start] = n;
+        _imc_lz_insert(lz, p);
+        ++p;
+
+        if (n > 0 && best >= lz->nice_len) {
+            dist = (mc[n - 1] & 0xFFFF) + 1;
+            for (k = 1; k < best; ++k, ++p) {
+                len = best - k;
+                lz->n_matches[p - start] = (len >= DEFLATE_MIN_MATCH) ? _LZ_CACHE_SKIP : 0;
+                lz->matches[(p - start) * _LZ_CACHE_DEPTH] = ((uint32_t)len << 16) | (uint32_t)(dist - 1);
+                _imc_lz_insert(lz, p);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Adds each match of __n_tokens__ tokens covering the block to the cache of the offset it starts at,
+ * so the cheapest path can always follow the tokens. A match which is already cached at the same length
+ * takes the token's distance, and when the cache is full the shortest match is dropped (or replaced, if the
+ * token's is shorter still).
+ * @since 16-10-2026
+ * @param[in,out] lz The compressor state
+ * @param[in] tokens The tokens
+ * @param[in] n_tokens The number of tokens
+ */
+static void _imc_lz_cache_tokens(DeflateLz_t *lz, const uint32_t *tokens, const size_t n_tokens) {
+    size_t t, j, n, len, i = 0;
+    uint32_t *mc;
+
+    for (t = 0; t < n_tokens; ++t) {
+        if (tokens[t] < _TOK_MATCH) {
+            ++i;
+            continue;
+        }
+
+        len = _TOK_LEN(tokens[t]);
+        mc = lz->matches + i * _LZ_CACHE_DEPTH;
+        n = (lz->n_matches[i] == _LZ_CACHE_SKIP) ? 1 : lz->n_matches[i];
+
+        for (j = 0; j < n && (mc[j] >> 16) < len; ++j);
+        if (j == n || (mc[j] >> 16) != len) {
+            if (n == _LZ_CACHE_DEPTH && j > 0) {
+                memmove((void*)mc, (void*)(mc + 1), (j - 1) * sizeof(*mc));
+                --j;
+            } else if (n < _LZ_CACHE_DEPTH) {
+                memmove((void*)(mc + j + 1), (void*)(mc + j), (n - j) * sizeof(*mc));
+                ++n;
+            }
+        }
+        mc[j] = ((uint32_t)len << 16) | (uint32_t)(_TOK_DIST(tokens[t]) - 1);
+
+        lz->n_matches[i] = (uint8_t)n;
+        i += len;
+    }
+}
+
+/**
+ * @brief Derives the cost (in bits) of every literal, match length and distance code from symbol frequencies.
+ * @since 16-10-2026
+ * @param[in] lz The compressor state
+ * @param[in] lit_freq Literal/length symbol frequencies
+ * @param[in] dist_freq Distance symbol frequencies
+ * @param[out] lit_cost The output location for the cost of each literal (256 entries)
+ * @param[out] len_cost The output location for the cost of each match length, including extra bits
+ * @param[out] dist_cost The output location for the cost of each distance code, including extra bits
+ */
+static void _imc_lz_costs(
+    const DeflateLz_t* const lz,
+    const uint32_t *lit_freq,
+    const uint32_t *dist_freq,
+    uint32_t *lit_cost,
+    uint32_t *len_cost,
+    uint32_t *dist_cost
+) {
+    size_t i;
+    uint8_t lit_len[DEFLATE_N_LITLEN];
+    uint8_t dist_len[DEFLATE_N_DIST];
+
+    _imc_huff_lengths(lit_freq, DEFLATE_N_LITLEN, DEFLATE_MAX_CODE_LEN, lit_len);
+    _imc_huff_lengths(dist_freq, DEFLATE_N_DIST, DEFLATE_MAX_CODE_LEN, dist_len);
+
+    for (i = 0; i < 256; ++i) {
+        lit_cost[i] = (lit_len[i] > 0) ? lit_len[i] : _LZ_UNUSED_COST;
+    }
+    for (i = DEFLATE_MIN_MATCH; i <= DEFLATE_MAX_MATCH; ++i) {
+        len_cost[i] = (lit_len[257 + lz->len_slot[i]] > 0) ? lit_len[257 + lz->len_slot[i]] : _LZ_UNUSED_COST;
+        len_cost[i] += _imc_len_extra[lz->len_slot[i]];
+    }
+    for (i = 0; i < DEFLATE_N_DIST; ++i) {
+        dist_cost[i] = ((dist_len[i] > 0) ? dist_len[i] : _LZ_UNUSED_COST) + _imc_dist_extra[i];
+    }
+}
+
+/**
+ * @brief Returns the size (in bits) of a dynamic block with the given symbol frequencies, header included.
+ * @since 16-10-2026
+ * @param[in] lit_freq Literal/length symbol frequencies (including the end of block)
+ * @param[in] dist_freq Distance symbol frequencies
+ * @returns The size of the block (in bits)
+ */
+static size_t _imc_dynamic_cost(const uint32_t *lit_freq, const uint32_t *dist_freq) {
+    size_t bits;
+    DynHeader_t hdr;
+
+    bits = _imc_dynamic_build(lit_freq, dist_freq, &hdr);
+    return bits + _imc_data_bits(hdr.tables.litlen_len, hdr.tables.dist_len, lit_freq, dist_freq);
+}
+
+/**
+ * @brief Decides where __n_tokens__ tokens are split into blocks and returns the size they will be emitted at.
+ * From level 4 the tokens are cut into runs of _LZ_SPLIT_TOKENS, and each run is appended
+ * to the current block only if that is cheaper than starting a new block with its own tables.
+ * The first __n_held__ tokens, whose input is no longer available, form the first run. Runs are
+ * only appended to their block if that is cheaper than emitting the run as it would be on its own,
+ * stored if need be, so that a block which cannot be stored grows no larger than a stored run.
+ * @since 16-10-2026
+ * @param[in] lz The compressor state
+ * @param[in] tokens The tokens
+ * @param[in] n_tokens The number of tokens
+ * @param[in] n_held The number of tokens held back from the previous block (0 if none)
+ * @param[out] cuts The output location for the first token of each block, followed by __n_tokens__ (_LZ_MAX_BLOCKS + 1 entries)
+ * @param[out] n_blocks The output location for the number of blocks
+ * @returns The size of the blocks, as _imc_emit_block() will write them (in bits)
+ */
+static size_t _imc_lz_plan(
+    const DeflateLz_t* const lz,
+    const uint32_t *tokens,
+    const size_t n_tokens,
+    const size_t n_held,
+    size_t *cuts,
+    size_t *n_blocks
+) {
+    size_t i, s, e, raw_len, seg_len, seg_cost, merged_cost, cost = 0, bits = 0;
+    uint8_t btype;
+    bool held = (n_held > 0);
+    DynHeader_t hdr;
+    uint32_t lit_freq[DEFLATE_N_LITLEN], dist_freq[DEFLATE_N_DIST];
+    uint32_t seg_lit[DEFLATE_N_LITLEN], seg_dist[DEFLATE_N_DIST];
+    uint32_t merged_lit[DEFLATE_N_LITLEN], merged_dist[DEFLATE_N_DIST];
+    const size_t split = (lz->level >= 4) ? _LZ_SPLIT_TOKENS : n_tokens;
+    const size_t first = held ? n_held : ((split < n_tokens) ? split : n_tokens);
+
+    *n_blocks = 0;
+    cuts[(*n_blocks)++] = 0;
+    raw_len = _imc_token_freqs(tokens, first, lz->len_slot, lit_freq, dist_freq);
+    if (first < n_tokens) {
+        cost = held ? _imc_block_bits(lit_freq, dist_freq, raw_len, false, &hdr, &btype) :
+                      _imc_dynamic_cost(lit_freq, dist_freq);
+    }
+
+    for (s = first; s < n_tokens; s = e) {
+        e = (s + split < n_tokens) ? s + split : n_tokens;
+        seg_len = _imc_token_freqs(tokens + s, e - s, lz->len_slot, seg_lit, seg_dist);
+        seg_cost = held ? _imc_block_bits(seg_lit, seg_dist, seg_len, true, &hdr, &btype) :
+                          _imc_dynamic_cost(seg_lit, seg_dist);
+
+        for (i = 0; i < DEFLATE_N_LITLEN; ++i) {
+            merged_lit[i] = lit_freq[i] + seg_lit[i];
+        }
+        for (i = 0; i < DEFLATE_N_DIST; ++i) {
+            merged_dist[i] = dist_freq[i] + seg_dist[i];
+        }
+        merged_lit[DEFLATE_END_OF_BLOCK] = 1;
+        merged_cost = held ? _imc_block_bits(merged_lit, merged_dist, raw_len + seg_len, false, &hdr, &btype) :
+                             _imc_dynamic_cost(merged_lit, merged_dist);
+
+        if (merged_cost <= cost + seg_cost) {
+            memcpy((void*)lit_freq, (void*)merged_lit, sizeof(lit_freq));
+            memcpy((void*)dist_freq, (void*)merged_dist, sizeof(dist_freq));
+            cost = merged_cost;
+            raw_len += seg_len;
+        } else {
+            bits += _imc_block_bits(lit_freq, dist_freq, raw_len, !held, &hdr, &btype);
+            cuts[(*n_blocks)++] = s;
+            memcpy((void*)lit_freq, (void*)seg_lit, sizeof(lit_freq));
+            memcpy((void*)dist_freq, (void*)seg_dist, sizeof(dist_freq));
+            cost = held ? _imc_dynamic_cost(seg_lit, seg_dist) : seg_cost;
+            raw_len = seg_len;
+            held = false;
+        }
+    }
+
+    bits += _imc_block_bits(lit_freq, dist_freq, raw_len, !held, &hdr, &btype);
+    cuts[*n_blocks] = n_tokens;
+
+    return bits;
+}
+
+/**
+ * @brief Emits __n_tokens__ tokens covering the input at __raw__ as the blocks planned by _imc_lz_plan(),
+ * after any tokens held back by the previous call.
+ * With more input to come, a last block of at most _LZ_SPLIT_TOKENS tokens which would not be stored
+ * is held back instead, so that it may share its tables with the next input.
+ * @since 16-10-2026
+ * @param[in,out] lz The compressor state
+ * @param[in] raw The input the tokens cover
+ * @param[in] n_tokens The number of tokens
+ * @param[in] more True if more input follows in the same stream, without a flush
+ * @param[in] final True if the last block ends the stream
+ * @param[in,out] out The output cursor
+ * @returns The advanced output cursor
+ */
+static uint8_t *_imc_lz_emit(
+    DeflateLz_t *lz,
+    const uint8_t *raw,
+    size_t n_tokens,
+    const bool more,
+    const bool final,
+    uint8_t *out
+) {
+    size_t b, n_blocks, n_emit, raw_len, held_len = 0;
+    uint8_t btype;
+    DynHeader_t hdr;
+    size_t cuts[_LZ_MAX_BLOCKS + 1];
+    uint32_t lit_freq[DEFLATE_N_LITLEN], dist_freq[DEFLATE_N_DIST];
+
+    if (lz->n_held > 0) {
+        memmove((void*)(lz->tokens + lz->n_held), (void*)lz->tokens, n_tokens * sizeof(*lz->tokens));
+        memcpy((void*)lz->tokens, (void*)lz->held, lz->n_held * sizeof(*lz->tokens));
+        n_tokens += lz->n_held;
+        held_len = _imc_token_freqs(lz->held, lz->n_held, lz->len_slot, lit_freq, dist_freq);
+    }
+
+    _imc_lz_plan(lz, lz->tokens, n_tokens, lz->n_held, cuts, &n_blocks);
+
+    n_emit = n_blocks;
+    if (more && n_tokens - cuts[n_blocks - 1] <= _LZ_SPLIT_TOKENS) {
+        raw_len = _imc_token_freqs(lz->tokens + cuts[n_blocks - 1], n_tokens - cuts[n_blocks - 1], lz->len_slot, lit_freq, dist_freq);
+        _imc_block_bits(lit_freq, dist_freq, raw_len, true, &hdr, &btype);
+        n_emit -= (btype != 0) ? 1 : 0;
+    }
+
+    for (b = 0; b < n_emit; ++b) {
+        raw_len = _imc_token_freqs(lz->tokens + cuts[b], cuts[b + 1] - cuts[b], lz->len_slot, lit_freq, dist_freq);
+        /* Only the first block can hold tokens from the previous call, whose input is gone */
+        out = _imc_emit_block(
+            &lz->bits, lz->tokens + cuts[b], cuts[b + 1] - cuts[b], lit_freq, dist_freq,
+            (b == 0 && lz->n_held > 0) ? NULL : raw, raw_len, lz->len_slot, final && b + 1 == n_blocks, out
+        );
+        raw += (b == 0) ? raw_len - held_len : raw_len;
+    }
+
+    lz->n_held = n_tokens - cuts[n_emit];
+    if (lz->n_held > 0) {
+        memcpy((void*)lz->held, (void*)(lz->tokens + cuts[n_emit]), lz->n_held * sizeof(*lz->held));
+    }
+
+    return out;
+}
+
+/**
+ * @brief Finds the cheapest path through the cached matches from __start__ to __end__ at the given symbol costs.
+ * @since 16-10-2026
+ * @param[in,out] lz The compressor state
+ * @param[in] start The offset of the first byte to be tokenized
+ * @param[in] end The offset one past the last byte to be tokenized
+ * @param[in] lit_cost The cost of each literal
+ * @param[in] len_cost The cost of each match length
+ * @param[in] dist_cost The cost of each distance code
+ * @param[out] tokens The output location for the tokens along the path
+ * @returns The number of tokens produced
+ */
+static size_t _imc_lz_cheapest(
+    DeflateLz_t *lz,
+    const size_t start,
+    const size_t end,
+    const uint32_t *lit_cost,
+    const uint32_t *len_cost,
+    const uint32_t *dist_cost,
+    uint32_t *tokens
+) {
+    size_t i, k, l, mlen, dist, n_cached, n_tokens = 0;
+    bool whole;
+    uint32_t c, best, choice, dc;
+    const uint32_t *mc;
+    const uint8_t *in = lz->window + start;
+    const size_t n = end - start;
+
+    /* cost[i] is the cheapest way to code everything from i onwards */
+    lz->cost[n] = 0;
+    for (i = n; i-- > 0;) {
+        best = lit_cost[in[i]] + lz->cost[i + 1];
+        choice = in[i];
+
+        mc = lz->matches + i * _LZ_CACHE_DEPTH;
+        l = DEFLATE_MIN_MATCH;
+        n_cached = lz->n_matches[i];
+        /* Matches beside a long one are only taken whole, which keeps runs from costing quadratic time */
+        whole = (n_cached == _LZ_CACHE_SKIP) || (n_cached > 0 && (mc[n_cached - 1] >> 16) >= lz->nice_len);
+        if (n_cached == _LZ_CACHE_SKIP) {
+            n_cached = 1;
+        }
+        for (k = 0; k < n_cached; ++k) {
+            mlen = mc[k] >> 16;
+            dist = (mc[k] & 0xFFFF) + 1;
+            dc = dist_cost[_imc_dist_slot(dist)];
+            if (whole) {
+                l = mlen;
+            }
+            /* Otherwise each length up to this match's is reachable at its distance */
+            for (; l <= mlen; ++l) {
+                c = len_cost[l] + dc + lz->cost[i + l];
+                if (c < best) {
+                    best = c;
+                    choice = _TOK(l, dist);
+                }
+            }
+        }
+
+        lz->cost[i] = best;
+        lz->choice[i] = choice;
+    }
+
+    for (i = 0; i < n; i += (lz->choice[i] < _TOK_MATCH) ? 1 : _TOK_LEN(lz->choice[i])) {
+        tokens[n_tokens++] = lz->choice[i];
+    }
+
+    return n_tokens;
+}
+
+/**
+ * @brief Tokenizes the window from __start__ along the cheapest path through the cached matches.
+ * The block is first parsed lazily with the level's settings, which are those of level 9, and the hash
+ * chains are rewound. The block ends where that parse did, and its matches are cached along with those
+ * _imc_lz_collect() finds. Each pass prices symbols by the Huffman code the previous tokens would be
+ * given, starting from the lazy parse, and its tokens are kept only if _imc_lz_plan() finds them
+ * smaller than the best so far. The tokens are therefore never larger than at level 9, and never
+ * larger with more passes.
+ * @since 16-10-2026
+ * @param[in,out] lz The compressor state
+ * @param[in] start The offset of the first byte to be tokenized
+ * @param[in] stop The offset at which the lazy parse ends
+ * @param[in] end The offset one past the last byte a match may cover (at least __stop__)
+ * @param[out] next The output location for the offset one past the last byte tokenized
+ * @returns The number of tokens produced (in lz->tokens)
+ */
+static size_t _imc_lz_parse_optimal(
+    DeflateLz_t *lz,
+    const size_t start,
+    const size_t stop,
+    const size_t end,
+    size_t *next
+) {
+    size_t pass, n_blocks, bits, best_bits, n_tokens, n_alt;
+    size_t cuts[_LZ_MAX_BLOCKS + 1];
+    uint32_t *tmp;
+    uint32_t lit_freq[DEFLATE_N_LITLEN];
+    uint32_t dist_freq[DEFLATE_N_DIST];
+    uint32_t lit_cost[256];
+    uint32_t len_cost[DEFLATE_MAX_MATCH + 1];
+    uint32_t dist_cost[DEFLATE_N_DIST];
+    const size_t max_chain = lz->max_chain;
+    const size_t head_size = ((size_t)1 << _LZ_HASH_BITS) * sizeof(*lz->head);
+
+    /* The seeding parse is undone, so the matches are collected from the hash chains as they were before the block */
+    memcpy((void*)lz->head_save, (void*)lz->head, head_size);
+    *next = start;
+    n_tokens = _imc_lz_parse(lz, next, stop, end, lz->tokens);
+    memcpy((void*)lz->head, (void*)lz->head_save, head_size);
+
+    lz->max_chain = _LZ_CACHE_CHAIN;
+    _imc_lz_collect(lz, start, *next);
+    lz->max_chain = max_chain;
+    _imc_lz_cache_tokens(lz, lz->tokens, n_tokens);
+
+    best_bits = _imc_lz_plan(lz, lz->tokens, n_tokens, 0, cuts, &n_blocks);
+
+    /* The tokens of the last pass price the next, whether or not they were kept */
+    _imc_token_freqs(lz->tokens, n_tokens, lz->len_slot, lit_freq, dist_freq);
+    for (pass = 0; pass < lz->passes; ++pass) {
+        _imc_lz_costs(lz, lit_freq, dist_freq, lit_cost, len_cost, dist_cost);
+        n_alt = _imc_lz_cheapest(lz, start, *next, lit_cost, len_cost, dist_cost, lz->alt);
+        _imc_token_freqs(lz->alt, n_alt, lz->len_slot, lit_freq, dist_freq);
+
+        bits = _imc_lz_plan(lz, lz->alt, n_alt, 0, cuts, &n_blocks);
+        if (bits < best_bits) {
+            best_bits = bits;
+            tmp = lz->tokens;
+            lz->tokens = lz->alt;
+            lz->alt = tmp;
+            n_tokens = n_alt;
+        }
+    }
+
+    return n_tokens;
+}
+
+/**
+ * @brief Compresses the input which has not been tokenized yet, along with any tokens held back.
+ * @since 16-10-2026
+ * @param[in,out] lz The compressor state
+ * @param[in] more True if more input follows in the same stream, without a flush
+ * @param[in] final True if the last block ends the stream
+ * @param[in,out] out The output cursor
+ * @returns The advanced output cursor
+ */
+static uint8_t *_imc_lz_block(DeflateLz_t *lz, const bool more, const bool final, uint8_t *out) {
+    size_t n_tokens = 0, next = lz->w_end;
+    const uint8_t *raw = lz->window + lz->w_pos;
+    const size_t len = lz->w_end - lz->w_pos;
+    /* With more input to come, the last DEFLATE_MAX_MATCH bytes are left for the next block unless a match reaches them */
+    const size_t stop = (more && len > DEFLATE_MAX_MATCH) ? lz->w_end - DEFLATE_MAX_MATCH : lz->w_end;
+
+    if (lz->level == 0) {
+        out = _imc_emit_stored(&lz->bits, raw, len, final, out);
+    } else {
+        if (lz->parse != _PARSE_OPTIMAL) {
+            next = lz->w_pos;
+            n_tokens = _imc_lz_parse(lz, &next, stop, lz->w_end, lz->tokens);
+        } else if (len > 0) {
+            /* Only tokens held back are left when a flush follows a full block */
+            n_tokens = _imc_lz_parse_optimal(lz, lz->w_pos, stop, lz->w_end, &next);
+        }
+        out = _imc_lz_emit(lz, raw, n_tokens, more, final, out);
+    }
+
+    lz->w_pos = next;
+    return out;
+}
+
+/**
+ * @brief Discards all but the last _LZ_WINDOW_SIZE bytes of history, moving them and the input not yet
+ * tokenized to the start of the window. Hash chain offsets are rebased to match, and those which fall
+ * out of the window become -1.
+ * @since 16-10-2026
+ * @param[in,out] lz The compressor state
+ */
+static void _imc_lz_slide(DeflateLz_t *lz) {
+    size_t i;
+    int32_t shift;
+
+    if (lz->w_pos <= _LZ_WINDOW_SIZE) {
+        return;
+    }
+
+    shift = (int32_t)(lz->w_pos - _LZ_WINDOW_SIZE);
+    memmove((void*)lz->window, (void*)(lz->window + shift), lz->w_end - shift);
+    memmove((void*)lz->prev, (void*)(lz->prev + shift), _LZ_WINDOW_SIZE * sizeof(*lz->prev));
+
+    for (i = 0; i < ((size_t)1 << _LZ_HASH_BITS); ++i) {
+        lz->head[i] = (lz->head[i] >= shift) ? lz->head[i] - shift : -1;
+    }
+    for (i = 0; i < _LZ_WINDOW_SIZE; ++i) {
+        lz->prev[i] = (lz->prev[i] >= shift) ? lz->prev[i] - shift : -1;
+    }
+
+    lz->w_pos -= shift;
+    lz->w_end -= shift;
+}
+
+/*
+ * ===============================
+ *       Public Functions
+ * ===============================
+ */
+
+/**
+ * @brief Updates a running Adler-32 checksum with __len__ bytes of __data__.
+ * Start from a checksum of 1. The SSE2 path sums 16 bytes per step: s1 via _mm_sad_epu8() and s2
+ * from the running s1 of earlier vectors plus a weighted (16..1) sum of the current vector.
+ * @since 16-10-2026
+ * @param[in] adler The checksum of all previous data
+ * @param[in] data The data to be summed
+ * @param[in] len The number of bytes to be summed
+ * @returns The updated checksum
+ */
+uint32_t imc_adler32(uint32_t adler, const uint8_t *data, size_t len) {
+    size_t n;
+    uint32_t s1 = adler & 0xFFFF;
+    uint32_t s2 = adler >> 16;
+#if defined(__SSE2__)
+    size_t k;
+    uint32_t sums[4];
+    __m128i v, vs1, vs2, vps;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i w_lo = _mm_setr_epi16(16, 15, 14, 13, 12, 11, 10, 9);
+    const __m128i w_hi = _mm_setr_epi16(8, 7, 6, 5, 4, 3, 2, 1);
+#endif
+
+    while (len > 0) {
+        n = (len < _ADLER_NMAX) ? len : _ADLER_NMAX;
+        len -= n;
+
+#if defined(__SSE2__)
+        k = n >> 4;
+        if (k > 0) {
+            vs1 = zero;
+            vs2 = zero;
+            vps = zero;
+            s2 += s1 * (k << 4);
+
+            while (k-- > 0) {
+                v = _mm_loadu_si128((const __m128i*)data);
+                vps = _mm_add_epi32(vps, vs1);
+                vs1 = _mm_add_epi32(vs1, _mm_sad_epu8(v, zero));
+                vs2 = _mm_add_epi32(vs2, _mm_madd_epi16(_mm_unpacklo_epi8(v, zero), w_lo));
+                vs2 = _mm_add_epi32(vs2, _mm_madd_epi16(_mm_unpackhi_epi8(v, zero), w_hi));
+                data += 16;
+            }
+
+            vs2 = _mm_add_epi32(vs2, _mm_slli_epi32(vps, 4));
+            _mm_storeu_si128((__m128i*)sums, vs1);
+            s1 += sums[0] + sums[2];
+            _mm_storeu_si128((__m128i*)sums, vs2);
+            s2 += sums[0] + sums[1] + sums[2] + sums[3];
+            n &= 15;
+        }
+#endif
+
+        while (n-- > 0) {
+            s1 += *data++;
+            s2 += s1;
+        }
+
+        s1 %= _ADLER_BASE;
+        s2 %= _ADLER_BASE;
+    }
+
+    return (s2 << 16) | s1;
+}
+
+/**
+ * @brief Initializes a run-length compressor for scanlines with __bpp__ bytes per pixel.
+ * @since 16-10-2026
+ * @param[out] rle The compressor state to be initialized
+ * @param[in] bpp The number of bytes per complete pixel (1-8)
+ * @returns IMC_ENOMEM if the token buffer could not be allocated, otherwise IMC_EOK
+ */
+ImcError_t imc_deflate_rle_init(DeflateRle_t *rle, const size_t bpp) {
+    uint32_t i;
+
+    memset((void*)rle, 0, sizeof(*rle));
+    rle->bpp = bpp;
+
+    rle->tokens = malloc(_RLE_BLOCK_SIZE * sizeof(*rle->tokens));
+    if (rle->tokens == NULL) {
+        IMC_LOG("Failed to allocate memory for token buffer", IMC_ERROR);
+        return IMC_ENOMEM;
+    }
+
+    for (i = DEFLATE_MIN_MATCH; i <= DEFLATE_MAX_MATCH; ++i) {
+        rle->len_slot[i] = _imc_len_slot(i);
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Releases the resources held by a run-length compressor.
+ * @since 16-10-2026
+ * @param[in,out] rle The compressor state
+ */
+void imc_deflate_rle_destroy(DeflateRle_t *rle) {
+    free(rle->tokens);
+    rle->tokens = NULL;
+}
+
+/**
+ * @brief Returns the most bytes imc_deflate_rle_write() or imc_deflate_rle_end() can produce for __len__ input bytes.
+ * @since 16-10-2026
+ * @param[in] len The number of input bytes
+ * @returns The size of output buffer required (in bytes)
+ */
+size_t imc_deflate_rle_bound(const size_t len) {
+    /*
+     * Up to a block of earlier input may still be pending. Block tables are built from the block's own
+     * frequencies, so no block costs more than the fixed code would (9 bits per byte) plus its header.
+     */
+    size_t total = len + _RLE_BLOCK_SIZE;
+    return total + (total >> 3) + (total / _RLE_BLOCK_SIZE + 1) * _DYN_HEADER_MAX + 8 + _BITBUF_SLACK;
+}
+
+/**
+ * @brief Compresses __len__ bytes as literals and runs at distance 1 or bpp.
+ * Matches never reach back before __in__, so each call may be given an unrelated buffer.
+ * Whole blocks are emitted once enough input has been gathered.
+ * @since 16-10-2026
+ * @param[in,out] rle The compressor state
+ * @param[in] in The bytes to be compressed
+ * @param[in] len The number of bytes to be compressed
+ * @param[out] out The output location (at least imc_deflate_rle_bound(__len__) bytes)
+ * @returns The number of whole bytes written to __out__
+ */
+size_t imc_deflate_rle_write(DeflateRle_t *rle, const uint8_t *in, const size_t len, uint8_t *out) {
+    size_t n, done = 0;
+    uint8_t *start = out;
+
+    while (done < len) {
+        n = _RLE_BLOCK_SIZE - rle->pending;
+        n = (n < len - done) ? n : len - done;
+        _imc_rle_tokenize(rle, in + done, n);
+        done += n;
+
+        if (rle->pending == _RLE_BLOCK_SIZE) {
+            out = _imc_rle_emit_block(rle, false, out);
+        }
+    }
+
+    return out - start;
+}
+
+/**
+ * @brief Emits any pending input as a final block, or as a block followed by a sync flush.
+ * After a sync flush (an empty stored block) the stream is byte aligned without a final block,
+ * so it can be concatenated with another raw DEFLATE stream.
+ * @since 16-10-2026
+ * @param[in,out] rle The compressor state
+ * @param[out] out The output location (at least imc_deflate_rle_bound(0) bytes)
+ * @param[in] final True if this ends the DEFLATE stream
+ * @returns The number of bytes written to __out__
+ */
+size_t imc_deflate_rle_end(DeflateRle_t *rle, uint8_t *out, const bool final) {
+    bool closed = false;
+    uint8_t *start = out;
+
+    if (rle->n_tokens > 0) {
+        out = _imc_rle_emit_block(rle, final, out);
+        closed = final;
+    }
+    out = _imc_end_stream(&rle->bits, final, closed, out);
+
+    return out - start;
+}
+
+/**
+ * @brief Initializes an LZ77 compressor for scanlines with __bpp__ bytes per pixel.
+ * @since 16-10-2026
+ * @param[out] lz The compressor state to be initialized
+ * @param[in] level The compression level (DEFLATE_MIN_LEVEL-DEFLATE_MAX_LEVEL)
+ * @param[in] bpp The number of bytes per complete pixel (1-8)
+ * @returns IMC_EINVAL if __level__ is out of range, IMC_ENOMEM if the buffers could not be allocated, otherwise IMC_EOK
+ */
+ImcError_t imc_deflate_init(DeflateLz_t *lz, const int level, const size_t bpp) {
+    uint32_t i;
+    const size_t n = _LZ_WINDOW_SIZE + _LZ_BLOCK_SIZE;
+
+    memset((void*)lz, 0, sizeof(*lz));
+
+    if (level < DEFLATE_MIN_LEVEL || level > DEFLATE_MAX_LEVEL) {
+        IMC_LOG("Invalid compression level", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    lz->level = level;
+    lz->bpp = bpp;
+    lz->max_chain = _imc_lz_params[level].max_chain;
+    lz->good_len = _imc_lz_params[level].good_len;
+    lz->lazy_len = _imc_lz_params[level].lazy_len;
+    lz->nice_len = _imc_lz_params[level].nice_len;
+    lz->parse = _imc_lz_params[level].parse;
+    lz->passes = _imc_lz_params[level].passes;
+
+    lz->window = calloc(n + _LZ_WINDOW_PAD, 1);
+    lz->head = malloc(((size_t)1 << _LZ_HASH_BITS) * sizeof(*lz->head));
+    lz->prev = malloc(n * sizeof(*lz->prev));
+    /* Tokens held back from the previous block are emitted ahead of the block's own */
+    lz->tokens = malloc((_LZ_BLOCK_SIZE + _LZ_SPLIT_TOKENS) * sizeof(*lz->tokens));
+    lz->held = malloc(_LZ_SPLIT_TOKENS * sizeof(*lz->held));
+    if (lz->window == NULL || lz->head == NULL || lz->prev == NULL || lz->tokens == NULL) {
+        IMC_LOG("Failed to allocate memory for compressor", IMC_ERROR);
+        imc_deflate_destroy(lz);
+        return IMC_ENOMEM;
+    }
+
+    if (lz->parse == _PARSE_OPTIMAL) {
+        lz->alt = malloc((_LZ_BLOCK_SIZE + _LZ_SPLIT_TOKENS) * sizeof(*lz->alt));
+        lz->head_save = malloc(((size_t)1 << _LZ_HASH_BITS) * sizeof(*lz->head_save));
+        lz->matches = malloc(_LZ_BLOCK_SIZE * _LZ_CACHE_DEPTH * sizeof(*lz->matches));
+        lz->n_matches = malloc(_LZ_BLOCK_SIZE);
+        lz->cost = malloc((_LZ_BLOCK_SIZE + 1) * sizeof(*lz->cost));
+        lz->choice = malloc(_LZ_BLOCK_SIZE * sizeof(*lz->choice));
+        if (lz->alt == NULL || lz->head_save == NULL || lz->matches == NULL || lz->n_matches == NULL ||
+            lz->cost == NULL || lz->choice == NULL) {
+            IMC_LOG("Failed to allocate memory for optimal parsing", IMC_ERROR);
+            imc_deflate_destroy(lz);
+            return IMC_ENOMEM;
+        }
+    }
+
+    /* All bits set is -1 */
+    memset((void*)lz->head, 0xFF, ((size_t)1 << _LZ_HASH_BITS) * sizeof(*lz->head));
+
+    for (i = DEFLATE_MIN_MATCH; i <= DEFLATE_MAX_MATCH; ++i) {
+        lz->len_slot[i] = _imc_len_slot(i);
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Releases the resources held by an LZ77 compressor.
+ * @since 16-10-2026
+ * @param[in,out] lz The compressor state
+ */
+void imc_deflate_destroy(DeflateLz_t *lz) {
+    free(lz->window);
+    free(lz->head);
+    free(lz->prev);
+    free(lz->tokens);
+    free(lz->alt);
+    free(lz->held);
+    free(lz->head_save);
+    free(lz->matches);
+    free(lz->n_matches);
+    free(lz->cost);
+    free(lz->choice);
+    lz->window = NULL;
+    lz->head = NULL;
+    lz->prev = NULL;
+    lz->tokens = NULL;
+    lz->alt = NULL;
+    lz->held = NULL;
+    lz->head_save = NULL;
+    lz->matches = NULL;
+    lz->n_matches = NULL;
+    lz->cost = NULL;
+    lz->choice = NULL;
+}
+
+/**
+ * @brief Returns the most bytes imc_deflate_write() or imc_deflate_end() can produce for __len__ input bytes.
+ * @since 16-10-2026
+ * @param[in] len The number of input bytes
+ * @returns The size of output buffer required (in bytes)
+ */
+size_t imc_deflate_bound(const size_t len) {
+    /*
+     * Up to a block of earlier input may still be pending, behind up to _LZ_SPLIT_TOKENS tokens held
+     * back. No block is emitted larger than it would be stored, which costs 5 bytes per 65535
+     * plus a byte of alignment, except the one holding those tokens: it is no larger than them with fixed
+     * codes (under 4 bytes each) followed by the rest of its input stored. There is at most one block per
+     * _LZ_SPLIT_TOKENS tokens (or bytes) of input, plus that one.
+     */
+    size_t total = len + _LZ_BLOCK_SIZE;
+    return total + 4 * _LZ_SPLIT_TOKENS + 6 * (total / 0xFFFF + total / _LZ_SPLIT_TOKENS + 3) + 16 + _BITBUF_SLACK;
+}
+
+/**
+ * @brief Compresses __len__ bytes. Matches may reach back into the input of earlier calls.
+ * Input is buffered and compressed once _LZ_BLOCK_SIZE bytes have been gathered.
+ * @since 16-10-2026
+ * @param[in,out] lz The compressor state
+ * @param[in] in The bytes to be compressed
+ * @param[in] len The number of bytes to be compressed
+ * @param[out] out The output location (at least imc_deflate_bound(__len__) bytes)
+ * @returns The number of whole bytes written to __out__
+ */
+size_t imc_deflate_write(DeflateLz_t *lz, const uint8_t *in, const size_t len, uint8_t *out) {
+    size_t n, done = 0;
+    uint8_t *start = out;
+
+    while (done < len) {
+        n = _LZ_BLOCK_SIZE - (lz->w_end - lz->w_pos);
+        n = (n < len - done) ? n : len - done;
+        memcpy((void*)(lz->window + lz->w_end), (void*)(in + done), n);
+        lz->w_end += n;
+        done += n;
+
+        if (lz->w_end - lz->w_pos == _LZ_BLOCK_SIZE) {
+            out = _imc_lz_block(lz, true, false, out);
+            _imc_lz_slide(lz);
+        }
+    }
+
+    return out - start;
+}
+
+/**
+ * @brief Compresses any buffered input as the final blocks, or as blocks followed by a sync flush.
+ * After a sync flush the stream is byte aligned without a final block, and later input may still
+ * refer back to earlier input.
+ * @since 16-10-2026
+ * @param[in,out] lz The compressor state
+ * @param[out] out The output location (at least imc_deflate_bound(0) bytes)
+ * @param[in] final True if this ends the DEFLATE stream
+ * @returns The number of bytes written to __out__
+ */
+size_t imc_deflate_end(DeflateLz_t *lz, uint8_t *out, const bool final) {
+    bool closed = false;
+    uint8_t *start = out;
+
+    if (lz->w_end > lz->w_pos || lz->n_held > 0) {
+        out = _imc_lz_block(lz, false, final, out);
+        _imc_lz_slide(lz);
+        closed = final;
+    }
+    out = _imc_end_stream(&lz->bits, final, closed, out);
+
+    return out - start;
+}
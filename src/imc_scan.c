@@ -0,0 +1,606 @@
+/**
+ * @file imc_scan.c
+ * @author Neil Kingdom
+ * @since 16-10-2026
+ * @version 1.0
+ * @brief Contains the functions necessary for reading the dimensions, format and EXIF metadata of
+ * many image files without decoding them.
+ *
+ * Only the headers at the front of each file are read: the signature and IHDR chunk of a PNG
+ * followed by the chunk headers up to its first IDAT, or the marker segments of a JPEG up to its
+ * frame header. Headers are read with pread() into a small window, and segments which carry
+ * nothing of interest are skipped by offset without reading them, so the cost of a file does not
+ * grow with its size. Directories are walked on the calling thread, which queues the paths of
+ * the files found for a pool of worker threads; each worker passes the metadata of the files it
+ * finishes to the caller's sink, one at a time, as soon as they are read.
+ */
+
+#include "imc_scan.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+
+/* Bytes requested by each pread(), enough for the headers of most files in one read */
+#define _SCAN_READ_SIZE 4096
+
+/* Capacity of a reader's window, which holds the longest JPEG segment whole */
+#define _SCAN_WINDOW_SIZE (65535 + 4)
+
+/* Number of paths queued for the workers before the directory walk waits for them */
+#define _SCAN_QUEUE_SIZE 1024
+
+/* Most JPEG segments (or fill bytes) followed while looking for the frame header */
+#define _SCAN_MAX_SEGMENTS 4096
+
+typedef struct {
+    int      fd;    /* The file being read */
+    uint8_t *buf;   /* Window of _SCAN_WINDOW_SIZE bytes onto the file */
+    off_t    off;   /* Offset of the window's first byte in the file */
+    size_t   len;   /* Number of valid bytes in the window */
+} ScanReader_t;
+
+typedef struct {
+    const ImcMetaSink_t *sink;                      /* The caller's sink */
+    const ImcScanOpts_t *opts;                      /* Scanning options */
+    char                *queue[_SCAN_QUEUE_SIZE];   /* Paths waiting to be read (a ring) */
+    size_t               head;                      /* Index of the next path to be claimed */
+    size_t               count;                     /* Number of paths in the queue */
+    bool                 done;                      /* True once the walk has queued its last path */
+    ImcError_t           status;                    /* First error returned by the sink */
+    pthread_mutex_t      lock;                      /* Guards the queue, done and status */
+    pthread_cond_t       not_empty;                 /* Signalled when a path is queued or the walk is done */
+    pthread_cond_t       not_full;                  /* Signalled when a path is claimed */
+    pthread_mutex_t      sink_lock;                 /* Serializes calls to the sink */
+} ScanJob_t;
+
+/*
+ * ===============================
+ *       Private Functions
+ * ===============================
+ */
+
+/**
+ * @brief Returns the __len__ bytes at offset __off__ of the file, reading them into the window if necessary.
+ * @since 16-10-2026
+ * @param[in,out] rd The reader
+ * @param[in] off The offset of the first byte
+ * @param[in] len The number of bytes (at most _SCAN_WINDOW_SIZE)
+ * @returns A pointer to the bytes, valid until the next call, or NULL if they lie past the end of the file
+ */
+static const uint8_t *_imc_scan_read(ScanReader_t *rd, const off_t off, const size_t len) {
+    ssize_t n;
+    size_t want;
+
+    if (off >= rd->off && len <= rd->len && (size_t)(off - rd->off) <= rd->len - len) {
+        return rd->buf + (off - rd->off);
+    }
+    if (len > _SCAN_WINDOW_SIZE) {
+        return NULL;
+    }
+
+    want = (len > _SCAN_READ_SIZE) ? len : _SCAN_READ_SIZE;
+    rd->off = off;
+    rd->len = 0;
+    while (rd->len < want) {
+        n = pread(rd->fd, rd->buf + rd->len, want - rd->len, off + (off_t)rd->len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        rd->len += (size_t)n;
+    }
+
+    return (rd->len >= len) ? rd->buf : NULL;
+}
+
+/**
+ * @brief Copies the text of an ASCII tag into __dst__, dropping the padding some cameras add.
+ * @since 16-10-2026
+ * @param[in] exif The parsed EXIF data
+ * @param[in] ifd The IFD holding the tag
+ * @param[in] tag The tag
+ * @param[out] dst The NUL terminated text, truncated to fit
+ * @param[in] dst_size The size of __dst__ (in bytes)
+ * @returns True if the tag was found
+ */
+static bool _imc_scan_string(
+    const Exif_t* const exif,
+    const ExifIfd_t ifd,
+    const uint16_t tag,
+    char *dst,
+    const size_t dst_size
+) {
+    ExifEntry_t entry;
+    const char *str;
+    size_t len;
+
+    if (imc_exif_find(exif, ifd, tag, &entry) != IMC_EOK || imc_exif_string(&entry, &str, &len) != IMC_EOK) {
+        return false;
+    }
+
+    while (len > 0 && str[len - 1] == ' ') {
+        --len;
+    }
+    len = (len < dst_size - 1) ? len : dst_size - 1;
+    memcpy((void*)dst, (void*)str, len);
+    dst[len] = '\0';
+
+    return len > 0;
+}
+
+/**
+ * @brief Copies the fields of interest from EXIF data into __meta__.
+ * @since 16-10-2026
+ * @param[in] exif The parsed EXIF data
+ * @param[in,out] meta The metadata
+ */
+static void _imc_scan_exif(const Exif_t* const exif, ImcMetadata_t *meta) {
+    meta->has_exif = true;
+    imc_exif_orientation(exif, &meta->orientation);
+    if (!_imc_scan_string(exif, EXIF_IFD_EXIF, EXIF_TAG_DATETIME_ORIGINAL, meta->datetime, sizeof(meta->datetime))) {
+        _imc_scan_string(exif, EXIF_IFD_0, EXIF_TAG_DATETIME, meta->datetime, sizeof(meta->datetime));
+    }
+    _imc_scan_string(exif, EXIF_IFD_0, EXIF_TAG_MAKE, meta->make, sizeof(meta->make));
+    _imc_scan_string(exif, EXIF_IFD_0, EXIF_TAG_MODEL, meta->model, sizeof(meta->model));
+    meta->has_gps = (imc_exif_gps(exif, &meta->latitude, &meta->longitude) == IMC_EOK);
+}
+
+/**
+ * @brief Reads the IHDR chunk of a PNG and the eXIf chunk, if any, ahead of its image data.
+ * @since 16-10-2026
+ * @param[in,out] rd The reader, whose file starts with the PNG signature
+ * @param[in,out] meta The metadata
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_scan_png(ScanReader_t *rd, ImcMetadata_t *meta) {
+    const uint8_t *p;
+    off_t pos;
+    uint32_t len;
+    Exif_t exif;
+
+    p = _imc_scan_read(rd, 8, 8 + 13);
+    if (p == NULL || memcmp(p + 4, IHDR, 4) != 0) {
+        return IMC_EINVAL;
+    }
+    p += 8;
+    meta->width = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    meta->height = ((uint32_t)p[4] << 24) | ((uint32_t)p[5] << 16) | ((uint32_t)p[6] << 8) | p[7];
+    meta->bit_depth = p[8];
+    meta->n_channels = (p[9] & PALETTE) ? 1 : 1 + ((p[9] & COLOR) ? 2 : 0) + ((p[9] & ALPHA) ? 1 : 0);
+    meta->progressive = (p[12] == 1);
+
+    /* Ancillary chunks only matter up to the image data, where the walk stops */
+    for (pos = 8 + 12 + 13; (p = _imc_scan_read(rd, pos, 8)) != NULL; pos += (off_t)len + 12) {
+        len = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+        if (memcmp(p + 4, IDAT, 4) == 0 || memcmp(p + 4, IEND, 4) == 0) {
+            break;
+        }
+        if (memcmp(p + 4, EXIF, 4) == 0 && !meta->has_exif) {
+            p = _imc_scan_read(rd, pos + 8, len);
+            if (p != NULL && imc_exif_parse(p, len, &exif) == IMC_EOK) {
+                _imc_scan_exif(&exif, meta);
+            }
+        }
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Reads the marker segments of a JPEG up to its frame header, including any EXIF APP1 segment.
+ * @since 16-10-2026
+ * @param[in,out] rd The reader, whose file starts with an SOI marker
+ * @param[in,out] meta The metadata
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_scan_jpeg(ScanReader_t *rd, ImcMetadata_t *meta) {
+    const uint8_t *p;
+    off_t pos = 2;
+    size_t len, n;
+    uint8_t marker;
+    Exif_t exif;
+
+    for (n = 0; n < _SCAN_MAX_SEGMENTS; ++n) {
+        p = _imc_scan_read(rd, pos, 4);
+        if (p == NULL || p[0] != 0xFF) {
+            break;
+        }
+        marker = p[1];
+        if (marker == 0xFF) {
+            ++pos;
+            continue;
+        } else if (marker == 0x01 || (marker >= JPEG_RST0 && marker <= JPEG_RST7)) {
+            pos += 2;
+            continue;
+        } else if (marker == JPEG_SOS || marker == JPEG_EOI) {
+            break;
+        }
+
+        len = (size_t)((p[2] << 8) | p[3]);
+        if (len < 2) {
+            break;
+        }
+
+        /* SOF0-SOF15, less DHT, JPG and DAC which share the range */
+        if (marker >= JPEG_SOF0 && marker <= 0xCF && marker != JPEG_DHT && marker != 0xC8 && marker != 0xCC) {
+            p = _imc_scan_read(rd, pos + 4, 6);
+            if (p == NULL) {
+                break;
+            }
+            meta->bit_depth = p[0];
+            meta->height = (uint32_t)((p[1] << 8) | p[2]);
+            meta->width = (uint32_t)((p[3] << 8) | p[4]);
+            meta->n_channels = p[5];
+            meta->progressive = ((marker & 0x03) == 0x02);
+            return IMC_EOK;
+        }
+
+        /* APP1 is shared with XMP, which is told apart by its identifier */
+        if (marker == JPEG_APP1 && !meta->has_exif) {
+            p = _imc_scan_read(rd, pos + 4, len - 2);
+            if (p != NULL && len - 2 >= 6 && memcmp(p, "Exif\0\0", 6) == 0
+                && imc_exif_parse(p, len - 2, &exif) == IMC_EOK) {
+                _imc_scan_exif(&exif, meta);
+            }
+        }
+        pos += (off_t)len + 2;
+    }
+
+    return IMC_ENODATA;
+}
+
+/**
+ * @brief Reads the metadata of the file at __path__ through __rd__.
+ * @since 16-10-2026
+ * @param[in] path The path of the file
+ * @param[in,out] rd The reader, whose window is allocated
+ * @param[out] meta The metadata, whose status is also returned
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_scan_file(const char* const path, ScanReader_t *rd, ImcMetadata_t *meta) {
+    const uint8_t *p;
+
+    memset(meta, 0, sizeof(*meta));
+    meta->path = path;
+    meta->orientation = 1;
+
+    rd->fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (rd->fd < 0) {
+        meta->status = IMC_EFAIL;
+        return meta->status;
+    }
+    rd->off = 0;
+    rd->len = 0;
+
+    p = _imc_scan_read(rd, 0, 8);
+    if (p != NULL && memcmp(p, PNG_MAGIC, 8) == 0) {
+        meta->format = IMC_FORMAT_PNG;
+        meta->status = _imc_scan_png(rd, meta);
+    } else if (p != NULL && p[0] == 0xFF && p[1] == JPEG_SOI && p[2] == 0xFF) {
+        meta->format = IMC_FORMAT_JPEG;
+        meta->status = _imc_scan_jpeg(rd, meta);
+    } else {
+        meta->status = IMC_ENODATA;
+    }
+
+    close(rd->fd);
+    rd->fd = -1;
+    return meta->status;
+}
+
+/**
+ * @brief Thread entry point which reads queued files until the walk is done and the queue is empty.
+ * @since 16-10-2026
+ * @param[in,out] arg The shared ScanJob_t
+ * @returns NULL
+ */
+static void *_imc_scan_worker(void *arg) {
+    ScanJob_t *job = (ScanJob_t*)arg;
+    ScanReader_t rd = { 0 };
+    ImcMetadata_t meta;
+    ImcError_t status;
+    char *path;
+
+    rd.buf = malloc(_SCAN_WINDOW_SIZE);
+    if (rd.buf == NULL) {
+        IMC_LOG("Failed to allocate memory for read buffer", IMC_ERROR);
+
+        /* Stop the scan, waking the walk in case it waits for room this worker would have made */
+        pthread_mutex_lock(&job->lock);
+        if (job->status == IMC_EOK) {
+            job->status = IMC_ENOMEM;
+        }
+        pthread_cond_broadcast(&job->not_full);
+        pthread_mutex_unlock(&job->lock);
+        return NULL;
+    }
+
+    while (true) {
+        pthread_mutex_lock(&job->lock);
+        while (job->count == 0 && !job->done) {
+            pthread_cond_wait(&job->not_empty, &job->lock);
+        }
+        if (job->count == 0) {
+            pthread_mutex_unlock(&job->lock);
+            break;
+        }
+        path = job->queue[job->head];
+        job->head = (job->head + 1) % _SCAN_QUEUE_SIZE;
+        job->count--;
+        status = job->status;
+        pthread_cond_signal(&job->not_full);
+        pthread_mutex_unlock(&job->lock);
+
+        /* Once the sink has stopped the scan, the rest of the queue is only drained */
+        if (status == IMC_EOK && (_imc_scan_file(path, &rd, &meta) == IMC_EOK || job->opts->all_files)) {
+            pthread_mutex_lock(&job->sink_lock);
+            status = job->sink->record(job->sink->ctx, &meta);
+            pthread_mutex_unlock(&job->sink_lock);
+
+            if (status != IMC_EOK) {
+                pthread_mutex_lock(&job->lock);
+                if (job->status == IMC_EOK) {
+                    job->status = status;
+                }
+                pthread_mutex_unlock(&job->lock);
+            }
+        }
+        free(path);
+    }
+
+    free(rd.buf);
+    return NULL;
+}
+
+/**
+ * @brief Queues __path__ for the workers, waiting while the queue is full.
+ * The path is freed by the worker which reads it, or here if the scan has been stopped.
+ * @since 16-10-2026
+ * @param[in,out] job The shared job
+ * @param[in] path The path, allocated with malloc()
+ * @returns The status of the scan, which is not IMC_EOK once the sink has stopped it
+ */
+static ImcError_t _imc_scan_push(ScanJob_t *job, char *path) {
+    ImcError_t status;
+
+    pthread_mutex_lock(&job->lock);
+    while (job->count == _SCAN_QUEUE_SIZE && job->status == IMC_EOK) {
+        pthread_cond_wait(&job->not_full, &job->lock);
+    }
+    status = job->status;
+    if (status == IMC_EOK) {
+        job->queue[(job->head + job->count) % _SCAN_QUEUE_SIZE] = path;
+        job->count++;
+        pthread_cond_signal(&job->not_empty);
+    }
+    pthread_mutex_unlock(&job->lock);
+
+    if (status != IMC_EOK) {
+        free(path);
+    }
+    return status;
+}
+
+/**
+ * @brief Queues every file in the directory __dir__, descending into its subdirectories if asked to.
+ * Symbolic links inside the tree are not followed, so a link cycle cannot trap the walk.
+ * @since 16-10-2026
+ * @param[in,out] job The shared job
+ * @param[in] dir The path of the directory
+ * @returns The status of the scan, which is not IMC_EOK once the sink has stopped it
+ */
+static ImcError_t _imc_scan_walk(ScanJob_t *job, const char* const dir) {
+    DIR *dp;
+    struct dirent *ent;
+    struct stat st;
+    ImcError_t status = IMC_EOK;
+    size_t dir_len = strlen(dir), name_len;
+    char *path;
+    bool is_dir, is_reg;
+
+    dp = opendir(dir);
+    if (dp == NULL) {
+        IMC_LOG("Failed to open directory", IMC_WARNING);
+        return IMC_EOK;
+    }
+
+    while (status == IMC_EOK && (ent = readdir(dp)) != NULL) {
+        if (strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0) {
+            continue;
+        }
+
+        name_len = strlen(ent->d_name);
+        path = malloc(dir_len + name_len + 2);
+        if (path == NULL) {
+            IMC_LOG("Failed to allocate memory for path", IMC_ERROR);
+            status = IMC_ENOMEM;
+            break;
+        }
+        memcpy((void*)path, (void*)dir, dir_len);
+        path[dir_len] = '/';
+        memcpy((void*)(path + dir_len + 1), (void*)ent->d_name, name_len + 1);
+
+        /* Most file systems give the type with the name, which saves a stat() per file */
+        is_dir = (ent->d_type == DT_DIR);
+        is_reg = (ent->d_type == DT_REG);
+        if (ent->d_type == DT_UNKNOWN && lstat(path, &st) == 0) {
+            is_dir = S_ISDIR(st.st_mode);
+            is_reg = S_ISREG(st.st_mode);
+        }
+
+        if (is_reg) {
+            status = _imc_scan_push(job, path);
+        } else {
+            if (is_dir && job->opts->recursive) {
+                status = _imc_scan_walk(job, path);
+            }
+            free(path);
+        }
+    }
+
+    closedir(dp);
+    return status;
+}
+
+/*
+ * ===============================
+ *        Public Functions
+ * ===============================
+ */
+
+/**
+ * @brief Returns the default scanning options.
+ * @since 16-10-2026
+ * @returns A ImcScanOpts_t reading files on one thread per online CPU and descending into subdirectories
+ */
+ImcScanOpts_t imc_scan_default_opts(void) {
+    ImcScanOpts_t opts;
+
+    opts.n_threads = 0;
+    opts.recursive = true;
+    opts.all_files = false;
+
+    return opts;
+}
+
+/**
+ * @brief Reads the dimensions, format and EXIF metadata of the PNG or JPEG at __path__ without decoding it.
+ * @since 16-10-2026
+ * @param[in] path The path of the file
+ * @param[out] meta The metadata, whose path points to __path__
+ * @returns IMC_EOK on success, IMC_ENODATA if the file is neither a PNG nor a JPEG (or its header
+ * is missing), or another error code on failure
+ */
+ImcError_t imc_read_metadata(const char* const path, ImcMetadata_t *meta) {
+    ScanReader_t rd = { 0 };
+    ImcError_t status;
+
+    if (path == NULL || meta == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    rd.buf = malloc(_SCAN_WINDOW_SIZE);
+    if (rd.buf == NULL) {
+        IMC_LOG("Failed to allocate memory for read buffer", IMC_ERROR);
+        return IMC_ENOMEM;
+    }
+
+    status = _imc_scan_file(path, &rd, meta);
+
+    free(rd.buf);
+    return status;
+}
+
+/**
+ * @brief Reads the metadata of every PNG and JPEG among __paths__, passing each file's to __sink__.
+ * Each path may name a file or a directory, whose files are all read (and, with
+ * ImcScanOpts_t.recursive set, those of its subdirectories too). The calling thread walks the
+ * directories while ImcScanOpts_t.n_threads workers read the files it queues, so __sink__
+ * receives records in the order the files are finished rather than the order they were found.
+ * Files which cannot be opened or are neither PNG nor JPEG are only passed on with
+ * ImcScanOpts_t.all_files set, their ImcMetadata_t.status saying why they were not read.
+ * @since 16-10-2026
+ * @param[in] paths The files and directories to scan
+ * @param[in] n_paths The number of entries in __paths__
+ * @param[in] sink The sink which receives the metadata
+ * @param[in] opts Scanning options or NULL to use imc_scan_default_opts()
+ * @returns An ImcError_t indicating the exit status code, which is that of __sink__ if it stopped the scan
+ */
+ImcError_t imc_scan_metadata(
+    const char* const* const paths,
+    const size_t n_paths,
+    const ImcMetaSink_t* const sink,
+    const ImcScanOpts_t* const opts
+) {
+    ScanJob_t job = { 0 };
+    ImcScanOpts_t def_opts = imc_scan_default_opts();
+    struct stat st;
+    pthread_t *threads = NULL;
+    ImcError_t status = IMC_EOK;
+    size_t i, n_threads, n_spawned;
+    long n_cpus;
+    char *path;
+
+    if (paths == NULL || sink == NULL || sink->record == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    job.sink = sink;
+    job.opts = (opts != NULL) ? opts : &def_opts;
+    job.status = IMC_EOK;
+
+    n_threads = job.opts->n_threads;
+    if (n_threads == 0) {
+        n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        n_threads = (n_cpus > 0) ? (size_t)n_cpus : 1;
+    }
+    threads = calloc(n_threads, sizeof(*threads));
+    if (threads == NULL) {
+        IMC_LOG("Failed to allocate memory for scan threads", IMC_ERROR);
+        return IMC_ENOMEM;
+    }
+
+    pthread_mutex_init(&job.lock, NULL);
+    pthread_mutex_init(&job.sink_lock, NULL);
+    pthread_cond_init(&job.not_empty, NULL);
+    pthread_cond_init(&job.not_full, NULL);
+
+    for (n_spawned = 0; n_spawned < n_threads; ++n_spawned) {
+        if (pthread_create(&threads[n_spawned], NULL, _imc_scan_worker, &job) != 0) {
+            IMC_LOG("Failed to spawn scan thread", IMC_WARNING);
+            break;
+        }
+    }
+    if (n_spawned == 0) {
+        status = IMC_EFAIL;
+        goto cleanup;
+    }
+
+    for (i = 0; i < n_paths && status == IMC_EOK; ++i) {
+        if (stat(paths[i], &st) == 0 && S_ISDIR(st.st_mode)) {
+            status = _imc_scan_walk(&job, paths[i]);
+            continue;
+        }
+
+        path = strdup(paths[i]);
+        if (path == NULL) {
+            IMC_LOG("Failed to allocate memory for path", IMC_ERROR);
+            status = IMC_ENOMEM;
+            break;
+        }
+        status = _imc_scan_push(&job, path);
+    }
+
+cleanup:
+    pthread_mutex_lock(&job.lock);
+    job.done = true;
+    /* A failed walk stops the workers as a stopping sink does */
+    if (job.status == IMC_EOK) {
+        job.status = status;
+    }
+    pthread_cond_broadcast(&job.not_empty);
+    pthread_mutex_unlock(&job.lock);
+
+    for (i = 0; i < n_spawned; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    /* Paths are left behind if every worker failed to start reading */
+    for (; job.count > 0; job.count--) {
+        free(job.queue[job.head]);
+        job.head = (job.head + 1) % _SCAN_QUEUE_SIZE;
+    }
+
+    pthread_cond_destroy(&job.not_full);
+    pthread_cond_destroy(&job.not_empty);
+    pthread_mutex_destroy(&job.sink_lock);
+    pthread_mutex_destroy(&job.lock);
+    free(threads);
+
+    return job.status;
+}
@@ -0,0 +1,706 @@
+/**
+ * @file imc_strip.c
+ * @author Neil Kingdom
+ * @since 16-10-2026
+ * @version 1.0
+ * @brief Contains the functions necessary for removing metadata from JPEG and PNG files without
+ * recompressing them.
+ *
+ * Metadata is either dropped whole (a JPEG marker segment or a PNG chunk) or edited where it
+ * lies: the GPS IFD and maker note are removed from EXIF data by zeroing their bytes and unlinking
+ * their entries, which leaves every other offset in the TIFF structure valid, so the EXIF data
+ * keeps its size and its segment or chunk can be written back as it was (with its CRC recomputed
+ * for PNG). Everything else, including all of the compressed image data, is copied through
+ * untouched: in memory with block moves, and between files with copy_file_range(), so that on
+ * most file systems the image data never passes through user space at all. The cost is therefore
+ * proportional to the size of the metadata rather than the number of pixels.
+ */
+
+#include "imc_strip.h"
+
+#include <errno.h>
+
+/* Bytes of a segment's or chunk's data needed to tell what it holds */
+#define _STRIP_PREFIX_SIZE 32
+
+/* Size of the buffer used where copy_file_range() is unavailable */
+#define _STRIP_COPY_SIZE (1 << 20)
+
+/* Identifiers at the start of JPEG APP1 segments */
+#define _STRIP_EXIF_ID      "Exif\0\0"
+#define _STRIP_EXIF_ID_SIZE 6
+#define _STRIP_XMP_ID       "http://ns.adobe.com/"
+#define _STRIP_XMP_ID_SIZE  20
+
+/* Keyword of a PNG iTXt chunk holding XMP (with its terminator) */
+#define _STRIP_XMP_KEY      "XML:com.adobe.xmp"
+#define _STRIP_XMP_KEY_SIZE 18
+
+typedef enum {
+    _STRIP_KEEP,    /* Copy the segment or chunk as it is */
+    _STRIP_DROP,    /* Leave the segment or chunk out */
+    _STRIP_EDIT     /* Remove parts of the EXIF data it holds */
+} StripAction_t;
+
+/*
+ * ===============================
+ *       Private Functions
+ * ===============================
+ */
+
+/**
+ * @brief Reads a 16-bit value stored in the given byte order.
+ * @since 16-10-2026
+ * @param[in] buf The location of at least 2 bytes
+ * @param[in] big_endian True if the most significant byte comes first
+ * @returns The value stored at __buf__
+ */
+static inline uint16_t _imc_strip_u16(const uint8_t* const buf, const bool big_endian) {
+    return big_endian ? (uint16_t)((buf[0] << 8) | buf[1])
+                      : (uint16_t)((buf[1] << 8) | buf[0]);
+}
+
+/**
+ * @brief Reads a big-endian 32-bit value.
+ * @since 16-10-2026
+ * @param[in] buf The location of at least 4 bytes
+ * @returns The value stored at __buf__
+ */
+static inline uint32_t _imc_strip_u32(const uint8_t* const buf) {
+    return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) | ((uint32_t)buf[2] << 8) | buf[3];
+}
+
+/**
+ * @brief Removes the entry with the given tag from an IFD, moving the entries after it down.
+ * The link to the next IFD moves down with them and the 12 bytes freed at the end are zeroed.
+ * @since 16-10-2026
+ * @param[in,out] tiff The TIFF header, through which __exif__ views the data
+ * @param[in] exif The parsed EXIF data
+ * @param[in] ifd The IFD holding the entry
+ * @param[in] tag The tag of the entry
+ */
+static void _imc_strip_unlink(
+    uint8_t *tiff,
+    const Exif_t* const exif,
+    const ExifIfd_t ifd,
+    const uint16_t tag
+) {
+    uint8_t *entries;
+    size_t i, tail, end, n_entries = imc_exif_count(exif, ifd);
+
+    if (n_entries == 0) {
+        return;
+    }
+
+    entries = tiff + exif->ifd[ifd] + 2;
+    for (i = 0; i < n_entries && _imc_strip_u16(entries + i * 12, exif->big_endian) != tag; ++i);
+    if (i == n_entries) {
+        return;
+    }
+
+    tail = (n_entries - 1 - i) * 12;
+    end = exif->ifd[ifd] + 2 + n_entries * 12;
+    if (exif->size - end >= 4) {
+        tail += 4;
+    }
+    memmove((void*)(entries + i * 12), (void*)(entries + (i + 1) * 12), tail);
+    memset((void*)(entries + i * 12 + tail), 0, 12);
+
+    n_entries--;
+    tiff[exif->ifd[ifd]] = (uint8_t)(exif->big_endian ? n_entries >> 8 : n_entries);
+    tiff[exif->ifd[ifd] + 1] = (uint8_t)(exif->big_endian ? n_entries : n_entries >> 8);
+}
+
+/**
+ * @brief Removes the GPS IFD and the maker note from EXIF data, as __opts__ asks, without changing its size.
+ * The bytes of everything removed are zeroed, so none of it survives in the output. EXIF data which
+ * cannot be parsed is left as it is.
+ * @since 16-10-2026
+ * @param[in,out] data The EXIF data (see imc_exif_parse())
+ * @param[in] size The size of __data__ (in bytes)
+ * @param[in] opts Stripping options
+ */
+static void _imc_strip_exif(uint8_t *data, const size_t size, const ImcStripOpts_t* const opts) {
+    Exif_t exif;
+    ExifEntry_t entry;
+    uint8_t *tiff;
+    size_t i, len, n_entries;
+
+    if (imc_exif_parse(data, size, &exif) != IMC_EOK) {
+        return;
+    }
+    tiff = data + (exif.tiff - data);
+
+    if (opts->gps) {
+        n_entries = imc_exif_count(&exif, EXIF_IFD_GPS);
+        for (i = 0; i < n_entries; ++i) {
+            if (imc_exif_entry(&exif, EXIF_IFD_GPS, i, &entry) == IMC_EOK && entry.data != NULL) {
+                memset((void*)(tiff + (entry.data - exif.tiff)), 0, entry.size);
+            }
+        }
+        if (n_entries > 0) {
+            len = 2 + n_entries * 12 + 4;
+            len = (len < exif.size - exif.ifd[EXIF_IFD_GPS]) ? len : exif.size - exif.ifd[EXIF_IFD_GPS];
+            memset((void*)(tiff + exif.ifd[EXIF_IFD_GPS]), 0, len);
+        }
+        _imc_strip_unlink(tiff, &exif, EXIF_IFD_0, EXIF_TAG_GPS_IFD);
+    }
+
+    if (opts->maker_notes) {
+        if (imc_exif_find(&exif, EXIF_IFD_EXIF, EXIF_TAG_MAKER_NOTE, &entry) == IMC_EOK && entry.data != NULL) {
+            memset((void*)(tiff + (entry.data - exif.tiff)), 0, entry.size);
+        }
+        _imc_strip_unlink(tiff, &exif, EXIF_IFD_EXIF, EXIF_TAG_MAKER_NOTE);
+    }
+}
+
+/**
+ * @brief Decides what becomes of a JPEG marker segment.
+ * @since 16-10-2026
+ * @param[in] marker The segment's marker
+ * @param[in] prefix The first bytes of the segment's data (following its length)
+ * @param[in] len The number of bytes in __prefix__
+ * @param[in] opts Stripping options
+ * @returns The action to take
+ */
+static StripAction_t _imc_strip_jpeg_action(
+    const uint8_t marker,
+    const uint8_t* const prefix,
+    const size_t len,
+    const ImcStripOpts_t* const opts
+) {
+    switch (marker) {
+        case JPEG_APP1:
+            if (len >= _STRIP_EXIF_ID_SIZE && memcmp(prefix, _STRIP_EXIF_ID, _STRIP_EXIF_ID_SIZE) == 0) {
+                if (opts->exif) {
+                    return _STRIP_DROP;
+                }
+                return (opts->gps || opts->maker_notes) ? _STRIP_EDIT : _STRIP_KEEP;
+            }
+            if (len >= _STRIP_XMP_ID_SIZE && memcmp(prefix, _STRIP_XMP_ID, _STRIP_XMP_ID_SIZE) == 0) {
+                return opts->xmp ? _STRIP_DROP : _STRIP_KEEP;
+            }
+            return _STRIP_KEEP;
+        case JPEG_APP13:
+            return opts->iptc ? _STRIP_DROP : _STRIP_KEEP;
+        case JPEG_COM:
+            return opts->text ? _STRIP_DROP : _STRIP_KEEP;
+        default:
+            return _STRIP_KEEP;
+    }
+}
+
+/**
+ * @brief Decides what becomes of a PNG chunk.
+ * @since 16-10-2026
+ * @param[in] type The chunk's type
+ * @param[in] prefix The first bytes of the chunk's data
+ * @param[in] len The number of bytes in __prefix__
+ * @param[in] opts Stripping options
+ * @returns The action to take
+ */
+static StripAction_t _imc_strip_png_action(
+    const uint8_t* const type,
+    const uint8_t* const prefix,
+    const size_t len,
+    const ImcStripOpts_t* const opts
+) {
+    if (memcmp(type, EXIF, 4) == 0) {
+        if (opts->exif) {
+            return _STRIP_DROP;
+        }
+        return (opts->gps || opts->maker_notes) ? _STRIP_EDIT : _STRIP_KEEP;
+    } else if (memcmp(type, TEXT, 4) == 0 || memcmp(type, ZTXT, 4) == 0) {
+        return opts->text ? _STRIP_DROP : _STRIP_KEEP;
+    } else if (memcmp(type, ITXT, 4) == 0) {
+        if (opts->xmp && len >= _STRIP_XMP_KEY_SIZE && memcmp(prefix, _STRIP_XMP_KEY, _STRIP_XMP_KEY_SIZE) == 0) {
+            return _STRIP_DROP;
+        }
+        return opts->text ? _STRIP_DROP : _STRIP_KEEP;
+    }
+
+    return _STRIP_KEEP;
+}
+
+/**
+ * @brief Recomputes the CRC of the PNG chunk at __chunk__ after its data has been edited.
+ * @since 16-10-2026
+ * @param[in,out] chunk The chunk, starting with its length
+ * @param[in] len The length of the chunk's data
+ */
+static void _imc_strip_png_crc(uint8_t *chunk, const uint32_t len) {
+    uint32_t crc = (uint32_t)crc32(0, chunk + 4, len + 4);
+
+    chunk[len + 8] = (uint8_t)(crc >> 24);
+    chunk[len + 9] = (uint8_t)(crc >> 16);
+    chunk[len + 10] = (uint8_t)(crc >> 8);
+    chunk[len + 11] = (uint8_t)crc;
+}
+
+/**
+ * @brief Strips the marker segments of a JPEG held in memory, compacting it in place.
+ * @since 16-10-2026
+ * @param[in,out] data The JPEG
+ * @param[in,out] size The size of __data__, reduced by the bytes removed
+ * @param[in] opts Stripping options
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_strip_jpeg_mem(uint8_t *data, size_t *size, const ImcStripOpts_t* const opts) {
+    size_t pos = 2, w = 2, len, seg;
+    uint8_t marker;
+    StripAction_t action;
+
+    while (*size - pos >= 4) {
+        if (data[pos] != 0xFF) {
+            IMC_LOG("Expected a JPEG marker", IMC_ERROR);
+            return IMC_EINVAL;
+        }
+        marker = data[pos + 1];
+        if (marker == JPEG_SOS || marker == JPEG_EOI) {
+            break;
+        }
+
+        /* Fill bytes and standalone markers carry no length */
+        if (marker == 0xFF) {
+            seg = 1;
+        } else if (marker == 0x01 || (marker >= JPEG_RST0 && marker <= JPEG_RST7)) {
+            seg = 2;
+        } else {
+            len = (size_t)((data[pos + 2] << 8) | data[pos + 3]);
+            if (len < 2 || len > *size - pos - 2) {
+                IMC_LOG("JPEG segment runs past the end of the file", IMC_ERROR);
+                return IMC_EOVERFLOW;
+            }
+            seg = len + 2;
+
+            action = _imc_strip_jpeg_action(marker, data + pos + 4, len - 2, opts);
+            if (action == _STRIP_DROP) {
+                pos += seg;
+                continue;
+            } else if (action == _STRIP_EDIT) {
+                _imc_strip_exif(data + pos + 4, len - 2, opts);
+            }
+        }
+
+        if (w != pos) {
+            memmove((void*)(data + w), (void*)(data + pos), seg);
+        }
+        w += seg;
+        pos += seg;
+    }
+
+    /* The scans follow untouched */
+    if (w != pos) {
+        memmove((void*)(data + w), (void*)(data + pos), *size - pos);
+    }
+    *size -= pos - w;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Strips the chunks of a PNG held in memory, compacting it in place.
+ * @since 16-10-2026
+ * @param[in,out] data The PNG
+ * @param[in,out] size The size of __data__, reduced by the bytes removed
+ * @param[in] opts Stripping options
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_strip_png_mem(uint8_t *data, size_t *size, const ImcStripOpts_t* const opts) {
+    size_t pos = 8, w = 8, seg;
+    uint32_t len;
+    StripAction_t action;
+
+    while (*size - pos >= 12) {
+        len = _imc_strip_u32(data + pos);
+        if (len > *size - pos - 12) {
+            IMC_LOG("PNG chunk runs past the end of the file", IMC_ERROR);
+            return IMC_EOVERFLOW;
+        }
+        seg = (size_t)len + 12;
+
+        action = _imc_strip_png_action(data + pos + 4, data + pos + 8, len, opts);
+        if (action == _STRIP_DROP) {
+            pos += seg;
+            continue;
+        } else if (action == _STRIP_EDIT) {
+            _imc_strip_exif(data + pos + 8, len, opts);
+            _imc_strip_png_crc(data + pos, len);
+        }
+
+        if (w != pos) {
+            memmove((void*)(data + w), (void*)(data + pos), seg);
+        }
+        w += seg;
+        pos += seg;
+    }
+
+    if (w != pos) {
+        memmove((void*)(data + w), (void*)(data + pos), *size - pos);
+    }
+    *size -= pos - w;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Reads exactly __len__ bytes at offset __off__ of __fd__.
+ * @since 16-10-2026
+ * @param[in] fd The file
+ * @param[out] buf The bytes
+ * @param[in] len The number of bytes
+ * @param[in] off The offset of the first byte
+ * @returns IMC_EOK on success, or IMC_EFAIL if the file ends first or cannot be read
+ */
+static ImcError_t _imc_strip_pread(const int fd, uint8_t *buf, const size_t len, const off_t off) {
+    ssize_t n;
+    size_t done = 0;
+
+    while (done < len) {
+        n = pread(fd, buf + done, len - done, off + (off_t)done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return IMC_EFAIL;
+        }
+        done += (size_t)n;
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Writes all __len__ bytes of __buf__ to __fd__.
+ * @since 16-10-2026
+ * @param[in] fd The file
+ * @param[in] buf The bytes
+ * @param[in] len The number of bytes
+ * @returns IMC_EOK on success, or IMC_EFAIL if the file cannot be written
+ */
+static ImcError_t _imc_strip_write(const int fd, const uint8_t *buf, size_t len) {
+    ssize_t n;
+
+    while (len > 0) {
+        n = write(fd, buf, len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return IMC_EFAIL;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Appends bytes __off__ to __off__ + __len__ of __in__ to __out__.
+ * The copy is left to the kernel with copy_file_range(), which can share or clone the blocks
+ * instead of copying them. Where it is unavailable (or the files are on different file
+ * systems of an older kernel), the bytes are copied through a buffer instead.
+ * @since 16-10-2026
+ * @param[in] in The source file
+ * @param[in] out The destination file, written at its current offset
+ * @param[in] off The offset of the first byte to copy
+ * @param[in] len The number of bytes to copy
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_strip_copy(const int in, const int out, off_t off, size_t len) {
+    uint8_t *buf;
+    size_t chunk;
+    ImcError_t status = IMC_EOK;
+#if defined(__linux__)
+    ssize_t n;
+
+    while (len > 0) {
+        n = copy_file_range(in, &off, out, NULL, len, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        len -= (size_t)n;
+    }
+#endif
+
+    if (len == 0) {
+        return IMC_EOK;
+    }
+
+    buf = malloc(_STRIP_COPY_SIZE);
+    if (buf == NULL) {
+        IMC_LOG("Failed to allocate memory for copy buffer", IMC_ERROR);
+        return IMC_ENOMEM;
+    }
+
+    while (len > 0 && status == IMC_EOK) {
+        chunk = (len < _STRIP_COPY_SIZE) ? len : _STRIP_COPY_SIZE;
+        status = _imc_strip_pread(in, buf, chunk, off);
+        if (status == IMC_EOK) {
+            status = _imc_strip_write(out, buf, chunk);
+        }
+        off += (off_t)chunk;
+        len -= chunk;
+    }
+    if (status != IMC_EOK) {
+        IMC_LOG("Failed to copy image data", IMC_ERROR);
+    }
+
+    free(buf);
+    return status;
+}
+
+/**
+ * @brief Writes a segment or chunk of __in__ to __out__ with the EXIF data it holds edited.
+ * @since 16-10-2026
+ * @param[in] in The source file
+ * @param[in] out The destination file
+ * @param[in] off The offset of the segment or chunk
+ * @param[in] len The size of the segment or chunk, including its marker or length, type and CRC
+ * @param[in] png True for a PNG chunk, false for a JPEG segment
+ * @param[in] opts Stripping options
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_strip_edit_fd(
+    const int in,
+    const int out,
+    const off_t off,
+    const size_t len,
+    const bool png,
+    const ImcStripOpts_t* const opts
+) {
+    uint8_t *buf;
+    ImcError_t status;
+
+    buf = malloc(len);
+    if (buf == NULL) {
+        IMC_LOG("Failed to allocate memory for EXIF data", IMC_ERROR);
+        return IMC_ENOMEM;
+    }
+
+    status = _imc_strip_pread(in, buf, len, off);
+    if (status == IMC_EOK) {
+        if (png) {
+            _imc_strip_exif(buf + 8, len - 12, opts);
+            _imc_strip_png_crc(buf, (uint32_t)(len - 12));
+        } else {
+            _imc_strip_exif(buf + 4, len - 4, opts);
+        }
+        status = _imc_strip_write(out, buf, len);
+    }
+
+    free(buf);
+    return status;
+}
+
+/**
+ * @brief Strips the file __in__ into __out__, walking its JPEG segments or PNG chunks with small reads.
+ * Runs of segments or chunks which are kept are copied in one go when the walk reaches one which
+ * is dropped or edited, and at the end, so the scans of a JPEG and the consecutive IDAT chunks of
+ * a PNG are each copied by a single _imc_strip_copy().
+ * @since 16-10-2026
+ * @param[in] in The source file
+ * @param[in] out The destination file
+ * @param[in] size The size of __in__ (in bytes)
+ * @param[in] png True if __in__ is a PNG, false if it is a JPEG
+ * @param[in] opts Stripping options
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_strip_fd(
+    const int in,
+    const int out,
+    const off_t size,
+    const bool png,
+    const ImcStripOpts_t* const opts
+) {
+    uint8_t hdr[8 + _STRIP_PREFIX_SIZE];
+    off_t pos = png ? 8 : 2, run = 0;
+    size_t len, seg, prefix;
+    StripAction_t action;
+    ImcError_t status = IMC_EOK;
+
+    while (status == IMC_EOK && size - pos >= (png ? 12 : 4)) {
+        status = _imc_strip_pread(in, hdr, png ? 8 : 4, pos);
+        if (status != IMC_EOK) {
+            break;
+        }
+
+        if (png) {
+            len = _imc_strip_u32(hdr);
+            if ((off_t)len > size - pos - 12) {
+                IMC_LOG("PNG chunk runs past the end of the file", IMC_ERROR);
+                return IMC_EOVERFLOW;
+            }
+            seg = len + 12;
+            prefix = (len < _STRIP_PREFIX_SIZE) ? len : _STRIP_PREFIX_SIZE;
+            /* Only the chunks which might be removed have their data peeked at */
+            if (memcmp(hdr + 4, ITXT, 4) == 0) {
+                status = _imc_strip_pread(in, hdr + 8, prefix, pos + 8);
+            }
+            action = _imc_strip_png_action(hdr + 4, hdr + 8, prefix, opts);
+        } else {
+            if (hdr[0] != 0xFF) {
+                IMC_LOG("Expected a JPEG marker", IMC_ERROR);
+                return IMC_EINVAL;
+            }
+            if (hdr[1] == JPEG_SOS || hdr[1] == JPEG_EOI) {
+                break;
+            }
+            if (hdr[1] == 0xFF || hdr[1] == 0x01 || (hdr[1] >= JPEG_RST0 && hdr[1] <= JPEG_RST7)) {
+                pos += (hdr[1] == 0xFF) ? 1 : 2;
+                continue;
+            }
+            len = (size_t)((hdr[2] << 8) | hdr[3]);
+            if (len < 2 || (off_t)len > size - pos - 2) {
+                IMC_LOG("JPEG segment runs past the end of the file", IMC_ERROR);
+                return IMC_EOVERFLOW;
+            }
+            seg = len + 2;
+            prefix = (len - 2 < _STRIP_PREFIX_SIZE) ? len - 2 : _STRIP_PREFIX_SIZE;
+            if (hdr[1] == JPEG_APP1) {
+                status = _imc_strip_pread(in, hdr + 4, prefix, pos + 4);
+            }
+            action = _imc_strip_jpeg_action(hdr[1], hdr + 4, (hdr[1] == JPEG_APP1) ? prefix : 0, opts);
+        }
+
+        if (status == IMC_EOK && action != _STRIP_KEEP) {
+            status = _imc_strip_copy(in, out, run, (size_t)(pos - run));
+            if (status == IMC_EOK && action == _STRIP_EDIT) {
+                status = _imc_strip_edit_fd(in, out, pos, seg, png, opts);
+            }
+            run = pos + (off_t)seg;
+        }
+        pos += (off_t)seg;
+    }
+
+    if (status == IMC_EOK) {
+        status = _imc_strip_copy(in, out, run, (size_t)(size - run));
+    }
+
+    return status;
+}
+
+/*
+ * ===============================
+ *        Public Functions
+ * ===============================
+ */
+
+/**
+ * @brief Returns the default stripping options.
+ * @since 16-10-2026
+ * @returns A ImcStripOpts_t which removes the GPS location and maker note from EXIF data and keeps all else
+ */
+ImcStripOpts_t imc_strip_default_opts(void) {
+    ImcStripOpts_t opts;
+
+    opts.exif = false;
+    opts.gps = true;
+    opts.maker_notes = true;
+    opts.xmp = false;
+    opts.iptc = false;
+    opts.text = false;
+
+    return opts;
+}
+
+/**
+ * @brief Removes metadata from the JPEG or PNG held in memory at __data__, in place.
+ * Dropped segments and chunks are squeezed out by moving what follows them down, and EXIF data
+ * which is edited keeps its size, so nothing is ever allocated and the result is never larger.
+ * The entropy-coded data of a JPEG is moved as one block; the chunks of a PNG which are kept,
+ * IDAT included, keep their bytes and CRCs.
+ * @since 16-10-2026
+ * @param[in,out] data The JPEG or PNG file's contents
+ * @param[in,out] size The size of __data__ (in bytes), reduced to that of the stripped file
+ * @param[in] opts Stripping options or NULL to use imc_strip_default_opts()
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_strip_mem(uint8_t *data, size_t *size, const ImcStripOpts_t* const opts) {
+    ImcStripOpts_t def_opts = imc_strip_default_opts();
+    const ImcStripOpts_t *_opts = (opts != NULL) ? opts : &def_opts;
+
+    if (data == NULL || size == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    if (*size >= 8 && memcmp(data, PNG_MAGIC, 8) == 0) {
+        return _imc_strip_png_mem(data, size, _opts);
+    } else if (*size >= 4 && data[0] == 0xFF && data[1] == JPEG_SOI) {
+        return _imc_strip_jpeg_mem(data, size, _opts);
+    }
+
+    IMC_LOG("Not a JPEG or PNG file", IMC_ERROR);
+    return IMC_EINVAL;
+}
+
+/**
+ * @brief Writes the JPEG or PNG file __src__ to __dst__ with its metadata removed.
+ * Only the marker segments or chunk headers are read (along with the EXIF data when it is
+ * edited); everything between the metadata which changes is copied with copy_file_range().
+ * __dst__ is created or truncated, must not be __src__, and is removed again if an error occurs.
+ * @since 16-10-2026
+ * @param[in] src The path of the JPEG or PNG
+ * @param[in] dst The path of the stripped file
+ * @param[in] opts Stripping options or NULL to use imc_strip_default_opts()
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_strip_file(const char* const src, const char* const dst, const ImcStripOpts_t* const opts) {
+    ImcStripOpts_t def_opts = imc_strip_default_opts();
+    const ImcStripOpts_t *_opts = (opts != NULL) ? opts : &def_opts;
+    struct stat st;
+    uint8_t sig[8];
+    ImcError_t status;
+    int in, out;
+    bool png;
+
+    if (src == NULL || dst == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    in = open(src, O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        IMC_LOG("Failed to open file", IMC_ERROR);
+        return IMC_EFAIL;
+    }
+    if (fstat(in, &st) != 0 || _imc_strip_pread(in, sig, sizeof(sig), 0) != IMC_EOK) {
+        IMC_LOG("Failed to read file", IMC_ERROR);
+        close(in);
+        return IMC_EFAIL;
+    }
+
+    if (memcmp(sig, PNG_MAGIC, 8) == 0) {
+        png = true;
+    } else if (sig[0] == 0xFF && sig[1] == JPEG_SOI) {
+        png = false;
+    } else {
+        IMC_LOG("Not a JPEG or PNG file", IMC_ERROR);
+        close(in);
+        return IMC_EINVAL;
+    }
+
+    out = open(dst, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (out < 0) {
+        IMC_LOG("Failed to create file", IMC_ERROR);
+        close(in);
+        return IMC_EFAIL;
+    }
+
+    status = _imc_strip_fd(in, out, st.st_size, png, _opts);
+
+    if (close(out) != 0 && status == IMC_EOK) {
+        status = IMC_EFAIL;
+    }
+    close(in);
+    if (status != IMC_EOK) {
+        unlink(dst);
+    }
+
+    return status;
+}
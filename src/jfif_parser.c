@@ -1 +1,5434 @@
+/**
+ * @file jfif_parser.c
+ * @author Neil Kingdom
+ * @since 16-10-2026
+ * @version 1.0
+ * @brief Contains the functions necessary for decoding a JPEG into a Pixmap_t and for encoding a
+ * Pixmap_t as a baseline JPEG.
+ *
+ * Sequential and progressive Huffman-coded frames with 8-bit samples are supported. Entropy-coded
+ * data is read through a 64-bit bit reservoir and Huffman codes are resolved with a
+ * table indexed by the next JPEG_HUFF_LOOKAHEAD bits. Each table entry packs the code
+ * length, the decoded symbol and, whenever the additional bits that follow the code
+ * also fit in the lookahead, the sign-extended coefficient value as well, so that most
+ * coefficients cost a single lookup.
+ *
+ * Sequential scans are transformed block by block as they are decoded. Progressive scans refine
+ * one coefficient buffer per component, allocated with the frame, which is only transformed once
+ * the last scan (or, for a preview, the first DC scan of every component) has been decoded.
+ *
+ * The inverse DCT is selected at run-time: AVX2 or SSE2 kernels where the CPU supports them,
+ * otherwise the scalar reference, which the SIMD kernels match exactly. Blocks whose AC
+ * coefficients are all zero skip the transform and are filled with their DC value. Chroma
+ * upsampling and YCbCr to RGB conversion run a row at a time with SSE2, writing straight into
+ * the output pixmap. A sequential frame can also be streamed: its first scan is then decoded a
+ * row of MCUs at a time into small windows onto the planes, and each band of finished rows is
+ * handed to a callback, so memory does not grow with the height of the image. The same windows
+ * feed raw planar output, which copies each component's rows out at its own sampling. A whole
+ * image can instead be rotated or mirrored upright as it is output, following its EXIF
+ * Orientation tag, by placing each band of converted rows straight into its final position.
+ *
+ * The encoder mirrors this a row of MCUs at a time: SSE2 RGB to YCbCr conversion and chroma
+ * downsampling, a forward DCT selected at run-time and quantization by reciprocal multiplication.
+ * It follows libjpeg's integer arithmetic throughout, so its output is identical to libjpeg's.
+ */
+
 #include "jfif_parser.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define _JPEG_X86
+#include <immintrin.h>
+#if defined(__SSE2__)
+/* Part of every x86-64 CPU, so the upsampling and color conversion use it without a run-time check */
+#define _JPEG_SSE2
+#endif
+#endif
+
+/* Number of Huffman tables of each class that a scan may select from */
+#define _JPEG_N_TABLES 4
+
+/* Flag of a Huffman lookup entry whose additional bits still need to be read */
+#define _JPEG_FAST_RECEIVE 0x20
+
+/* Number of rows converted before they are rotated or mirrored into an auto-oriented pixmap */
+#define _JPEG_ORIENT_ROWS 32
+
+/* True if any byte of the 64-bit word x is 0xFF */
+#define _JPEG_HAS_FF(x) ((~(x) - 0x0101010101010101ULL) & (x) & 0x8080808080808080ULL)
+
+typedef struct {
+    int32_t  fast[1 << JPEG_HUFF_LOOKAHEAD];   /* Packed lookup entries (see _imc_jpeg_build_huff()) */
+    int32_t  maxcode[18];                       /* Largest code of each length (-1 if there are none) */
+    int32_t  valoffset[17];                     /* Added to a code of each length to index symbols */
+    uint8_t  symbols[256];                      /* Symbols in order of increasing code length */
+    bool     is_ac;                             /* True for an AC table, whose symbols are run/size pairs */
+    bool     defined;                           /* True once a DHT segment has defined the table */
+} JpegHuff_t;
+
+typedef struct {
+    uint8_t  id;        /* Component identifier */
+    uint8_t  h;         /* Horizontal sampling factor */
+    uint8_t  v;         /* Vertical sampling factor */
+    uint8_t  tq;        /* Quantization table selector */
+    uint8_t  td;        /* DC Huffman table selector of the current scan */
+    uint8_t  ta;        /* AC Huffman table selector of the current scan */
+    size_t   width;     /* Width of the component (in samples) */
+    size_t   height;    /* Height of the component (in samples) */
+    size_t   bw;        /* Number of blocks per row (padded to a whole number of MCUs) */
+    size_t   bh;        /* Number of rows of blocks (padded to a whole number of MCUs) */
+    uint8_t  bs;        /* Width and height of each decoded block (8 divided by its DCT scaling) */
+    size_t   stride;    /* Length of a row of the plane (in bytes) */
+    uint8_t *plane;     /* Decoded samples */
+    size_t   row0;      /* First row of the plane held in memory (non-zero only while streaming) */
+    int16_t *coefs;     /* Quantized coefficients of every block in natural order (progressive only, DC only when decoding DC only) */
+    bool     has_dc;    /* True once a scan has coded the DC coefficients (progressive only) */
+    bool     skip;      /* True if the component's blocks are parsed but never decoded (the chroma of a luma-only decode) */
+} JpegComp_t;
+
+typedef struct {
+    const uint8_t *pos;         /* Next byte of entropy-coded data */
+    const uint8_t *end;         /* End of the JPEG */
+    uint64_t       bitbuf;      /* Bit reservoir (left-justified) */
+    int            bitcount;    /* Number of valid bits in bitbuf */
+    uint8_t        marker;      /* Marker which ended the entropy-coded segment (0 if none has been seen) */
+} JpegBits_t;
+
+typedef struct {
+    JpegComp_t *comps[JPEG_MAX_COMPONENTS];     /* Components of the scan in the order they are interleaved */
+    idct_func   idct[JPEG_MAX_COMPONENTS];      /* Inverse DCT of each component's blocks */
+    uint8_t     n_comps;                        /* Number of components in the scan */
+    size_t      n_mcux;                         /* Number of MCUs per row */
+    size_t      n_mcuy;                         /* Number of rows of MCUs */
+    uint8_t     ss;                             /* First coefficient of the spectral band (zig-zag order) */
+    uint8_t     se;                             /* Last coefficient of the spectral band (zig-zag order) */
+    uint8_t     ah;                             /* Point transform of the previous pass over the band (0 if first) */
+    uint8_t     al;                             /* Point transform of this pass */
+} JpegScan_t;
+
+typedef struct {
+    const uint8_t *data;                            /* Start of the JPEG */
+    const uint8_t *end;                             /* End of the JPEG */
+    const uint8_t *pos;                             /* Current parse position */
+    size_t         width;                           /* Width of the image (in pixels) */
+    size_t         height;                          /* Height of the image (in pixels) */
+    uint8_t        block_size;                      /* Size of a decoded block of the most sampled component */
+    size_t         out_width;                       /* Width of the decoded image (in pixels) */
+    size_t         out_height;                      /* Height of the decoded image (in pixels) */
+    uint8_t        n_comps;                         /* Number of components in the frame */
+    JpegComp_t     comps[JPEG_MAX_COMPONENTS];      /* Components of the frame */
+    uint8_t        hmax;                            /* Largest horizontal sampling factor */
+    uint8_t        vmax;                            /* Largest vertical sampling factor */
+    size_t         mcux;                            /* Number of MCUs per row of an interleaved scan */
+    size_t         mcuy;                            /* Number of rows of MCUs of an interleaved scan */
+    bool           has_frame;                       /* True once the SOF segment has been read */
+    bool           progressive;                     /* True if the frame is progressive (SOF2) */
+    bool           preview;                         /* True to stop once every component has a DC scan */
+    bool           dc_only;                         /* True to decode only the DC coefficient of every block */
+    bool           luma_only;                       /* True to decode only the luma of YCbCr frames */
+    bool           raw;                             /* True to decode every component at its own sampling, for output as planes */
+    bool           header_only;                     /* True to stop reading once the frame header has been read */
+    bool           coefs_only;                      /* True to keep every frame's coefficients instead of decoding samples */
+    bool           stream;                          /* True to leave the first scan of a sequential frame to be streamed if it holds every component */
+    JpegTransform_t orient;                         /* Rotation or mirroring applied as rows are output (from the EXIF Orientation tag) */
+    JpegScan_t     scan;                            /* The scan left to be streamed (n_comps is 0 if there is none) */
+    size_t         n_scans;                         /* Number of scans decoded */
+    uint16_t       qt[_JPEG_N_TABLES][64];          /* Quantization tables (natural order) */
+    bool           qt_defined[_JPEG_N_TABLES];      /* True for each quantization table defined */
+    JpegHuff_t     dc_huff[_JPEG_N_TABLES];         /* DC Huffman tables */
+    JpegHuff_t     ac_huff[_JPEG_N_TABLES];         /* AC Huffman tables */
+    uint16_t       restart_interval;                /* Number of MCUs between restart markers (0 if unused) */
+    int            adobe_transform;                 /* Color transform of the Adobe segment (-1 if absent) */
+    idct_func      idct;                            /* Inverse DCT of blocks with AC coefficients */
+    bool           simd;                            /* True to upsample and convert colors with SIMD */
+    bool           fancy;                           /* True to upsample chroma by interpolation */
+    size_t         n_threads;                       /* Number of threads decoding restart intervals */
+} JpegDecoder_t;
+
+typedef struct {
+    const JpegDecoder_t *dec;           /* The decoder */
+    const JpegScan_t    *scan;          /* The scan being decoded */
+    const uint8_t      **starts;        /* Start of each restart interval's entropy-coded data */
+    size_t               n_intervals;   /* Number of restart intervals */
+    size_t               n_mcus;        /* Number of MCUs in the scan */
+    size_t               next;          /* Index of the next interval to be claimed by a worker */
+    ImcError_t           status;        /* First error reported by a worker */
+    pthread_mutex_t      lock;          /* Guards next and status */
+} JpegIntervalJob_t;
+
+typedef struct {
+    uint16_t code[256];     /* Code of each symbol */
+    uint8_t  size[256];     /* Length of each symbol's code (0 if it has none) */
+    uint8_t  bits[16];      /* Number of codes of each length (1-16 bits) */
+    uint8_t  vals[256];     /* Symbols in order of increasing code length */
+    uint16_t n_vals;        /* Number of symbols */
+} JpegHuffEnc_t;
+
+typedef struct {
+    uint8_t  h;         /* Horizontal sampling factor */
+    uint8_t  v;         /* Vertical sampling factor */
+    uint8_t  id;        /* Component identifier */
+    uint8_t  tq;        /* Quantization table selector */
+    uint8_t  th;        /* Huffman table selector (0 or 1) */
+    size_t   bw;        /* Number of blocks per row (padded to a whole number of MCUs) */
+    size_t   real_bw;   /* Number of blocks per row which hold part of the image */
+    size_t   real_bh;   /* Number of rows of blocks which hold part of the image */
+    size_t   stride;    /* Length of a row of the plane (in bytes) */
+    uint8_t *plane;     /* Samples of the current row of MCUs */
+    int16_t *coefs;     /* Quantized coefficients of the current row of MCUs (every row if optimizing) */
+    int      dc_pred;   /* DC coefficient of the previous block coded */
+} JpegEncComp_t;
+
+typedef struct {
+    const JpegSink_t *sink;         /* Receives the encoded bytes */
+    uint8_t           buf[65536];   /* Output not yet passed to the sink */
+    size_t            len;          /* Number of bytes in buf */
+    uint64_t          acc;          /* Bits not yet written (right-justified) */
+    int               n_bits;       /* Number of valid bits in acc */
+    ImcError_t        status;       /* First error returned by the sink (sticky) */
+} JpegWriter_t;
+
+typedef struct {
+    const Pixmap_t *pixmap;                             /* The pixmap being encoded */
+    size_t          width;                              /* Width of the image (in pixels) */
+    size_t          height;                             /* Height of the image (in pixels) */
+    uint8_t         n_comps;                            /* Number of components in the frame */
+    JpegEncComp_t   comps[JPEG_MAX_COMPONENTS];        /* Components of the frame */
+    uint8_t         hmax;                               /* Largest horizontal sampling factor */
+    uint8_t         vmax;                               /* Largest vertical sampling factor */
+    size_t          mcux;                               /* Number of MCUs per row */
+    size_t          mcuy;                               /* Number of rows of MCUs */
+    const uint8_t  *src;                                /* JPEG whose APPn and COM segments replace the JFIF segment (NULL if none) */
+    size_t          src_size;                           /* Size of src (in bytes) */
+    uint8_t        *chroma;                             /* Full resolution chroma rows (subsampled frames only) */
+    uint16_t        qt[_JPEG_N_TABLES][64];             /* Quantization tables (natural order) */
+    uint16_t        divisors[2][256];                   /* Reciprocals of the quantization tables (see _imc_jpeg_reciprocals()) */
+    JpegHuffEnc_t   dc_huff[2];                         /* DC Huffman tables */
+    JpegHuffEnc_t   ac_huff[2];                         /* AC Huffman tables */
+    size_t          dc_freq[2][256];                    /* Frequencies of the DC symbols (optimizing only) */
+    size_t          ac_freq[2][256];                    /* Frequencies of the AC symbols (optimizing only) */
+    fdct_func       fdct;                               /* Forward DCT */
+    bool            optimize;                           /* True to write optimal Huffman tables */
+    bool            simd;                               /* True to convert and downsample with SIMD */
+    JpegWriter_t    writer;                             /* Output of the encoder */
+} JpegEncoder_t;
+
+typedef struct {
+    uint8_t *data;      /* Encoded JPEG */
+    size_t   size;      /* Number of bytes written */
+    size_t   capacity;  /* Number of bytes allocated */
+} JpegMemBuf_t;
+
+/*
+ * Position in natural (row-major) order of each coefficient in zig-zag order. The trailing
+ * entries absorb runs which overshoot the end of a corrupt block.
+ */
+static const uint8_t _jpeg_natural_order[64 + 16] = {
+     0,  1,  8, 16,  9,  2,  3, 10,
+    17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34,
+    27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36,
+    29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46,
+    53, 60, 61, 54, 47, 55, 62, 63,
+    63, 63, 63, 63, 63, 63, 63, 63,
+    63, 63, 63, 63, 63, 63, 63, 63
+};
+
+/* Quantization tables of ITU T.81 Annex K.1 in natural order, scaled by the encoder's quality */
+static const uint8_t _jpeg_std_luma_qt[64] = {
+    16,  11,  10,  16,  24,  40,  51,  61,
+    12,  12,  14,  19,  26,  58,  60,  55,
+    14,  13,  16,  24,  40,  57,  69,  56,
+    14,  17,  22,  29,  51,  87,  80,  62,
+    18,  22,  37,  56,  68, 109, 103,  77,
+    24,  35,  55,  64,  81, 104, 113,  92,
+    49,  64,  78,  87, 103, 121, 120, 101,
+    72,  92,  95,  98, 112, 100, 103,  99
+};
+
+static const uint8_t _jpeg_std_chroma_qt[64] = {
+    17,  18,  24,  47,  99,  99,  99,  99,
+    18,  21,  26,  66,  99,  99,  99,  99,
+    24,  26,  56,  99,  99,  99,  99,  99,
+    47,  66,  99,  99,  99,  99,  99,  99,
+    99,  99,  99,  99,  99,  99,  99,  99,
+    99,  99,  99,  99,  99,  99,  99,  99,
+    99,  99,  99,  99,  99,  99,  99,  99,
+    99,  99,  99,  99,  99,  99,  99,  99
+};
+
+/* Huffman tables of ITU T.81 Annex K.3, used unless the encoder optimizes its own */
+
+static const uint8_t _jpeg_dc_luma_bits[16] = {
+    0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0
+};
+
+static const uint8_t _jpeg_dc_luma_vals[12] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b
+};
+
+static const uint8_t _jpeg_dc_chroma_bits[16] = {
+    0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0
+};
+
+static const uint8_t _jpeg_dc_chroma_vals[12] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b
+};
+
+static const uint8_t _jpeg_ac_luma_bits[16] = {
+    0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 125
+};
+
+static const uint8_t _jpeg_ac_luma_vals[162] = {
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12,
+    0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+    0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08,
+    0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0,
+    0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16,
+    0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59,
+    0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79,
+    0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98,
+    0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+    0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6,
+    0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5,
+    0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4,
+    0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+    0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea,
+    0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+    0xf9, 0xfa
+};
+
+static const uint8_t _jpeg_ac_chroma_bits[16] = {
+    0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 119
+};
+
+static const uint8_t _jpeg_ac_chroma_vals[162] = {
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21,
+    0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+    0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91,
+    0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0,
+    0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34,
+    0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26,
+    0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38,
+    0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+    0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58,
+    0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+    0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78,
+    0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96,
+    0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5,
+    0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4,
+    0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+    0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2,
+    0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda,
+    0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9,
+    0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+    0xf9, 0xfa
+};
+
+/*
+ * ===============================
+ *       Private Functions
+ * ===============================
+ */
+
+/**
+ * @brief Reads a big-endian 16-bit value from __buf__.
+ * @since 16-10-2026
+ * @param[in] buf The location of at least 2 bytes
+ * @returns The value stored at __buf__
+ */
+static inline uint16_t _imc_jpeg_u16(const uint8_t* const buf) {
+    return (uint16_t)((buf[0] << 8) | buf[1]);
+}
+
+/**
+ * @brief Clamps __x__ to the range of an 8-bit sample.
+ * @since 16-10-2026
+ * @param[in] x The value to be clamped
+ * @returns __x__ limited to 0-255
+ */
+static inline uint8_t _imc_jpeg_clamp(const int x) {
+    return (x < 0) ? 0 : ((x > 255) ? 255 : (uint8_t)x);
+}
+
+/**
+ * @brief Extends the __s__ additional bits __v__ of a coefficient to its signed value.
+ * @since 16-10-2026
+ * @param[in] v The additional bits
+ * @param[in] s The number of additional bits (1-15)
+ * @returns The coefficient value
+ */
+static inline int _imc_jpeg_extend(const int v, const int s) {
+    return (v < (1 << (s - 1))) ? v - (1 << s) + 1 : v;
+}
+
+/**
+ * @brief Tops up the bit reservoir of __br__ to at least 57 bits.
+ * Stuffed zero bytes are dropped. Once a marker is reached it is left unread, its code is
+ * recorded and the reservoir is padded with zeros, as is the case once the data runs out.
+ * @since 16-10-2026
+ * @param[in,out] br The bit reader
+ */
+static inline void _imc_jpeg_fill(JpegBits_t *br) {
+    uint64_t word;
+    int n;
+
+    /* Take as many whole bytes as fit when none of the next 8 can begin a marker */
+    if (!br->marker && br->end - br->pos >= 8) {
+        word = ((uint64_t)br->pos[0] << 56) | ((uint64_t)br->pos[1] << 48)
+             | ((uint64_t)br->pos[2] << 40) | ((uint64_t)br->pos[3] << 32)
+             | ((uint64_t)br->pos[4] << 24) | ((uint64_t)br->pos[5] << 16)
+             | ((uint64_t)br->pos[6] <<  8) | ((uint64_t)br->pos[7] <<  0);
+        if (!_JPEG_HAS_FF(word)) {
+            n = (64 - br->bitcount) >> 3;
+            if (n < 8) {
+                word &= ~0ULL << ((8 - n) << 3);
+            }
+            br->bitbuf |= word >> br->bitcount;
+            br->bitcount += n << 3;
+            br->pos += n;
+            return;
+        }
+    }
+
+    while (br->bitcount <= 56) {
+        uint32_t byte = 0;
+
+        if (!br->marker && br->pos < br->end) {
+            byte = *br->pos;
+            if (byte != 0xFF) {
+                br->pos++;
+            } else if (br->pos + 1 >= br->end) {
+                br->marker = JPEG_EOI;
+                byte = 0;
+            } else if (br->pos[1] == 0x00) {
+                br->pos += 2;
+            } else if (br->pos[1] == 0xFF) {
+                /* Fill byte ahead of a marker */
+                br->pos++;
+                continue;
+            } else {
+                br->marker = br->pos[1];
+                byte = 0;
+            }
+        }
+
+        br->bitbuf |= (uint64_t)byte << (56 - br->bitcount);
+        br->bitcount += 8;
+    }
+}
+
+/**
+ * @brief Returns the next __n__ bits of __br__ without consuming them.
+ * @since 16-10-2026
+ * @param[in] br The bit reader
+ * @param[in] n The number of bits (1-32)
+ * @returns The bits as an unsigned integer
+ */
+static inline uint32_t _imc_jpeg_peek(const JpegBits_t* const br, const int n) {
+    return (uint32_t)(br->bitbuf >> (64 - n));
+}
+
+/**
+ * @brief Consumes __n__ bits of __br__.
+ * @since 16-10-2026
+ * @param[in,out] br The bit reader
+ * @param[in] n The number of bits (0-32)
+ */
+static inline void _imc_jpeg_skip(JpegBits_t *br, const int n) {
+    br->bitbuf <<= n;
+    br->bitcount -= n;
+}
+
+/**
+ * @brief Reads __s__ additional bits from __br__ and extends them to a coefficient value.
+ * @since 16-10-2026
+ * @param[in,out] br The bit reader
+ * @param[in] s The number of additional bits (1-15)
+ * @returns The coefficient value
+ */
+static inline int _imc_jpeg_receive(JpegBits_t *br, const int s) {
+    int v = (int)_imc_jpeg_peek(br, s);
+
+    _imc_jpeg_skip(br, s);
+    return _imc_jpeg_extend(v, s);
+}
+
+/**
+ * @brief Reads __n__ raw bits from __br__, topping up the reservoir first if needed.
+ * @since 16-10-2026
+ * @param[in,out] br The bit reader
+ * @param[in] n The number of bits (1-16)
+ * @returns The bits as an unsigned integer
+ */
+static inline uint32_t _imc_jpeg_get_bits(JpegBits_t *br, const int n) {
+    uint32_t v;
+
+    if (br->bitcount < n) {
+        _imc_jpeg_fill(br);
+    }
+    v = _imc_jpeg_peek(br, n);
+    _imc_jpeg_skip(br, n);
+
+    return v;
+}
+
+/**
+ * @brief Builds the lookup table and canonical code limits of a Huffman table.
+ * Every JPEG_HUFF_LOOKAHEAD-bit prefix of a code no longer than the lookahead maps onto an entry
+ * holding the number of bits to consume in bits 0-4, the symbol in bits 8-15 and the
+ * coefficient value in bits 16-31. When the additional bits of the symbol do not also fit in
+ * the prefix, only the code is consumed and _JPEG_FAST_RECEIVE is set. Prefixes of longer codes
+ * map onto 0 and are resolved one length at a time.
+ * @since 16-10-2026
+ * @param[out] huff The Huffman table
+ * @param[in] counts The number of codes of each length (1-16)
+ * @param[in] symbols The symbols in order of increasing code length
+ * @param[in] is_ac True if the table codes AC run/size symbols rather than DC sizes
+ * @returns IMC_EINVAL if the code lengths are over-subscribed, otherwise IMC_EOK
+ */
+static ImcError_t _imc_jpeg_build_huff(
+    JpegHuff_t *huff,
+    const uint8_t* const counts,
+    const uint8_t* const symbols,
+    const bool is_ac
+) {
+    int len, i, s, k = 0;
+    uint32_t code = 0, idx, span, extra;
+    int32_t val;
+    uint8_t sym;
+
+    memset((void*)huff->fast, 0, sizeof(huff->fast));
+
+    for (len = 1; len <= 16; ++len) {
+        huff->valoffset[len] = k - (int32_t)code;
+        for (i = 0; i < counts[len - 1]; ++i, ++k, ++code) {
+            sym = symbols[k];
+            huff->symbols[k] = sym;
+            if (len > JPEG_HUFF_LOOKAHEAD) {
+                continue;
+            }
+
+            s = is_ac ? (sym & 0x0F) : sym;
+            span = 1u << (JPEG_HUFF_LOOKAHEAD - len);
+            for (idx = code << (JPEG_HUFF_LOOKAHEAD - len); span > 0; ++idx, --span) {
+                if (s == 0) {
+                    huff->fast[idx] = len | (sym << 8);
+                } else if (len + s <= JPEG_HUFF_LOOKAHEAD) {
+                    extra = (idx >> (JPEG_HUFF_LOOKAHEAD - len - s)) & ((1u << s) - 1);
+                    val = _imc_jpeg_extend((int)extra, s);
+                    huff->fast[idx] = (int32_t)((uint32_t)val << 16) | (sym << 8) | (len + s);
+                } else {
+                    huff->fast[idx] = len | _JPEG_FAST_RECEIVE | (sym << 8);
+                }
+            }
+        }
+        huff->maxcode[len] = (counts[len - 1] > 0) ? (int32_t)code - 1 : -1;
+        if (code > (1u << len)) {
+            IMC_LOG("Huffman code lengths are over-subscribed", IMC_ERROR);
+            return IMC_EINVAL;
+        }
+        code <<= 1;
+    }
+    huff->maxcode[17] = INT32_MAX;
+    huff->is_ac = is_ac;
+    huff->defined = true;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Decodes a symbol whose code is longer than the lookahead.
+ * @since 16-10-2026
+ * @param[in,out] br The bit reader (holding at least 16 bits)
+ * @param[in] huff The Huffman table
+ * @returns The symbol or -1 if the bits do not form a code
+ */
+static int _imc_jpeg_huff_slow(JpegBits_t *br, const JpegHuff_t* const huff) {
+    int len;
+    int32_t code;
+
+    for (len = JPEG_HUFF_LOOKAHEAD + 1; len <= 16; ++len) {
+        code = (int32_t)_imc_jpeg_peek(br, len);
+        if (code <= huff->maxcode[len]) {
+            _imc_jpeg_skip(br, len);
+            return huff->symbols[code + huff->valoffset[len]];
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Decodes the next symbol of __br__ along with the coefficient value that follows it.
+ * @since 16-10-2026
+ * @param[in,out] br The bit reader
+ * @param[in] huff The Huffman table
+ * @param[out] val The coefficient value (0 for symbols without additional bits)
+ * @returns The symbol or -1 if the data is corrupt
+ */
+static inline int _imc_jpeg_decode_symbol(JpegBits_t *br, const JpegHuff_t* const huff, int *val) {
+    int32_t entry;
+    int sym, s;
+
+    if (br->bitcount < 32) {
+        _imc_jpeg_fill(br);
+    }
+
+    entry = huff->fast[_imc_jpeg_peek(br, JPEG_HUFF_LOOKAHEAD)];
+    if (entry != 0) {
+        _imc_jpeg_skip(br, entry & 0x1F);
+        sym = (entry >> 8) & 0xFF;
+        if (!(entry & _JPEG_FAST_RECEIVE)) {
+            *val = entry >> 16;
+            return sym;
+        }
+    } else {
+        sym = _imc_jpeg_huff_slow(br, huff);
+        if (sym < 0) {
+            return -1;
+        }
+    }
+
+    s = huff->is_ac ? (sym & 0x0F) : sym;
+    *val = (s > 0) ? _imc_jpeg_receive(br, s) : 0;
+
+    return sym;
+}
+
+/**
+ * @brief Decodes the coefficients of a single block.
+ * @since 16-10-2026
+ * @param[in,out] br The bit reader
+ * @param[in] dc The DC Huffman table
+ * @param[in] ac The AC Huffman table
+ * @param[in,out] dc_pred The DC predictor of the block's component
+ * @param[out] coefs The quantized coefficients in natural order (must be zeroed beforehand)
+ * @param[out] last The zig-zag index of the last coefficient decoded (0 if the block is DC only)
+ * @returns IMC_EFAIL if the data is corrupt, otherwise IMC_EOK
+ */
+static ImcError_t _imc_jpeg_decode_block(
+    JpegBits_t *br,
+    const JpegHuff_t* const dc,
+    const JpegHuff_t* const ac,
+    int *dc_pred,
+    int16_t *coefs,
+    int *last
+) {
+    int k, sym, val;
+
+    if (_imc_jpeg_decode_symbol(br, dc, &val) < 0) {
+        return IMC_EFAIL;
+    }
+    *dc_pred += val;
+    coefs[0] = (int16_t)*dc_pred;
+    *last = 0;
+
+    for (k = 1; k < 64; ++k) {
+        sym = _imc_jpeg_decode_symbol(br, ac, &val);
+        if (sym < 0) {
+            return IMC_EFAIL;
+        } else if ((sym & 0x0F) == 0) {
+            if (sym != 0xF0) {
+                break;
+            }
+            k += 15;
+            continue;
+        }
+
+        k += sym >> 4;
+        coefs[_jpeg_natural_order[k]] = (int16_t)val;
+        *last = k;
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Decodes the DC coefficient of a single block and skips over its AC coefficients.
+ * The AC symbols are still decoded to find the end of the block, but their additional bits are
+ * skipped without being extended and nothing is stored.
+ * @since 16-10-2026
+ * @param[in,out] br The bit reader
+ * @param[in] dc The DC Huffman table
+ * @param[in] ac The AC Huffman table
+ * @param[in,out] dc_pred The DC predictor of the block's component, which becomes its DC coefficient
+ * @returns IMC_EFAIL if the data is corrupt, otherwise IMC_EOK
+ */
+static ImcError_t _imc_jpeg_decode_dc_only(
+    JpegBits_t *br,
+    const JpegHuff_t* const dc,
+    const JpegHuff_t* const ac,
+    int *dc_pred
+) {
+    int32_t entry;
+    int k, sym, val;
+
+    if (_imc_jpeg_decode_symbol(br, dc, &val) < 0) {
+        return IMC_EFAIL;
+    }
+    *dc_pred += val;
+
+    for (k = 1; k < 64; ++k) {
+        if (br->bitcount < 32) {
+            _imc_jpeg_fill(br);
+        }
+
+        /* Entries without _JPEG_FAST_RECEIVE already count the additional bits in their length */
+        entry = ac->fast[_imc_jpeg_peek(br, JPEG_HUFF_LOOKAHEAD)];
+        if (entry != 0) {
+            _imc_jpeg_skip(br, entry & 0x1F);
+            sym = (entry >> 8) & 0xFF;
+            if (entry & _JPEG_FAST_RECEIVE) {
+                _imc_jpeg_skip(br, sym & 0x0F);
+            }
+        } else {
+            sym = _imc_jpeg_huff_slow(br, ac);
+            if (sym < 0) {
+                return IMC_EFAIL;
+            }
+            _imc_jpeg_skip(br, sym & 0x0F);
+        }
+
+        if ((sym & 0x0F) == 0) {
+            if (sym != 0xF0) {
+                break;
+            }
+            k += 15;
+        } else {
+            k += sym >> 4;
+        }
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Decodes the DC coefficient of a block in a progressive DC scan.
+ * The first scan codes the DC difference scaled down by __al__ bits, and each refinement scan
+ * adds the next bit.
+ * @since 16-10-2026
+ * @param[in,out] br The bit reader
+ * @param[in] dc The DC Huffman table (unused by refinement scans)
+ * @param[in] scan The scan
+ * @param[in,out] dc_pred The DC predictor of the block's component
+ * @param[in,out] coefs The block's coefficients in natural order
+ * @returns IMC_EFAIL if the data is corrupt, otherwise IMC_EOK
+ */
+static ImcError_t _imc_jpeg_decode_dc_prog(
+    JpegBits_t *br,
+    const JpegHuff_t* const dc,
+    const JpegScan_t* const scan,
+    int *dc_pred,
+    int16_t *coefs
+) {
+    int val;
+
+    if (scan->ah != 0) {
+        if (_imc_jpeg_get_bits(br, 1)) {
+            coefs[0] |= (int16_t)(1 << scan->al);
+        }
+        return IMC_EOK;
+    }
+
+    if (_imc_jpeg_decode_symbol(br, dc, &val) < 0) {
+        return IMC_EFAIL;
+    }
+    *dc_pred += val;
+    coefs[0] = (int16_t)(*dc_pred * (1 << scan->al));
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Decodes the first pass over the spectral band of a block in a progressive AC scan.
+ * An end-of-band run covers this and the next __eobrun__ blocks, which then have nothing coded.
+ * @since 16-10-2026
+ * @param[in,out] br The bit reader
+ * @param[in] ac The AC Huffman table
+ * @param[in] scan The scan
+ * @param[in,out] eobrun The number of blocks remaining in the current end-of-band run
+ * @param[in,out] coefs The block's coefficients in natural order
+ * @returns IMC_EFAIL if the data is corrupt, otherwise IMC_EOK
+ */
+static ImcError_t _imc_jpeg_decode_ac_first(
+    JpegBits_t *br,
+    const JpegHuff_t* const ac,
+    const JpegScan_t* const scan,
+    uint32_t *eobrun,
+    int16_t *coefs
+) {
+    int k, r, sym, val;
+
+    if (*eobrun > 0) {
+        (*eobrun)--;
+        return IMC_EOK;
+    }
+
+    for (k = scan->ss; k <= scan->se; ++k) {
+        sym = _imc_jpeg_decode_symbol(br, ac, &val);
+        if (sym < 0) {
+            return IMC_EFAIL;
+        }
+
+        r = sym >> 4;
+        if ((sym & 0x0F) != 0) {
+            k += r;
+            coefs[_jpeg_natural_order[k]] = (int16_t)(val * (1 << scan->al));
+        } else if (r == 15) {
+            k += 15;
+        } else {
+            *eobrun = (1u << r) - 1;
+            if (r > 0) {
+                *eobrun += _imc_jpeg_get_bits(br, r);
+            }
+            break;
+        }
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Decodes a refinement pass over the spectral band of a block in a progressive AC scan.
+ * Every coefficient which is already nonzero receives a correction bit, whether it lies in a
+ * run of zeros being skipped or in an end-of-band run, and newly nonzero coefficients are
+ * +/-1 at this pass's point transform. This is the procedure of ITU T.81 G.1.2.3.
+ * @since 16-10-2026
+ * @param[in,out] br The bit reader
+ * @param[in] ac The AC Huffman table
+ * @param[in] scan The scan
+ * @param[in,out] eobrun The number of blocks remaining in the current end-of-band run
+ * @param[in,out] coefs The block's coefficients in natural order
+ * @returns IMC_EFAIL if the data is corrupt, otherwise IMC_EOK
+ */
+static ImcError_t _imc_jpeg_decode_ac_refine(
+    JpegBits_t *br,
+    const JpegHuff_t* const ac,
+    const JpegScan_t* const scan,
+    uint32_t *eobrun,
+    int16_t *coefs
+) {
+    int k = scan->ss, r, sym, val;
+    int p1 = 1 << scan->al, m1 = -p1;
+    int16_t *coef;
+
+    for (; *eobrun == 0 && k <= scan->se; ++k) {
+        sym = _imc_jpeg_decode_symbol(br, ac, &val);
+        if (sym < 0) {
+            return IMC_EFAIL;
+        }
+
+        r = sym >> 4;
+        if ((sym & 0x0F) != 0) {
+            /* The single additional bit is the sign of the new coefficient */
+            val = (val > 0) ? p1 : m1;
+        } else if (r != 15) {
+            *eobrun = 1u << r;
+            if (r > 0) {
+                *eobrun += _imc_jpeg_get_bits(br, r);
+            }
+            break;
+        }
+
+        /* Skip r zero coefficients, correcting the nonzero ones passed on the way */
+        for (; k <= scan->se; ++k) {
+            coef = &coefs[_jpeg_natural_order[k]];
+            if (*coef != 0) {
+                if (_imc_jpeg_get_bits(br, 1) && (*coef & p1) == 0) {
+                    *coef = (int16_t)(*coef + ((*coef >= 0) ? p1 : m1));
+                }
+            } else if (--r < 0) {
+                break;
+            }
+        }
+
+        if ((sym & 0x0F) != 0) {
+            coefs[_jpeg_natural_order[k]] = (int16_t)val;
+        }
+    }
+
+    if (*eobrun > 0) {
+        for (; k <= scan->se; ++k) {
+            coef = &coefs[_jpeg_natural_order[k]];
+            if (*coef != 0 && _imc_jpeg_get_bits(br, 1) && (*coef & p1) == 0) {
+                *coef = (int16_t)(*coef + ((*coef >= 0) ? p1 : m1));
+            }
+        }
+        (*eobrun)--;
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Dequantizes a block and computes its inverse DCT.
+ * This is the accurate integer algorithm of Loeffler, Ligtenberg and Moschytz (as used by
+ * the IJG's jidctint.c), with 13 bits of fixed-point precision and 2 extra bits carried
+ * between the column and row passes.
+ * @since 16-10-2026
+ * @param[in] coefs The quantized coefficients in natural order
+ * @param[in] qt The quantization table in natural order
+ * @param[out] out The top-left sample of the 8x8 output block
+ * @param[in] stride The distance between rows of __out__ (in bytes)
+ */
+static void _imc_jpeg_idct_islow(
+    const int16_t* const coefs,
+    const uint16_t* const qt,
+    uint8_t *out,
+    const size_t stride
+) {
+    int32_t tmp0, tmp1, tmp2, tmp3, tmp10, tmp11, tmp12, tmp13;
+    int32_t z1, z2, z3, z4, z5;
+    int32_t ws[64];
+    const int16_t *in;
+    const uint16_t *q;
+    int32_t *w;
+    int i;
+
+    /* Columns: dequantize and descale by 11 bits, keeping 2 fractional bits */
+    for (i = 0, in = coefs, q = qt, w = ws; i < 8; ++i, ++in, ++q, ++w) {
+        if ((in[8] | in[16] | in[24] | in[32] | in[40] | in[48] | in[56]) == 0) {
+            tmp0 = in[0] * q[0] * 4;
+            w[0] = w[8] = w[16] = w[24] = w[32] = w[40] = w[48] = w[56] = tmp0;
+            continue;
+        }
+
+        z2 = in[16] * q[16];
+        z3 = in[48] * q[48];
+        z1 = (z2 + z3) * 4433;
+        tmp2 = z1 - z3 * 15137;
+        tmp3 = z1 + z2 * 6270;
+        z2 = in[0] * q[0];
+        z3 = in[32] * q[32];
+        tmp0 = (z2 + z3) * 8192;
+        tmp1 = (z2 - z3) * 8192;
+        tmp10 = tmp0 + tmp3;
+        tmp13 = tmp0 - tmp3;
+        tmp11 = tmp1 + tmp2;
+        tmp12 = tmp1 - tmp2;
+
+        tmp0 = in[56] * q[56];
+        tmp1 = in[40] * q[40];
+        tmp2 = in[24] * q[24];
+        tmp3 = in[8] * q[8];
+        z1 = tmp0 + tmp3;
+        z2 = tmp1 + tmp2;
+        z3 = tmp0 + tmp2;
+        z4 = tmp1 + tmp3;
+        z5 = (z3 + z4) * 9633;
+        tmp0 *= 2446;
+        tmp1 *= 16819;
+        tmp2 *= 25172;
+        tmp3 *= 12299;
+        z1 *= -7373;
+        z2 *= -20995;
+        z3 = z3 * -16069 + z5;
+        z4 = z4 * -3196 + z5;
+        tmp0 += z1 + z3;
+        tmp1 += z2 + z4;
+        tmp2 += z2 + z3;
+        tmp3 += z1 + z4;
+
+        w[0]  = (tmp10 + tmp3 + (1 << 10)) >> 11;
+        w[56] = (tmp10 - tmp3 + (1 << 10)) >> 11;
+        w[8]  = (tmp11 + tmp2 + (1 << 10)) >> 11;
+        w[48] = (tmp11 - tmp2 + (1 << 10)) >> 11;
+        w[16] = (tmp12 + tmp1 + (1 << 10)) >> 11;
+        w[40] = (tmp12 - tmp1 + (1 << 10)) >> 11;
+        w[24] = (tmp13 + tmp0 + (1 << 10)) >> 11;
+        w[32] = (tmp13 - tmp0 + (1 << 10)) >> 11;
+    }
+
+    /* Rows: descale by 18 bits (including the factor of 8 of the 2D transform) and level shift */
+    for (i = 0, w = ws; i < 8; ++i, w += 8, out += stride) {
+        if ((w[1] | w[2] | w[3] | w[4] | w[5] | w[6] | w[7]) == 0) {
+            memset((void*)out, _imc_jpeg_clamp(((w[0] + (1 << 4)) >> 5) + 128), 8);
+            continue;
+        }
+
+        z2 = w[2];
+        z3 = w[6];
+        z1 = (z2 + z3) * 4433;
+        tmp2 = z1 - z3 * 15137;
+        tmp3 = z1 + z2 * 6270;
+        tmp0 = (w[0] + w[4]) * 8192;
+        tmp1 = (w[0] - w[4]) * 8192;
+        tmp10 = tmp0 + tmp3;
+        tmp13 = tmp0 - tmp3;
+        tmp11 = tmp1 + tmp2;
+        tmp12 = tmp1 - tmp2;
+
+        tmp0 = w[7];
+        tmp1 = w[5];
+        tmp2 = w[3];
+        tmp3 = w[1];
+        z1 = tmp0 + tmp3;
+        z2 = tmp1 + tmp2;
+        z3 = tmp0 + tmp2;
+        z4 = tmp1 + tmp3;
+        z5 = (z3 + z4) * 9633;
+        tmp0 *= 2446;
+        tmp1 *= 16819;
+        tmp2 *= 25172;
+        tmp3 *= 12299;
+        z1 *= -7373;
+        z2 *= -20995;
+        z3 = z3 * -16069 + z5;
+        z4 = z4 * -3196 + z5;
+        tmp0 += z1 + z3;
+        tmp1 += z2 + z4;
+        tmp2 += z2 + z3;
+        tmp3 += z1 + z4;
+
+        out[0] = _imc_jpeg_clamp(((tmp10 + tmp3 + (1 << 17)) >> 18) + 128);
+        out[7] = _imc_jpeg_clamp(((tmp10 - tmp3 + (1 << 17)) >> 18) + 128);
+        out[1] = _imc_jpeg_clamp(((tmp11 + tmp2 + (1 << 17)) >> 18) + 128);
+        out[6] = _imc_jpeg_clamp(((tmp11 - tmp2 + (1 << 17)) >> 18) + 128);
+        out[2] = _imc_jpeg_clamp(((tmp12 + tmp1 + (1 << 17)) >> 18) + 128);
+        out[5] = _imc_jpeg_clamp(((tmp12 - tmp1 + (1 << 17)) >> 18) + 128);
+        out[3] = _imc_jpeg_clamp(((tmp13 + tmp0 + (1 << 17)) >> 18) + 128);
+        out[4] = _imc_jpeg_clamp(((tmp13 - tmp0 + (1 << 17)) >> 18) + 128);
+    }
+}
+
+/**
+ * @brief Dequantizes a block and computes a 4x4 inverse DCT of its low-frequency coefficients.
+ * This is the reduced transform of the IJG's jidctred.c, which yields the block downscaled by 2
+ * directly. Column 4 and row 4 are never read.
+ * @since 16-10-2026
+ * @param[in] coefs The quantized coefficients in natural order
+ * @param[in] qt The quantization table in natural order
+ * @param[out] out The top-left sample of the 4x4 output block
+ * @param[in] stride The distance between rows of __out__ (in bytes)
+ */
+static void _imc_jpeg_idct_4x4(
+    const int16_t* const coefs,
+    const uint16_t* const qt,
+    uint8_t *out,
+    const size_t stride
+) {
+    int32_t tmp0, tmp2, tmp10, tmp12, z1, z2, z3, z4;
+    int32_t ws[32];
+    const int16_t *in;
+    const uint16_t *q;
+    int32_t *w;
+    int i;
+
+    for (i = 0, in = coefs, q = qt, w = ws; i < 8; ++i, ++in, ++q, ++w) {
+        if (i == 4) {
+            continue;
+        } else if ((in[8] | in[16] | in[24] | in[40] | in[48] | in[56]) == 0) {
+            w[0] = w[8] = w[16] = w[24] = in[0] * q[0] * 4;
+            continue;
+        }
+
+        tmp0 = in[0] * q[0] * 16384;
+        tmp2 = in[16] * q[16] * 15137 - in[48] * q[48] * 6270;
+        tmp10 = tmp0 + tmp2;
+        tmp12 = tmp0 - tmp2;
+
+        z1 = in[56] * q[56];
+        z2 = in[40] * q[40];
+        z3 = in[24] * q[24];
+        z4 = in[8] * q[8];
+        tmp0 = z1 * -1730 + z2 * 11893 + z3 * -17799 + z4 * 8697;
+        tmp2 = z1 * -4176 + z2 * -4926 + z3 * 7373 + z4 * 20995;
+
+        w[0]  = (tmp10 + tmp2 + (1 << 11)) >> 12;
+        w[24] = (tmp10 - tmp2 + (1 << 11)) >> 12;
+        w[8]  = (tmp12 + tmp0 + (1 << 11)) >> 12;
+        w[16] = (tmp12 - tmp0 + (1 << 11)) >> 12;
+    }
+
+    for (i = 0, w = ws; i < 4; ++i, w += 8, out += stride) {
+        if ((w[1] | w[2] | w[3] | w[5] | w[6] | w[7]) == 0) {
+            memset((void*)out, _imc_jpeg_clamp(((w[0] + (1 << 4)) >> 5) + 128), 4);
+            continue;
+        }
+
+        tmp0 = w[0] * 16384;
+        tmp2 = w[2] * 15137 - w[6] * 6270;
+        tmp10 = tmp0 + tmp2;
+        tmp12 = tmp0 - tmp2;
+
+        tmp0 = w[7] * -1730 + w[5] * 11893 + w[3] * -17799 + w[1] * 8697;
+        tmp2 = w[7] * -4176 + w[5] * -4926 + w[3] * 7373 + w[1] * 20995;
+
+        out[0] = _imc_jpeg_clamp(((tmp10 + tmp2 + (1 << 18)) >> 19) + 128);
+        out[3] = _imc_jpeg_clamp(((tmp10 - tmp2 + (1 << 18)) >> 19) + 128);
+        out[1] = _imc_jpeg_clamp(((tmp12 + tmp0 + (1 << 18)) >> 19) + 128);
+        out[2] = _imc_jpeg_clamp(((tmp12 - tmp0 + (1 << 18)) >> 19) + 128);
+    }
+}
+
+/**
+ * @brief Dequantizes a block and computes a 2x2 inverse DCT of its low-frequency coefficients.
+ * This is the reduced transform of the IJG's jidctred.c, which yields the block downscaled by 4
+ * directly. Only the odd columns and rows (and the DC terms) contribute.
+ * @since 16-10-2026
+ * @param[in] coefs The quantized coefficients in natural order
+ * @param[in] qt The quantization table in natural order
+ * @param[out] out The top-left sample of the 2x2 output block
+ * @param[in] stride The distance between rows of __out__ (in bytes)
+ */
+static void _imc_jpeg_idct_2x2(
+    const int16_t* const coefs,
+    const uint16_t* const qt,
+    uint8_t *out,
+    const size_t stride
+) {
+    int32_t tmp0, tmp10;
+    int32_t ws[16];
+    const int16_t *in;
+    const uint16_t *q;
+    int32_t *w;
+    int i;
+
+    for (i = 0, in = coefs, q = qt, w = ws; i < 8; ++i, ++in, ++q, ++w) {
+        if (i == 2 || i == 4 || i == 6) {
+            continue;
+        } else if ((in[8] | in[24] | in[40] | in[56]) == 0) {
+            w[0] = w[8] = in[0] * q[0] * 4;
+            continue;
+        }
+
+        tmp10 = in[0] * q[0] * 32768;
+        tmp0 = in[56] * q[56] * -5906 + in[40] * q[40] * 6967
+             + in[24] * q[24] * -10426 + in[8] * q[8] * 29692;
+
+        w[0] = (tmp10 + tmp0 + (1 << 12)) >> 13;
+        w[8] = (tmp10 - tmp0 + (1 << 12)) >> 13;
+    }
+
+    for (i = 0, w = ws; i < 2; ++i, w += 8, out += stride) {
+        if ((w[1] | w[3] | w[5] | w[7]) == 0) {
+            out[0] = out[1] = _imc_jpeg_clamp(((w[0] + (1 << 4)) >> 5) + 128);
+            continue;
+        }
+
+        tmp10 = w[0] * 32768;
+        tmp0 = w[7] * -5906 + w[5] * 6967 + w[3] * -10426 + w[1] * 29692;
+
+        out[0] = _imc_jpeg_clamp(((tmp10 + tmp0 + (1 << 19)) >> 20) + 128);
+        out[1] = _imc_jpeg_clamp(((tmp10 - tmp0 + (1 << 19)) >> 20) + 128);
+    }
+}
+
+/**
+ * @brief Dequantizes a block's DC coefficient and writes the block's average as a single sample,
+ * which is the block downscaled by 8.
+ * @since 16-10-2026
+ * @param[in] coefs The quantized coefficients in natural order
+ * @param[in] qt The quantization table in natural order
+ * @param[out] out The output sample
+ * @param[in] stride Unused
+ */
+static void _imc_jpeg_idct_1x1(
+    const int16_t* const coefs,
+    const uint16_t* const qt,
+    uint8_t *out,
+    const size_t stride
+) {
+    (void)stride;
+    out[0] = _imc_jpeg_clamp(((coefs[0] * qt[0] + 4) >> 3) + 128);
+}
+
+/**
+ * @brief Fills an output block from a block whose AC coefficients are all zero.
+ * The result is identical to that of the full or reduced inverse DCT of such a block.
+ * @since 16-10-2026
+ * @param[in] dc The quantized DC coefficient
+ * @param[in] q The DC quantizer
+ * @param[out] out The top-left sample of the output block
+ * @param[in] stride The distance between rows of __out__ (in bytes)
+ * @param[in] size The width and height of the output block (1, 2, 4 or 8)
+ */
+static void _imc_jpeg_idct_dc(
+    const int16_t dc,
+    const uint16_t q,
+    uint8_t *out,
+    const size_t stride,
+    const uint8_t size
+) {
+    uint8_t val = _imc_jpeg_clamp(((dc * q + 4) >> 3) + 128);
+    uint8_t i;
+
+    for (i = 0; i < size; ++i, out += stride) {
+        memset((void*)out, val, size);
+    }
+}
+
+#if defined(_JPEG_X86)
+
+/* Pairs of fixed-point constants multiplied with interleaved 16-bit operands by pmaddwd */
+#define _JPEG_PAIR(a, b) _mm_set_epi16((b), (a), (b), (a), (b), (a), (b), (a))
+
+/**
+ * @brief Transposes an 8x8 matrix of 16-bit values held one row per register.
+ * @since 16-10-2026
+ * @param[in,out] r The rows of the matrix
+ */
+__attribute__((target("sse2")))
+static inline void _imc_jpeg_transpose_sse2(__m128i *r) {
+    __m128i a0, a1, a2, a3, a4, a5, a6, a7;
+    __m128i b0, b1, b2, b3, b4, b5, b6, b7;
+
+    a0 = _mm_unpacklo_epi16(r[0], r[1]);
+    a1 = _mm_unpackhi_epi16(r[0], r[1]);
+    a2 = _mm_unpacklo_epi16(r[2], r[3]);
+    a3 = _mm_unpackhi_epi16(r[2], r[3]);
+    a4 = _mm_unpacklo_epi16(r[4], r[5]);
+    a5 = _mm_unpackhi_epi16(r[4], r[5]);
+    a6 = _mm_unpacklo_epi16(r[6], r[7]);
+    a7 = _mm_unpackhi_epi16(r[6], r[7]);
+
+    b0 = _mm_unpacklo_epi32(a0, a2);
+    b1 = _mm_unpackhi_epi32(a0, a2);
+    b2 = _mm_unpacklo_epi32(a1, a3);
+    b3 = _mm_unpackhi_epi32(a1, a3);
+    b4 = _mm_unpacklo_epi32(a4, a6);
+    b5 = _mm_unpackhi_epi32(a4, a6);
+    b6 = _mm_unpacklo_epi32(a5, a7);
+    b7 = _mm_unpackhi_epi32(a5, a7);
+
+    r[0] = _mm_unpacklo_epi64(b0, b4);
+    r[1] = _mm_unpackhi_epi64(b0, b4);
+    r[2] = _mm_unpacklo_epi64(b1, b5);
+    r[3] = _mm_unpackhi_epi64(b1, b5);
+    r[4] = _mm_unpacklo_epi64(b2, b6);
+    r[5] = _mm_unpackhi_epi64(b2, b6);
+    r[6] = _mm_unpacklo_epi64(b3, b7);
+    r[7] = _mm_unpackhi_epi64(b3, b7);
+}
+
+/**
+ * @brief Computes the 1D LLM inverse DCT of four of the eight vectors held in __r__.
+ * The operands are interleaved in pairs so that each product of two inputs with two constants is
+ * a single pmaddwd. The results are rounded, shifted right by __shift__ and left as 32-bit values.
+ * @since 16-10-2026
+ * @param[in] r The 16-bit inputs, where r[k] holds the k-th input of eight transforms
+ * @param[in] hi False to transform lanes 0-3, true to transform lanes 4-7
+ * @param[in] bias The rounding term (plus any level shift) added before shifting
+ * @param[in] shift The number of bits to descale by
+ * @param[out] out The 32-bit outputs, where out[k] holds the k-th output of four transforms
+ */
+__attribute__((target("sse2")))
+static inline void _imc_jpeg_idct_half_sse2(
+    const __m128i* const r,
+    const bool hi,
+    const __m128i bias,
+    const int shift,
+    __m128i *out
+) {
+    __m128i p26, p04, p71, p53, p34;
+    __m128i tmp0, tmp1, tmp2, tmp3, tmp10, tmp11, tmp12, tmp13, z3, z4;
+    __m128i z3s = _mm_add_epi16(r[7], r[3]);
+    __m128i z4s = _mm_add_epi16(r[5], r[1]);
+
+    if (hi) {
+        p26 = _mm_unpackhi_epi16(r[2], r[6]);
+        p04 = _mm_unpackhi_epi16(r[0], r[4]);
+        p71 = _mm_unpackhi_epi16(r[7], r[1]);
+        p53 = _mm_unpackhi_epi16(r[5], r[3]);
+        p34 = _mm_unpackhi_epi16(z3s, z4s);
+    } else {
+        p26 = _mm_unpacklo_epi16(r[2], r[6]);
+        p04 = _mm_unpacklo_epi16(r[0], r[4]);
+        p71 = _mm_unpacklo_epi16(r[7], r[1]);
+        p53 = _mm_unpacklo_epi16(r[5], r[3]);
+        p34 = _mm_unpacklo_epi16(z3s, z4s);
+    }
+
+    /* Even part */
+    tmp3 = _mm_madd_epi16(p26, _JPEG_PAIR(4433 + 6270, 4433));
+    tmp2 = _mm_madd_epi16(p26, _JPEG_PAIR(4433, 4433 - 15137));
+    tmp0 = _mm_madd_epi16(p04, _JPEG_PAIR(8192, 8192));
+    tmp1 = _mm_madd_epi16(p04, _JPEG_PAIR(8192, -8192));
+    tmp10 = _mm_add_epi32(tmp0, tmp3);
+    tmp13 = _mm_sub_epi32(tmp0, tmp3);
+    tmp11 = _mm_add_epi32(tmp1, tmp2);
+    tmp12 = _mm_sub_epi32(tmp1, tmp2);
+
+    /* Odd part */
+    z3 = _mm_madd_epi16(p34, _JPEG_PAIR(9633 - 16069, 9633));
+    z4 = _mm_madd_epi16(p34, _JPEG_PAIR(9633, 9633 - 3196));
+    tmp0 = _mm_add_epi32(_mm_madd_epi16(p71, _JPEG_PAIR(2446 - 7373, -7373)), z3);
+    tmp3 = _mm_add_epi32(_mm_madd_epi16(p71, _JPEG_PAIR(-7373, 12299 - 7373)), z4);
+    tmp1 = _mm_add_epi32(_mm_madd_epi16(p53, _JPEG_PAIR(16819 - 20995, -20995)), z4);
+    tmp2 = _mm_add_epi32(_mm_madd_epi16(p53, _JPEG_PAIR(-20995, 25172 - 20995)), z3);
+
+    tmp10 = _mm_add_epi32(tmp10, bias);
+    tmp11 = _mm_add_epi32(tmp11, bias);
+    tmp12 = _mm_add_epi32(tmp12, bias);
+    tmp13 = _mm_add_epi32(tmp13, bias);
+
+    out[0] = _mm_srai_epi32(_mm_add_epi32(tmp10, tmp3), shift);
+    out[7] = _mm_srai_epi32(_mm_sub_epi32(tmp10, tmp3), shift);
+    out[1] = _mm_srai_epi32(_mm_add_epi32(tmp11, tmp2), shift);
+    out[6] = _mm_srai_epi32(_mm_sub_epi32(tmp11, tmp2), shift);
+    out[2] = _mm_srai_epi32(_mm_add_epi32(tmp12, tmp1), shift);
+    out[5] = _mm_srai_epi32(_mm_sub_epi32(tmp12, tmp1), shift);
+    out[3] = _mm_srai_epi32(_mm_add_epi32(tmp13, tmp0), shift);
+    out[4] = _mm_srai_epi32(_mm_sub_epi32(tmp13, tmp0), shift);
+}
+
+/**
+ * @brief SSE2 version of _imc_jpeg_idct_islow().
+ * Dequantization is a 16-bit multiply of each row of coefficients, after which both passes
+ * transform eight columns (then rows) at a time. Intermediate values are narrowed to 16 bits
+ * between passes, which is lossless for any block that is the DCT of 8-bit samples, so the output
+ * matches the scalar version for every block of a valid JPEG.
+ * @since 16-10-2026
+ * @param[in] coefs The quantized coefficients in natural order
+ * @param[in] qt The quantization table in natural order
+ * @param[out] out The top-left sample of the 8x8 output block
+ * @param[in] stride The distance between rows of __out__ (in bytes)
+ */
+__attribute__((target("sse2")))
+static void _imc_jpeg_idct_sse2(
+    const int16_t* const coefs,
+    const uint16_t* const qt,
+    uint8_t *out,
+    const size_t stride
+) {
+    __m128i r[8], lo[8], hi[8], px;
+    int i;
+
+    for (i = 0; i < 8; ++i) {
+        r[i] = _mm_mullo_epi16(
+            _mm_loadu_si128((const __m128i*)(coefs + 8 * i)),
+            _mm_loadu_si128((const __m128i*)(qt + 8 * i))
+        );
+    }
+
+    /* Columns */
+    _imc_jpeg_idct_half_sse2(r, false, _mm_set1_epi32(1 << 10), 11, lo);
+    _imc_jpeg_idct_half_sse2(r, true, _mm_set1_epi32(1 << 10), 11, hi);
+    for (i = 0; i < 8; ++i) {
+        r[i] = _mm_packs_epi32(lo[i], hi[i]);
+    }
+    _imc_jpeg_transpose_sse2(r);
+
+    /* Rows, with the level shift folded into the rounding term */
+    _imc_jpeg_idct_half_sse2(r, false, _mm_set1_epi32((1 << 17) + (128 << 18)), 18, lo);
+    _imc_jpeg_idct_half_sse2(r, true, _mm_set1_epi32((1 << 17) + (128 << 18)), 18, hi);
+    for (i = 0; i < 8; ++i) {
+        r[i] = _mm_packs_epi32(lo[i], hi[i]);
+    }
+    _imc_jpeg_transpose_sse2(r);
+
+    for (i = 0; i < 8; i += 2, out += 2 * stride) {
+        px = _mm_packus_epi16(r[i], r[i + 1]);
+        _mm_storel_epi64((__m128i*)out, px);
+        _mm_storel_epi64((__m128i*)(out + stride), _mm_srli_si128(px, 8));
+    }
+}
+
+/**
+ * @brief Spreads the two 64-bit halves of a row of 8 16-bit values into the low halves of the
+ * two 128-bit lanes, so that lane-wise unpacks interleave whole rows.
+ * @since 16-10-2026
+ * @param[in] row The row
+ * @returns The spread row
+ */
+__attribute__((target("avx2")))
+static inline __m256i _imc_jpeg_spread_avx2(const __m128i row) {
+    return _mm256_permute4x64_epi64(_mm256_castsi128_si256(row), 0x50);
+}
+
+/**
+ * @brief Transposes an 8x8 matrix of 32-bit values held one row per register.
+ * @since 16-10-2026
+ * @param[in,out] r The rows of the matrix
+ */
+__attribute__((target("avx2")))
+static inline void _imc_jpeg_transpose_avx2(__m256i *r) {
+    __m256i a0, a1, a2, a3, a4, a5, a6, a7;
+    __m256i b0, b1, b2, b3, b4, b5, b6, b7;
+
+    a0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    a1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    a2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    a3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    a4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    a5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    a6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    a7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+    b0 = _mm256_unpacklo_epi64(a0, a2);
+    b1 = _mm256_unpackhi_epi64(a0, a2);
+    b2 = _mm256_unpacklo_epi64(a1, a3);
+    b3 = _mm256_unpackhi_epi64(a1, a3);
+    b4 = _mm256_unpacklo_epi64(a4, a6);
+    b5 = _mm256_unpackhi_epi64(a4, a6);
+    b6 = _mm256_unpacklo_epi64(a5, a7);
+    b7 = _mm256_unpackhi_epi64(a5, a7);
+
+    r[0] = _mm256_permute2x128_si256(b0, b4, 0x20);
+    r[1] = _mm256_permute2x128_si256(b1, b5, 0x20);
+    r[2] = _mm256_permute2x128_si256(b2, b6, 0x20);
+    r[3] = _mm256_permute2x128_si256(b3, b7, 0x20);
+    r[4] = _mm256_permute2x128_si256(b0, b4, 0x31);
+    r[5] = _mm256_permute2x128_si256(b1, b5, 0x31);
+    r[6] = _mm256_permute2x128_si256(b2, b6, 0x31);
+    r[7] = _mm256_permute2x128_si256(b3, b7, 0x31);
+}
+
+/**
+ * @brief Computes eight 1D LLM inverse DCTs at once.
+ * The same pmaddwd formulation as _imc_jpeg_idct_half_sse2() is used, but with the inputs spread
+ * by _imc_jpeg_spread_avx2() a single 256-bit multiply-add covers all eight transforms.
+ * @since 16-10-2026
+ * @param[in] r The spread 16-bit inputs, where r[k] holds the k-th input of each transform
+ * @param[in] bias The rounding term (plus any level shift) added before shifting
+ * @param[in] shift The number of bits to descale by
+ * @param[out] out The 32-bit outputs, where out[k] holds the k-th output of each transform
+ */
+__attribute__((target("avx2")))
+static inline void _imc_jpeg_idct_1d_avx2(
+    const __m256i* const r,
+    const __m256i bias,
+    const int shift,
+    __m256i *out
+) {
+    __m256i p26, p04, p71, p53, p34;
+    __m256i tmp0, tmp1, tmp2, tmp3, tmp10, tmp11, tmp12, tmp13, z3, z4;
+
+    p26 = _mm256_unpacklo_epi16(r[2], r[6]);
+    p04 = _mm256_unpacklo_epi16(r[0], r[4]);
+    p71 = _mm256_unpacklo_epi16(r[7], r[1]);
+    p53 = _mm256_unpacklo_epi16(r[5], r[3]);
+    p34 = _mm256_unpacklo_epi16(_mm256_add_epi16(r[7], r[3]), _mm256_add_epi16(r[5], r[1]));
+
+    /* Even part */
+    tmp3 = _mm256_madd_epi16(p26, _mm256_broadcastsi128_si256(_JPEG_PAIR(4433 + 6270, 4433)));
+    tmp2 = _mm256_madd_epi16(p26, _mm256_broadcastsi128_si256(_JPEG_PAIR(4433, 4433 - 15137)));
+    tmp0 = _mm256_madd_epi16(p04, _mm256_broadcastsi128_si256(_JPEG_PAIR(8192, 8192)));
+    tmp1 = _mm256_madd_epi16(p04, _mm256_broadcastsi128_si256(_JPEG_PAIR(8192, -8192)));
+    tmp10 = _mm256_add_epi32(_mm256_add_epi32(tmp0, tmp3), bias);
+    tmp13 = _mm256_add_epi32(_mm256_sub_epi32(tmp0, tmp3), bias);
+    tmp11 = _mm256_add_epi32(_mm256_add_epi32(tmp1, tmp2), bias);
+    tmp12 = _mm256_add_epi32(_mm256_sub_epi32(tmp1, tmp2), bias);
+
+    /* Odd part */
+    z3 = _mm256_madd_epi16(p34, _mm256_broadcastsi128_si256(_JPEG_PAIR(9633 - 16069, 9633)));
+    z4 = _mm256_madd_epi16(p34, _mm256_broadcastsi128_si256(_JPEG_PAIR(9633, 9633 - 3196)));
+    tmp0 = _mm256_add_epi32(_mm256_madd_epi16(p71, _mm256_broadcastsi128_si256(_JPEG_PAIR(2446 - 7373, -7373))), z3);
+    tmp3 = _mm256_add_epi32(_mm256_madd_epi16(p71, _mm256_broadcastsi128_si256(_JPEG_PAIR(-7373, 12299 - 7373))), z4);
+    tmp1 = _mm256_add_epi32(_mm256_madd_epi16(p53, _mm256_broadcastsi128_si256(_JPEG_PAIR(16819 - 20995, -20995))), z4);
+    tmp2 = _mm256_add_epi32(_mm256_madd_epi16(p53, _mm256_broadcastsi128_si256(_JPEG_PAIR(-20995, 25172 - 20995))), z3);
+
+    out[0] = _mm256_srai_epi32(_mm256_add_epi32(tmp10, tmp3), shift);
+    out[7] = _mm256_srai_epi32(_mm256_sub_epi32(tmp10, tmp3), shift);
+    out[1] = _mm256_srai_epi32(_mm256_add_epi32(tmp11, tmp2), shift);
+    out[6] = _mm256_srai_epi32(_mm256_sub_epi32(tmp11, tmp2), shift);
+    out[2] = _mm256_srai_epi32(_mm256_add_epi32(tmp12, tmp1), shift);
+    out[5] = _mm256_srai_epi32(_mm256_sub_epi32(tmp12, tmp1), shift);
+    out[3] = _mm256_srai_epi32(_mm256_add_epi32(tmp13, tmp0), shift);
+    out[4] = _mm256_srai_epi32(_mm256_sub_epi32(tmp13, tmp0), shift);
+}
+
+/**
+ * @brief AVX2 version of _imc_jpeg_idct_islow().
+ * Each pass is a single set of eight-wide transforms whose 32-bit outputs are transposed as they
+ * are, so no intermediate results are narrowed to 16 bits within a pass. The output matches the
+ * SSE2 version exactly.
+ * @since 16-10-2026
+ * @param[in] coefs The quantized coefficients in natural order
+ * @param[in] qt The quantization table in natural order
+ * @param[out] out The top-left sample of the 8x8 output block
+ * @param[in] stride The distance between rows of __out__ (in bytes)
+ */
+__attribute__((target("avx2")))
+static void _imc_jpeg_idct_avx2(
+    const int16_t* const coefs,
+    const uint16_t* const qt,
+    uint8_t *out,
+    const size_t stride
+) {
+    __m256i r[8], w[8], a, b, px;
+    int i;
+
+    for (i = 0; i < 8; ++i) {
+        r[i] = _imc_jpeg_spread_avx2(_mm_mullo_epi16(
+            _mm_loadu_si128((const __m128i*)(coefs + 8 * i)),
+            _mm_loadu_si128((const __m128i*)(qt + 8 * i))
+        ));
+    }
+
+    /* Columns */
+    _imc_jpeg_idct_1d_avx2(r, _mm256_set1_epi32(1 << 10), 11, w);
+    _imc_jpeg_transpose_avx2(w);
+
+    /* Rows, with the level shift folded into the rounding term (packs spreads each row as required) */
+    for (i = 0; i < 8; ++i) {
+        r[i] = _mm256_packs_epi32(w[i], w[i]);
+    }
+    _imc_jpeg_idct_1d_avx2(r, _mm256_set1_epi32((1 << 17) + (128 << 18)), 18, w);
+    _imc_jpeg_transpose_avx2(w);
+
+    for (i = 0; i < 8; i += 4, out += 4 * stride) {
+        a = _mm256_permute4x64_epi64(_mm256_packs_epi32(w[i], w[i + 1]), 0xD8);
+        b = _mm256_permute4x64_epi64(_mm256_packs_epi32(w[i + 2], w[i + 3]), 0xD8);
+        px = _mm256_packus_epi16(a, b);
+        _mm_storel_epi64((__m128i*)out, _mm256_castsi256_si128(px));
+        _mm_storel_epi64((__m128i*)(out + stride), _mm256_extracti128_si256(px, 1));
+        _mm_storel_epi64((__m128i*)(out + 2 * stride), _mm_srli_si128(_mm256_castsi256_si128(px), 8));
+        _mm_storel_epi64((__m128i*)(out + 3 * stride), _mm_srli_si128(_mm256_extracti128_si256(px, 1), 8));
+    }
+}
+
+#endif /* _JPEG_X86 */
+
+/**
+ * @brief Selects the fastest inverse DCT supported by the CPU.
+ * @since 16-10-2026
+ * @param[in] simd False to always select the scalar reference implementation
+ * @returns The inverse DCT function
+ */
+static idct_func _imc_jpeg_select_idct(const bool simd) {
+    idct_func idct = NULL;
+
+    if (simd) {
+        idct = imc_jpeg_idct_kernel(JPEG_IDCT_AVX2);
+        if (idct == NULL) {
+            idct = imc_jpeg_idct_kernel(JPEG_IDCT_SSE2);
+        }
+    }
+
+    return (idct != NULL) ? idct : _imc_jpeg_idct_islow;
+}
+
+/**
+ * @brief Advances __dec__ past the next marker.
+ * Bytes which do not form a marker (such as garbage between segments) are skipped.
+ * @since 16-10-2026
+ * @param[in,out] dec The decoder
+ * @returns The marker code or 0 if the end of the data was reached
+ */
+static uint8_t _imc_jpeg_next_marker(JpegDecoder_t *dec) {
+    uint8_t marker;
+
+    while (dec->pos + 1 < dec->end) {
+        if (dec->pos[0] == 0xFF && dec->pos[1] != 0x00 && dec->pos[1] != 0xFF) {
+            marker = dec->pos[1];
+            dec->pos += 2;
+            return marker;
+        }
+        dec->pos++;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Reads the length field of the segment at the parse position.
+ * On success the parse position is moved past the length field.
+ * @since 16-10-2026
+ * @param[in,out] dec The decoder
+ * @param[out] len The length of the segment's data (excluding the length field)
+ * @returns IMC_EINVAL if the segment is truncated, otherwise IMC_EOK
+ */
+static ImcError_t _imc_jpeg_segment(JpegDecoder_t *dec, size_t *len) {
+    size_t seg_len;
+
+    if (dec->end - dec->pos < 2) {
+        IMC_LOG("Truncated JPEG segment", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    seg_len = _imc_jpeg_u16(dec->pos);
+    if (seg_len < 2 || seg_len > (size_t)(dec->end - dec->pos)) {
+        IMC_LOG("Truncated JPEG segment", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    dec->pos += 2;
+    *len = seg_len - 2;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Reads the quantization tables of a DQT segment.
+ * @since 16-10-2026
+ * @param[in,out] dec The decoder
+ * @param[in] seg The segment's data
+ * @param[in] len The length of the segment's data
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_read_dqt(JpegDecoder_t *dec, const uint8_t *seg, size_t len) {
+    uint8_t pq, tq;
+    size_t i, n;
+
+    while (len > 0) {
+        pq = seg[0] >> 4;
+        tq = seg[0] & 0x0F;
+        n = (pq == 0) ? 65 : 129;
+        if (pq > 1 || tq >= _JPEG_N_TABLES || len < n) {
+            IMC_LOG("Invalid quantization table", IMC_ERROR);
+            return IMC_EINVAL;
+        }
+
+        for (i = 0; i < 64; ++i) {
+            dec->qt[tq][_jpeg_natural_order[i]] = (pq == 0) ? seg[1 + i] : _imc_jpeg_u16(seg + 1 + 2 * i);
+            /* The SIMD kernels dequantize with 16-bit signed multiplies */
+            if (dec->qt[tq][_jpeg_natural_order[i]] > INT16_MAX) {
+                dec->idct = _imc_jpeg_idct_islow;
+            }
+        }
+        dec->qt_defined[tq] = true;
+
+        seg += n;
+        len -= n;
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Reads the Huffman tables of a DHT segment.
+ * @since 16-10-2026
+ * @param[in,out] dec The decoder
+ * @param[in] seg The segment's data
+ * @param[in] len The length of the segment's data
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_read_dht(JpegDecoder_t *dec, const uint8_t *seg, size_t len) {
+    ImcError_t status;
+    uint8_t tc, th;
+    size_t i, n_symbols;
+
+    while (len > 0) {
+        if (len < 17) {
+            IMC_LOG("Invalid Huffman table", IMC_ERROR);
+            return IMC_EINVAL;
+        }
+
+        tc = seg[0] >> 4;
+        th = seg[0] & 0x0F;
+        for (i = 0, n_symbols = 0; i < 16; ++i) {
+            n_symbols += seg[1 + i];
+        }
+        if (tc > 1 || th >= _JPEG_N_TABLES || n_symbols > 256 || len < 17 + n_symbols) {
+            IMC_LOG("Invalid Huffman table", IMC_ERROR);
+            return IMC_EINVAL;
+        }
+
+        /* DC symbols are sizes of at most 15 additional bits */
+        for (i = 0; tc == 0 && i < n_symbols; ++i) {
+            if (seg[17 + i] > 15) {
+                IMC_LOG("Invalid Huffman table", IMC_ERROR);
+                return IMC_EINVAL;
+            }
+        }
+
+        status = _imc_jpeg_build_huff(
+            (tc == 0) ? &dec->dc_huff[th] : &dec->ac_huff[th],
+            seg + 1, seg + 17, tc == 1
+        );
+        if (status != IMC_EOK) {
+            return status;
+        }
+
+        seg += 17 + n_symbols;
+        len -= 17 + n_symbols;
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Returns true if the three components of __dec__ hold RGB rather than YCbCr.
+ * An Adobe segment says so with a transform of 0 and, without one, so do the component
+ * identifiers 'R', 'G' and 'B'.
+ * @since 16-10-2026
+ * @param[in] dec The decoder whose frame header has been read
+ * @returns True if the frame holds RGB
+ */
+static bool _imc_jpeg_is_rgb(const JpegDecoder_t* const dec) {
+    return dec->n_comps == 3 && ((dec->adobe_transform == 0)
+        || (dec->adobe_transform < 0 && dec->comps[0].id == 'R'
+            && dec->comps[1].id == 'G' && dec->comps[2].id == 'B'));
+}
+
+/**
+ * @brief Returns the number of rows of __comp__'s plane decoded by each row of MCUs of a scan
+ * which holds every component.
+ * @since 16-10-2026
+ * @param[in] dec The decoder
+ * @param[in] comp The component
+ * @returns The number of rows
+ */
+static size_t _imc_jpeg_mcu_rows(const JpegDecoder_t* const dec, const JpegComp_t* const comp) {
+    return ((dec->n_comps == 1) ? 1 : comp->v) * comp->bs;
+}
+
+/**
+ * @brief Allocates the plane of every component of __dec__.
+ * A window holds a row of MCUs along with the rows above it which are still needed to output the
+ * rows which follow (see _imc_jpeg_stream()), which never number more than the largest ratio
+ * between the sampling of two components plus 3.
+ * @since 16-10-2026
+ * @param[in,out] dec The decoder whose frame header has been read
+ * @param[in] window True to allocate a window onto each plane rather than the whole plane
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_alloc_planes(JpegDecoder_t *dec, const bool window) {
+    JpegComp_t *comp;
+    size_t rows;
+    uint8_t i;
+
+    for (i = 0; i < dec->n_comps; ++i) {
+        comp = &dec->comps[i];
+        if (comp->skip) {
+            continue;
+        }
+        rows = window ? _imc_jpeg_mcu_rows(dec, comp) + dec->vmax * dec->block_size + 3 : comp->bh * comp->bs;
+        comp->plane = malloc(comp->stride * rows);
+        if (comp->plane == NULL) {
+            IMC_LOG("Failed to allocate memory for JPEG component", IMC_ERROR);
+            return IMC_ENOMEM;
+        }
+        comp->row0 = 0;
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Reads the frame header of an SOF segment and allocates the component planes.
+ * The coefficient buffers of a progressive frame are allocated here too, once, and every scan
+ * refines them in place.
+ * @since 16-10-2026
+ * @param[in,out] dec The decoder
+ * @param[in] seg The segment's data
+ * @param[in] len The length of the segment's data
+ * @param[in] progressive True if the frame is progressive (SOF2)
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_read_sof(
+    JpegDecoder_t *dec,
+    const uint8_t *seg,
+    const size_t len,
+    const bool progressive
+) {
+    JpegComp_t *comp;
+    uint8_t i;
+    bool ycc;
+
+    if (dec->has_frame) {
+        IMC_LOG("JPEG contains more than one frame", IMC_ERROR);
+        return IMC_EINVAL;
+    } else if (len < 6 || len != 6 + 3 * (size_t)seg[5]) {
+        IMC_LOG("Invalid frame header", IMC_ERROR);
+        return IMC_EINVAL;
+    } else if (seg[0] != 8) {
+        IMC_LOG("Only 8-bit JPEG samples are supported", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    dec->height = _imc_jpeg_u16(seg + 1);
+    dec->width = _imc_jpeg_u16(seg + 3);
+    dec->n_comps = seg[5];
+    if (dec->width == 0 || dec->height == 0) {
+        IMC_LOG("Invalid JPEG dimensions", IMC_ERROR);
+        return IMC_EINVAL;
+    } else if (dec->n_comps != 1 && dec->n_comps != 3 && dec->n_comps != 4) {
+        IMC_LOG("Unsupported number of JPEG components", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    dec->hmax = dec->vmax = 1;
+    for (i = 0; i < dec->n_comps; ++i) {
+        comp = &dec->comps[i];
+        comp->id = seg[6 + 3 * i];
+        comp->h = seg[7 + 3 * i] >> 4;
+        comp->v = seg[7 + 3 * i] & 0x0F;
+        comp->tq = seg[8 + 3 * i];
+        if (comp->h < 1 || comp->h > 4 || comp->v < 1 || comp->v > 4 || comp->tq >= _JPEG_N_TABLES) {
+            IMC_LOG("Invalid frame component", IMC_ERROR);
+            return IMC_EINVAL;
+        }
+        dec->hmax = (comp->h > dec->hmax) ? comp->h : dec->hmax;
+        dec->vmax = (comp->v > dec->vmax) ? comp->v : dec->vmax;
+    }
+
+    dec->mcux = (dec->width + 8 * dec->hmax - 1) / (8 * dec->hmax);
+    dec->mcuy = (dec->height + 8 * dec->vmax - 1) / (8 * dec->vmax);
+
+    /* The chroma of a YCbCr frame is skipped by a luma-only decode */
+    ycc = dec->luma_only && dec->n_comps == 3 && !_imc_jpeg_is_rgb(dec);
+
+    dec->out_width = (dec->width * dec->block_size + 7) / 8;
+    dec->out_height = (dec->height * dec->block_size + 7) / 8;
+
+    for (i = 0; i < dec->n_comps; ++i) {
+        comp = &dec->comps[i];
+        comp->width = (dec->width * comp->h + dec->hmax - 1) / dec->hmax;
+        comp->height = (dec->height * comp->v + dec->vmax - 1) / dec->vmax;
+        comp->bw = dec->mcux * comp->h;
+        comp->bh = dec->mcuy * comp->v;
+
+        /* Scale subsampled components up through a larger inverse DCT rather than upsampling */
+        comp->bs = dec->block_size;
+        while (!dec->dc_only && !dec->raw && comp->bs < 8
+                && (dec->hmax * dec->block_size) % (comp->h * comp->bs * 2) == 0
+                && (dec->vmax * dec->block_size) % (comp->v * comp->bs * 2) == 0) {
+            comp->bs *= 2;
+        }
+
+        comp->stride = comp->bw * comp->bs;
+        comp->skip = ycc && i > 0;
+        if (comp->skip || dec->header_only) {
+            continue;
+        } else if (progressive || dec->coefs_only) {
+            comp->coefs = calloc(comp->bw * comp->bh * (dec->dc_only ? 1 : 64), sizeof(*comp->coefs));
+            if (comp->coefs == NULL) {
+                IMC_LOG("Failed to allocate memory for JPEG coefficients", IMC_ERROR);
+                return IMC_ENOMEM;
+            }
+        }
+    }
+    dec->progressive = progressive;
+    dec->has_frame = true;
+
+    /* A sequential frame which may be streamed gets its planes with its first scan */
+    if (!dec->coefs_only && !dec->header_only && (progressive || !dec->stream)) {
+        return _imc_jpeg_alloc_planes(dec, false);
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Returns the inverse DCT which decodes blocks of __comp__ at their scaled size.
+ * @since 16-10-2026
+ * @param[in] dec The decoder
+ * @param[in] comp The component
+ * @returns The inverse DCT function
+ */
+static idct_func _imc_jpeg_comp_idct(const JpegDecoder_t* const dec, const JpegComp_t* const comp) {
+    switch (comp->bs) {
+        case 1:
+            return _imc_jpeg_idct_1x1;
+        case 2:
+            return _imc_jpeg_idct_2x2;
+        case 4:
+            return _imc_jpeg_idct_4x4;
+        default:
+            return dec->idct;
+    }
+}
+
+/**
+ * @brief Resynchronizes __br__ at the restart marker which ends a restart interval.
+ * If the data is damaged and the next marker is not a restart marker, it is left for the bit
+ * reader to find so that the rest of the scan decodes as zeros.
+ * @since 16-10-2026
+ * @param[in,out] br The bit reader
+ */
+static void _imc_jpeg_restart(JpegBits_t *br) {
+    const uint8_t *p = br->pos;
+
+    if (!br->marker) {
+        while (p + 1 < br->end && !(p[0] == 0xFF && p[1] != 0x00 && p[1] != 0xFF)) {
+            p++;
+        }
+    }
+    if (p + 1 < br->end && p[0] == 0xFF && p[1] >= JPEG_RST0 && p[1] <= JPEG_RST7) {
+        p += 2;
+    }
+
+    br->pos = p;
+    br->bitbuf = 0;
+    br->bitcount = 0;
+    br->marker = 0;
+}
+
+/**
+ * @brief Decodes a run of consecutive MCUs of a scan into the component planes.
+ * The run must not cross a restart interval, at the start of which the DC predictors are reset,
+ * and a run of a progressive scan must begin one, since the end-of-band run starts from zero. Scans of a single component are non-interleaved and
+ * each block is its own MCU. Otherwise each MCU holds h x v blocks of every component in the
+ * scan. The blocks of progressive scans (and of every scan when only the coefficients are kept)
+ * are decoded into the coefficient buffers instead. When decoding DC only, each block of a
+ * sequential scan becomes a single sample straight from its DC coefficient. The blocks of a
+ * skipped component are parsed and dropped.
+ * @since 16-10-2026
+ * @param[in] dec The decoder
+ * @param[in] scan The scan
+ * @param[in,out] br The bit reader, positioned at the first MCU of the run
+ * @param[in] first The index of the first MCU (in raster order)
+ * @param[in] n_mcus The number of MCUs to decode
+ * @param[in,out] dc_pred The DC predictor of each component of the scan
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_decode_mcus(
+    const JpegDecoder_t* const dec,
+    const JpegScan_t* const scan,
+    JpegBits_t *br,
+    const size_t first,
+    const size_t n_mcus,
+    int *dc_pred
+) {
+    const JpegComp_t *comp;
+    uint8_t *out;
+    size_t mcu, mx, my, bx, by;
+    uint8_t i, h, v;
+    int16_t coefs[64], *blk;
+    int last;
+    uint32_t eobrun = 0;
+    ImcError_t status;
+
+    memset((void*)coefs, 0, sizeof(coefs));
+
+    for (mcu = first; mcu < first + n_mcus; ++mcu) {
+        mx = mcu % scan->n_mcux;
+        my = mcu / scan->n_mcux;
+
+        for (i = 0; i < scan->n_comps; ++i) {
+            comp = scan->comps[i];
+            h = (scan->n_comps == 1) ? 1 : comp->h;
+            v = (scan->n_comps == 1) ? 1 : comp->v;
+            for (by = my * v; by < (my + 1) * v; ++by) {
+                for (bx = mx * h; bx < (mx + 1) * h; ++bx) {
+                    if (dec->progressive) {
+                        blk = comp->skip ? coefs : comp->coefs + (by * comp->bw + bx) * (dec->dc_only ? 1 : 64);
+                        if (scan->ss == 0) {
+                            status = _imc_jpeg_decode_dc_prog(br, &dec->dc_huff[comp->td], scan, &dc_pred[i], blk);
+                        } else if (scan->ah == 0) {
+                            status = _imc_jpeg_decode_ac_first(br, &dec->ac_huff[comp->ta], scan, &eobrun, blk);
+                        } else {
+                            status = _imc_jpeg_decode_ac_refine(br, &dec->ac_huff[comp->ta], scan, &eobrun, blk);
+                        }
+                        if (status != IMC_EOK) {
+                            IMC_LOG("Corrupt JPEG entropy-coded data", IMC_ERROR);
+                            return status;
+                        }
+                        continue;
+                    }
+
+                    if (dec->dc_only || comp->skip) {
+                        if (_imc_jpeg_decode_dc_only(
+                                br, &dec->dc_huff[comp->td], &dec->ac_huff[comp->ta], &dc_pred[i]) != IMC_EOK) {
+                            IMC_LOG("Corrupt JPEG entropy-coded data", IMC_ERROR);
+                            return IMC_EFAIL;
+                        } else if (comp->skip) {
+                            continue;
+                        }
+                        _imc_jpeg_idct_dc((int16_t)dc_pred[i], dec->qt[comp->tq][0],
+                            comp->plane + (by - comp->row0) * comp->stride + bx, comp->stride, 1);
+                        continue;
+                    }
+
+                    blk = dec->coefs_only ? comp->coefs + (by * comp->bw + bx) * 64 : coefs;
+                    if (_imc_jpeg_decode_block(
+                            br, &dec->dc_huff[comp->td], &dec->ac_huff[comp->ta],
+                            &dc_pred[i], blk, &last) != IMC_EOK) {
+                        IMC_LOG("Corrupt JPEG entropy-coded data", IMC_ERROR);
+                        return IMC_EFAIL;
+                    } else if (dec->coefs_only) {
+                        continue;
+                    }
+
+                    out = comp->plane + (by * comp->bs - comp->row0) * comp->stride + bx * comp->bs;
+                    if (last == 0) {
+                        _imc_jpeg_idct_dc(coefs[0], dec->qt[comp->tq][0], out, comp->stride, comp->bs);
+                        coefs[0] = 0;
+                    } else {
+                        scan->idct[i](coefs, dec->qt[comp->tq], out, comp->stride);
+                        memset((void*)coefs, 0, sizeof(coefs));
+                    }
+                }
+            }
+        }
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Finds the start of every restart interval of a scan by scanning for RSTn markers.
+ * @since 16-10-2026
+ * @param[in] dec The decoder, whose parse position is the start of the entropy-coded data
+ * @param[in] n_intervals The number of restart intervals the scan must have
+ * @param[out] starts The start of each interval's entropy-coded data
+ * @param[out] scan_end The marker which ends the scan
+ * @returns True if exactly __n_intervals__ - 1 restart markers were found
+ */
+static bool _imc_jpeg_find_intervals(
+    const JpegDecoder_t* const dec,
+    const size_t n_intervals,
+    const uint8_t **starts,
+    const uint8_t **scan_end
+) {
+    const uint8_t *p = dec->pos;
+    size_t n = 1;
+
+    starts[0] = p;
+    while ((p = memchr(p, 0xFF, dec->end - p)) != NULL && p + 1 < dec->end) {
+        if (p[1] == 0x00 || p[1] == 0xFF) {
+            p++;
+            continue;
+        } else if (p[1] < JPEG_RST0 || p[1] > JPEG_RST7) {
+            break;
+        } else if (n == n_intervals) {
+            return false;
+        }
+        p += 2;
+        starts[n++] = p;
+    }
+
+    *scan_end = (p != NULL && p + 1 < dec->end) ? p : dec->end;
+    return n == n_intervals;
+}
+
+/**
+ * @brief Decodes the restart intervals claimed from __arg__ until none remain.
+ * @since 16-10-2026
+ * @param[in,out] arg The JpegIntervalJob_t shared by every worker
+ * @returns NULL
+ */
+static void *_imc_jpeg_interval_worker(void *arg) {
+    size_t idx, first, n_mcus;
+    ImcError_t status;
+    JpegBits_t br;
+    int dc_pred[JPEG_MAX_COMPONENTS];
+    JpegIntervalJob_t *job = (JpegIntervalJob_t*)arg;
+
+    while (true) {
+        pthread_mutex_lock(&job->lock);
+        if (job->status != IMC_EOK || job->next >= job->n_intervals) {
+            pthread_mutex_unlock(&job->lock);
+            break;
+        }
+        idx = job->next++;
+        pthread_mutex_unlock(&job->lock);
+
+        first = idx * job->dec->restart_interval;
+        n_mcus = job->n_mcus - first;
+        if (n_mcus > job->dec->restart_interval) {
+            n_mcus = job->dec->restart_interval;
+        }
+
+        memset((void*)&br, 0, sizeof(br));
+        br.pos = job->starts[idx];
+        br.end = job->dec->end;
+        memset((void*)dc_pred, 0, sizeof(dc_pred));
+
+        status = _imc_jpeg_decode_mcus(job->dec, job->scan, &br, first, n_mcus, dc_pred);
+        if (status != IMC_EOK) {
+            pthread_mutex_lock(&job->lock);
+            if (job->status == IMC_EOK) {
+                job->status = status;
+            }
+            pthread_mutex_unlock(&job->lock);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Decodes the restart intervals of a scan on separate threads.
+ * Every interval starts with fresh DC predictors and a byte-aligned bit reader and covers
+ * distinct blocks of the planes, so the intervals are decoded independently and the planes need
+ * no merging afterwards.
+ * @since 16-10-2026
+ * @param[in,out] dec The decoder, whose parse position is the start of the entropy-coded data
+ * @param[in] scan The scan
+ * @param[in] n_threads The number of threads to decode with (including the calling thread)
+ * @param[out] done True if the scan was decoded, false if it must be decoded serially because
+ * its restart markers do not match its restart interval
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_decode_parallel(
+    JpegDecoder_t *dec,
+    const JpegScan_t* const scan,
+    const size_t n_threads,
+    bool *done
+) {
+    size_t t, n_spawned;
+    const uint8_t *scan_end;
+    ImcError_t status;
+    JpegIntervalJob_t job = { 0 };
+    pthread_t *threads = NULL;
+
+    *done = false;
+    job.dec = dec;
+    job.scan = scan;
+    job.n_mcus = scan->n_mcux * scan->n_mcuy;
+    job.n_intervals = (job.n_mcus + dec->restart_interval - 1) / dec->restart_interval;
+    job.status = IMC_EOK;
+    job.starts = malloc(job.n_intervals * sizeof(*job.starts));
+    threads = calloc(n_threads, sizeof(*threads));
+    if (job.starts == NULL || threads == NULL) {
+        IMC_LOG("Failed to allocate memory for interval job", IMC_ERROR);
+        status = IMC_ENOMEM;
+        goto cleanup;
+    }
+
+    if (!_imc_jpeg_find_intervals(dec, job.n_intervals, job.starts, &scan_end)) {
+        status = IMC_EOK;
+        goto cleanup;
+    }
+    pthread_mutex_init(&job.lock, NULL);
+
+    /* The calling thread works too, so spawn one fewer than requested */
+    for (n_spawned = 0; n_spawned + 1 < n_threads && n_spawned + 1 < job.n_intervals; ++n_spawned) {
+        if (pthread_create(&threads[n_spawned], NULL, _imc_jpeg_interval_worker, &job) != 0) {
+            IMC_LOG("Failed to spawn decoder thread", IMC_WARNING);
+            break;
+        }
+    }
+    _imc_jpeg_interval_worker(&job);
+    for (t = 0; t < n_spawned; ++t) {
+        pthread_join(threads[t], NULL);
+    }
+    pthread_mutex_destroy(&job.lock);
+
+    status = job.status;
+    dec->pos = scan_end;
+    *done = true;
+
+cleanup:
+    free(job.starts);
+    free(threads);
+
+    return status;
+}
+
+/**
+ * @brief Decodes the entropy-coded segment(s) of a scan into the component planes.
+ * Scans with restart intervals are decoded in parallel when more than one thread is available
+ * and every interval's restart marker is present, and serially otherwise.
+ * @since 16-10-2026
+ * @param[in,out] dec The decoder, whose parse position is the start of the entropy-coded data
+ * @param[in] scan The scan
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_decode_scan(JpegDecoder_t *dec, const JpegScan_t* const scan) {
+    ImcError_t status;
+    JpegBits_t br = { 0 };
+    size_t mcu, n_mcus = scan->n_mcux * scan->n_mcuy;
+    size_t step = (dec->restart_interval > 0) ? dec->restart_interval : n_mcus;
+    int dc_pred[JPEG_MAX_COMPONENTS];
+    bool done = false;
+
+    if (dec->restart_interval > 0 && dec->n_threads > 1 && n_mcus > step) {
+        status = _imc_jpeg_decode_parallel(dec, scan, dec->n_threads, &done);
+        if (status != IMC_EOK || done) {
+            return status;
+        }
+    }
+
+    br.pos = dec->pos;
+    br.end = dec->end;
+
+    for (mcu = 0; mcu < n_mcus; mcu += step) {
+        if (mcu > 0) {
+            _imc_jpeg_restart(&br);
+        }
+        memset((void*)dc_pred, 0, sizeof(dc_pred));
+
+        status = _imc_jpeg_decode_mcus(dec, scan, &br, mcu, (n_mcus - mcu < step) ? n_mcus - mcu : step, dc_pred);
+        if (status != IMC_EOK) {
+            return status;
+        }
+    }
+
+    /* Leave the parse position at the marker which ended the scan */
+    dec->pos = br.pos;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Reads the scan header of an SOS segment and decodes the scan which follows it.
+ * @since 16-10-2026
+ * @param[in,out] dec The decoder
+ * @param[in] seg The segment's data
+ * @param[in] len The length of the segment's data
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_read_sos(JpegDecoder_t *dec, const uint8_t *seg, const size_t len) {
+    JpegScan_t scan;
+    JpegComp_t *comp;
+    uint8_t i, j, n_scomps;
+    size_t blocks = 0;
+    bool need_dc = true, need_ac = true;
+    ImcError_t status;
+
+    if (!dec->has_frame) {
+        IMC_LOG("JPEG scan precedes the frame header", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    n_scomps = (len > 0) ? seg[0] : 0;
+    if (n_scomps < 1 || n_scomps > dec->n_comps || len != 4 + 2 * (size_t)n_scomps) {
+        IMC_LOG("Invalid scan header", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    scan.ss = seg[1 + 2 * n_scomps];
+    scan.se = seg[2 + 2 * n_scomps];
+    scan.ah = seg[3 + 2 * n_scomps] >> 4;
+    scan.al = seg[3 + 2 * n_scomps] & 0x0F;
+    if (dec->progressive) {
+        /* DC and AC coefficients never share a scan, and AC scans hold a single component */
+        if ((scan.ss == 0 && scan.se != 0)
+                || (scan.ss > 0 && (scan.se < scan.ss || scan.se > 63 || n_scomps != 1))
+                || scan.ah > 13 || scan.al > 13) {
+            IMC_LOG("Invalid progressive scan parameters", IMC_ERROR);
+            return IMC_EINVAL;
+        }
+        need_dc = (scan.ss == 0 && scan.ah == 0);
+        need_ac = (scan.ss > 0);
+    }
+
+    for (i = 0; i < n_scomps; ++i) {
+        for (j = 0, comp = NULL; j < dec->n_comps; ++j) {
+            if (dec->comps[j].id == seg[1 + 2 * i]) {
+                comp = &dec->comps[j];
+            }
+        }
+        if (comp == NULL) {
+            IMC_LOG("Scan references an unknown component", IMC_ERROR);
+            return IMC_EINVAL;
+        }
+
+        comp->td = seg[2 + 2 * i] >> 4;
+        comp->ta = seg[2 + 2 * i] & 0x0F;
+        if (comp->td >= _JPEG_N_TABLES || comp->ta >= _JPEG_N_TABLES
+                || (need_dc && !dec->dc_huff[comp->td].defined)
+                || (need_ac && !dec->ac_huff[comp->ta].defined)
+                || !dec->qt_defined[comp->tq]) {
+            IMC_LOG("Scan references an undefined table", IMC_ERROR);
+            return IMC_EINVAL;
+        }
+
+        if (dec->progressive && scan.ss == 0) {
+            comp->has_dc = true;
+        }
+        scan.comps[i] = comp;
+        scan.idct[i] = _imc_jpeg_comp_idct(dec, comp);
+        blocks += comp->h * comp->v;
+    }
+
+    if (n_scomps > 1 && blocks > 10) {
+        IMC_LOG("Too many blocks in a JPEG MCU", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    scan.n_comps = n_scomps;
+    if (n_scomps == 1) {
+        scan.n_mcux = (scan.comps[0]->width + 7) / 8;
+        scan.n_mcuy = (scan.comps[0]->height + 7) / 8;
+    } else {
+        scan.n_mcux = dec->mcux;
+        scan.n_mcuy = dec->mcuy;
+    }
+
+    dec->n_scans++;
+    if ((dec->dc_only || scan.comps[0]->skip) && scan.ss > 0) {
+        /* The entropy-coded data of an AC scan is skipped along with any other bytes up to the next marker */
+        return IMC_EOK;
+    }
+
+    /* A frame which may be streamed learns from its first scan whether it can be */
+    if (!dec->coefs_only && dec->comps[0].plane == NULL) {
+        if (n_scomps == dec->n_comps) {
+            dec->scan = scan;
+            return _imc_jpeg_alloc_planes(dec, true);
+        }
+        status = _imc_jpeg_alloc_planes(dec, false);
+        if (status != IMC_EOK) {
+            return status;
+        }
+    }
+
+    return _imc_jpeg_decode_scan(dec, &scan);
+}
+
+/**
+ * @brief Transforms the coefficient buffers of a progressive frame into the component planes.
+ * @since 16-10-2026
+ * @param[in] dec The decoder whose scans have been decoded
+ */
+static void _imc_jpeg_transform_coefs(const JpegDecoder_t* const dec) {
+    const JpegComp_t *comp;
+    const int16_t *blk;
+    idct_func idct;
+    size_t bx, by;
+    uint8_t i, k, n = dec->dc_only ? 1 : 64;
+
+    for (i = 0; i < dec->n_comps; ++i) {
+        comp = &dec->comps[i];
+        if (comp->skip) {
+            continue;
+        }
+        idct = _imc_jpeg_comp_idct(dec, comp);
+        for (by = 0, blk = comp->coefs; by < comp->bh; ++by) {
+            for (bx = 0; bx < comp->bw; ++bx, blk += n) {
+                for (k = 1; k < n && blk[k] == 0; ++k);
+                if (k == n) {
+                    _imc_jpeg_idct_dc(blk[0], dec->qt[comp->tq][0],
+                        comp->plane + by * comp->bs * comp->stride + bx * comp->bs, comp->stride, comp->bs);
+                } else {
+                    idct(blk, dec->qt[comp->tq], comp->plane + by * comp->bs * comp->stride + bx * comp->bs,
+                        comp->stride);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Returns true once every component of a progressive frame has had a DC scan.
+ * @since 16-10-2026
+ * @param[in] dec The decoder
+ * @returns True if a preview of the frame can be produced
+ */
+static bool _imc_jpeg_has_preview(const JpegDecoder_t* const dec) {
+    uint8_t i;
+
+    for (i = 0; i < dec->n_comps; ++i) {
+        if (!dec->comps[i].has_dc) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Reads the segments of a JPEG up to the end of the image, decoding each scan.
+ * A progressive frame is transformed once its scans end (or, when previewing, once every component
+ * has had its first DC scan). Reading stops at a scan left to be streamed, or after the frame
+ * header when only the header is wanted. A progressive JPEG whose entropy-coded data is cut short decodes
+ * at the quality of the scans which were complete.
+ * @since 16-10-2026
+ * @param[in,out] dec The decoder
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_read_segments(JpegDecoder_t *dec) {
+    ImcError_t status = IMC_EOK;
+    uint8_t marker;
+    const uint8_t *seg;
+    size_t len;
+
+    if (dec->end - dec->pos < 2 || dec->pos[0] != 0xFF || dec->pos[1] != JPEG_SOI) {
+        IMC_LOG("Data is not a JPEG", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+    dec->pos += 2;
+
+    while ((marker = _imc_jpeg_next_marker(dec)) != 0 && marker != JPEG_EOI) {
+        /* Stray SOI and RSTn markers stand alone */
+        if (marker == JPEG_SOI || (marker >= JPEG_RST0 && marker <= JPEG_RST7)) {
+            continue;
+        }
+
+        status = _imc_jpeg_segment(dec, &len);
+        if (status != IMC_EOK) {
+            break;
+        }
+        seg = dec->pos;
+        dec->pos += len;
+
+        switch (marker) {
+            case JPEG_SOF0:
+            case JPEG_SOF1:
+            case JPEG_SOF2:
+                status = _imc_jpeg_read_sof(dec, seg, len, marker == JPEG_SOF2);
+                marker = dec->header_only ? JPEG_EOI : marker;
+                break;
+            case JPEG_DQT:
+                status = _imc_jpeg_read_dqt(dec, seg, len);
+                break;
+            case JPEG_DHT:
+                status = _imc_jpeg_read_dht(dec, seg, len);
+                break;
+            case JPEG_DRI:
+                if (len < 2) {
+                    IMC_LOG("Invalid restart interval", IMC_ERROR);
+                    status = IMC_EINVAL;
+                } else {
+                    dec->restart_interval = _imc_jpeg_u16(seg);
+                }
+                break;
+            case JPEG_SOS:
+                status = _imc_jpeg_read_sos(dec, seg, len);
+                if (status == IMC_EOK && (dec->scan.n_comps > 0
+                        || (dec->preview && dec->progressive && _imc_jpeg_has_preview(dec)))) {
+                    marker = JPEG_EOI;
+                }
+                break;
+            case JPEG_APP14:
+                if (len >= 12 && memcmp((void*)seg, (void*)"Adobe", 5) == 0) {
+                    dec->adobe_transform = seg[11];
+                }
+                break;
+            case 0xC3: case 0xC5: case 0xC6: case 0xC7:
+            case 0xC9: case 0xCA: case 0xCB: case 0xCD: case 0xCE: case 0xCF:
+                IMC_LOG("Lossless, hierarchical and arithmetic-coded JPEGs are not supported", IMC_ERROR);
+                status = IMC_EINVAL;
+                break;
+            default:
+                /* APPn, COM and other segments are skipped */
+                break;
+        }
+
+        if (status != IMC_EOK || marker == JPEG_EOI) {
+            break;
+        }
+    }
+
+    if (status == IMC_EOK && dec->header_only) {
+        if (!dec->has_frame) {
+            IMC_LOG("JPEG contains no frame header", IMC_ERROR);
+            status = IMC_ENODATA;
+        }
+    } else if (status == IMC_EOK && dec->n_scans == 0) {
+        IMC_LOG("JPEG contains no scans", IMC_ERROR);
+        status = IMC_ENODATA;
+    } else if (status == IMC_EOK && dec->progressive && !dec->coefs_only) {
+        _imc_jpeg_transform_coefs(dec);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Computes the vertical fancy upsampling sums 3 * near[x] + far[x] of a row of samples.
+ * Passing the same row as __near__ and __far__ gives 4 * near[x], which is how rows that are not
+ * upsampled vertically enter the horizontal pass.
+ * @since 16-10-2026
+ * @param[in] near The nearest row of samples
+ * @param[in] far The next nearest row of samples
+ * @param[out] colsum The sums
+ * @param[in] n The number of samples in a row
+ * @param[in] simd False to always use the scalar loop
+ */
+static void _imc_jpeg_colsum(
+    const uint8_t* const near,
+    const uint8_t* const far,
+    int16_t *colsum,
+    const size_t n,
+    const bool simd
+) {
+    size_t x = 0;
+#if defined(_JPEG_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i a, b;
+
+    for (; simd && x + 8 <= n; x += 8) {
+        a = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(near + x)), zero);
+        b = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(far + x)), zero);
+        _mm_storeu_si128((__m128i*)(colsum + x), _mm_add_epi16(_mm_add_epi16(a, _mm_add_epi16(a, a)), b));
+    }
+#else
+    (void)simd;
+#endif
+
+    for (; x < n; ++x) {
+        colsum[x] = (int16_t)(near[x] * 3 + far[x]);
+    }
+}
+
+/**
+ * @brief Doubles the width of a row by triangular interpolation of its column sums.
+ * Output sample 2i is (3 * colsum[i] + colsum[i - 1] + even_bias) >> 4 and output sample 2i + 1 is
+ * (3 * colsum[i] + colsum[i + 1] + odd_bias) >> 4, which are libjpeg's h2v1 and h2v2 fancy
+ * upsampling filters with the biases it uses for each. colsum[-1] and colsum[n] must repeat the
+ * edge sums.
+ * @since 16-10-2026
+ * @param[in] colsum The column sums produced by _imc_jpeg_colsum()
+ * @param[out] dst The upsampled row of 2 * __n__ samples
+ * @param[in] n The number of column sums
+ * @param[in] even_bias The rounding bias of even output samples
+ * @param[in] odd_bias The rounding bias of odd output samples
+ * @param[in] simd False to always use the scalar loop
+ */
+static void _imc_jpeg_h2_fancy(
+    const int16_t* const colsum,
+    uint8_t *dst,
+    const size_t n,
+    const int even_bias,
+    const int odd_bias,
+    const bool simd
+) {
+    size_t i = 0;
+    int c3;
+#if defined(_JPEG_SSE2)
+    const __m128i be = _mm_set1_epi16((int16_t)even_bias), bo = _mm_set1_epi16((int16_t)odd_bias);
+    __m128i c, even, odd;
+
+    /* Sums are at most 4 * 1020, so the 16-bit arithmetic cannot overflow */
+    for (; simd && i + 8 <= n; i += 8) {
+        c = _mm_loadu_si128((const __m128i*)(colsum + i));
+        c = _mm_add_epi16(c, _mm_add_epi16(c, c));
+        even = _mm_add_epi16(_mm_add_epi16(c, _mm_loadu_si128((const __m128i*)(colsum + i - 1))), be);
+        odd = _mm_add_epi16(_mm_add_epi16(c, _mm_loadu_si128((const __m128i*)(colsum + i + 1))), bo);
+        even = _mm_srli_epi16(even, 4);
+        odd = _mm_srli_epi16(odd, 4);
+        _mm_storeu_si128((__m128i*)(dst + 2 * i),
+            _mm_packus_epi16(_mm_unpacklo_epi16(even, odd), _mm_unpackhi_epi16(even, odd)));
+    }
+#else
+    (void)simd;
+#endif
+
+    for (; i < n; ++i) {
+        c3 = colsum[i] * 3;
+        dst[2 * i] = (uint8_t)((c3 + colsum[(ptrdiff_t)i - 1] + even_bias) >> 4);
+        dst[2 * i + 1] = (uint8_t)((c3 + colsum[i + 1] + odd_bias) >> 4);
+    }
+}
+
+/**
+ * @brief Interpolates a row between two rows of samples as (3 * near[x] + far[x] + bias) >> 2,
+ * which is libjpeg's h1v2 fancy upsampling filter.
+ * @since 16-10-2026
+ * @param[in] near The nearest row of samples
+ * @param[in] far The next nearest row of samples
+ * @param[out] dst The interpolated row
+ * @param[in] n The number of samples in a row
+ * @param[in] bias The rounding bias (1 for the upper of each pair of rows, 2 for the lower)
+ * @param[in] simd False to always use the scalar loop
+ */
+static void _imc_jpeg_v2_fancy(
+    const uint8_t* const near,
+    const uint8_t* const far,
+    uint8_t *dst,
+    const size_t n,
+    const int bias,
+    const bool simd
+) {
+    size_t x = 0;
+#if defined(_JPEG_SSE2)
+    const __m128i zero = _mm_setzero_si128(), b = _mm_set1_epi16((int16_t)bias);
+    __m128i nv, fv, lo, hi;
+
+    for (; simd && x + 16 <= n; x += 16) {
+        nv = _mm_loadu_si128((const __m128i*)(near + x));
+        fv = _mm_loadu_si128((const __m128i*)(far + x));
+        lo = _mm_unpacklo_epi8(nv, zero);
+        hi = _mm_unpackhi_epi8(nv, zero);
+        lo = _mm_add_epi16(_mm_add_epi16(lo, _mm_add_epi16(lo, lo)), _mm_unpacklo_epi8(fv, zero));
+        hi = _mm_add_epi16(_mm_add_epi16(hi, _mm_add_epi16(hi, hi)), _mm_unpackhi_epi8(fv, zero));
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, b), 2);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, b), 2);
+        _mm_storeu_si128((__m128i*)(dst + x), _mm_packus_epi16(lo, hi));
+    }
+#else
+    (void)simd;
+#endif
+
+    for (; x < n; ++x) {
+        dst[x] = (uint8_t)((near[x] * 3 + far[x] + bias) >> 2);
+    }
+}
+
+/**
+ * @brief Returns row __y__ of the output upsampled from the plane of __comp__.
+ * With fancy upsampling, components subsampled by exactly 2 horizontally, vertically or both are
+ * interpolated with libjpeg's triangular filters (horizontally only when at least 3 samples of a
+ * row lie inside the image, as libjpeg does). Every other ratio, and every component when fancy
+ * upsampling is off, is upsampled by replication.
+ * @since 16-10-2026
+ * @param[in] dec The decoder whose planes have been decoded
+ * @param[in] comp The component
+ * @param[in] y The output row
+ * @param[out] dst Scratch space of at least JpegDecoder_t.out_width + 16 samples for the upsampled row
+ * @param[out] colsum Scratch space of at least JpegDecoder_t.out_width + 16 column sums
+ * @returns __dst__, or a row of the plane if it needs no upsampling
+ */
+static const uint8_t *_imc_jpeg_upsample_row(
+    const JpegDecoder_t* const dec,
+    const JpegComp_t* const comp,
+    const size_t y,
+    uint8_t *dst,
+    int16_t *colsum
+) {
+    const uint8_t *src, *far;
+    size_t x, row, dw, dh, ratio, rep = 0;
+    size_t hs = comp->h * comp->bs, vs = comp->v * comp->bs;
+    size_t hs_max = dec->hmax * dec->block_size, vs_max = dec->vmax * dec->block_size;
+    bool v2 = (vs * 2 == vs_max);
+
+    row = y * vs / vs_max;
+    src = comp->plane + (row - comp->row0) * comp->stride;
+    if (hs == hs_max && vs == vs_max) {
+        return src;
+    }
+
+    /* Number of samples of the component which lie inside the image */
+    dw = (dec->width * hs + dec->hmax * 8 - 1) / (dec->hmax * 8);
+    dh = (dec->height * vs + dec->vmax * 8 - 1) / (dec->vmax * 8);
+
+    /* The row on the far side of the output row's centre, repeating the edge rows */
+    far = src;
+    if (v2 && (y & 1) == 0 && row > 0) {
+        far = src - comp->stride;
+    } else if (v2 && (y & 1) == 1 && row + 1 < dh) {
+        far = src + comp->stride;
+    }
+
+    if (dec->fancy && hs == hs_max && v2) {
+        _imc_jpeg_v2_fancy(src, far, dst, dec->out_width, (y & 1) ? 2 : 1, dec->simd);
+        return dst;
+    } else if (dec->fancy && hs * 2 == hs_max && (vs == vs_max || v2) && dw > 2) {
+        _imc_jpeg_colsum(src, far, colsum + 1, dw, dec->simd);
+        colsum[0] = colsum[1];
+        colsum[dw + 1] = colsum[dw];
+        if (v2) {
+            _imc_jpeg_h2_fancy(colsum + 1, dst, dw, 8, 7, dec->simd);
+        } else {
+            _imc_jpeg_h2_fancy(colsum + 1, dst, dw, 4, 8, dec->simd);
+        }
+        return dst;
+    } else if (hs == hs_max) {
+        return src;
+    }
+
+    if (hs_max % hs == 0) {
+        ratio = hs_max / hs;
+        for (x = 0; x < dec->out_width; ++x) {
+            dst[x] = src[0];
+            if (++rep == ratio) {
+                rep = 0;
+                src++;
+            }
+        }
+    } else {
+        for (x = 0; x < dec->out_width; ++x) {
+            dst[x] = src[x * hs / hs_max];
+        }
+    }
+
+    return dst;
+}
+
+/**
+ * @brief Converts a row of YCbCr samples into RGB, RGBA or BGRA pixels.
+ * The conversion uses libjpeg's 16.16 fixed-point constants. The SSE2 path keeps the results exact
+ * by splitting each constant that does not fit in 16 bits into a multiple of 65536, applied as a
+ * plain addition, and a 16-bit remainder, applied by _mm_madd_epi16() together with the rounding term.
+ * @since 16-10-2026
+ * @param[in] yrow The luma samples
+ * @param[in] cbrow The blue-difference chroma samples
+ * @param[in] crrow The red-difference chroma samples
+ * @param[out] out The pixels
+ * @param[in] n The number of pixels
+ * @param[in] n_ch The number of channels of each pixel (3 or 4, the fourth being opaque alpha)
+ * @param[in] bgr True to store blue first
+ * @param[in] simd False to always use the scalar loop
+ */
+static void _imc_jpeg_ycc_row(
+    const uint8_t* const yrow,
+    const uint8_t* const cbrow,
+    const uint8_t* const crrow,
+    uint8_t *out,
+    const size_t n,
+    const size_t n_ch,
+    const bool bgr,
+    const bool simd
+) {
+    size_t x = 0;
+    int yv, cb, cr, ri = bgr ? 2 : 0, bi = 2 - ri;
+#if defined(_JPEG_SSE2)
+    size_t i;
+    const __m128i zero = _mm_setzero_si128(), c128 = _mm_set1_epi16(128), two = _mm_set1_epi16(2);
+    const __m128i alpha = _mm_set1_epi8((char)0xFF), half = _mm_set1_epi32(32768);
+    const __m128i k_r = _mm_set_epi16(16384, 26345, 16384, 26345, 16384, 26345, 16384, 26345);
+    const __m128i k_g = _mm_set_epi16(18734, -22554, 18734, -22554, 18734, -22554, 18734, -22554);
+    const __m128i k_b = _mm_set_epi16(16384, -14942, 16384, -14942, 16384, -14942, 16384, -14942);
+    __m128i y16, cb16, cr16, r, g, b, rg, ba;
+    uint8_t px[32];
+
+    for (; simd && x + 8 <= n; x += 8) {
+        y16 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(yrow + x)), zero);
+        cb16 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(cbrow + x)), zero), c128);
+        cr16 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(crrow + x)), zero), c128);
+
+        /* R = Y + Cr + ((26345 * Cr + 2 * 16384) >> 16) */
+        r = _mm_packs_epi32(
+            _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(cr16, two), k_r), 16),
+            _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(cr16, two), k_r), 16));
+        r = _mm_add_epi16(_mm_add_epi16(y16, cr16), r);
+
+        /* G = Y - Cr + ((-22554 * Cb + 18734 * Cr + 32768) >> 16) */
+        g = _mm_packs_epi32(
+            _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(cb16, cr16), k_g), half), 16),
+            _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(cb16, cr16), k_g), half), 16));
+        g = _mm_add_epi16(_mm_sub_epi16(y16, cr16), g);
+
+        /* B = Y + 2 * Cb + ((-14942 * Cb + 2 * 16384) >> 16) */
+        b = _mm_packs_epi32(
+            _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(cb16, two), k_b), 16),
+            _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(cb16, two), k_b), 16));
+        b = _mm_add_epi16(_mm_add_epi16(y16, _mm_add_epi16(cb16, cb16)), b);
+
+        r = _mm_packus_epi16(r, r);
+        g = _mm_packus_epi16(g, g);
+        b = _mm_packus_epi16(b, b);
+        rg = bgr ? _mm_unpacklo_epi8(b, g) : _mm_unpacklo_epi8(r, g);
+        ba = bgr ? _mm_unpacklo_epi8(r, alpha) : _mm_unpacklo_epi8(b, alpha);
+        if (n_ch == 4) {
+            _mm_storeu_si128((__m128i*)(out + 4 * x), _mm_unpacklo_epi16(rg, ba));
+            _mm_storeu_si128((__m128i*)(out + 4 * x + 16), _mm_unpackhi_epi16(rg, ba));
+        } else {
+            _mm_storeu_si128((__m128i*)px, _mm_unpacklo_epi16(rg, ba));
+            _mm_storeu_si128((__m128i*)(px + 16), _mm_unpackhi_epi16(rg, ba));
+            for (i = 0; i < 8; ++i) {
+                memcpy((void*)(out + 3 * (x + i)), (void*)(px + 4 * i), 3);
+            }
+        }
+    }
+#else
+    (void)simd;
+#endif
+
+    for (out += x * n_ch; x < n; ++x, out += n_ch) {
+        yv = yrow[x];
+        cb = cbrow[x] - 128;
+        cr = crrow[x] - 128;
+        out[ri] = _imc_jpeg_clamp(yv + ((91881 * cr + 32768) >> 16));
+        out[1] = _imc_jpeg_clamp(yv + ((-22554 * cb - 46802 * cr + 32768) >> 16));
+        out[bi] = _imc_jpeg_clamp(yv + ((116130 * cb + 32768) >> 16));
+        if (n_ch == 4) {
+            out[3] = 0xFF;
+        }
+    }
+}
+
+/**
+ * @brief Returns the transform which turns an image stored with the given EXIF orientation upright.
+ * @since 16-10-2026
+ * @param[in] data The JPEG file's contents
+ * @param[in] size The length of __data__ (in bytes)
+ * @returns The transform, which is JPEG_XFORM_NONE if there is no valid Orientation tag
+ */
+static JpegTransform_t _imc_jpeg_exif_orient(const uint8_t* const data, const size_t size) {
+    static const JpegTransform_t xforms[9] = {
+        JPEG_XFORM_NONE, JPEG_XFORM_NONE, JPEG_XFORM_FLIP_H, JPEG_XFORM_ROT_180, JPEG_XFORM_FLIP_V,
+        JPEG_XFORM_TRANSPOSE, JPEG_XFORM_ROT_90, JPEG_XFORM_TRANSVERSE, JPEG_XFORM_ROT_270
+    };
+    Exif_t exif;
+    uint16_t orientation;
+
+    if (imc_exif_from_jpeg(data, size, &exif) != IMC_EOK
+        || imc_exif_orientation(&exif, &orientation) != IMC_EOK) {
+        return JPEG_XFORM_NONE;
+    }
+
+    return xforms[orientation];
+}
+
+/**
+ * @brief Places a band of converted rows at their rotated or mirrored position in __pixmap__.
+ * When the transform swaps the axes, each column of the band becomes a run of __n_rows__
+ * neighbouring pixels in one row of __pixmap__, so the band is written a run at a time rather
+ * than a pixel per row.
+ * @since 16-10-2026
+ * @param[in] dec The decoder, whose output dimensions are those of the unrotated image
+ * @param[in] band The converted rows, each dec->out_width pixels wide
+ * @param[in] y The row of the unrotated image held by the first row of __band__
+ * @param[in] n_rows The number of rows in __band__
+ * @param[in,out] pixmap The pixmap, whose dimensions are those of the rotated image
+ */
+static void _imc_jpeg_orient_band(
+    const JpegDecoder_t* const dec,
+    const uint8_t* const band,
+    const size_t y,
+    const size_t n_rows,
+    Pixmap_t *pixmap
+) {
+    const JpegTransform_t xform = dec->orient;
+    const uint8_t *src;
+    uint8_t *dst;
+    size_t x, r, c, dx, dy, n_ch = pixmap->n_channels;
+    size_t src_stride = dec->out_width * n_ch, dst_stride = pixmap->width * n_ch;
+    bool swap = (xform == JPEG_XFORM_TRANSPOSE || xform == JPEG_XFORM_TRANSVERSE
+        || xform == JPEG_XFORM_ROT_90 || xform == JPEG_XFORM_ROT_270);
+    bool mirror_x = (xform == JPEG_XFORM_FLIP_H || xform == JPEG_XFORM_ROT_180
+        || xform == JPEG_XFORM_ROT_90 || xform == JPEG_XFORM_TRANSVERSE);
+    bool mirror_y = (xform == JPEG_XFORM_FLIP_V || xform == JPEG_XFORM_ROT_180
+        || xform == JPEG_XFORM_ROT_270 || xform == JPEG_XFORM_TRANSVERSE);
+    ptrdiff_t step = mirror_x ? -(ptrdiff_t)n_ch : (ptrdiff_t)n_ch;
+
+    if (!swap) {
+        for (r = 0; r < n_rows; ++r) {
+            src = band + r * src_stride;
+            dy = mirror_y ? pixmap->height - 1 - (y + r) : y + r;
+            dst = pixmap->data + dy * dst_stride;
+            if (!mirror_x) {
+                memcpy((void*)dst, (void*)src, src_stride);
+                continue;
+            }
+            for (dst += dst_stride - n_ch, x = 0; x < dec->out_width; ++x, src += n_ch, dst -= n_ch) {
+                for (c = 0; c < n_ch; ++c) {
+                    dst[c] = src[c];
+                }
+            }
+        }
+        return;
+    }
+
+    /* Column x of the band becomes part of row x (or its mirror) of the pixmap */
+    dx = mirror_x ? pixmap->width - 1 - y : y;
+    for (x = 0; x < dec->out_width; ++x) {
+        dy = mirror_y ? pixmap->height - 1 - x : x;
+        dst = pixmap->data + dy * dst_stride + dx * n_ch;
+        src = band + x * n_ch;
+        /* Constant sizes let each pixel be copied by a single load and store */
+        switch (n_ch) {
+            case 1:
+                for (r = 0; r < n_rows; ++r, src += src_stride, dst += step) {
+                    *dst = *src;
+                }
+                break;
+            case 3:
+                for (r = 0; r < n_rows; ++r, src += src_stride, dst += step) {
+                    memcpy((void*)dst, (void*)src, 3);
+                }
+                break;
+            default:
+                for (r = 0; r < n_rows; ++r, src += src_stride, dst += step) {
+                    memcpy((void*)dst, (void*)src, 4);
+                }
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Converts rows of the decoded component planes into the channels of __pixmap__.
+ * The image is produced a row at a time: each component's row is upsampled into a scratch row
+ * (see _imc_jpeg_upsample_row()) and converted straight into __pixmap__, so no full-size
+ * intermediate image is ever written. Three-component images are converted from YCbCr unless an
+ * Adobe segment or the component identifiers say that they hold RGB, and four-component images
+ * are treated as Adobe CMYK or YCCK. A single channel takes the luma plane as it is, or the luma
+ * of the RGB pixels of images without one. If the decoder has a transform to apply (see
+ * JpegDecOpts_t.auto_orient), rows are converted into a band of _JPEG_ORIENT_ROWS rows instead,
+ * each of which is placed straight into its rotated or mirrored position (see
+ * _imc_jpeg_orient_band()), so the image is oriented without a second full-size buffer.
+ * @since 16-10-2026
+ * @param[in] dec The decoder whose planes have been decoded
+ * @param[in] format The channel layout of __pixmap__
+ * @param[in,out] pixmap The pixmap whose dimensions and channels are already set and whose data is
+ * allocated, which receives __pixmap__->height rows of the image (or the whole image, rotated or
+ * mirrored, if the decoder has a transform to apply)
+ * @param[in] y0 The row of the image which becomes the first row of __pixmap__ (0 if the decoder
+ * has a transform to apply)
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_output(
+    const JpegDecoder_t* const dec,
+    const JpegFormat_t format,
+    Pixmap_t *pixmap,
+    const size_t y0
+) {
+    const uint8_t *rows[JPEG_MAX_COMPONENTS];
+    uint8_t *tmp = NULL, *band = NULL, *out;
+    int16_t *colsum = NULL;
+    size_t x, y, n_ch = pixmap->n_channels, row_len = dec->out_width + 16;
+    size_t n_rows = (dec->orient != JPEG_XFORM_NONE) ? dec->out_height : pixmap->height;
+    int r, g, b, k, cb, cr;
+    int ri = (format == JPEG_FMT_BGRA) ? 2 : 0, bi = 2 - ri;
+    uint8_t i;
+    bool is_rgb = _imc_jpeg_is_rgb(dec), is_ycck = (dec->n_comps == 4 && dec->adobe_transform == 2);
+
+    tmp = malloc(row_len * dec->n_comps);
+    colsum = malloc(row_len * sizeof(*colsum));
+    if (dec->orient != JPEG_XFORM_NONE) {
+        band = malloc(_JPEG_ORIENT_ROWS * dec->out_width * n_ch);
+    }
+    if (tmp == NULL || colsum == NULL || (dec->orient != JPEG_XFORM_NONE && band == NULL)) {
+        IMC_LOG("Failed to allocate memory for JPEG row", IMC_ERROR);
+        free(tmp);
+        free(colsum);
+        free(band);
+        return IMC_ENOMEM;
+    }
+
+    for (y = 0; y < n_rows; ++y) {
+        if (band != NULL && y > 0 && y % _JPEG_ORIENT_ROWS == 0) {
+            _imc_jpeg_orient_band(dec, band, y - _JPEG_ORIENT_ROWS, _JPEG_ORIENT_ROWS, pixmap);
+        }
+
+        for (i = 0; i < dec->n_comps; ++i) {
+            if (!dec->comps[i].skip) {
+                rows[i] = _imc_jpeg_upsample_row(dec, &dec->comps[i], y0 + y, tmp + i * row_len, colsum);
+            }
+        }
+
+        out = (band != NULL) ? band + (y % _JPEG_ORIENT_ROWS) * dec->out_width * n_ch
+            : pixmap->data + y * dec->out_width * n_ch;
+        if (n_ch == 1 && (dec->n_comps == 1 || dec->comps[1].skip)) {
+            memcpy((void*)out, (void*)rows[0], dec->out_width);
+            continue;
+        } else if (dec->n_comps == 3 && !is_rgb && n_ch >= 3) {
+            _imc_jpeg_ycc_row(rows[0], rows[1], rows[2], out, dec->out_width, n_ch,
+                format == JPEG_FMT_BGRA, dec->simd);
+            continue;
+        }
+
+        for (x = 0; x < dec->out_width; ++x, out += n_ch) {
+            if (dec->n_comps == 1) {
+                r = g = b = rows[0][x];
+            } else if (is_rgb) {
+                r = rows[0][x];
+                g = rows[1][x];
+                b = rows[2][x];
+            } else {
+                cb = rows[1][x] - 128;
+                cr = rows[2][x] - 128;
+                r = rows[0][x] + ((91881 * cr + 32768) >> 16);
+                g = rows[0][x] + ((-22554 * cb - 46802 * cr + 32768) >> 16);
+                b = rows[0][x] + ((116130 * cb + 32768) >> 16);
+            }
+
+            if (dec->n_comps == 4) {
+                /* Adobe stores CMYK inverted, so each channel is scaled by the inverted black */
+                k = rows[3][x];
+                if (is_ycck) {
+                    r = 255 - _imc_jpeg_clamp(r);
+                    g = 255 - _imc_jpeg_clamp(g);
+                    b = 255 - _imc_jpeg_clamp(b);
+                }
+                r = (_imc_jpeg_clamp(r) * k + 127) / 255;
+                g = (_imc_jpeg_clamp(g) * k + 127) / 255;
+                b = (_imc_jpeg_clamp(b) * k + 127) / 255;
+            }
+
+            if (n_ch == 1) {
+                /* Luma of RGB and CMYK images, with libjpeg's weights */
+                out[0] = (uint8_t)((19595 * _imc_jpeg_clamp(r) + 38470 * _imc_jpeg_clamp(g)
+                    + 7471 * _imc_jpeg_clamp(b) + 32768) >> 16);
+                continue;
+            }
+            out[ri] = _imc_jpeg_clamp(r);
+            out[1] = _imc_jpeg_clamp(g);
+            out[bi] = _imc_jpeg_clamp(b);
+            if (n_ch == 4) {
+                out[3] = 0xFF;
+            }
+        }
+    }
+
+    if (band != NULL && n_rows > 0) {
+        _imc_jpeg_orient_band(dec, band, (n_rows - 1) / _JPEG_ORIENT_ROWS * _JPEG_ORIENT_ROWS,
+            (n_rows - 1) % _JPEG_ORIENT_ROWS + 1, pixmap);
+    }
+
+    free(tmp);
+    free(colsum);
+    free(band);
+    return IMC_EOK;
+}
+
+/**
+ * @brief Frees the component planes and coefficient buffers of __dec__.
+ * @since 16-10-2026
+ * @param[in,out] dec The decoder
+ */
+static void _imc_jpeg_dec_destroy(JpegDecoder_t *dec) {
+    uint8_t i;
+
+    for (i = 0; i < JPEG_MAX_COMPONENTS; ++i) {
+        free(dec->comps[i].plane);
+        free(dec->comps[i].coefs);
+        dec->comps[i].plane = NULL;
+        dec->comps[i].coefs = NULL;
+    }
+}
+
+/**
+ * @brief Allocates a decoder for the JPEG held in memory at __data__ and applies __opts__ to it.
+ * @since 16-10-2026
+ * @param[in] data The JPEG file's contents
+ * @param[in] size The length of __data__ (in bytes)
+ * @param[in] opts Decoding options
+ * @returns The decoder or NULL if an error occurred
+ */
+static JpegDecoder_t *_imc_jpeg_dec_create(
+    const uint8_t* const data,
+    const size_t size,
+    const JpegDecOpts_t* const opts
+) {
+    JpegDecoder_t *dec = NULL;
+    long n_cpus;
+
+    if (opts->scale_denom != 1 && opts->scale_denom != 2 && opts->scale_denom != 4 && opts->scale_denom != 8) {
+        IMC_LOG("JPEG scale denominator must be 1, 2, 4 or 8", IMC_ERROR);
+        return NULL;
+    }
+
+    dec = calloc(1, sizeof(JpegDecoder_t));
+    if (dec == NULL) {
+        IMC_LOG("Failed to allocate memory for JPEG decoder", IMC_ERROR);
+        return NULL;
+    }
+    dec->data = dec->pos = data;
+    dec->end = data + size;
+    dec->adobe_transform = -1;
+    dec->idct = _imc_jpeg_select_idct(opts->simd);
+    dec->block_size = opts->dc_only ? 1 : 8 / opts->scale_denom;
+    dec->simd = opts->simd;
+    dec->fancy = opts->fancy_upsampling && dec->block_size > 1;
+    dec->preview = opts->preview;
+    dec->dc_only = opts->dc_only;
+    dec->luma_only = (opts->format == JPEG_FMT_LUMA);
+    dec->n_threads = opts->n_threads;
+    if (dec->n_threads == 0) {
+        n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        dec->n_threads = (n_cpus > 0) ? (size_t)n_cpus : 1;
+    }
+
+    return dec;
+}
+
+/**
+ * @brief Returns the number of channels of the pixels __dec__ outputs in __format__.
+ * @since 16-10-2026
+ * @param[in] dec The decoder whose frame header has been read
+ * @param[in] format The channel layout
+ * @returns The number of channels
+ */
+static size_t _imc_jpeg_out_channels(const JpegDecoder_t* const dec, const JpegFormat_t format) {
+    switch (format) {
+        case JPEG_FMT_RGB:
+            return 3;
+        case JPEG_FMT_RGBA:
+        case JPEG_FMT_BGRA:
+            return 4;
+        case JPEG_FMT_LUMA:
+            return 1;
+        default:
+            return (dec->n_comps == 1) ? 1 : 3;
+    }
+}
+
+/**
+ * @brief Decodes row __my__ of the MCUs of the scan left to be streamed into the windows onto the planes.
+ * @since 16-10-2026
+ * @param[in] dec The decoder
+ * @param[in,out] br The bit reader, positioned at the row's first MCU
+ * @param[in] my The row of MCUs
+ * @param[in,out] dc_pred The DC predictor of each component, carried from row to row
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_decode_mcu_row(
+    const JpegDecoder_t* const dec,
+    JpegBits_t *br,
+    const size_t my,
+    int *dc_pred
+) {
+    const JpegScan_t *scan = &dec->scan;
+    ImcError_t status;
+    size_t mcu, next, end;
+
+    for (mcu = my * scan->n_mcux, end = mcu + scan->n_mcux; mcu < end; mcu = next) {
+        if (dec->restart_interval > 0 && mcu > 0 && mcu % dec->restart_interval == 0) {
+            _imc_jpeg_restart(br);
+            memset((void*)dc_pred, 0, JPEG_MAX_COMPONENTS * sizeof(*dc_pred));
+        }
+        next = (dec->restart_interval > 0) ? (mcu / dec->restart_interval + 1) * dec->restart_interval : end;
+        next = (next < end) ? next : end;
+
+        status = _imc_jpeg_decode_mcus(dec, scan, br, mcu, next - mcu, dc_pred);
+        if (status != IMC_EOK) {
+            return status;
+        }
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Decodes the frame of __dec__ a row of MCUs at a time, passing each band of output rows to __sink__.
+ * A scan left to be streamed is decoded into windows onto the component planes. After each row of
+ * MCUs, every output row whose samples (and the samples interpolated with them) have been decoded
+ * is converted and handed to __sink__, and each window slides down to the rows still needed.
+ * Restart intervals are followed serially. A frame whose planes were decoded whole, because it is
+ * progressive or its components were coded in separate scans, is output in bands of the same
+ * height.
+ * @since 16-10-2026
+ * @param[in,out] dec The decoder whose segments have been read
+ * @param[in] format The channel layout of the bands
+ * @param[in] sink The sink which receives the bands
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_stream(
+    JpegDecoder_t *dec,
+    const JpegFormat_t format,
+    const JpegBandSink_t* const sink
+) {
+    const JpegScan_t *scan = &dec->scan;
+    JpegComp_t *comp;
+    JpegBits_t br = { 0 };
+    Pixmap_t band;
+    ImcError_t status = IMC_EOK;
+    int dc_pred[JPEG_MAX_COMPONENTS] = { 0 };
+    size_t avail, keep, y_end, my = 0, y = 0;
+    size_t vs, vs_max = dec->vmax * dec->block_size;
+    uint8_t i;
+
+    band.width = dec->out_width;
+    band.n_channels = _imc_jpeg_out_channels(dec, format);
+    band.offset = 0;
+    band.bit_depth = 8;
+    band.data = malloc(band.width * (2 * vs_max + 1) * band.n_channels);
+    if (band.data == NULL) {
+        IMC_LOG("Failed to allocate memory for JPEG band", IMC_ERROR);
+        return IMC_ENOMEM;
+    }
+
+    br.pos = dec->pos;
+    br.end = dec->end;
+
+    while (y < dec->out_height) {
+        y_end = (y + vs_max < dec->out_height) ? y + vs_max : dec->out_height;
+
+        if (scan->n_comps > 0) {
+            status = _imc_jpeg_decode_mcu_row(dec, &br, my, dc_pred);
+            if (status != IMC_EOK) {
+                goto cleanup;
+            }
+
+            /* Hold back the rows interpolated with samples of the next row of MCUs */
+            y_end = dec->out_height;
+            for (i = 0, ++my; i < dec->n_comps && my < scan->n_mcuy; ++i) {
+                comp = &dec->comps[i];
+                if (comp->skip) {
+                    continue;
+                }
+                vs = comp->v * comp->bs;
+                avail = my * _imc_jpeg_mcu_rows(dec, comp);
+                if ((avail - 1) * vs_max / vs < y_end) {
+                    y_end = (avail - 1) * vs_max / vs;
+                }
+            }
+        }
+
+        if (y_end > y) {
+            band.height = y_end - y;
+            status = _imc_jpeg_output(dec, format, &band, y);
+            if (status == IMC_EOK) {
+                status = sink->band(sink->ctx, &band, y);
+            }
+            if (status != IMC_EOK) {
+                goto cleanup;
+            }
+            y = y_end;
+        }
+
+        /* Keep the row above the next output row's samples, which it may be interpolated with */
+        for (i = 0; i < dec->n_comps && scan->n_comps > 0; ++i) {
+            comp = &dec->comps[i];
+            if (comp->skip) {
+                continue;
+            }
+            vs = comp->v * comp->bs;
+            avail = my * _imc_jpeg_mcu_rows(dec, comp);
+            keep = y * vs / vs_max;
+            keep = (keep > comp->row0) ? keep - 1 : comp->row0;
+            memmove((void*)comp->plane, (void*)(comp->plane + (keep - comp->row0) * comp->stride),
+                (avail - keep) * comp->stride);
+            comp->row0 = keep;
+        }
+    }
+
+cleanup:
+    free(band.data);
+    return status;
+}
+
+/**
+ * @brief Sets the number of planes of __planes__ and the dimensions of each to those decoded by __dec__.
+ * Each plane is as large as libjpeg's raw output of its component: the image dimensions scaled by
+ * the component's sampling relative to the largest and by the decoded block size, rounded up.
+ * @since 16-10-2026
+ * @param[in] dec The decoder whose frame header has been read
+ * @param[out] planes The planes
+ */
+static void _imc_jpeg_plane_dims(const JpegDecoder_t* const dec, JpegPlanes_t *planes) {
+    const JpegComp_t *comp;
+    uint8_t i;
+
+    planes->n_planes = dec->n_comps;
+    for (i = 0; i < dec->n_comps; ++i) {
+        comp = &dec->comps[i];
+        planes->width[i] = (dec->width * comp->h * comp->bs + dec->hmax * 8 - 1) / (dec->hmax * 8);
+        planes->height[i] = (dec->height * comp->v * comp->bs + dec->vmax * 8 - 1) / (dec->vmax * 8);
+    }
+}
+
+/**
+ * @brief Decodes the frame of __dec__ into the caller's __planes__ without upsampling or color conversion.
+ * A scan left to be streamed is decoded a row of MCUs at a time into the windows onto the
+ * component planes, whose rows are copied out while they are still in cache. Nothing needs to be
+ * kept between rows, so each row of MCUs is decoded to the top of the windows. A frame whose
+ * planes were decoded whole has them copied out in one go.
+ * @since 16-10-2026
+ * @param[in,out] dec The decoder whose segments have been read
+ * @param[in] planes The planes, whose dimensions are set and whose data is allocated
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_stream_planes(JpegDecoder_t *dec, const JpegPlanes_t* const planes) {
+    JpegComp_t *comp;
+    JpegBits_t br = { 0 };
+    ImcError_t status;
+    int dc_pred[JPEG_MAX_COMPONENTS] = { 0 };
+    size_t row, end, my, n_mcuy = (dec->scan.n_comps > 0) ? dec->scan.n_mcuy : 1;
+    uint8_t i;
+
+    br.pos = dec->pos;
+    br.end = dec->end;
+
+    for (my = 0; my < n_mcuy; ++my) {
+        if (dec->scan.n_comps > 0) {
+            status = _imc_jpeg_decode_mcu_row(dec, &br, my, dc_pred);
+            if (status != IMC_EOK) {
+                return status;
+            }
+        }
+
+        for (i = 0; i < dec->n_comps; ++i) {
+            comp = &dec->comps[i];
+            row = (dec->scan.n_comps > 0) ? my * _imc_jpeg_mcu_rows(dec, comp) : 0;
+            end = (dec->scan.n_comps > 0) ? row + _imc_jpeg_mcu_rows(dec, comp) : planes->height[i];
+            for (end = (end < planes->height[i]) ? end : planes->height[i]; row < end; ++row) {
+                memcpy((void*)(planes->data[i] + row * planes->stride[i]),
+                    (void*)(comp->plane + (row - comp->row0) * comp->stride), planes->width[i]);
+            }
+            comp->row0 = (dec->scan.n_comps > 0) ? (my + 1) * _imc_jpeg_mcu_rows(dec, comp) : 0;
+        }
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Returns the size of the file referenced by __fp__, leaving it positioned at the start.
+ * @since 16-10-2026
+ * @param[in] fp The file handle
+ * @returns The size of the file (in bytes)
+ */
+static size_t _imc_jpeg_file_size(FILE *fp) {
+    size_t size;
+
+    fseek(fp, 0L, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0L, SEEK_SET);
+
+    return size;
+}
+
+/**
+ * @brief Scales a standard quantization table by an IJG quality factor.
+ * @since 16-10-2026
+ * @param[in] base The table of ITU T.81 Annex K in natural order
+ * @param[in] quality The quality (1-100)
+ * @param[out] qt The scaled table in natural order, limited to 1-255 for baseline
+ */
+static void _imc_jpeg_scale_qt(const uint8_t* const base, const uint8_t quality, uint16_t *qt) {
+    int i, scale, q;
+
+    scale = (quality < 50) ? 5000 / quality : 200 - 2 * quality;
+    for (i = 0; i < 64; ++i) {
+        q = (base[i] * scale + 50) / 100;
+        qt[i] = (uint16_t)((q < 1) ? 1 : ((q > 255) ? 255 : q));
+    }
+}
+
+/**
+ * @brief Computes the reciprocals that quantize the output of the forward DCT by __qt__.
+ * The forward DCT leaves its outputs scaled up by 8, so each divisor is 8q. Dividing a magnitude
+ * x by d with rounding then becomes ((x + c) * m) >> (16 + s), where m is a 16-bit reciprocal
+ * and c folds the rounding term into a correction for the error of m. The scale 2^(16 - s) lets
+ * SIMD code apply the shift as a second high multiply.
+ * @since 16-10-2026
+ * @param[in] qt The quantization table in natural order
+ * @param[out] divisors The reciprocals, corrections, scales and shifts (64 of each)
+ */
+static void _imc_jpeg_reciprocals(const uint16_t* const qt, uint16_t *divisors) {
+    uint32_t d, fq, fr, c;
+    int i, b, r;
+
+    for (i = 0; i < 64; ++i) {
+        d = (uint32_t)qt[i] * 8;
+        for (b = 0; (d >> (b + 1)) != 0; ++b);
+        r = 16 + b;
+        fq = (1u << r) / d;
+        fr = (1u << r) % d;
+        c = d / 2;
+        if (fr == 0) {
+            /* Powers of two would need a 17-bit reciprocal */
+            fq >>= 1;
+            r--;
+        } else if (fr <= d / 2) {
+            c++;
+        } else {
+            fq++;
+        }
+
+        divisors[i] = (uint16_t)fq;
+        divisors[64 + i] = (uint16_t)c;
+        divisors[128 + i] = (uint16_t)(1u << (32 - r));
+        divisors[192 + i] = (uint16_t)(r - 16);
+    }
+}
+
+/**
+ * @brief Quantizes a coefficient produced by the forward DCT.
+ * @since 16-10-2026
+ * @param[in] x The coefficient (scaled up by 8)
+ * @param[in] divisors The table produced by _imc_jpeg_reciprocals()
+ * @param[in] i The coefficient's position in natural order
+ * @returns The quantized coefficient
+ */
+static inline int16_t _imc_jpeg_quantize(const int32_t x, const uint16_t* const divisors, const int i) {
+    uint32_t a = (uint32_t)((x < 0) ? -x : x);
+
+    a = ((a + divisors[64 + i]) * divisors[i]) >> (16 + divisors[192 + i]);
+    return (int16_t)((x < 0) ? -(int32_t)a : (int32_t)a);
+}
+
+/**
+ * @brief Computes the forward DCT of a block and quantizes it.
+ * This is the accurate integer algorithm of the IJG's jfdctint.c (Loeffler, Ligtenberg and
+ * Moschytz), with 13 bits of fixed-point precision and 2 extra bits carried between the row and
+ * column passes. Its outputs are scaled up by 8, which the divisors account for.
+ * @since 16-10-2026
+ * @param[in] in The top-left sample of the 8x8 input block
+ * @param[in] stride The distance between rows of __in__ (in bytes)
+ * @param[in] divisors The table produced by _imc_jpeg_reciprocals()
+ * @param[out] coefs The quantized coefficients in natural order
+ */
+static void _imc_jpeg_fdct_islow(
+    const uint8_t* const in,
+    const size_t stride,
+    const uint16_t* const divisors,
+    int16_t *coefs
+) {
+    int32_t tmp0, tmp1, tmp2, tmp3, tmp4, tmp5, tmp6, tmp7;
+    int32_t tmp10, tmp11, tmp12, tmp13, z1, z2, z3, z4, z5;
+    int32_t ws[64];
+    const uint8_t *p;
+    int32_t *w;
+    int i;
+
+    /* Rows: level shift and scale up by 2 bits */
+    for (i = 0, p = in, w = ws; i < 8; ++i, p += stride, w += 8) {
+        tmp0 = p[0] + p[7] - 256;
+        tmp7 = p[0] - p[7];
+        tmp1 = p[1] + p[6] - 256;
+        tmp6 = p[1] - p[6];
+        tmp2 = p[2] + p[5] - 256;
+        tmp5 = p[2] - p[5];
+        tmp3 = p[3] + p[4] - 256;
+        tmp4 = p[3] - p[4];
+
+        tmp10 = tmp0 + tmp3;
+        tmp13 = tmp0 - tmp3;
+        tmp11 = tmp1 + tmp2;
+        tmp12 = tmp1 - tmp2;
+        w[0] = (tmp10 + tmp11) * 4;
+        w[4] = (tmp10 - tmp11) * 4;
+        z1 = (tmp12 + tmp13) * 4433;
+        w[2] = (z1 + tmp13 * 6270 + (1 << 10)) >> 11;
+        w[6] = (z1 - tmp12 * 15137 + (1 << 10)) >> 11;
+
+        z1 = tmp4 + tmp7;
+        z2 = tmp5 + tmp6;
+        z3 = tmp4 + tmp6;
+        z4 = tmp5 + tmp7;
+        z5 = (z3 + z4) * 9633;
+        tmp4 *= 2446;
+        tmp5 *= 16819;
+        tmp6 *= 25172;
+        tmp7 *= 12299;
+        z1 *= -7373;
+        z2 *= -20995;
+        z3 = z3 * -16069 + z5;
+        z4 = z4 * -3196 + z5;
+        w[7] = (tmp4 + z1 + z3 + (1 << 10)) >> 11;
+        w[5] = (tmp5 + z2 + z4 + (1 << 10)) >> 11;
+        w[3] = (tmp6 + z2 + z3 + (1 << 10)) >> 11;
+        w[1] = (tmp7 + z1 + z4 + (1 << 10)) >> 11;
+    }
+
+    /* Columns: remove the 2 bits, leaving the outputs scaled up by 8 */
+    for (i = 0, w = ws; i < 8; ++i, ++w) {
+        tmp0 = w[0] + w[56];
+        tmp7 = w[0] - w[56];
+        tmp1 = w[8] + w[48];
+        tmp6 = w[8] - w[48];
+        tmp2 = w[16] + w[40];
+        tmp5 = w[16] - w[40];
+        tmp3 = w[24] + w[32];
+        tmp4 = w[24] - w[32];
+
+        tmp10 = tmp0 + tmp3;
+        tmp13 = tmp0 - tmp3;
+        tmp11 = tmp1 + tmp2;
+        tmp12 = tmp1 - tmp2;
+        coefs[i] = _imc_jpeg_quantize((tmp10 + tmp11 + 2) >> 2, divisors, i);
+        coefs[32 + i] = _imc_jpeg_quantize((tmp10 - tmp11 + 2) >> 2, divisors, 32 + i);
+        z1 = (tmp12 + tmp13) * 4433;
+        coefs[16 + i] = _imc_jpeg_quantize((z1 + tmp13 * 6270 + (1 << 14)) >> 15, divisors, 16 + i);
+        coefs[48 + i] = _imc_jpeg_quantize((z1 - tmp12 * 15137 + (1 << 14)) >> 15, divisors, 48 + i);
+
+        z1 = tmp4 + tmp7;
+        z2 = tmp5 + tmp6;
+        z3 = tmp4 + tmp6;
+        z4 = tmp5 + tmp7;
+        z5 = (z3 + z4) * 9633;
+        tmp4 *= 2446;
+        tmp5 *= 16819;
+        tmp6 *= 25172;
+        tmp7 *= 12299;
+        z1 *= -7373;
+        z2 *= -20995;
+        z3 = z3 * -16069 + z5;
+        z4 = z4 * -3196 + z5;
+        coefs[56 + i] = _imc_jpeg_quantize((tmp4 + z1 + z3 + (1 << 14)) >> 15, divisors, 56 + i);
+        coefs[40 + i] = _imc_jpeg_quantize((tmp5 + z2 + z4 + (1 << 14)) >> 15, divisors, 40 + i);
+        coefs[24 + i] = _imc_jpeg_quantize((tmp6 + z2 + z3 + (1 << 14)) >> 15, divisors, 24 + i);
+        coefs[8 + i] = _imc_jpeg_quantize((tmp7 + z1 + z4 + (1 << 14)) >> 15, divisors, 8 + i);
+    }
+}
+
+#if defined(_JPEG_X86)
+
+/**
+ * @brief Multiplies interleaved pairs of 16-bit vectors by a pair of constants with pmaddwd,
+ * adds a 32-bit term to each half, shifts right by __shift__ and narrows the results to 16 bits.
+ * @since 16-10-2026
+ * @param[in] a The first operand of each pair
+ * @param[in] b The second operand of each pair
+ * @param[in] k The constants, built with _JPEG_PAIR()
+ * @param[in] add_lo The term added to the products of lanes 0-3
+ * @param[in] add_hi The term added to the products of lanes 4-7
+ * @param[in] shift The number of bits to descale by
+ * @returns a * k1 + b * k2 for each lane, descaled
+ */
+__attribute__((target("sse2")))
+static inline __m128i _imc_jpeg_madd_sse2(
+    const __m128i a,
+    const __m128i b,
+    const __m128i k,
+    const __m128i add_lo,
+    const __m128i add_hi,
+    const int shift
+) {
+    __m128i lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(a, b), k), add_lo);
+    __m128i hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(a, b), k), add_hi);
+
+    return _mm_packs_epi32(_mm_srai_epi32(lo, shift), _mm_srai_epi32(hi, shift));
+}
+
+/**
+ * @brief Computes the 1D LLM forward DCT of eight vectors in place.
+ * The odd part and the rotation of the even part are pmaddwd products of interleaved pairs, as
+ * in _imc_jpeg_idct_half_sse2(). Outputs 0 and 4 are 16-bit sums which are either scaled up by
+ * 2 bits (__first__) or rounded and scaled down by 2 bits, and the other outputs are rounded and
+ * shifted right by __shift__.
+ * @since 16-10-2026
+ * @param[in,out] r The vectors, where r[k] holds the k-th input (then output) of eight transforms
+ * @param[in] first True for the row pass, false for the column pass
+ * @param[in] shift The number of bits to descale the other outputs by
+ */
+__attribute__((target("sse2")))
+static inline void _imc_jpeg_fdct_1d_sse2(__m128i *r, const bool first, const int shift) {
+    __m128i tmp0, tmp1, tmp2, tmp3, tmp4, tmp5, tmp6, tmp7, tmp10, tmp11, tmp12, tmp13;
+    __m128i z34lo, z34hi, z3lo, z3hi, z4lo, z4hi;
+    const __m128i bias = _mm_set1_epi32(1 << (shift - 1)), two = _mm_set1_epi16(2);
+
+    tmp0 = _mm_add_epi16(r[0], r[7]);
+    tmp7 = _mm_sub_epi16(r[0], r[7]);
+    tmp1 = _mm_add_epi16(r[1], r[6]);
+    tmp6 = _mm_sub_epi16(r[1], r[6]);
+    tmp2 = _mm_add_epi16(r[2], r[5]);
+    tmp5 = _mm_sub_epi16(r[2], r[5]);
+    tmp3 = _mm_add_epi16(r[3], r[4]);
+    tmp4 = _mm_sub_epi16(r[3], r[4]);
+
+    /* Even part */
+    tmp10 = _mm_add_epi16(tmp0, tmp3);
+    tmp13 = _mm_sub_epi16(tmp0, tmp3);
+    tmp11 = _mm_add_epi16(tmp1, tmp2);
+    tmp12 = _mm_sub_epi16(tmp1, tmp2);
+    if (first) {
+        r[0] = _mm_slli_epi16(_mm_add_epi16(tmp10, tmp11), 2);
+        r[4] = _mm_slli_epi16(_mm_sub_epi16(tmp10, tmp11), 2);
+    } else {
+        r[0] = _mm_srai_epi16(_mm_add_epi16(_mm_add_epi16(tmp10, tmp11), two), 2);
+        r[4] = _mm_srai_epi16(_mm_add_epi16(_mm_sub_epi16(tmp10, tmp11), two), 2);
+    }
+    r[2] = _imc_jpeg_madd_sse2(tmp13, tmp12, _JPEG_PAIR(4433 + 6270, 4433), bias, bias, shift);
+    r[6] = _imc_jpeg_madd_sse2(tmp13, tmp12, _JPEG_PAIR(4433, 4433 - 15137), bias, bias, shift);
+
+    /* Odd part, with the rounding term folded into the shared products */
+    z34lo = _mm_unpacklo_epi16(_mm_add_epi16(tmp4, tmp6), _mm_add_epi16(tmp5, tmp7));
+    z34hi = _mm_unpackhi_epi16(_mm_add_epi16(tmp4, tmp6), _mm_add_epi16(tmp5, tmp7));
+    z3lo = _mm_add_epi32(_mm_madd_epi16(z34lo, _JPEG_PAIR(9633 - 16069, 9633)), bias);
+    z3hi = _mm_add_epi32(_mm_madd_epi16(z34hi, _JPEG_PAIR(9633 - 16069, 9633)), bias);
+    z4lo = _mm_add_epi32(_mm_madd_epi16(z34lo, _JPEG_PAIR(9633, 9633 - 3196)), bias);
+    z4hi = _mm_add_epi32(_mm_madd_epi16(z34hi, _JPEG_PAIR(9633, 9633 - 3196)), bias);
+
+    r[7] = _imc_jpeg_madd_sse2(tmp4, tmp7, _JPEG_PAIR(2446 - 7373, -7373), z3lo, z3hi, shift);
+    r[1] = _imc_jpeg_madd_sse2(tmp4, tmp7, _JPEG_PAIR(-7373, 12299 - 7373), z4lo, z4hi, shift);
+    r[5] = _imc_jpeg_madd_sse2(tmp5, tmp6, _JPEG_PAIR(16819 - 20995, -20995), z4lo, z4hi, shift);
+    r[3] = _imc_jpeg_madd_sse2(tmp5, tmp6, _JPEG_PAIR(-20995, 25172 - 20995), z3lo, z3hi, shift);
+}
+
+/**
+ * @brief SSE2 version of _imc_jpeg_fdct_islow().
+ * Both passes transform eight rows (then columns) at a time in 16-bit lanes, which hold every
+ * intermediate value of the DCT of 8-bit samples, so the output matches the scalar version
+ * exactly. The quantization divides magnitudes with two high multiplies, by the reciprocal and
+ * then by the scale that applies the shift.
+ * @since 16-10-2026
+ * @param[in] in The top-left sample of the 8x8 input block
+ * @param[in] stride The distance between rows of __in__ (in bytes)
+ * @param[in] divisors The table produced by _imc_jpeg_reciprocals()
+ * @param[out] coefs The quantized coefficients in natural order
+ */
+__attribute__((target("sse2")))
+static void _imc_jpeg_fdct_sse2(
+    const uint8_t* const in,
+    const size_t stride,
+    const uint16_t* const divisors,
+    int16_t *coefs
+) {
+    __m128i r[8], sign, a;
+    const __m128i zero = _mm_setzero_si128(), c128 = _mm_set1_epi16(128);
+    int i;
+
+    for (i = 0; i < 8; ++i) {
+        r[i] = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(in + i * stride)), zero), c128);
+    }
+
+    /* Rows, then columns */
+    _imc_jpeg_transpose_sse2(r);
+    _imc_jpeg_fdct_1d_sse2(r, true, 11);
+    _imc_jpeg_transpose_sse2(r);
+    _imc_jpeg_fdct_1d_sse2(r, false, 15);
+
+    for (i = 0; i < 8; ++i) {
+        sign = _mm_srai_epi16(r[i], 15);
+        a = _mm_sub_epi16(_mm_xor_si128(r[i], sign), sign);
+        a = _mm_add_epi16(a, _mm_loadu_si128((const __m128i*)(divisors + 64 + 8 * i)));
+        a = _mm_mulhi_epu16(a, _mm_loadu_si128((const __m128i*)(divisors + 8 * i)));
+        a = _mm_mulhi_epu16(a, _mm_loadu_si128((const __m128i*)(divisors + 128 + 8 * i)));
+        _mm_storeu_si128((__m128i*)(coefs + 8 * i), _mm_sub_epi16(_mm_xor_si128(a, sign), sign));
+    }
+}
+
+#endif /* _JPEG_X86 */
+
+/**
+ * @brief Selects the fastest forward DCT supported by the CPU.
+ * @since 16-10-2026
+ * @param[in] simd False to always select the scalar reference implementation
+ * @returns The forward DCT function
+ */
+static fdct_func _imc_jpeg_select_fdct(const bool simd) {
+#if defined(_JPEG_X86)
+    if (simd && __builtin_cpu_supports("sse2")) {
+        return _imc_jpeg_fdct_sse2;
+    }
+#else
+    (void)simd;
+#endif
+
+    return _imc_jpeg_fdct_islow;
+}
+
+#if defined(_JPEG_SSE2)
+/**
+ * @brief Sums the pmaddwd products of the interleaved pairs (a, b) and (c, d) with a bias and
+ * keeps the top 16 bits of each 32-bit sum.
+ * @since 16-10-2026
+ * @param[in] a The first operand of the first pair
+ * @param[in] b The second operand of the first pair
+ * @param[in] k1 The constants of the first pair, built with _JPEG_PAIR()
+ * @param[in] c The first operand of the second pair
+ * @param[in] d The second operand of the second pair
+ * @param[in] k2 The constants of the second pair, built with _JPEG_PAIR()
+ * @param[in] bias The 32-bit term added before the shift
+ * @returns (a * k1 + b * k1' + c * k2 + d * k2' + bias) >> 16 for each lane
+ */
+static inline __m128i _imc_jpeg_madd2_sse2(
+    const __m128i a,
+    const __m128i b,
+    const __m128i k1,
+    const __m128i c,
+    const __m128i d,
+    const __m128i k2,
+    const __m128i bias
+) {
+    __m128i lo, hi;
+
+    lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(a, b), k1), _mm_madd_epi16(_mm_unpacklo_epi16(c, d), k2));
+    hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(a, b), k1), _mm_madd_epi16(_mm_unpackhi_epi16(c, d), k2));
+
+    return _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(lo, bias), 16), _mm_srai_epi32(_mm_add_epi32(hi, bias), 16));
+}
+#endif
+
+/**
+ * @brief Converts a row of RGB pixels to YCbCr with libjpeg's fixed-point coefficients.
+ * Eight pixels are converted at a time with SSE2, whose pmaddwd products only take 16-bit
+ * constants, so the coefficients of 0.587 and 0.5 are each split across two products.
+ * @since 16-10-2026
+ * @param[in] in The pixels
+ * @param[in] n_ch The number of channels of each pixel (3 or 4, the fourth being ignored)
+ * @param[out] yrow The luma samples
+ * @param[out] cbrow The blue-difference chroma samples
+ * @param[out] crrow The red-difference chroma samples
+ * @param[in] n The number of pixels
+ * @param[in] simd False to always use the scalar loop
+ */
+static void _imc_jpeg_rgb_ycc_row(
+    const uint8_t *in,
+    const size_t n_ch,
+    uint8_t *yrow,
+    uint8_t *cbrow,
+    uint8_t *crrow,
+    const size_t n,
+    const bool simd
+) {
+    size_t x = 0;
+    int r, g, b;
+#if defined(_JPEG_SSE2)
+    const __m128i mask = _mm_set1_epi32(0xFF), half = _mm_set1_epi32(32768), offset = _mm_set1_epi32(8421375);
+    __m128i lo, hi, r16, g16, b16, y16, cb16, cr16;
+
+    /* Packed RGB is read 16 bytes at a time, which runs 4 bytes past the eighth pixel */
+    for (; simd && x + 8 + ((n_ch == 3) ? 2 : 0) <= n; x += 8) {
+        if (n_ch == 4) {
+            lo = _mm_loadu_si128((const __m128i*)(in + 4 * x));
+            hi = _mm_loadu_si128((const __m128i*)(in + 4 * x + 16));
+        } else {
+            /* Spread each group of 4 pixels into 32-bit lanes, whose top bytes are ignored */
+            lo = _mm_loadu_si128((const __m128i*)(in + 3 * x));
+            hi = _mm_loadu_si128((const __m128i*)(in + 3 * x + 12));
+            lo = _mm_unpacklo_epi64(_mm_unpacklo_epi32(lo, _mm_srli_si128(lo, 3)),
+                _mm_unpacklo_epi32(_mm_srli_si128(lo, 6), _mm_srli_si128(lo, 9)));
+            hi = _mm_unpacklo_epi64(_mm_unpacklo_epi32(hi, _mm_srli_si128(hi, 3)),
+                _mm_unpacklo_epi32(_mm_srli_si128(hi, 6), _mm_srli_si128(hi, 9)));
+        }
+        r16 = _mm_packs_epi32(_mm_and_si128(lo, mask), _mm_and_si128(hi, mask));
+        g16 = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(lo, 8), mask), _mm_and_si128(_mm_srli_epi32(hi, 8), mask));
+        b16 = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(lo, 16), mask), _mm_and_si128(_mm_srli_epi32(hi, 16), mask));
+
+        /* Y = (19595 * R + 2 * 19235 * G + 7471 * B + 32768) >> 16 */
+        y16 = _imc_jpeg_madd2_sse2(r16, g16, _JPEG_PAIR(19595, 19235), g16, b16, _JPEG_PAIR(19235, 7471), half);
+
+        /* Cb = (-11059 * R - 21709 * G + 2 * 16384 * B + (128 << 16) + 32767) >> 16 */
+        cb16 = _imc_jpeg_madd2_sse2(r16, g16, _JPEG_PAIR(-11059, -21709), b16, b16, _JPEG_PAIR(16384, 16384), offset);
+
+        /* Cr = (2 * 16384 * R - 27439 * G - 5329 * B + (128 << 16) + 32767) >> 16 */
+        cr16 = _imc_jpeg_madd2_sse2(r16, r16, _JPEG_PAIR(16384, 16384), g16, b16, _JPEG_PAIR(-27439, -5329), offset);
+
+        _mm_storel_epi64((__m128i*)(yrow + x), _mm_packus_epi16(y16, y16));
+        _mm_storel_epi64((__m128i*)(cbrow + x), _mm_packus_epi16(cb16, cb16));
+        _mm_storel_epi64((__m128i*)(crrow + x), _mm_packus_epi16(cr16, cr16));
+    }
+#else
+    (void)simd;
+#endif
+
+    for (in += x * n_ch; x < n; ++x, in += n_ch) {
+        r = in[0];
+        g = in[1];
+        b = in[2];
+        yrow[x] = (uint8_t)((19595 * r + 38470 * g + 7471 * b + 32768) >> 16);
+        cbrow[x] = (uint8_t)((-11059 * r - 21709 * g + 32768 * b + 8421375) >> 16);
+        crrow[x] = (uint8_t)((32768 * r - 27439 * g - 5329 * b + 8421375) >> 16);
+    }
+}
+
+/**
+ * @brief Halves a row of chroma samples horizontally, and vertically if __in1__ is given.
+ * Like libjpeg, each output sample is the rounded average of its inputs, with a rounding bias
+ * that alternates between neighbouring samples so that no direction is favoured.
+ * @since 16-10-2026
+ * @param[in] in0 The upper (or only) input row, holding 2 * __n__ samples
+ * @param[in] in1 The lower input row, or NULL to downsample horizontally only
+ * @param[out] out The downsampled row
+ * @param[in] n The number of samples of __out__
+ * @param[in] simd False to always use the scalar loop
+ */
+static void _imc_jpeg_downsample_row(
+    const uint8_t* const in0,
+    const uint8_t* const in1,
+    uint8_t *out,
+    const size_t n,
+    const bool simd
+) {
+    size_t x = 0;
+#if defined(_JPEG_SSE2)
+    const __m128i lo8 = _mm_set1_epi16(0xFF);
+    const __m128i bias = _mm_set1_epi32((in1 != NULL) ? 0x00020001 : 0x00010000);
+    const __m128i shift = _mm_cvtsi32_si128((in1 != NULL) ? 2 : 1);
+    __m128i a, b;
+
+    for (; simd && x + 8 <= n; x += 8) {
+        /* Each 16-bit lane sums the two bytes which it holds */
+        a = _mm_loadu_si128((const __m128i*)(in0 + 2 * x));
+        a = _mm_add_epi16(_mm_and_si128(a, lo8), _mm_srli_epi16(a, 8));
+        if (in1 != NULL) {
+            b = _mm_loadu_si128((const __m128i*)(in1 + 2 * x));
+            a = _mm_add_epi16(a, _mm_add_epi16(_mm_and_si128(b, lo8), _mm_srli_epi16(b, 8)));
+        }
+        a = _mm_srl_epi16(_mm_add_epi16(a, bias), shift);
+        _mm_storel_epi64((__m128i*)(out + x), _mm_packus_epi16(a, a));
+    }
+#else
+    (void)simd;
+#endif
+
+    for (; x < n; ++x) {
+        if (in1 != NULL) {
+            out[x] = (uint8_t)((in0[2 * x] + in0[2 * x + 1] + in1[2 * x] + in1[2 * x + 1] + 1 + (x & 1)) >> 2);
+        } else {
+            out[x] = (uint8_t)((in0[2 * x] + in0[2 * x + 1] + (x & 1)) >> 1);
+        }
+    }
+}
+
+/**
+ * @brief Passes the buffered output of __w__ to its sink.
+ * After the sink has failed, output is discarded and the error is kept in JpegWriter_t.status.
+ * @since 16-10-2026
+ * @param[in,out] w The writer
+ */
+static void _imc_jpeg_flush(JpegWriter_t *w) {
+    if (w->len > 0 && w->status == IMC_EOK) {
+        w->status = w->sink->write(w->sink->ctx, w->buf, w->len);
+    }
+    w->len = 0;
+}
+
+/**
+ * @brief Appends a byte to the output of __w__.
+ * @since 16-10-2026
+ * @param[in,out] w The writer
+ * @param[in] byte The byte
+ */
+static inline void _imc_jpeg_put_byte(JpegWriter_t *w, const uint8_t byte) {
+    if (w->len == sizeof(w->buf)) {
+        _imc_jpeg_flush(w);
+    }
+    w->buf[w->len++] = byte;
+}
+
+/**
+ * @brief Appends a big-endian 16-bit value to the output of __w__.
+ * @since 16-10-2026
+ * @param[in,out] w The writer
+ * @param[in] val The value
+ */
+static void _imc_jpeg_put_u16(JpegWriter_t *w, const uint16_t val) {
+    _imc_jpeg_put_byte(w, (uint8_t)(val >> 8));
+    _imc_jpeg_put_byte(w, (uint8_t)val);
+}
+
+/**
+ * @brief Writes the oldest 32 bits held by __w__, stuffing a zero byte after each 0xFF.
+ * @since 16-10-2026
+ * @param[in,out] w The writer, holding at least 32 bits
+ */
+static inline void _imc_jpeg_put_word(JpegWriter_t *w) {
+    uint32_t word;
+    int i;
+
+    w->n_bits -= 32;
+    word = (uint32_t)(w->acc >> w->n_bits);
+    if (w->len + 8 > sizeof(w->buf)) {
+        _imc_jpeg_flush(w);
+    }
+
+    if (!_JPEG_HAS_FF((uint64_t)word)) {
+        w->buf[w->len] = (uint8_t)(word >> 24);
+        w->buf[w->len + 1] = (uint8_t)(word >> 16);
+        w->buf[w->len + 2] = (uint8_t)(word >> 8);
+        w->buf[w->len + 3] = (uint8_t)word;
+        w->len += 4;
+        return;
+    }
+
+    for (i = 24; i >= 0; i -= 8) {
+        w->buf[w->len++] = (uint8_t)(word >> i);
+        if ((uint8_t)(word >> i) == 0xFF) {
+            w->buf[w->len++] = 0;
+        }
+    }
+}
+
+/**
+ * @brief Appends bits to the entropy-coded output of __w__.
+ * Bits are gathered in a 64-bit buffer and written 32 at a time, so that most calls only shift.
+ * @since 16-10-2026
+ * @param[in,out] w The writer
+ * @param[in] bits The bits, right-justified
+ * @param[in] size The number of bits (at most 32)
+ */
+static inline void _imc_jpeg_put_bits(JpegWriter_t *w, const uint32_t bits, const int size) {
+    w->acc = (w->acc << size) | bits;
+    w->n_bits += size;
+    if (w->n_bits >= 32) {
+        _imc_jpeg_put_word(w);
+    }
+}
+
+/**
+ * @brief Pads the entropy-coded output of __w__ to a whole byte with 1-bits and writes what remains.
+ * @since 16-10-2026
+ * @param[in,out] w The writer
+ */
+static void _imc_jpeg_put_pad(JpegWriter_t *w) {
+    uint8_t byte;
+
+    w->acc = (w->acc << 7) | 0x7F;
+    for (w->n_bits += 7; w->n_bits >= 8; w->n_bits -= 8) {
+        byte = (uint8_t)(w->acc >> (w->n_bits - 8));
+        _imc_jpeg_put_byte(w, byte);
+        if (byte == 0xFF) {
+            _imc_jpeg_put_byte(w, 0);
+        }
+    }
+    w->n_bits = 0;
+}
+
+/**
+ * @brief Returns the number of bits needed to represent __v__.
+ * @since 16-10-2026
+ * @param[in] v A non-negative value
+ * @returns The category of __v__ (0 for 0)
+ */
+static inline int _imc_jpeg_nbits(const int v) {
+    return (v == 0) ? 0 : 32 - __builtin_clz((unsigned)v);
+}
+
+/**
+ * @brief Assigns canonical codes to the symbols of a Huffman table (ITU T.81 Annex C).
+ * @since 16-10-2026
+ * @param[in,out] huff The table whose bits and vals are set
+ */
+static void _imc_jpeg_huff_codes(JpegHuffEnc_t *huff) {
+    uint16_t code = 0;
+    int len, i, k = 0;
+
+    memset((void*)huff->size, 0, sizeof(huff->size));
+    for (len = 1; len <= 16; ++len) {
+        for (i = 0; i < huff->bits[len - 1]; ++i, ++k) {
+            huff->code[huff->vals[k]] = code++;
+            huff->size[huff->vals[k]] = (uint8_t)len;
+        }
+        code <<= 1;
+    }
+}
+
+/**
+ * @brief Sets up one of the Huffman tables suggested by ITU T.81 Annex K.
+ * @since 16-10-2026
+ * @param[out] huff The table
+ * @param[in] bits The number of codes of each length
+ * @param[in] vals The symbols in order of increasing code length
+ */
+static void _imc_jpeg_std_huff(JpegHuffEnc_t *huff, const uint8_t* const bits, const uint8_t* const vals) {
+    int i;
+
+    memcpy((void*)huff->bits, (void*)bits, sizeof(huff->bits));
+    for (i = 0, huff->n_vals = 0; i < 16; ++i) {
+        huff->n_vals += bits[i];
+    }
+    memcpy((void*)huff->vals, (void*)vals, huff->n_vals);
+    _imc_jpeg_huff_codes(huff);
+}
+
+/**
+ * @brief Builds the optimal Huffman table for a set of symbol frequencies.
+ * This is libjpeg's jpeg_gen_optimal_table(), so the same statistics give the same table: a
+ * Huffman tree is built with a reserved symbol of frequency 1, which keeps any code from being
+ * all ones, then codes longer than 16 bits are shortened as described in ITU T.81 Annex K.2.
+ * @since 16-10-2026
+ * @param[in] freq The number of times each symbol occurs
+ * @param[out] huff The table
+ */
+static void _imc_jpeg_optimal_huff(const size_t* const freq, JpegHuffEnc_t *huff) {
+    size_t f[257], v;
+    int codesize[257], others[257], bits[258];
+    int i, j, c1, c2;
+
+    memcpy((void*)f, (void*)freq, 256 * sizeof(*f));
+    f[256] = 1;
+    memset((void*)codesize, 0, sizeof(codesize));
+    memset((void*)bits, 0, sizeof(bits));
+    for (i = 0; i < 257; ++i) {
+        others[i] = -1;
+    }
+
+    for (;;) {
+        /* Merge the two least frequent trees, preferring the larger symbol on ties */
+        c1 = c2 = -1;
+        for (i = 0, v = SIZE_MAX; i < 257; ++i) {
+            if (f[i] != 0 && f[i] <= v) {
+                v = f[i];
+                c1 = i;
+            }
+        }
+        for (i = 0, v = SIZE_MAX; i < 257; ++i) {
+            if (f[i] != 0 && f[i] <= v && i != c1) {
+                v = f[i];
+                c2 = i;
+            }
+        }
+        if (c2 < 0) {
+            break;
+        }
+
+        f[c1] += f[c2];
+        f[c2] = 0;
+        for (codesize[c1]++; others[c1] >= 0; codesize[c1]++) {
+            c1 = others[c1];
+        }
+        others[c1] = c2;
+        for (codesize[c2]++; others[c2] >= 0; codesize[c2]++) {
+            c2 = others[c2];
+        }
+    }
+
+    for (i = 0; i < 257; ++i) {
+        bits[codesize[i]]++;
+    }
+
+    /* Move pairs of the longest codes up, splitting a shorter code to make room */
+    for (i = 257; i > 16; --i) {
+        while (bits[i] > 0) {
+            for (j = i - 2; bits[j] == 0; --j);
+            bits[i] -= 2;
+            bits[i - 1]++;
+            bits[j + 1] += 2;
+            bits[j]--;
+        }
+    }
+
+    /* Give up the reserved symbol's code, which is one of the longest */
+    for (i = 16; bits[i] == 0; --i);
+    bits[i]--;
+
+    for (i = 1; i <= 16; ++i) {
+        huff->bits[i - 1] = (uint8_t)bits[i];
+    }
+    huff->n_vals = 0;
+    for (i = 1; i <= 257; ++i) {
+        for (j = 0; j < 256; ++j) {
+            if (codesize[j] == i) {
+                huff->vals[huff->n_vals++] = (uint8_t)j;
+            }
+        }
+    }
+    _imc_jpeg_huff_codes(huff);
+}
+
+/**
+ * @brief Reorders the AC coefficients of a block into zig-zag order.
+ * @since 16-10-2026
+ * @param[in] block The quantized coefficients in natural order
+ * @param[out] zz The coefficients in zig-zag order (zz[0] does not hold the DC coefficient)
+ * @returns A mask with bit k set if the k-th coefficient in zig-zag order is non-zero
+ */
+static inline uint64_t _imc_jpeg_zigzag(const int16_t* const block, int16_t *zz) {
+    uint64_t mask = 0;
+    int k;
+#if defined(_JPEG_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i a, b;
+
+    for (k = 1; k < 64; ++k) {
+        zz[k] = block[_jpeg_natural_order[k]];
+    }
+    zz[0] = 0;
+    for (k = 0; k < 64; k += 16) {
+        a = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)(zz + k)), zero);
+        b = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i*)(zz + k + 8)), zero);
+        mask |= (uint64_t)(uint16_t)~_mm_movemask_epi8(_mm_packs_epi16(a, b)) << k;
+    }
+#else
+    for (k = 1; k < 64; ++k) {
+        zz[k] = block[_jpeg_natural_order[k]];
+        mask |= (uint64_t)(zz[k] != 0) << k;
+    }
+#endif
+
+    return mask;
+}
+
+/**
+ * @brief Counts the Huffman symbols which a block will be coded with.
+ * @since 16-10-2026
+ * @param[in] block The quantized coefficients in natural order
+ * @param[in,out] dc_pred The DC coefficient of the component's previous block
+ * @param[in,out] dc_freq The frequencies of the DC symbols
+ * @param[in,out] ac_freq The frequencies of the AC symbols
+ */
+static void _imc_jpeg_count_block(
+    const int16_t* const block,
+    int *dc_pred,
+    size_t *dc_freq,
+    size_t *ac_freq
+) {
+    int16_t zz[64];
+    uint64_t mask = _imc_jpeg_zigzag(block, zz);
+    int k, v, run, last = 0;
+
+    v = block[0] - *dc_pred;
+    *dc_pred = block[0];
+    dc_freq[_imc_jpeg_nbits((v < 0) ? -v : v)]++;
+
+    for (; mask != 0; mask &= mask - 1, last = k) {
+        k = __builtin_ctzll(mask);
+        for (run = k - last - 1; run > 15; run -= 16) {
+            ac_freq[0xF0]++;
+        }
+        v = zz[k];
+        ac_freq[(run << 4) + _imc_jpeg_nbits((v < 0) ? -v : v)]++;
+    }
+    if (last != 63) {
+        ac_freq[0x00]++;
+    }
+}
+
+/**
+ * @brief Huffman codes a block.
+ * The non-zero AC coefficients are visited through a bit mask, so runs of zeros are skipped
+ * in one step, and each code is written together with the bits which follow it.
+ * @since 16-10-2026
+ * @param[in,out] w The writer
+ * @param[in] block The quantized coefficients in natural order
+ * @param[in,out] dc_pred The DC coefficient of the component's previous block
+ * @param[in] dc The DC Huffman table
+ * @param[in] ac The AC Huffman table
+ */
+static void _imc_jpeg_emit_block(
+    JpegWriter_t *w,
+    const int16_t* const block,
+    int *dc_pred,
+    const JpegHuffEnc_t* const dc,
+    const JpegHuffEnc_t* const ac
+) {
+    int16_t zz[64];
+    uint64_t mask = _imc_jpeg_zigzag(block, zz);
+    int k, v, s, sym, run, last = 0;
+
+    /* Negative values are sent as their one's complement in s bits */
+    v = block[0] - *dc_pred;
+    *dc_pred = block[0];
+    s = _imc_jpeg_nbits((v < 0) ? -v : v);
+    _imc_jpeg_put_bits(w, ((uint32_t)dc->code[s] << s) | ((uint32_t)(v - (v < 0)) & ((1u << s) - 1)),
+        dc->size[s] + s);
+
+    for (; mask != 0; mask &= mask - 1, last = k) {
+        k = __builtin_ctzll(mask);
+        for (run = k - last - 1; run > 15; run -= 16) {
+            _imc_jpeg_put_bits(w, ac->code[0xF0], ac->size[0xF0]);
+        }
+        v = zz[k];
+        s = _imc_jpeg_nbits((v < 0) ? -v : v);
+        sym = (run << 4) + s;
+        _imc_jpeg_put_bits(w, ((uint32_t)ac->code[sym] << s) | ((uint32_t)(v - (v < 0)) & ((1u << s) - 1)),
+            ac->size[sym] + s);
+    }
+    if (last != 63) {
+        _imc_jpeg_put_bits(w, ac->code[0x00], ac->size[0x00]);
+    }
+}
+
+/**
+ * @brief Writes a DHT segment defining one Huffman table.
+ * @since 16-10-2026
+ * @param[in,out] w The writer
+ * @param[in] huff The table
+ * @param[in] tc_th The table class (0 for DC, 1 for AC) in the high nibble and its destination in the low nibble
+ */
+static void _imc_jpeg_put_dht(JpegWriter_t *w, const JpegHuffEnc_t* const huff, const uint8_t tc_th) {
+    int i;
+
+    _imc_jpeg_put_u16(w, 0xFF00 | JPEG_DHT);
+    _imc_jpeg_put_u16(w, (uint16_t)(19 + huff->n_vals));
+    _imc_jpeg_put_byte(w, tc_th);
+    for (i = 0; i < 16; ++i) {
+        _imc_jpeg_put_byte(w, huff->bits[i]);
+    }
+    for (i = 0; i < huff->n_vals; ++i) {
+        _imc_jpeg_put_byte(w, huff->vals[i]);
+    }
+}
+
+/**
+ * @brief Writes the APPn and COM segments which precede the first scan of __src__, unchanged.
+ * @since 16-10-2026
+ * @param[in,out] w The writer
+ * @param[in] src The JPEG, which has already been decoded
+ * @param[in] size The size of __src__ (in bytes)
+ */
+static void _imc_jpeg_copy_markers(JpegWriter_t *w, const uint8_t* const src, const size_t size) {
+    const uint8_t *p = src + 2, *end = src + size;
+    size_t len, k;
+
+    while (end - p >= 4 && p[0] == 0xFF && p[1] != JPEG_SOS && p[1] != JPEG_EOI) {
+        if (p[1] == 0xFF) {
+            p++;
+            continue;
+        }
+
+        len = _imc_jpeg_u16(p + 2);
+        if (len < 2 || (size_t)(end - p) < 2 + len) {
+            break;
+        }
+        if ((p[1] >= JPEG_APP0 && p[1] <= 0xEF) || p[1] == JPEG_COM) {
+            for (k = 0; k < 2 + len; ++k) {
+                _imc_jpeg_put_byte(w, p[k]);
+            }
+        }
+        p += 2 + len;
+    }
+}
+
+/**
+ * @brief Writes every segment which precedes the entropy-coded data: SOI, a JFIF APP0 segment (or
+ * the APPn and COM segments of JpegEncoder_t.src), the quantization tables, the frame header, the
+ * Huffman tables and the scan header.
+ * Frames whose quantization tables all fit in 8 bits are baseline, and the rest are extended
+ * sequential with 16-bit tables.
+ * @since 16-10-2026
+ * @param[in,out] enc The encoder whose tables are set
+ */
+static void _imc_jpeg_write_headers(JpegEncoder_t *enc) {
+    /* JFIF 1.01 with a 1:1 pixel aspect ratio and no thumbnail */
+    static const uint8_t jfif[14] = { 'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0 };
+    JpegWriter_t *w = &enc->writer;
+    uint8_t i, t, n_tables = (enc->n_comps == 1) ? 1 : 2;
+    bool used[_JPEG_N_TABLES] = { false }, wide[_JPEG_N_TABLES] = { false }, extended = false;
+    int k;
+
+    _imc_jpeg_put_u16(w, 0xFF00 | JPEG_SOI);
+    if (enc->src != NULL) {
+        _imc_jpeg_copy_markers(w, enc->src, enc->src_size);
+    } else {
+        _imc_jpeg_put_u16(w, 0xFF00 | JPEG_APP0);
+        _imc_jpeg_put_u16(w, 2 + sizeof(jfif));
+        for (k = 0; k < (int)sizeof(jfif); ++k) {
+            _imc_jpeg_put_byte(w, jfif[k]);
+        }
+    }
+
+    for (i = 0; i < enc->n_comps; ++i) {
+        used[enc->comps[i].tq] = true;
+    }
+    for (t = 0; t < _JPEG_N_TABLES; ++t) {
+        for (k = 0; used[t] && k < 64; ++k) {
+            wide[t] = wide[t] || enc->qt[t][k] > 255;
+        }
+        extended = extended || wide[t];
+        if (!used[t]) {
+            continue;
+        }
+
+        _imc_jpeg_put_u16(w, 0xFF00 | JPEG_DQT);
+        _imc_jpeg_put_u16(w, wide[t] ? 131 : 67);
+        _imc_jpeg_put_byte(w, (uint8_t)((wide[t] << 4) | t));
+        for (k = 0; k < 64; ++k) {
+            if (wide[t]) {
+                _imc_jpeg_put_u16(w, enc->qt[t][_jpeg_natural_order[k]]);
+            } else {
+                _imc_jpeg_put_byte(w, (uint8_t)enc->qt[t][_jpeg_natural_order[k]]);
+            }
+        }
+    }
+
+    _imc_jpeg_put_u16(w, 0xFF00 | (extended ? JPEG_SOF1 : JPEG_SOF0));
+    _imc_jpeg_put_u16(w, (uint16_t)(8 + 3 * enc->n_comps));
+    _imc_jpeg_put_byte(w, 8);
+    _imc_jpeg_put_u16(w, (uint16_t)enc->height);
+    _imc_jpeg_put_u16(w, (uint16_t)enc->width);
+    _imc_jpeg_put_byte(w, enc->n_comps);
+    for (i = 0; i < enc->n_comps; ++i) {
+        _imc_jpeg_put_byte(w, enc->comps[i].id);
+        _imc_jpeg_put_byte(w, (uint8_t)((enc->comps[i].h << 4) | enc->comps[i].v));
+        _imc_jpeg_put_byte(w, enc->comps[i].tq);
+    }
+
+    for (t = 0; t < n_tables; ++t) {
+        _imc_jpeg_put_dht(w, &enc->dc_huff[t], t);
+        _imc_jpeg_put_dht(w, &enc->ac_huff[t], 0x10 | t);
+    }
+
+    _imc_jpeg_put_u16(w, 0xFF00 | JPEG_SOS);
+    _imc_jpeg_put_u16(w, (uint16_t)(6 + 2 * enc->n_comps));
+    _imc_jpeg_put_byte(w, enc->n_comps);
+    for (i = 0; i < enc->n_comps; ++i) {
+        _imc_jpeg_put_byte(w, enc->comps[i].id);
+        _imc_jpeg_put_byte(w, (uint8_t)((enc->comps[i].th << 4) | enc->comps[i].th));
+    }
+    _imc_jpeg_put_byte(w, 0);
+    _imc_jpeg_put_byte(w, 63);
+    _imc_jpeg_put_byte(w, 0);
+}
+
+/**
+ * @brief Sets up the components, tables and buffers of __enc__.
+ * Color pixmaps are coded as YCbCr with the luma sampled at the factors given by __opts__ and
+ * the chroma at 1x1, and greyscale pixmaps as a single component. The component planes hold one
+ * row of MCUs, and the coefficient buffers hold one row of MCUs too, or the whole image when the
+ * Huffman tables are optimized, since the statistics of every block must be known first.
+ * @since 16-10-2026
+ * @param[out] enc The zeroed encoder
+ * @param[in] pixmap The pixmap to be encoded, which has been validated
+ * @param[in] sink The sink which receives the encoded bytes
+ * @param[in] opts The encoding options
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_enc_init(
+    JpegEncoder_t *enc,
+    const Pixmap_t* const pixmap,
+    const JpegSink_t* const sink,
+    const JpegEncOpts_t* const opts
+) {
+    JpegEncComp_t *comp;
+    size_t n_rows;
+    uint8_t i, t;
+
+    enc->pixmap = pixmap;
+    enc->width = pixmap->width;
+    enc->height = pixmap->height;
+    enc->n_comps = (pixmap->n_channels >= 3) ? 3 : 1;
+    enc->hmax = (enc->n_comps == 3 && opts->subsampling != JPEG_SUBSAMPLE_444) ? 2 : 1;
+    enc->vmax = (enc->n_comps == 3 && opts->subsampling == JPEG_SUBSAMPLE_420) ? 2 : 1;
+    enc->mcux = (enc->width + 8 * enc->hmax - 1) / (8 * enc->hmax);
+    enc->mcuy = (enc->height + 8 * enc->vmax - 1) / (8 * enc->vmax);
+    enc->optimize = opts->optimize;
+    enc->simd = opts->simd;
+    enc->fdct = _imc_jpeg_select_fdct(opts->simd);
+    enc->writer.sink = sink;
+    enc->writer.status = IMC_EOK;
+
+    _imc_jpeg_scale_qt(_jpeg_std_luma_qt, opts->quality, enc->qt[0]);
+    _imc_jpeg_scale_qt(_jpeg_std_chroma_qt, opts->quality, enc->qt[1]);
+    for (t = 0; t < 2; ++t) {
+        _imc_jpeg_reciprocals(enc->qt[t], enc->divisors[t]);
+    }
+    _imc_jpeg_std_huff(&enc->dc_huff[0], _jpeg_dc_luma_bits, _jpeg_dc_luma_vals);
+    _imc_jpeg_std_huff(&enc->ac_huff[0], _jpeg_ac_luma_bits, _jpeg_ac_luma_vals);
+    _imc_jpeg_std_huff(&enc->dc_huff[1], _jpeg_dc_chroma_bits, _jpeg_dc_chroma_vals);
+    _imc_jpeg_std_huff(&enc->ac_huff[1], _jpeg_ac_chroma_bits, _jpeg_ac_chroma_vals);
+
+    n_rows = enc->optimize ? enc->mcuy : 1;
+    for (i = 0; i < enc->n_comps; ++i) {
+        comp = &enc->comps[i];
+        comp->h = (i == 0) ? enc->hmax : 1;
+        comp->v = (i == 0) ? enc->vmax : 1;
+        comp->id = i + 1;
+        comp->tq = comp->th = (i == 0) ? 0 : 1;
+        comp->bw = enc->mcux * comp->h;
+        comp->real_bw = (enc->width * comp->h + 8 * enc->hmax - 1) / (8 * enc->hmax);
+        comp->real_bh = (enc->height * comp->v + 8 * enc->vmax - 1) / (8 * enc->vmax);
+        comp->stride = comp->bw * 8;
+        comp->plane = malloc(comp->stride * 8 * comp->v);
+        comp->coefs = malloc(comp->bw * comp->v * n_rows * 64 * sizeof(*comp->coefs));
+        if (comp->plane == NULL || comp->coefs == NULL) {
+            IMC_LOG("Failed to allocate memory for JPEG component", IMC_ERROR);
+            return IMC_ENOMEM;
+        }
+    }
+
+    if (enc->hmax > 1) {
+        /* Full resolution chroma, which is downsampled into the component planes */
+        enc->chroma = malloc(2 * enc->comps[0].stride * 8 * enc->vmax);
+        if (enc->chroma == NULL) {
+            IMC_LOG("Failed to allocate memory for JPEG chroma rows", IMC_ERROR);
+            return IMC_ENOMEM;
+        }
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Frees the buffers of __enc__.
+ * @since 16-10-2026
+ * @param[in,out] enc The encoder
+ */
+static void _imc_jpeg_enc_destroy(JpegEncoder_t *enc) {
+    uint8_t i;
+
+    for (i = 0; i < JPEG_MAX_COMPONENTS; ++i) {
+        free(enc->comps[i].plane);
+        free(enc->comps[i].coefs);
+        enc->comps[i].plane = NULL;
+        enc->comps[i].coefs = NULL;
+    }
+    free(enc->chroma);
+    enc->chroma = NULL;
+}
+
+/**
+ * @brief Converts, downsamples and transforms a row of MCUs into quantized coefficients.
+ * The image is extended to whole MCUs by replicating its last column and row (for subsampled
+ * chroma, its last downsampled row, as libjpeg does). Blocks which lie
+ * entirely outside a component's dimensions are coded as libjpeg codes them, with no AC
+ * coefficients and the DC coefficient of the previous block, which costs almost nothing.
+ * @since 16-10-2026
+ * @param[in,out] enc The encoder
+ * @param[in] my The index of the row of MCUs
+ */
+static void _imc_jpeg_transform_row(JpegEncoder_t *enc, const size_t my) {
+    const Pixmap_t *pixmap = enc->pixmap;
+    const uint8_t *src;
+    uint8_t *full[JPEG_MAX_COMPONENTS];
+    size_t x, y, r, bx, by, n_ch = pixmap->n_channels;
+    size_t w_pad = enc->comps[0].stride, n_rows = 8 * (size_t)enc->vmax;
+    size_t n_valid = (enc->height + enc->vmax - 1) / enc->vmax;
+    JpegEncComp_t *comp;
+    int16_t *base, *block;
+    uint8_t i;
+
+    for (i = 0; i < enc->n_comps; ++i) {
+        full[i] = (i > 0 && enc->hmax > 1) ? enc->chroma + (i - 1) * w_pad * n_rows : enc->comps[i].plane;
+    }
+
+    for (r = 0; r < n_rows; ++r) {
+        y = my * n_rows + r;
+        y = (y < enc->height) ? y : enc->height - 1;
+        src = pixmap->data + y * enc->width * n_ch;
+        if (enc->n_comps == 3) {
+            _imc_jpeg_rgb_ycc_row(src, n_ch, full[0] + r * w_pad, full[1] + r * w_pad, full[2] + r * w_pad,
+                enc->width, enc->simd);
+        } else {
+            for (x = 0; x < enc->width; ++x) {
+                full[0][r * w_pad + x] = src[x * n_ch];
+            }
+        }
+
+        for (i = 0; i < enc->n_comps; ++i) {
+            memset((void*)(full[i] + r * w_pad + enc->width), full[i][r * w_pad + enc->width - 1], w_pad - enc->width);
+        }
+    }
+
+    if (enc->hmax > 1) {
+        for (i = 1; i < enc->n_comps; ++i) {
+            comp = &enc->comps[i];
+            for (r = 0; r < 8; ++r) {
+                if (my * 8 + r >= n_valid) {
+                    /* Like libjpeg, rows past the image repeat the last downsampled row */
+                    memcpy((void*)(comp->plane + r * comp->stride), (void*)(comp->plane + (r - 1) * comp->stride),
+                        comp->stride);
+                    continue;
+                }
+                _imc_jpeg_downsample_row(full[i] + r * enc->vmax * w_pad,
+                    (enc->vmax > 1) ? full[i] + (2 * r + 1) * w_pad : NULL,
+                    comp->plane + r * comp->stride, comp->stride, enc->simd);
+            }
+        }
+    }
+
+    for (i = 0; i < enc->n_comps; ++i) {
+        comp = &enc->comps[i];
+        base = comp->coefs + (enc->optimize ? my * comp->v * comp->bw * 64 : 0);
+        for (by = 0; by < comp->v; ++by) {
+            for (bx = 0; bx < comp->bw; ++bx) {
+                block = base + (by * comp->bw + bx) * 64;
+                if (my * comp->v + by < comp->real_bh && bx < comp->real_bw) {
+                    enc->fdct(comp->plane + by * 8 * comp->stride + bx * 8, comp->stride,
+                        enc->divisors[comp->tq], block);
+                    continue;
+                }
+
+                /* Padding blocks take their DC from the block coded before them in the MCU */
+                memset((void*)block, 0, 64 * sizeof(*block));
+                if (my * comp->v + by >= comp->real_bh) {
+                    block[0] = base[((by - 1) * comp->bw + (bx / comp->h) * comp->h + comp->h - 1) * 64];
+                } else {
+                    block[0] = block[-64];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Huffman codes a row of MCUs, or counts the symbols it would be coded with.
+ * @since 16-10-2026
+ * @param[in,out] enc The encoder
+ * @param[in] my The index of the row of MCUs, which has been transformed
+ * @param[in] count True to count symbols for optimal tables instead of writing codes
+ */
+static void _imc_jpeg_encode_row(JpegEncoder_t *enc, const size_t my, const bool count) {
+    const int16_t *base[JPEG_MAX_COMPONENTS], *block;
+    JpegEncComp_t *comp;
+    size_t mx, bx, by;
+    uint8_t i;
+
+    for (i = 0; i < enc->n_comps; ++i) {
+        comp = &enc->comps[i];
+        base[i] = comp->coefs + (enc->optimize ? my * comp->v * comp->bw * 64 : 0);
+    }
+
+    for (mx = 0; mx < enc->mcux; ++mx) {
+        for (i = 0; i < enc->n_comps; ++i) {
+            comp = &enc->comps[i];
+            for (by = 0; by < comp->v; ++by) {
+                for (bx = 0; bx < comp->h; ++bx) {
+                    block = base[i] + (by * comp->bw + mx * comp->h + bx) * 64;
+                    if (count) {
+                        _imc_jpeg_count_block(block, &comp->dc_pred, enc->dc_freq[comp->th], enc->ac_freq[comp->th]);
+                    } else {
+                        _imc_jpeg_emit_block(&enc->writer, block, &comp->dc_pred,
+                            &enc->dc_huff[comp->th], &enc->ac_huff[comp->th]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Ends the entropy-coded data written by __enc__ and the image.
+ * @since 16-10-2026
+ * @param[in,out] enc The encoder
+ * @returns The first error returned by the sink, otherwise IMC_EOK
+ */
+static ImcError_t _imc_jpeg_finish(JpegEncoder_t *enc) {
+    _imc_jpeg_put_pad(&enc->writer);
+    _imc_jpeg_put_u16(&enc->writer, 0xFF00 | JPEG_EOI);
+    _imc_jpeg_flush(&enc->writer);
+
+    return enc->writer.status;
+}
+
+/**
+ * @brief Writes a frame whose coefficients are all held in the components' coefficient buffers
+ * with optimal Huffman tables.
+ * Every block is visited twice: once to count the symbols which it will be coded with and, once
+ * the tables are built from those counts, again to code it.
+ * @since 16-10-2026
+ * @param[in,out] enc The encoder, whose rows of MCUs have all been transformed
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_write_coefs(JpegEncoder_t *enc) {
+    size_t my;
+    uint8_t i, t;
+
+    for (my = 0; my < enc->mcuy; ++my) {
+        _imc_jpeg_encode_row(enc, my, true);
+    }
+
+    for (t = 0; t < ((enc->n_comps == 1) ? 1 : 2); ++t) {
+        _imc_jpeg_optimal_huff(enc->dc_freq[t], &enc->dc_huff[t]);
+        _imc_jpeg_optimal_huff(enc->ac_freq[t], &enc->ac_huff[t]);
+    }
+    for (i = 0; i < enc->n_comps; ++i) {
+        enc->comps[i].dc_pred = 0;
+    }
+
+    _imc_jpeg_write_headers(enc);
+    for (my = 0; my < enc->mcuy && enc->writer.status == IMC_EOK; ++my) {
+        _imc_jpeg_encode_row(enc, my, false);
+    }
+
+    return _imc_jpeg_finish(enc);
+}
+
+/**
+ * @brief Fills the components of __enc__ with the coefficients of __dec__ rearranged by __xform__.
+ * Each output block is a source block whose coefficients are transposed when the transform
+ * swaps the axes, and negated at odd frequencies along each axis it mirrors, since mirroring a
+ * cosine of odd frequency negates it. Mirrored axes must span whole MCUs, so that no block moves
+ * from the partial edge MCU, whose padding would become visible, to the other side of the image.
+ * @since 16-10-2026
+ * @param[in] dec The decoder, holding the trimmed frame's coefficients
+ * @param[in] xform The transform
+ * @param[in,out] enc The encoder, whose frame dimensions and sampling factors are set
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_jpeg_xform_coefs(
+    const JpegDecoder_t* const dec,
+    const JpegTransform_t xform,
+    JpegEncoder_t *enc
+) {
+    const JpegComp_t *s;
+    JpegEncComp_t *d;
+    const int16_t *src;
+    int16_t *dst;
+    uint8_t index[64], i;
+    bool negate[64];
+    bool swap = (xform == JPEG_XFORM_TRANSPOSE || xform == JPEG_XFORM_TRANSVERSE
+        || xform == JPEG_XFORM_ROT_90 || xform == JPEG_XFORM_ROT_270);
+    bool mirror_x = (xform == JPEG_XFORM_FLIP_H || xform == JPEG_XFORM_ROT_180
+        || xform == JPEG_XFORM_ROT_270 || xform == JPEG_XFORM_TRANSVERSE);
+    bool mirror_y = (xform == JPEG_XFORM_FLIP_V || xform == JPEG_XFORM_ROT_180
+        || xform == JPEG_XFORM_ROT_90 || xform == JPEG_XFORM_TRANSVERSE);
+    size_t x, y, sx, sy, nbx, nby, rows, src_w = swap ? enc->height : enc->width;
+    size_t src_h = swap ? enc->width : enc->height;
+    int k, r, c, sr, sc;
+
+    for (k = 0; k < 64; ++k) {
+        r = k / 8;
+        c = k % 8;
+        sr = swap ? c : r;
+        sc = swap ? r : c;
+        index[k] = (uint8_t)(sr * 8 + sc);
+        negate[k] = (mirror_x && (sc & 1)) != (mirror_y && (sr & 1));
+    }
+
+    for (i = 0; i < dec->n_comps; ++i) {
+        s = &dec->comps[i];
+        d = &enc->comps[i];
+        d->bw = enc->mcux * d->h;
+        rows = enc->mcuy * d->v;
+        d->coefs = malloc(d->bw * rows * 64 * sizeof(*d->coefs));
+        if (d->coefs == NULL) {
+            IMC_LOG("Failed to allocate memory for JPEG coefficients", IMC_ERROR);
+            return IMC_ENOMEM;
+        }
+
+        /* Number of source blocks spanned by the (whole MCU) mirrored axes */
+        nbx = src_w / (8 * (swap ? enc->vmax : enc->hmax)) * (swap ? d->v : d->h);
+        nby = src_h / (8 * (swap ? enc->hmax : enc->vmax)) * (swap ? d->h : d->v);
+
+        for (y = 0, dst = d->coefs; y < rows; ++y) {
+            for (x = 0; x < d->bw; ++x, dst += 64) {
+                sx = swap ? y : x;
+                sy = swap ? x : y;
+                sx = mirror_x ? nbx - 1 - sx : sx;
+                sy = mirror_y ? nby - 1 - sy : sy;
+                src = s->coefs + (sy * s->bw + sx) * 64;
+                for (k = 0; k < 64; ++k) {
+                    dst[k] = negate[k] ? (int16_t)-src[index[k]] : src[index[k]];
+                }
+            }
+        }
+    }
+
+    for (i = 0; i < _JPEG_N_TABLES; ++i) {
+        for (k = 0; k < 64; ++k) {
+            enc->qt[i][k] = dec->qt[i][index[k]];
+        }
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief JpegSink_t callback which writes to a FILE.
+ * @since 16-10-2026
+ * @param[in] ctx The FILE being written to
+ * @param[in] data The bytes to be written
+ * @param[in] len The number of bytes to be written
+ * @returns IMC_EFAIL if the write was short, otherwise IMC_EOK
+ */
+static ImcError_t _imc_jpeg_file_sink_write(void *ctx, const uint8_t *data, const size_t len) {
+    return (fwrite((void*)data, 1, len, (FILE*)ctx) == len) ? IMC_EOK : IMC_EFAIL;
+}
+
+/**
+ * @brief JpegSink_t callback which appends to a growable JpegMemBuf_t.
+ * @since 16-10-2026
+ * @param[in] ctx The JpegMemBuf_t being appended to
+ * @param[in] data The bytes to be appended
+ * @param[in] len The number of bytes to be appended
+ * @returns IMC_ENOMEM if the buffer could not be grown, otherwise IMC_EOK
+ */
+static ImcError_t _imc_jpeg_mem_sink_write(void *ctx, const uint8_t *data, const size_t len) {
+    size_t capacity;
+    uint8_t *tmp = NULL;
+    JpegMemBuf_t *buf = (JpegMemBuf_t*)ctx;
+
+    if (buf->size + len > buf->capacity) {
+        capacity = (buf->capacity > 0) ? buf->capacity : 4096;
+        while (capacity < buf->size + len) {
+            capacity *= 2;
+        }
+
+        tmp = realloc(buf->data, capacity);
+        if (tmp == NULL) {
+            IMC_LOG("Failed to grow memory sink", IMC_ERROR);
+            return IMC_ENOMEM;
+        }
+        buf->data = tmp;
+        buf->capacity = capacity;
+    }
+
+    memcpy((void*)(buf->data + buf->size), (void*)data, len);
+    buf->size += len;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Decodes the JPEG held in memory at __data__ into a Pixmap_t, rotated or mirrored by __orient__.
+ * @since 16-10-2026
+ * @param[in] data The JPEG file's contents
+ * @param[in] size The length of __data__ (in bytes)
+ * @param[in] opts Decoding options or NULL to use imc_jpeg_default_opts()
+ * @param[in] orient The transform applied to the decoded image as it is output
+ * @returns A Pixmap_t structure containing the decoded image or NULL if an error occurred
+ */
+static Pixmap_t *_imc_jpeg_decode_pixmap(
+    const uint8_t* const data,
+    const size_t size,
+    const JpegDecOpts_t* const opts,
+    const JpegTransform_t orient
+) {
+    ImcError_t status;
+    JpegDecoder_t *dec = NULL;
+    Pixmap_t *pixmap = NULL;
+    JpegDecOpts_t def_opts = imc_jpeg_default_opts();
+    const JpegDecOpts_t *_opts = (opts != NULL) ? opts : &def_opts;
+    bool swap = (orient == JPEG_XFORM_TRANSPOSE || orient == JPEG_XFORM_TRANSVERSE
+        || orient == JPEG_XFORM_ROT_90 || orient == JPEG_XFORM_ROT_270);
+
+    if (data == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return NULL;
+    }
+
+    dec = _imc_jpeg_dec_create(data, size, _opts);
+    if (dec == NULL) {
+        return NULL;
+    }
+    dec->orient = orient;
+
+    status = _imc_jpeg_read_segments(dec);
+    if (status != IMC_EOK) {
+        goto cleanup;
+    }
+
+    pixmap = malloc(sizeof(Pixmap_t));
+    if (pixmap == NULL) {
+        IMC_LOG("Failed to allocate memory for Pixmap_t", IMC_ERROR);
+        goto cleanup;
+    }
+
+    pixmap->n_channels = _imc_jpeg_out_channels(dec, _opts->format);
+    pixmap->width = swap ? dec->out_height : dec->out_width;
+    pixmap->height = swap ? dec->out_width : dec->out_height;
+    pixmap->offset = 0;
+    pixmap->bit_depth = 8;
+    pixmap->data = malloc(pixmap->width * pixmap->height * pixmap->n_channels);
+    if (pixmap->data == NULL) {
+        IMC_LOG("Failed to allocate memory for pixmap data", IMC_ERROR);
+        free(pixmap);
+        pixmap = NULL;
+        goto cleanup;
+    }
+
+    status = _imc_jpeg_output(dec, _opts->format, pixmap, 0);
+    if (status != IMC_EOK) {
+        free(pixmap->data);
+        free(pixmap);
+        pixmap = NULL;
+    }
+
+cleanup:
+    _imc_jpeg_dec_destroy(dec);
+    free(dec);
+
+    return pixmap;
+}
+
+/*
+ * ===============================
+ *       Public Functions
+ * ===============================
+ */
+
+/**
+ * @brief Returns the default JPEG decoding options.
+ * @since 16-10-2026
+ * @returns A JpegDecOpts_t which decodes at full size on a single thread, keeps greyscale images as
+ * 1 channel, decodes the rest as RGB with interpolated chroma and uses SIMD kernels where the CPU
+ * supports them
+ */
+JpegDecOpts_t imc_jpeg_default_opts(void) {
+    JpegDecOpts_t opts;
+
+    opts.format = JPEG_FMT_NATIVE;
+    opts.simd = true;
+    opts.scale_denom = 1;
+    opts.n_threads = 1;
+    opts.fancy_upsampling = true;
+    opts.preview = false;
+    opts.dc_only = false;
+    opts.auto_orient = false;
+
+    return opts;
+}
+
+/**
+ * @brief Returns one of the inverse DCT kernels which the decoder selects between, so that they may
+ * be compared. Every kernel produces the same output for the blocks of a valid JPEG.
+ * @since 16-10-2026
+ * @param[in] kernel The kernel to return
+ * @returns The kernel, or NULL if it was not built or the CPU does not support it
+ */
+idct_func imc_jpeg_idct_kernel(const JpegIdct_t kernel) {
+    switch (kernel) {
+        case JPEG_IDCT_SCALAR:
+            return _imc_jpeg_idct_islow;
+#if defined(_JPEG_X86)
+        case JPEG_IDCT_SSE2:
+            return __builtin_cpu_supports("sse2") ? _imc_jpeg_idct_sse2 : NULL;
+        case JPEG_IDCT_AVX2:
+            return __builtin_cpu_supports("avx2") ? _imc_jpeg_idct_avx2 : NULL;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * @brief Open a JPEG file for decoding.
+ * @since 16-10-2026
+ * @param[in] path An absolute or relative path to the JPEG file
+ * @returns A JpegHndl_t struct or NULL if an error occurred
+ */
+JpegHndl_t *imc_jpeg_open(const char* const path) {
+    JpegHndl_t *jpeg = NULL;
+
+    jpeg = calloc(1, sizeof(JpegHndl_t));
+    if (jpeg == NULL) {
+        IMC_LOG("Failed to allocate memory for jpeg", IMC_ERROR);
+        return NULL;
+    }
+
+    jpeg->fp = fopen(path, "rb");
+    if (jpeg->fp == NULL) {
+        IMC_LOG("Failed to open file", IMC_ERROR);
+        free(jpeg);
+        return NULL;
+    }
+
+    jpeg->size = _imc_jpeg_file_size(jpeg->fp);
+    jpeg->data = malloc(jpeg->size > 0 ? jpeg->size : 1);
+    if (jpeg->data == NULL) {
+        IMC_LOG("Failed to allocate memory for jpeg data", IMC_ERROR);
+        imc_jpeg_close(jpeg);
+        return NULL;
+    }
+
+    if (fread(jpeg->data, 1, jpeg->size, jpeg->fp) != jpeg->size) {
+        IMC_LOG("Failed to read file", IMC_ERROR);
+        imc_jpeg_close(jpeg);
+        return NULL;
+    }
+
+    return jpeg;
+}
+
+/**
+ * @brief Close the JPEG file associated with the handle referenced by __jpeg__.
+ * @since 16-10-2026
+ * @param[in] jpeg A JpegHndl_t pointer referencing the JPEG file to be closed
+ * @returns An ImcError_t indicating the exit status of the operation
+ */
+ImcError_t imc_jpeg_close(JpegHndl_t *jpeg) {
+    int status;
+
+    if (jpeg == NULL) {
+        IMC_LOG("Attempted double free on JPEG handle", IMC_WARNING);
+        return IMC_EFAULT;
+    }
+
+    free(jpeg->data);
+
+    if (jpeg->fp) {
+        status = fclose(jpeg->fp);
+        if (status != 0) {
+            IMC_LOG("Failed to close JPEG", IMC_WARNING);
+            free(jpeg);
+            return IMC_EFAIL;
+        }
+    }
+
+    free(jpeg);
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Decodes the JPEG held in memory at __data__ into a Pixmap_t.
+ * Baseline, extended sequential and progressive Huffman-coded JPEGs with 8-bit samples, any
+ * sampling factors, 1, 3 or 4 components and restart intervals are supported. With
+ * JpegDecOpts_t.preview set, a progressive JPEG is only decoded until every component has had a
+ * DC scan, which usually means just its first scan, giving a blocky preview. When
+ * JpegDecOpts_t.scale_denom is 2, 4 or 8 each block is decoded by a reduced inverse DCT (4x4,
+ * 2x2 or DC only) straight into the downscaled image, whose dimensions are rounded up. Scans
+ * with restart intervals are entropy-decoded on up to JpegDecOpts_t.n_threads threads. Subsampled
+ * chroma is interpolated as libjpeg's fancy upsampling does unless
+ * JpegDecOpts_t.fancy_upsampling is false (or the image is decoded at 1/8 scale), in which case it
+ * is replicated. JpegDecOpts_t.dc_only decodes one pixel per block of every component from its DC
+ * coefficient alone: AC coefficients are parsed only to advance through sequential scans, and
+ * the AC scans of progressive JPEGs are skipped entirely. JPEG_FMT_LUMA decodes only the Y plane
+ * of YCbCr images into a single-channel pixmap: the chroma blocks are parsed and dropped without
+ * being stored or transformed, their progressive AC scans are skipped, and there is nothing to
+ * upsample or convert. Other images are decoded in full and converted to their luma. With
+ * JpegDecOpts_t.auto_orient set, the Orientation tag of the EXIF data is read and each band of
+ * converted rows is written straight into its rotated or mirrored place in the pixmap, whose
+ * width and height are swapped for the orientations which transpose the image.
+ * @since 16-10-2026
+ * @param[in] data The JPEG file's contents
+ * @param[in] size The length of __data__ (in bytes)
+ * @param[in] opts Decoding options or NULL to use imc_jpeg_default_opts()
+ * @returns A Pixmap_t structure containing the decoded image or NULL if an error occurred
+ */
+Pixmap_t *imc_jpeg_decode_mem(
+    const uint8_t* const data,
+    const size_t size,
+    const JpegDecOpts_t* const opts
+) {
+    JpegTransform_t orient = JPEG_XFORM_NONE;
+
+    if (data == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return NULL;
+    }
+
+    if (opts != NULL && opts->auto_orient) {
+        orient = _imc_jpeg_exif_orient(data, size);
+    }
+
+    return _imc_jpeg_decode_pixmap(data, size, opts, orient);
+}
+
+/**
+ * @brief Decodes the JPEG referenced by __jpeg__ into a Pixmap_t.
+ * @since 16-10-2026
+ * @param[in] jpeg A handle to the JPEG file obtained by invoking imc_jpeg_open()
+ * @param[in] opts Decoding options or NULL to use imc_jpeg_default_opts()
+ * @returns A Pixmap_t structure containing the decoded image or NULL if an error occurred
+ */
+Pixmap_t *imc_jpeg_decode(JpegHndl_t *jpeg, const JpegDecOpts_t* const opts) {
+    if (jpeg == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return NULL;
+    }
+
+    return imc_jpeg_decode_mem(jpeg->data, jpeg->size, opts);
+}
+
+/**
+ * @brief Decodes the thumbnail embedded in the EXIF data of the JPEG held in memory at __data__.
+ * The thumbnail is located through IFD1 of the APP1 segment and decoded straight from __data__.
+ * Only the marker segments ahead of the primary image's first scan are read, so the cost does not
+ * depend on the size of the primary image at all.
+ * @since 16-10-2026
+ * @param[in] data The JPEG file's contents
+ * @param[in] size The length of __data__ (in bytes)
+ * @param[in] opts Decoding options for the thumbnail or NULL to use imc_jpeg_default_opts()
+ * @returns A Pixmap_t structure containing the decoded thumbnail or NULL if there is none or an
+ * error occurred
+ */
+Pixmap_t *imc_jpeg_decode_thumbnail_mem(
+    const uint8_t* const data,
+    const size_t size,
+    const JpegDecOpts_t* const opts
+) {
+    Exif_t exif;
+    JpegTransform_t orient = JPEG_XFORM_NONE;
+    const uint8_t *thumb;
+    size_t thumb_size;
+
+    if (data == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return NULL;
+    }
+
+    if (imc_exif_from_jpeg(data, size, &exif) != IMC_EOK
+        || imc_exif_thumbnail(&exif, &thumb, &thumb_size) != IMC_EOK) {
+        IMC_LOG("JPEG has no EXIF thumbnail", IMC_WARNING);
+        return NULL;
+    }
+
+    /* The thumbnail is stored the same way up as the primary image, whose Orientation tag applies to both */
+    if (opts != NULL && opts->auto_orient) {
+        orient = _imc_jpeg_exif_orient(data, size);
+    }
+
+    return _imc_jpeg_decode_pixmap(thumb, thumb_size, opts, orient);
+}
+
+/**
+ * @brief Decodes the thumbnail embedded in the EXIF data of the JPEG referenced by __jpeg__.
+ * @since 16-10-2026
+ * @param[in] jpeg A handle to the JPEG file obtained by invoking imc_jpeg_open()
+ * @param[in] opts Decoding options for the thumbnail or NULL to use imc_jpeg_default_opts()
+ * @returns A Pixmap_t structure containing the decoded thumbnail or NULL if there is none or an
+ * error occurred
+ */
+Pixmap_t *imc_jpeg_decode_thumbnail(JpegHndl_t *jpeg, const JpegDecOpts_t* const opts) {
+    if (jpeg == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return NULL;
+    }
+
+    return imc_jpeg_decode_thumbnail_mem(jpeg->data, jpeg->size, opts);
+}
+
+/**
+ * @brief Decodes the JPEG held in memory at __data__ a band of rows at a time, passing each to __sink__.
+ * A sequential JPEG whose first scan interleaves every component (as baseline JPEGs do) is decoded
+ * a row of MCUs at a time, holding just that row and the few rows above it which are still
+ * needed, so memory does not grow with the height of the image. Each band then holds roughly the
+ * rows of one row of MCUs. Progressive JPEGs and JPEGs whose components are coded in separate
+ * scans must be decoded whole before any row can be output, after which their rows are passed
+ * on in bands of the same height. Every option of imc_jpeg_decode_mem() applies, except that
+ * streamed scans are decoded on a single thread. The band passed to __sink__ is only valid for
+ * the duration of the call.
+ * @since 16-10-2026
+ * @param[in] data The JPEG file's contents
+ * @param[in] size The length of __data__ (in bytes)
+ * @param[in] sink The sink which receives the bands, from the top of the image down
+ * @param[in] opts Decoding options or NULL to use imc_jpeg_default_opts()
+ * @returns An ImcError_t indicating the exit status code, which is that of __sink__ if it stopped
+ * the decode
+ */
+ImcError_t imc_jpeg_decode_stream_mem(
+    const uint8_t* const data,
+    const size_t size,
+    const JpegBandSink_t* const sink,
+    const JpegDecOpts_t* const opts
+) {
+    ImcError_t status;
+    JpegDecoder_t *dec = NULL;
+    JpegDecOpts_t def_opts = imc_jpeg_default_opts();
+    const JpegDecOpts_t *_opts = (opts != NULL) ? opts : &def_opts;
+
+    if (data == NULL || sink == NULL || sink->band == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    dec = _imc_jpeg_dec_create(data, size, _opts);
+    if (dec == NULL) {
+        return IMC_EFAIL;
+    }
+    dec->stream = true;
+
+    status = _imc_jpeg_read_segments(dec);
+    if (status == IMC_EOK) {
+        status = _imc_jpeg_stream(dec, _opts->format, sink);
+    }
+
+    _imc_jpeg_dec_destroy(dec);
+    free(dec);
+
+    return status;
+}
+
+/**
+ * @brief Decodes the JPEG referenced by __jpeg__ a band of rows at a time, passing each to __sink__.
+ * @since 16-10-2026
+ * @param[in] jpeg A handle to the JPEG file obtained by invoking imc_jpeg_open()
+ * @param[in] sink The sink which receives the bands (see imc_jpeg_decode_stream_mem())
+ * @param[in] opts Decoding options or NULL to use imc_jpeg_default_opts()
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_jpeg_decode_stream(JpegHndl_t *jpeg, const JpegBandSink_t* const sink, const JpegDecOpts_t* const opts) {
+    if (jpeg == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    return imc_jpeg_decode_stream_mem(jpeg->data, jpeg->size, sink, opts);
+}
+
+/**
+ * @brief Reads the frame header of the JPEG held in memory at __data__ and sets the number and
+ * dimensions of the planes imc_jpeg_decode_planes() decodes it into.
+ * Nothing is decoded. The caller allocates each plane from the dimensions and chooses its stride.
+ * @since 16-10-2026
+ * @param[in] data The JPEG file's contents
+ * @param[in] size The length of __data__ (in bytes)
+ * @param[in] opts Decoding options or NULL to use imc_jpeg_default_opts(), which must match
+ * those passed to imc_jpeg_decode_planes()
+ * @param[out] planes The planes, of which JpegPlanes_t.n_planes, width and height are set
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_jpeg_planes_info(
+    const uint8_t* const data,
+    const size_t size,
+    const JpegDecOpts_t* const opts,
+    JpegPlanes_t *planes
+) {
+    ImcError_t status;
+    JpegDecoder_t *dec = NULL;
+    JpegDecOpts_t def_opts = imc_jpeg_default_opts();
+    const JpegDecOpts_t *_opts = (opts != NULL) ? opts : &def_opts;
+
+    if (data == NULL || planes == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    dec = _imc_jpeg_dec_create(data, size, _opts);
+    if (dec == NULL) {
+        return IMC_EFAIL;
+    }
+    dec->luma_only = false;
+    dec->raw = true;
+    dec->header_only = true;
+
+    status = _imc_jpeg_read_segments(dec);
+    if (status == IMC_EOK) {
+        _imc_jpeg_plane_dims(dec, planes);
+    }
+
+    _imc_jpeg_dec_destroy(dec);
+    free(dec);
+
+    return status;
+}
+
+/**
+ * @brief Decodes the JPEG held in memory at __data__ into planes of its native components.
+ * Each component is decoded at its own sampling (so a 4:2:0 YCbCr JPEG gives a full-size Y plane
+ * and half-size Cb and Cr planes) without any upsampling or color conversion, straight into the
+ * caller's planes at the caller's strides. Sequential JPEGs whose first scan interleaves every
+ * component are decoded a row of MCUs at a time, each copied into the planes as soon as it is
+ * decoded; others are decoded whole first. JpegDecOpts_t.format and fancy_upsampling do not
+ * apply, and a scaled decode scales every plane alike.
+ * @since 16-10-2026
+ * @param[in] data The JPEG file's contents
+ * @param[in] size The length of __data__ (in bytes)
+ * @param[in] opts Decoding options or NULL to use imc_jpeg_default_opts()
+ * @param[in,out] planes The planes, whose JpegPlanes_t.data and stride are set by the caller (see
+ * imc_jpeg_planes_info()) and whose n_planes, width and height are set again from the frame
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_jpeg_decode_planes(
+    const uint8_t* const data,
+    const size_t size,
+    const JpegDecOpts_t* const opts,
+    JpegPlanes_t *planes
+) {
+    ImcError_t status;
+    JpegDecoder_t *dec = NULL;
+    JpegDecOpts_t def_opts = imc_jpeg_default_opts();
+    const JpegDecOpts_t *_opts = (opts != NULL) ? opts : &def_opts;
+    uint8_t i;
+
+    if (data == NULL || planes == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    dec = _imc_jpeg_dec_create(data, size, _opts);
+    if (dec == NULL) {
+        return IMC_EFAIL;
+    }
+    dec->luma_only = false;
+    dec->raw = true;
+    dec->stream = true;
+
+    status = _imc_jpeg_read_segments(dec);
+    if (status != IMC_EOK) {
+        goto cleanup;
+    }
+
+    _imc_jpeg_plane_dims(dec, planes);
+    for (i = 0; i < planes->n_planes; ++i) {
+        if (planes->data[i] == NULL || planes->stride[i] < planes->width[i]) {
+            IMC_LOG("JPEG plane is missing or its stride is shorter than its width", IMC_ERROR);
+            status = IMC_EINVAL;
+            goto cleanup;
+        }
+    }
+
+    status = _imc_jpeg_stream_planes(dec, planes);
+
+cleanup:
+    _imc_jpeg_dec_destroy(dec);
+    free(dec);
+
+    return status;
+}
+
+/**
+ * @brief Returns the default JPEG encoding options.
+ * @since 16-10-2026
+ * @returns A JpegEncOpts_t which encodes at quality 75 with 4:2:0 chroma subsampling and the
+ * standard Huffman tables, using SIMD kernels where the CPU supports them
+ */
+JpegEncOpts_t imc_jpeg_enc_default_opts(void) {
+    JpegEncOpts_t opts;
+
+    opts.quality = 75;
+    opts.subsampling = JPEG_SUBSAMPLE_420;
+    opts.optimize = false;
+    opts.simd = true;
+
+    return opts;
+}
+
+/**
+ * @brief Encodes __pixmap__ as a baseline JPEG and passes the encoded bytes to __sink__ as they are produced.
+ * Pixmaps with 3 or 4 channels are converted to YCbCr (alpha is discarded) and pixmaps with 1 or 2
+ * channels are written as greyscale. The image is processed a row of MCUs at a time: RGB to YCbCr
+ * conversion and chroma downsampling run with SSE2 and the forward DCT is selected at run-time like
+ * the inverse DCT. Quantization multiplies by reciprocals instead of dividing. The arithmetic
+ * follows libjpeg's accurate integer path, so the output matches libjpeg's for the same quality,
+ * sampling and options. With JpegEncOpts_t.optimize set, every block is transformed before
+ * anything is written so that the Huffman tables can be built from the image's own statistics,
+ * which typically saves several percent at the cost of holding the coefficients in memory.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap to be encoded
+ * @param[in] sink The sink which receives the encoded bytes
+ * @param[in] opts Encoding options or NULL to use imc_jpeg_enc_default_opts()
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_jpeg_write_sink(
+    const Pixmap_t* const pixmap,
+    const JpegSink_t* const sink,
+    const JpegEncOpts_t* const opts
+) {
+    ImcError_t status;
+    JpegEncoder_t *enc = NULL;
+    JpegEncOpts_t def_opts = imc_jpeg_enc_default_opts();
+    const JpegEncOpts_t *_opts = (opts != NULL) ? opts : &def_opts;
+    size_t my;
+
+    if (pixmap == NULL || pixmap->data == NULL || sink == NULL || sink->write == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    } else if (pixmap->bit_depth != 8 || pixmap->n_channels < 1 || pixmap->n_channels > 4) {
+        IMC_LOG("JPEG encoder only supports 8-bit pixmaps with 1 to 4 channels", IMC_ERROR);
+        return IMC_EINVAL;
+    } else if (pixmap->width == 0 || pixmap->height == 0 || pixmap->width > 65535 || pixmap->height > 65535) {
+        IMC_LOG("JPEG dimensions must be between 1 and 65535", IMC_ERROR);
+        return IMC_EINVAL;
+    } else if (_opts->quality < 1 || _opts->quality > 100) {
+        IMC_LOG("JPEG quality must be between 1 and 100", IMC_ERROR);
+        return IMC_EINVAL;
+    } else if (_opts->subsampling != JPEG_SUBSAMPLE_444 && _opts->subsampling != JPEG_SUBSAMPLE_422
+            && _opts->subsampling != JPEG_SUBSAMPLE_420) {
+        IMC_LOG("Invalid JPEG chroma subsampling", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    enc = calloc(1, sizeof(JpegEncoder_t));
+    if (enc == NULL) {
+        IMC_LOG("Failed to allocate memory for JPEG encoder", IMC_ERROR);
+        return IMC_ENOMEM;
+    }
+
+    status = _imc_jpeg_enc_init(enc, pixmap, sink, _opts);
+    if (status != IMC_EOK) {
+        goto cleanup;
+    }
+
+    if (enc->optimize) {
+        for (my = 0; my < enc->mcuy; ++my) {
+            _imc_jpeg_transform_row(enc, my);
+        }
+        status = _imc_jpeg_write_coefs(enc);
+    } else {
+        _imc_jpeg_write_headers(enc);
+        for (my = 0; my < enc->mcuy && enc->writer.status == IMC_EOK; ++my) {
+            _imc_jpeg_transform_row(enc, my);
+            _imc_jpeg_encode_row(enc, my, false);
+        }
+        status = _imc_jpeg_finish(enc);
+    }
+
+cleanup:
+    _imc_jpeg_enc_destroy(enc);
+    free(enc);
+
+    return status;
+}
+
+/**
+ * @brief Encodes __pixmap__ as a JPEG file.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap to be encoded
+ * @param[in] fname The name of the output file
+ * @param[in] opts Encoding options or NULL to use imc_jpeg_enc_default_opts()
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_jpeg_write(
+    const Pixmap_t* const pixmap,
+    const char* const fname,
+    const JpegEncOpts_t* const opts
+) {
+    ImcError_t status;
+    JpegSink_t sink;
+    FILE *fp = NULL;
+
+    fp = fopen(fname, "wb");
+    if (fp == NULL) {
+        IMC_LOG("Failed to open file for write", IMC_ERROR);
+        return IMC_EFAIL;
+    }
+
+    sink.write = _imc_jpeg_file_sink_write;
+    sink.ctx = fp;
+
+    status = imc_jpeg_write_sink(pixmap, &sink, opts);
+    if (fclose(fp) != 0 && status == IMC_EOK) {
+        IMC_LOG("Failed to close file", IMC_ERROR);
+        status = IMC_EFAIL;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Encodes __pixmap__ as a JPEG held in memory.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap to be encoded
+ * @param[out] data The output location for the encoded JPEG, which the caller must free()
+ * @param[out] size The output location for the size of the encoded JPEG (in bytes)
+ * @param[in] opts Encoding options or NULL to use imc_jpeg_enc_default_opts()
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_jpeg_write_mem(
+    const Pixmap_t* const pixmap,
+    uint8_t **data,
+    size_t *size,
+    const JpegEncOpts_t* const opts
+) {
+    ImcError_t status;
+    JpegSink_t sink;
+    JpegMemBuf_t buf = { 0 };
+
+    if (data == NULL || size == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    sink.write = _imc_jpeg_mem_sink_write;
+    sink.ctx = &buf;
+
+    status = imc_jpeg_write_sink(pixmap, &sink, opts);
+    if (status != IMC_EOK) {
+        free(buf.data);
+        *data = NULL;
+        *size = 0;
+        return status;
+    }
+
+    *data = buf.data;
+    *size = buf.size;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Losslessly transforms the JPEG held in memory at __data__ and passes the result to __sink__.
+ * The frame is entropy-decoded into its quantized DCT coefficients, which are rearranged block
+ * by block (see _imc_jpeg_xform_coefs()) and Huffman coded again with optimal tables, so no
+ * inverse or forward DCT runs and no quality is lost. Transforms which swap the axes also swap
+ * each component's sampling factors and transpose the quantization tables. Like jpegtran's -trim
+ * option, a partial MCU at an edge which the transform moves is dropped, which trims up to 15
+ * pixels from the right or bottom of the source. The output is a baseline (or, for 16-bit
+ * quantization tables, extended sequential) JPEG without restart markers, which keeps the APPn
+ * and COM segments of the source. Any EXIF orientation tag among them is left unchanged.
+ * @since 16-10-2026
+ * @param[in] data The JPEG file's contents
+ * @param[in] size The length of __data__ (in bytes)
+ * @param[in] xform The transform
+ * @param[in] sink The sink which receives the transformed JPEG
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_jpeg_transform_sink(
+    const uint8_t* const data,
+    const size_t size,
+    const JpegTransform_t xform,
+    const JpegSink_t* const sink
+) {
+    ImcError_t status;
+    JpegDecoder_t *dec = NULL;
+    JpegEncoder_t *enc = NULL;
+    size_t width, height, iw, ih;
+    bool swap = (xform == JPEG_XFORM_TRANSPOSE || xform == JPEG_XFORM_TRANSVERSE
+        || xform == JPEG_XFORM_ROT_90 || xform == JPEG_XFORM_ROT_270);
+    uint8_t i;
+
+    if (data == NULL || sink == NULL || sink->write == NULL || xform < JPEG_XFORM_NONE || xform > JPEG_XFORM_ROT_270) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    dec = calloc(1, sizeof(JpegDecoder_t));
+    enc = calloc(1, sizeof(JpegEncoder_t));
+    if (dec == NULL || enc == NULL) {
+        IMC_LOG("Failed to allocate memory for JPEG transform", IMC_ERROR);
+        free(dec);
+        free(enc);
+        return IMC_ENOMEM;
+    }
+    dec->data = dec->pos = data;
+    dec->end = data + size;
+    dec->adobe_transform = -1;
+    dec->idct = _imc_jpeg_select_idct(false);
+    dec->block_size = 8;
+    dec->n_threads = 1;
+    dec->coefs_only = true;
+
+    status = _imc_jpeg_read_segments(dec);
+    if (status != IMC_EOK) {
+        goto cleanup;
+    }
+
+    /* A single component is never interleaved, so each of its MCUs is one block */
+    for (i = 0; i < dec->n_comps; ++i) {
+        enc->comps[i].id = dec->comps[i].id;
+        enc->comps[i].h = (dec->n_comps == 1) ? 1 : (swap ? dec->comps[i].v : dec->comps[i].h);
+        enc->comps[i].v = (dec->n_comps == 1) ? 1 : (swap ? dec->comps[i].h : dec->comps[i].v);
+        enc->comps[i].tq = dec->comps[i].tq;
+        enc->comps[i].th = (i == 0) ? 0 : 1;
+    }
+    iw = 8 * ((dec->n_comps == 1) ? 1 : dec->hmax);
+    ih = 8 * ((dec->n_comps == 1) ? 1 : dec->vmax);
+
+    width = dec->width;
+    height = dec->height;
+    if (xform == JPEG_XFORM_FLIP_H || xform == JPEG_XFORM_ROT_180
+            || xform == JPEG_XFORM_ROT_270 || xform == JPEG_XFORM_TRANSVERSE) {
+        width -= width % iw;
+    }
+    if (xform == JPEG_XFORM_FLIP_V || xform == JPEG_XFORM_ROT_180
+            || xform == JPEG_XFORM_ROT_90 || xform == JPEG_XFORM_TRANSVERSE) {
+        height -= height % ih;
+    }
+    if (width == 0 || height == 0) {
+        IMC_LOG("JPEG is smaller than an MCU along a mirrored axis", IMC_ERROR);
+        status = IMC_EINVAL;
+        goto cleanup;
+    }
+
+    enc->width = swap ? height : width;
+    enc->height = swap ? width : height;
+    enc->n_comps = dec->n_comps;
+    enc->hmax = (uint8_t)((swap ? ih : iw) / 8);
+    enc->vmax = (uint8_t)((swap ? iw : ih) / 8);
+    enc->mcux = (enc->width + 8 * enc->hmax - 1) / (8 * enc->hmax);
+    enc->mcuy = (enc->height + 8 * enc->vmax - 1) / (8 * enc->vmax);
+    enc->optimize = true;
+    enc->src = data;
+    enc->src_size = size;
+    enc->writer.sink = sink;
+    enc->writer.status = IMC_EOK;
+
+    status = _imc_jpeg_xform_coefs(dec, xform, enc);
+    if (status == IMC_EOK) {
+        status = _imc_jpeg_write_coefs(enc);
+    }
+
+cleanup:
+    _imc_jpeg_dec_destroy(dec);
+    _imc_jpeg_enc_destroy(enc);
+    free(dec);
+    free(enc);
+
+    return status;
+}
+
+/**
+ * @brief Losslessly transforms the JPEG referenced by __jpeg__ and writes the result to a file.
+ * @since 16-10-2026
+ * @param[in] jpeg A handle to the JPEG file obtained by invoking imc_jpeg_open()
+ * @param[in] xform The transform (see imc_jpeg_transform_sink())
+ * @param[in] fname The name of the output file
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_jpeg_transform(JpegHndl_t *jpeg, const JpegTransform_t xform, const char* const fname) {
+    ImcError_t status;
+    JpegSink_t sink;
+    FILE *fp = NULL;
+
+    if (jpeg == NULL || fname == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    fp = fopen(fname, "wb");
+    if (fp == NULL) {
+        IMC_LOG("Failed to open file for write", IMC_ERROR);
+        return IMC_EFAIL;
+    }
+
+    sink.write = _imc_jpeg_file_sink_write;
+    sink.ctx = fp;
+
+    status = imc_jpeg_transform_sink(jpeg->data, jpeg->size, xform, &sink);
+    if (fclose(fp) != 0 && status == IMC_EOK) {
+        IMC_LOG("Failed to close file", IMC_ERROR);
+        status = IMC_EFAIL;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Losslessly transforms the JPEG held in memory at __data__ into a JPEG held in memory.
+ * @since 16-10-2026
+ * @param[in] data The JPEG file's contents
+ * @param[in] size The length of __data__ (in bytes)
+ * @param[in] xform The transform (see imc_jpeg_transform_sink())
+ * @param[out] out The output location for the transformed JPEG, which the caller must free()
+ * @param[out] out_size The output location for the size of the transformed JPEG (in bytes)
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_jpeg_transform_mem(
+    const uint8_t* const data,
+    const size_t size,
+    const JpegTransform_t xform,
+    uint8_t **out,
+    size_t *out_size
+) {
+    ImcError_t status;
+    JpegSink_t sink;
+    JpegMemBuf_t buf = { 0 };
+
+    if (out == NULL || out_size == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    sink.write = _imc_jpeg_mem_sink_write;
+    sink.ctx = &buf;
+
+    status = imc_jpeg_transform_sink(data, size, xform, &sink);
+    if (status != IMC_EOK) {
+        free(buf.data);
+        *out = NULL;
+        *out_size = 0;
+        return status;
+    }
+
+    *out = buf.data;
+    *out_size = buf.size;
+
+    return IMC_EOK;
+}
@@ -0,0 +1,2506 @@
+/**
+ * @file png_encoder.c
+ * @author Neil Kingdom
+ * @since 16-10-2026
+ * @version 1.0
+ * @brief Contains the functions necessary for encoding a Pixmap_t as a PNG.
+ *
+ * Scanlines are filtered one at a time and fed straight into deflate, so the
+ * encoder never holds more than two unfiltered scanlines and the five filtered
+ * candidates in memory. Compressed output is emitted as IDAT chunks of at most
+ * PngEncOpts_t.idat_size bytes to a PngSink_t, which may write to a file,
+ * grow a memory buffer, or forward the bytes anywhere else.
+ */
+
+#include "png_encoder.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* Zero padding kept either side of a scanline so that neighbours can be read unconditionally */
+#define _PNG_ROW_PAD 16
+
+/* The number of filter types defined by filter method 0 */
+#define _PNG_N_FILTERS 5
+
+/* Minimum amount of filtered data (in bytes) given to each thread of a parallel encode */
+#define _PNG_MIN_BAND_SIZE (1 << 19)
+
+typedef struct {
+    PngSink_t sink;                             /* Destination of the encoded bytes */
+    z_stream  stream;                           /* Deflate state */
+    Ihdr_t    ihdr;                             /* Header of the image being encoded */
+    uint8_t   filter;                           /* NONE, SUB, UP, AVG, PAETH or ADAPTIVE */
+    size_t    bpp;                              /* Bytes per complete pixel (rounded up to 1) */
+    size_t    scanline_len;                     /* Length of an unfiltered scanline (in bytes) */
+    size_t    row_len;                          /* Length of a row of the caller's pixels (in bytes) */
+    size_t    idat_size;                        /* Maximum length of an IDAT data segment */
+    uint8_t  *prev_scanline;                    /* Previous unfiltered scanline (padded) */
+    uint8_t  *curr_scanline;                    /* Current unfiltered scanline (padded) */
+    uint8_t  *filt_buf[_PNG_N_FILTERS];         /* Filtered candidates prefixed by their filter type */
+    uint8_t  *chunk_buf;                        /* IDAT header, data segment and CRC */
+    uint8_t  *row_mem;                          /* Backing allocation of the scanline buffers */
+    bool      stream_init;                      /* True once deflateInit2() has succeeded */
+    bool      framed;                           /* False to emit bare deflate data rather than IDAT chunks */
+    bool      wrap;                             /* True to emit a zlib stream rather than raw deflate */
+    bool      fast;                             /* True to compress with the run-length compressor */
+    bool      in_tree;                          /* True to compress with the in-tree LZ77 compressor */
+    uint32_t  adler;                            /* Adler-32 of the data fed to deflate unless zlib computes it */
+    uint8_t  *zbuf;                             /* Output of the in-tree compressors */
+    DeflateRle_t rle;                           /* Run-length compressor state */
+    DeflateLz_t  lz;                            /* LZ77 compressor state */
+    const Palette_t *palette;                   /* Palette of an indexed-color image (NULL otherwise) */
+    const Chunk_t   *ancillary;                 /* Ancillary chunks copied into the output */
+    size_t           n_ancillary;               /* Number of ancillary chunks */
+} PngEncState_t;
+
+struct PngEncHndl {
+    PngEncState_t state;                        /* Encoder state */
+    size_t        rows_left;                    /* Number of scanlines not yet written */
+    ImcError_t    status;                       /* First error encountered (sticky) */
+};
+
+typedef struct {
+    uint8_t *data;      /* Encoded PNG */
+    size_t   size;      /* Number of bytes written */
+    size_t   capacity;  /* Number of bytes allocated */
+} PngMemBuf_t;
+
+typedef struct {
+    const Pixmap_t     *pixmap;     /* The pixmap being encoded */
+    const Ihdr_t       *ihdr;       /* Header of the image being encoded */
+    const PngEncOpts_t *opts;       /* Encoding options */
+    size_t              band_rows;  /* Number of scanlines per band */
+    size_t              n_bands;    /* Number of bands */
+    size_t              next_band;  /* Index of the next band to be claimed by a worker */
+    PngMemBuf_t        *bands;      /* Raw deflate data of each band */
+    uint32_t           *adlers;     /* Adler-32 of the filtered scanlines of each band */
+    ImcError_t          status;     /* First error reported by a worker */
+    pthread_mutex_t     lock;       /* Guards next_band and status */
+} PngBandJob_t;
+
+typedef struct {
+    Pixmap_t    sub;        /* Pixels of the frame's region as they are stored in the APNG */
+    bool        owns_data;  /* True if sub.data must be freed */
+    uint32_t    x;          /* Horizontal offset of the region */
+    uint32_t    y;          /* Vertical offset of the region */
+    uint8_t     dispose;    /* APNG_DISPOSE_* applied after the frame */
+    uint8_t     blend;      /* APNG_BLEND_* used to render the frame */
+    PngMemBuf_t zdata;      /* Compressed region (a zlib stream) */
+} ApngPlan_t;
+
+typedef struct {
+    const uint8_t *canvas;      /* Canvas the frame would be rendered onto */
+    size_t         rect[4];     /* Region in which the frame differs from canvas (x, y, width, height) */
+    uint8_t        dispose;     /* APNG_DISPOSE_* of the previous frame which leaves canvas */
+    uint8_t        blend;       /* APNG_BLEND_* used to render the frame */
+    Pixmap_t       sub;         /* Pixels of the region as they would be stored (data is NULL if blend cannot reproduce the frame) */
+    PngMemBuf_t    zdata;       /* Compressed region (a zlib stream) */
+} ApngCand_t;
+
+typedef struct {
+    ApngCand_t         *cands;      /* Candidate plans for the frame */
+    size_t              n_cands;    /* Number of candidates */
+    const Pixmap_t     *target;     /* The complete frame */
+    const PngEncOpts_t *opts;       /* Options the candidates are compressed with */
+    size_t              next_cand;  /* Next candidate to be claimed by a worker */
+    ImcError_t          status;     /* First error reported by a worker */
+    pthread_mutex_t     lock;       /* Guards next_cand and status */
+} ApngTrialJob_t;
+
+typedef struct {
+    ApngPlan_t         *plans;      /* One plan per frame */
+    size_t              n_frames;   /* Number of frames */
+    const PngEncOpts_t *opts;       /* Encoding options */
+    size_t              next_frame; /* Next frame to be claimed by a worker */
+    ImcError_t          status;     /* First error reported by a worker */
+    pthread_mutex_t     lock;       /* Guards next_frame and status */
+} ApngJob_t;
+
+/*
+ * ===============================
+ *       Private Functions
+ * ===============================
+ */
+
+/**
+ * @brief Store __val__ in __buf__ in network (big-endian) byte order.
+ * @since 16-10-2026
+ * @param[out] buf The output location of at least 4 bytes
+ * @param[in] val The value to be stored
+ */
+static void _imc_put_u32(uint8_t *buf, const uint32_t val) {
+    buf[0] = (val >> 24) & 0xFF;
+    buf[1] = (val >> 16) & 0xFF;
+    buf[2] = (val >>  8) & 0xFF;
+    buf[3] = (val >>  0) & 0xFF;
+}
+
+/**
+ * @brief Writes a complete chunk (length, type, data and CRC) to __sink__.
+ * @since 16-10-2026
+ * @param[in] sink The sink which receives the chunk
+ * @param[in] type The four character chunk type code
+ * @param[in] data The chunk's data segment (may be NULL if __len__ is 0)
+ * @param[in] len The length of the data segment (in bytes)
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_write_chunk(
+    const PngSink_t* const sink,
+    const char* const type,
+    const uint8_t* const data,
+    const uint32_t len
+) {
+    ImcError_t status;
+    uint32_t crc;
+    uint8_t header[8], footer[4];
+
+    _imc_put_u32(header, len);
+    memcpy((void*)(header + 4), (void*)type, 4);
+
+    crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, header + 4, 4);
+    if (len > 0) {
+        crc = crc32(crc, data, len);
+    }
+    _imc_put_u32(footer, crc);
+
+    status = sink->write(sink->ctx, header, sizeof(header));
+    if (status == IMC_EOK && len > 0) {
+        status = sink->write(sink->ctx, data, len);
+    }
+    if (status == IMC_EOK) {
+        status = sink->write(sink->ctx, footer, sizeof(footer));
+    }
+
+    return status;
+}
+
+/**
+ * @brief Emits the IDAT chunk staged in __state__'s chunk buffer.
+ * The chunk buffer reserves 8 bytes ahead of the data segment and 4 bytes after it so that
+ * the whole chunk reaches the sink in a single write. Unframed states emit only the data segment.
+ * @since 16-10-2026
+ * @param[in,out] state The encoder state whose pending compressed data will be flushed
+ * @param[in] len The number of compressed bytes staged in the data segment
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_flush_idat(PngEncState_t *state, const size_t len) {
+    uint32_t crc;
+    uint8_t *chunk = state->chunk_buf;
+
+    if (len == 0) {
+        return IMC_EOK;
+    } else if (!state->framed) {
+        return state->sink.write(state->sink.ctx, chunk + 8, len);
+    }
+
+    _imc_put_u32(chunk, (uint32_t)len);
+    memcpy((void*)(chunk + 4), (void*)IDAT, 4);
+    crc = crc32(0L, chunk + 4, len + 4);
+    _imc_put_u32(chunk + 8 + len, crc);
+
+    return state->sink.write(state->sink.ctx, chunk, len + 12);
+}
+
+/**
+ * @brief Maps the number of channels in a pixmap onto the corresponding PNG color type.
+ * @since 16-10-2026
+ * @param[in] n_channels The number of channels / samples per pixel
+ * @param[out] color_type The output location for the color type
+ * @returns IMC_EINVAL if there is no matching color type, otherwise IMC_EOK
+ */
+static ImcError_t _imc_png_color_type(const uint8_t n_channels, uint8_t *color_type) {
+    switch (n_channels) {
+        case 1:
+            *color_type = NONE;
+            break;
+        case 2:
+            *color_type = ALPHA;
+            break;
+        case 3:
+            *color_type = COLOR;
+            break;
+        case 4:
+            *color_type = (COLOR | ALPHA);
+            break;
+        default:
+            return IMC_EINVAL;
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Fills in the header of an image with the given dimensions and sample format.
+ * @since 16-10-2026
+ * @param[in] width The width of the image (in pixels)
+ * @param[in] height The height of the image (in pixels)
+ * @param[in] n_channels The number of channels per pixel (1-4)
+ * @param[in] bit_depth The number of bits per sample
+ * @param[out] ihdr The output location for the header
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_make_ihdr(
+    const size_t width,
+    const size_t height,
+    const uint8_t n_channels,
+    const uint8_t bit_depth,
+    Ihdr_t *ihdr
+) {
+    ImcError_t status;
+
+    memset((void*)ihdr, 0, sizeof(*ihdr));
+
+    if (width > INT32_MAX || height > INT32_MAX) {
+        IMC_LOG("Invalid image dimensions", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    status = _imc_png_color_type(n_channels, &ihdr->color_type);
+    if (status != IMC_EOK) {
+        IMC_LOG("Pixmap has an unsupported number of channels", IMC_ERROR);
+        return status;
+    }
+
+    ihdr->width = width;
+    ihdr->height = height;
+    ihdr->bit_depth = bit_depth;
+    ihdr->n_channels = n_channels;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Returns the smallest bit depth able to index a palette of __n_entries__ colors.
+ * @since 16-10-2026
+ * @param[in] n_entries The number of palette entries (1-256)
+ * @returns 1, 2, 4 or 8
+ */
+static uint8_t _imc_palette_bit_depth(const size_t n_entries) {
+    if (n_entries <= 2) {
+        return 1;
+    } else if (n_entries <= 4) {
+        return 2;
+    } else if (n_entries <= 16) {
+        return 4;
+    }
+
+    return 8;
+}
+
+/**
+ *                    +-+-+
+ * Previous scanline: |c|b|
+ *                    +-+-+
+ * Current scanline:  |a|x|
+ *                    +-+-+
+ *
+ * Both scanlines are padded with zeros so that (a) and (c) read as 0 for the
+ * first pixel and every neighbour of the first scanline reads as 0.
+ */
+
+/**
+ * @brief IDAT filter method 0 (NONE).
+ * Filt(x) = Orig(x)
+ * @since 16-10-2026
+ * @param[in] prev_scanline The previous unfiltered scanline
+ * @param[in] curr_scanline The scanline being filtered
+ * @param[out] out The output location for the filtered scanline
+ * @param[in] len The length of the scanline (in bytes)
+ * @param[in] bpp The number of bytes per complete pixel
+ */
+static void _imc_filter_none(
+    const uint8_t *prev_scanline,
+    const uint8_t *curr_scanline,
+    uint8_t *out,
+    const size_t len,
+    const size_t bpp
+) {
+    (void)prev_scanline;
+    (void)bpp;
+
+    memcpy((void*)out, (void*)curr_scanline, len);
+}
+
+/**
+ * @brief IDAT filter method 1 (SUB).
+ * Filt(x) = Orig(x) - Orig(a)
+ * @since 16-10-2026
+ * @param[in] prev_scanline The previous unfiltered scanline
+ * @param[in] curr_scanline The scanline being filtered
+ * @param[out] out The output location for the filtered scanline
+ * @param[in] len The length of the scanline (in bytes)
+ * @param[in] bpp The number of bytes per complete pixel
+ */
+static void _imc_filter_sub(
+    const uint8_t *prev_scanline,
+    const uint8_t *curr_scanline,
+    uint8_t *out,
+    const size_t len,
+    const size_t bpp
+) {
+    size_t i;
+
+    (void)prev_scanline;
+
+    for (i = 0; i < len; ++i) {
+        out[i] = curr_scanline[i] - curr_scanline[i - bpp];
+    }
+}
+
+/**
+ * @brief IDAT filter method 2 (UP).
+ * Filt(x) = Orig(x) - Orig(b)
+ * @since 16-10-2026
+ * @param[in] prev_scanline The previous unfiltered scanline
+ * @param[in] curr_scanline The scanline being filtered
+ * @param[out] out The output location for the filtered scanline
+ * @param[in] len The length of the scanline (in bytes)
+ * @param[in] bpp The number of bytes per complete pixel
+ */
+static void _imc_filter_up(
+    const uint8_t *prev_scanline,
+    const uint8_t *curr_scanline,
+    uint8_t *out,
+    const size_t len,
+    const size_t bpp
+) {
+    size_t i;
+
+    (void)bpp;
+
+    for (i = 0; i < len; ++i) {
+        out[i] = curr_scanline[i] - prev_scanline[i];
+    }
+}
+
+/**
+ * @brief IDAT filter method 3 (AVERAGE).
+ * Filt(x) = Orig(x) - floor((Orig(a) + Orig(b)) / 2)
+ * @since 16-10-2026
+ * @param[in] prev_scanline The previous unfiltered scanline
+ * @param[in] curr_scanline The scanline being filtered
+ * @param[out] out The output location for the filtered scanline
+ * @param[in] len The length of the scanline (in bytes)
+ * @param[in] bpp The number of bytes per complete pixel
+ */
+static void _imc_filter_avg(
+    const uint8_t *prev_scanline,
+    const uint8_t *curr_scanline,
+    uint8_t *out,
+    const size_t len,
+    const size_t bpp
+) {
+    size_t i;
+    for (i = 0; i < len; ++i) {
+        out[i] = curr_scanline[i] - ((curr_scanline[i - bpp] + prev_scanline[i]) >> 1);
+    }
+}
+
+/**
+ * @brief The paeth predictor algorithm used in filter type 4: PAETH.
+ * @since 16-10-2026
+ * @param[in] a Byte to the left of x
+ * @param[in] b Byte directly above x
+ * @param[in] c Byte to the left of b
+ * @returns The predictor for byte x
+ */
+static inline uint8_t _imc_paeth_predictor(const uint8_t a, const uint8_t b, const uint8_t c) {
+    int32_t pa = abs((int32_t)b - c);
+    int32_t pb = abs((int32_t)a - c);
+    int32_t pc = abs((int32_t)a + b - 2 * c);
+
+    if (pa <= pb && pa <= pc) {
+        return a;
+    } else if (pb <= pc) {
+        return b;
+    }
+
+    return c;
+}
+
+/**
+ * @brief IDAT filter method 4 (PAETH).
+ * Filt(x) = Orig(x) - PaethPredictor(Orig(a), Orig(b), Orig(c))
+ * @since 16-10-2026
+ * @param[in] prev_scanline The previous unfiltered scanline
+ * @param[in] curr_scanline The scanline being filtered
+ * @param[out] out The output location for the filtered scanline
+ * @param[in] len The length of the scanline (in bytes)
+ * @param[in] bpp The number of bytes per complete pixel
+ */
+static void _imc_filter_paeth(
+    const uint8_t *prev_scanline,
+    const uint8_t *curr_scanline,
+    uint8_t *out,
+    const size_t len,
+    const size_t bpp
+) {
+    size_t i;
+    for (i = 0; i < len; ++i) {
+        out[i] = curr_scanline[i] - _imc_paeth_predictor(
+            curr_scanline[i - bpp], prev_scanline[i], prev_scanline[i - bpp]
+        );
+    }
+}
+
+static const filter_func _imc_filters[_PNG_N_FILTERS] = {
+    _imc_filter_none,
+    _imc_filter_sub,
+    _imc_filter_up,
+    _imc_filter_avg,
+    _imc_filter_paeth
+};
+
+/**
+ * @brief Scores a filtered scanline by summing the magnitude of each byte treated as a signed value.
+ * Lower scores tend to compress better, which is the heuristic recommended by the PNG specification.
+ * @since 16-10-2026
+ * @param[in] filt The filtered scanline
+ * @param[in] len The length of the filtered scanline (in bytes)
+ * @returns The sum of absolute differences of the scanline
+ */
+static uint64_t _imc_filter_score(const uint8_t *filt, const size_t len) {
+    size_t i;
+    uint64_t sum = 0;
+
+    for (i = 0; i < len; ++i) {
+        sum += (filt[i] < 128) ? filt[i] : 256 - filt[i];
+    }
+
+    return sum;
+}
+
+#if defined(__SSE2__)
+
+/**
+ * @brief Computes the paeth predictor for 8 pixels held in the low or high half of 16-bit lanes.
+ * @since 16-10-2026
+ * @param[in] a Bytes to the left of x widened to 16 bits
+ * @param[in] b Bytes directly above x widened to 16 bits
+ * @param[in] c Bytes to the left of b widened to 16 bits
+ * @returns The predictors widened to 16 bits
+ */
+static inline __m128i _imc_paeth_epi16(const __m128i a, const __m128i b, const __m128i c) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i bc = _mm_sub_epi16(b, c);
+    __m128i ac = _mm_sub_epi16(a, c);
+    __m128i abc = _mm_add_epi16(bc, ac);
+    __m128i pa = _mm_max_epi16(bc, _mm_sub_epi16(zero, bc));
+    __m128i pb = _mm_max_epi16(ac, _mm_sub_epi16(zero, ac));
+    __m128i pc = _mm_max_epi16(abc, _mm_sub_epi16(zero, abc));
+    /* Lanes where pa <= pb && pa <= pc select a, else lanes where pb <= pc select b, otherwise c */
+    __m128i not_a = _mm_or_si128(_mm_cmpgt_epi16(pa, pb), _mm_cmpgt_epi16(pa, pc));
+    __m128i not_b = _mm_cmpgt_epi16(pb, pc);
+    __m128i bc_sel = _mm_or_si128(_mm_and_si128(not_b, c), _mm_andnot_si128(not_b, b));
+
+    return _mm_or_si128(_mm_and_si128(not_a, bc_sel), _mm_andnot_si128(not_a, a));
+}
+
+/**
+ * @brief Computes the paeth predictor for 16 bytes.
+ * @since 16-10-2026
+ * @param[in] a Bytes to the left of x
+ * @param[in] b Bytes directly above x
+ * @param[in] c Bytes to the left of b
+ * @returns The 16 predicted bytes
+ */
+static inline __m128i _imc_paeth_sse2(const __m128i a, const __m128i b, const __m128i c) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i lo = _imc_paeth_epi16(
+        _mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero), _mm_unpacklo_epi8(c, zero)
+    );
+    __m128i hi = _imc_paeth_epi16(
+        _mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero), _mm_unpackhi_epi8(c, zero)
+    );
+
+    return _mm_packus_epi16(lo, hi);
+}
+
+/**
+ * @brief Accumulates the sum of absolute (signed) byte values of __v__ into __acc__.
+ * @since 16-10-2026
+ * @param[in] acc Two 64-bit running sums
+ * @param[in] v The filtered bytes being scored
+ * @returns The updated running sums
+ */
+static inline __m128i _imc_sad_sse2(const __m128i acc, const __m128i v) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i mag = _mm_min_epu8(v, _mm_sub_epi8(zero, v));
+    return _mm_add_epi64(acc, _mm_sad_epu8(mag, zero));
+}
+
+/**
+ * @brief Filters a scanline with each filter selected by __mask__ in a single pass and scores the results.
+ * Whole vectors are processed here and the remaining tail falls back to the scalar filters.
+ * @since 16-10-2026
+ * @param[in] prev_scanline The previous unfiltered scanline (padded)
+ * @param[in] curr_scanline The scanline being filtered (padded)
+ * @param[out] out Output locations for each filter type (entries not in __mask__ are untouched)
+ * @param[out] scores Output locations for the score of each filter type
+ * @param[in] len The length of the scanline (in bytes)
+ * @param[in] bpp The number of bytes per complete pixel
+ * @param[in] mask Bit i is set if filter type i should be computed
+ */
+static void _imc_filter_sse2(
+    const uint8_t *prev_scanline,
+    const uint8_t *curr_scanline,
+    uint8_t **out,
+    uint64_t *scores,
+    const size_t len,
+    const size_t bpp,
+    const uint8_t mask
+) {
+    size_t i, f;
+    __m128i x, a, b, c, v;
+    __m128i one = _mm_set1_epi8(1);
+    __m128i acc[_PNG_N_FILTERS];
+
+    for (f = 0; f < _PNG_N_FILTERS; ++f) {
+        acc[f] = _mm_setzero_si128();
+    }
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        x = _mm_loadu_si128((const __m128i*)(curr_scanline + i));
+        a = _mm_loadu_si128((const __m128i*)(curr_scanline + i - bpp));
+        b = _mm_loadu_si128((const __m128i*)(prev_scanline + i));
+        c = _mm_loadu_si128((const __m128i*)(prev_scanline + i - bpp));
+
+        if (mask & (1 << NONE)) {
+            _mm_storeu_si128((__m128i*)(out[NONE] + i), x);
+            acc[NONE] = _imc_sad_sse2(acc[NONE], x);
+        }
+        if (mask & (1 << SUB)) {
+            v = _mm_sub_epi8(x, a);
+            _mm_storeu_si128((__m128i*)(out[SUB] + i), v);
+            acc[SUB] = _imc_sad_sse2(acc[SUB], v);
+        }
+        if (mask & (1 << UP)) {
+            v = _mm_sub_epi8(x, b);
+            _mm_storeu_si128((__m128i*)(out[UP] + i), v);
+            acc[UP] = _imc_sad_sse2(acc[UP], v);
+        }
+        if (mask & (1 << AVG)) {
+            /* _mm_avg_epu8 rounds up, so subtract the carried low bit to get floor((a + b) / 2) */
+            v = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+            v = _mm_sub_epi8(x, v);
+            _mm_storeu_si128((__m128i*)(out[AVG] + i), v);
+            acc[AVG] = _imc_sad_sse2(acc[AVG], v);
+        }
+        if (mask & (1 << PAETH)) {
+            v = _mm_sub_epi8(x, _imc_paeth_sse2(a, b, c));
+            _mm_storeu_si128((__m128i*)(out[PAETH] + i), v);
+            acc[PAETH] = _imc_sad_sse2(acc[PAETH], v);
+        }
+    }
+
+    for (f = 0; f < _PNG_N_FILTERS; ++f) {
+        if (mask & (1 << f)) {
+            acc[f] = _mm_add_epi64(acc[f], _mm_unpackhi_epi64(acc[f], acc[f]));
+            scores[f] = (uint64_t)_mm_cvtsi128_si64(acc[f]);
+            if (i < len) {
+                _imc_filters[f](prev_scanline + i, curr_scanline + i, out[f] + i, len - i, bpp);
+                scores[f] += _imc_filter_score(out[f] + i, len - i);
+            }
+        }
+    }
+}
+
+#endif /* __SSE2__ */
+
+/**
+ * @brief Filters the current scanline of __state__ and returns the buffer holding the chosen filtered scanline.
+ * In ADAPTIVE mode all five filters are tried and the one with the lowest sum of absolute differences wins.
+ * @since 16-10-2026
+ * @param[in,out] state The encoder state holding the current and previous scanlines
+ * @returns A buffer of scanline_len + 1 bytes beginning with the filter type byte
+ */
+static uint8_t *_imc_png_filter_scanline(PngEncState_t *state) {
+    size_t f, best;
+    uint64_t scores[_PNG_N_FILTERS] = { 0 };
+    uint8_t mask = (state->filter == ADAPTIVE) ? 0x1F : (1 << state->filter);
+    uint8_t *out[_PNG_N_FILTERS];
+
+    for (f = 0; f < _PNG_N_FILTERS; ++f) {
+        out[f] = state->filt_buf[f] + 1;
+    }
+
+#if defined(__SSE2__)
+    _imc_filter_sse2(
+        state->prev_scanline, state->curr_scanline, out, scores,
+        state->scanline_len, state->bpp, mask
+    );
+#else
+    for (f = 0; f < _PNG_N_FILTERS; ++f) {
+        if (mask & (1 << f)) {
+            _imc_filters[f](
+                state->prev_scanline, state->curr_scanline, out[f],
+                state->scanline_len, state->bpp
+            );
+            if (state->filter == ADAPTIVE) {
+                scores[f] = _imc_filter_score(out[f], state->scanline_len);
+            }
+        }
+    }
+#endif
+
+    if (state->filter != ADAPTIVE) {
+        return state->filt_buf[state->filter];
+    }
+
+    best = NONE;
+    for (f = SUB; f < _PNG_N_FILTERS; ++f) {
+        if (scores[f] < scores[best]) {
+            best = f;
+        }
+    }
+
+    return state->filt_buf[best];
+}
+
+/**
+ * @brief Appends __len__ bytes to the IDAT staged in __state__, emitting a chunk each time it fills.
+ * The output cursor of the z_stream tracks the staged bytes whether or not zlib is compressing.
+ * @since 16-10-2026
+ * @param[in,out] state The encoder state owning the chunk buffer
+ * @param[in] data The bytes to be staged
+ * @param[in] len The number of bytes to be staged
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_stage_idat(PngEncState_t *state, const uint8_t *data, size_t len) {
+    size_t n;
+    ImcError_t status;
+    z_stream *stream = &state->stream;
+
+    while (len > 0) {
+        n = (stream->avail_out < len) ? stream->avail_out : len;
+        memcpy((void*)stream->next_out, (void*)data, n);
+        stream->next_out += n;
+        stream->avail_out -= n;
+        data += n;
+        len -= n;
+
+        if (stream->avail_out == 0) {
+            status = _imc_png_flush_idat(state, state->idat_size);
+            if (status != IMC_EOK) {
+                return status;
+            }
+            stream->next_out  = state->chunk_buf + 8;
+            stream->avail_out = state->idat_size;
+        }
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Builds the two byte zlib header for a deflate stream with a 32K window.
+ * @since 16-10-2026
+ * @param[in] level The zlib compression level, which is recorded as a hint
+ * @param[out] hdr The output location for the header
+ */
+static void _imc_zlib_header(const int level, uint8_t *hdr) {
+    uint8_t flevel;
+
+    if (level == Z_DEFAULT_COMPRESSION || level == 6) {
+        flevel = 2;
+    } else {
+        flevel = (level < 2) ? 0 : (level < 6) ? 1 : 3;
+    }
+
+    /* FCHECK pads the header to a multiple of 31 */
+    hdr[0] = 0x78;
+    hdr[1] = flevel << 6;
+    hdr[1] += 31 - ((hdr[0] << 8) + hdr[1]) % 31;
+}
+
+/**
+ * @brief Feeds __len__ bytes into the deflate stream, emitting an IDAT chunk each time the chunk buffer fills.
+ * In fast mode the bytes go to the run-length compressor instead, and with in_tree set to the LZ77
+ * compressor. A flush ends their current block.
+ * @since 16-10-2026
+ * @param[in,out] state The encoder state
+ * @param[in] data The bytes to be compressed (may be NULL when finishing)
+ * @param[in] len The number of bytes to be compressed
+ * @param[in] flush The zlib flush mode (Z_NO_FLUSH, Z_FULL_FLUSH or Z_FINISH)
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_deflate(
+    PngEncState_t *state,
+    const uint8_t *data,
+    const size_t len,
+    const int flush
+) {
+    int status;
+    bool full;
+    size_t n;
+    ImcError_t err;
+    uint8_t trailer[4];
+    z_stream *stream = &state->stream;
+
+    if ((state->fast || state->in_tree || !state->wrap) && len > 0) {
+        state->adler = imc_adler32(state->adler, data, len);
+    }
+
+    if (state->fast || state->in_tree) {
+        if (state->fast) {
+            n = imc_deflate_rle_write(&state->rle, data, len, state->zbuf);
+        } else {
+            n = imc_deflate_write(&state->lz, data, len, state->zbuf);
+        }
+        err = _imc_png_stage_idat(state, state->zbuf, n);
+        if (err != IMC_EOK || flush == Z_NO_FLUSH) {
+            return err;
+        }
+
+        if (state->fast) {
+            n = imc_deflate_rle_end(&state->rle, state->zbuf, flush == Z_FINISH);
+        } else {
+            n = imc_deflate_end(&state->lz, state->zbuf, flush == Z_FINISH);
+        }
+        err = _imc_png_stage_idat(state, state->zbuf, n);
+        if (err == IMC_EOK && state->wrap && flush == Z_FINISH) {
+            _imc_put_u32(trailer, state->adler);
+            err = _imc_png_stage_idat(state, trailer, sizeof(trailer));
+        }
+        return err;
+    }
+
+    stream->next_in  = (Bytef*)data;
+    stream->avail_in = len;
+
+    do {
+        status = deflate(stream, flush);
+        if (status == Z_STREAM_ERROR) {
+            IMC_LOG("Compression error", IMC_ERROR);
+            return IMC_EFAIL;
+        }
+
+        /* A flush is only complete once deflate() returns with output space to spare */
+        full = (stream->avail_out == 0);
+        if (full) {
+            err = _imc_png_flush_idat(state, state->idat_size);
+            if (err != IMC_EOK) {
+                return err;
+            }
+            stream->next_out  = state->chunk_buf + 8;
+            stream->avail_out = state->idat_size;
+        }
+    } while (
+        stream->avail_in > 0 ||
+        (flush == Z_FINISH && status != Z_STREAM_END) ||
+        (flush != Z_NO_FLUSH && full)
+    );
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Releases all resources held by __state__.
+ * @since 16-10-2026
+ * @param[in,out] state The encoder state to be destroyed
+ */
+static void _imc_png_enc_destroy(PngEncState_t *state) {
+    if (state->stream_init) {
+        (void)deflateEnd(&state->stream);
+        state->stream_init = false;
+    }
+    if (state->fast) {
+        imc_deflate_rle_destroy(&state->rle);
+    }
+    if (state->in_tree) {
+        imc_deflate_destroy(&state->lz);
+    }
+
+    free(state->row_mem);
+    free(state->chunk_buf);
+    free(state->zbuf);
+    state->row_mem = NULL;
+    state->chunk_buf = NULL;
+    state->zbuf = NULL;
+}
+
+/**
+ * @brief Validates the encoding parameters and allocates the scanline buffers and deflate stream.
+ * @since 16-10-2026
+ * @param[out] state The encoder state to be initialized
+ * @param[in] ihdr The header of the image being encoded (n_channels must be set)
+ * @param[in] sink The sink which receives the encoded bytes
+ * @param[in] opts Encoding options
+ * @param[in] window_bits Passed to deflateInit2() (negative for raw deflate, or 0 to skip creating a compressor)
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_enc_alloc(
+    PngEncState_t *state,
+    const Ihdr_t* const ihdr,
+    const PngSink_t* const sink,
+    const PngEncOpts_t* const opts,
+    const int window_bits
+) {
+    int status, level;
+    size_t f, padded_len;
+
+    memset((void*)state, 0, sizeof(*state));
+
+    if (ihdr->width == 0 || ihdr->height == 0 || ihdr->width > INT32_MAX || ihdr->height > INT32_MAX) {
+        IMC_LOG("Invalid image dimensions", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    if (ihdr->bit_depth != 8 && ihdr->bit_depth != 16) {
+        IMC_LOG("Only bit depths of 8 and 16 are supported", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    if (opts->filter > ADAPTIVE || opts->idat_size == 0 || opts->idat_size > INT32_MAX) {
+        IMC_LOG("Invalid encoding options", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    level = opts->level;
+    if (opts->in_tree && level == Z_DEFAULT_COMPRESSION) {
+        level = DEFLATE_DEFAULT_LEVEL;
+    }
+    if (opts->in_tree && !opts->fast && (level < DEFLATE_MIN_LEVEL || level > DEFLATE_MAX_LEVEL)) {
+        IMC_LOG("Invalid compression level", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    for (f = 0; f < opts->n_ancillary; ++f) {
+        /* Bit 5 of the first byte of the type is set for ancillary chunks */
+        if (opts->ancillary == NULL || !(opts->ancillary[f].type[0] & 0x20)) {
+            IMC_LOG("Only ancillary chunks may be copied into the output", IMC_ERROR);
+            return IMC_EINVAL;
+        }
+    }
+
+    state->sink = *sink;
+    state->ihdr = *ihdr;
+    state->row_len = (size_t)ihdr->n_channels * ihdr->width * (ihdr->bit_depth >> 3);
+    state->ancillary = opts->ancillary;
+    state->n_ancillary = opts->n_ancillary;
+
+    if (opts->palette != NULL) {
+        if (ihdr->n_channels != 1 || ihdr->bit_depth != 8) {
+            IMC_LOG("Indexed-color images must be encoded from 8-bit palette indices", IMC_ERROR);
+            return IMC_EINVAL;
+        }
+        if (opts->palette->n_entries == 0 || opts->palette->n_entries > 256) {
+            IMC_LOG("Palette must hold between 1 and 256 entries", IMC_ERROR);
+            return IMC_EINVAL;
+        }
+        state->palette = opts->palette;
+        state->ihdr.color_type = PALETTE | COLOR;
+        state->ihdr.bit_depth = _imc_palette_bit_depth(opts->palette->n_entries);
+    }
+
+    state->framed = true;
+    state->wrap = (window_bits > 0);
+    state->fast = opts->fast && window_bits != 0;
+    state->in_tree = opts->in_tree && !state->fast && window_bits != 0;
+    state->adler = 1;
+    /* The fast preset never searches for a filter */
+    state->filter = (opts->fast && opts->filter == ADAPTIVE) ? PNG_FAST_FILTER : opts->filter;
+    state->idat_size = opts->idat_size;
+    state->bpp = (state->ihdr.n_channels * state->ihdr.bit_depth + 7) >> 3;
+    state->scanline_len = ((size_t)state->ihdr.n_channels * state->ihdr.width * state->ihdr.bit_depth + 7) >> 3;
+
+    /* Two padded scanlines followed by five filtered candidates (each with a leading filter type byte) */
+    padded_len = state->scanline_len + 2 * _PNG_ROW_PAD;
+    state->row_mem = calloc(2 * padded_len + _PNG_N_FILTERS * padded_len, 1);
+    state->chunk_buf = malloc(state->idat_size + 12);
+    if (state->row_mem == NULL || state->chunk_buf == NULL) {
+        IMC_LOG("Failed to allocate memory for scanline buffers", IMC_ERROR);
+        _imc_png_enc_destroy(state);
+        return IMC_ENOMEM;
+    }
+
+    state->prev_scanline = state->row_mem + _PNG_ROW_PAD;
+    state->curr_scanline = state->row_mem + padded_len + _PNG_ROW_PAD;
+    for (f = 0; f < _PNG_N_FILTERS; ++f) {
+        state->filt_buf[f] = state->row_mem + (2 + f) * padded_len;
+        state->filt_buf[f][0] = f;
+    }
+
+    if (state->fast) {
+        state->zbuf = malloc(imc_deflate_rle_bound(state->scanline_len + 1));
+        if (state->zbuf == NULL) {
+            IMC_LOG("Failed to allocate memory for compression buffer", IMC_ERROR);
+            _imc_png_enc_destroy(state);
+            return IMC_ENOMEM;
+        }
+        if (imc_deflate_rle_init(&state->rle, state->bpp) != IMC_EOK) {
+            _imc_png_enc_destroy(state);
+            return IMC_ENOMEM;
+        }
+    } else if (state->in_tree) {
+        state->zbuf = malloc(imc_deflate_bound(state->scanline_len + 1));
+        if (state->zbuf == NULL) {
+            IMC_LOG("Failed to allocate memory for compression buffer", IMC_ERROR);
+            _imc_png_enc_destroy(state);
+            return IMC_ENOMEM;
+        }
+        if (imc_deflate_init(&state->lz, level, state->bpp) != IMC_EOK) {
+            _imc_png_enc_destroy(state);
+            return IMC_ENOMEM;
+        }
+    } else if (window_bits != 0) {
+        status = deflateInit2(&state->stream, opts->level, Z_DEFLATED, window_bits, 8, opts->strategy);
+        if (status != Z_OK) {
+            IMC_LOG("Failed to initialize compression stream", IMC_ERROR);
+            _imc_png_enc_destroy(state);
+            return IMC_EFAIL;
+        }
+        state->stream_init = true;
+    }
+    state->stream.next_out  = state->chunk_buf + 8;
+    state->stream.avail_out = state->idat_size;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Returns true if ancillary chunk __chunk__ must precede PLTE.
+ * @since 16-10-2026
+ * @param[in] chunk The ancillary chunk
+ * @returns True for cHRM, gAMA, iCCP, sBIT and sRGB, otherwise false
+ */
+static bool _imc_chunk_before_plte(const Chunk_t* const chunk) {
+    return memcmp(chunk->type, CHRM, 4) == 0 || memcmp(chunk->type, GAMA, 4) == 0 ||
+           memcmp(chunk->type, ICCP, 4) == 0 || memcmp(chunk->type, SBIT, 4) == 0 ||
+           memcmp(chunk->type, SRGB, 4) == 0;
+}
+
+/**
+ * @brief Writes every ancillary chunk of __state__ which does (or does not) belong before PLTE.
+ * @since 16-10-2026
+ * @param[in] state The encoder state
+ * @param[in] before_plte Selects which chunks are written
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_write_ancillary(const PngEncState_t* const state, const bool before_plte) {
+    size_t i;
+    const Chunk_t *chunk;
+    ImcError_t status = IMC_EOK;
+
+    for (i = 0; i < state->n_ancillary && status == IMC_EOK; ++i) {
+        chunk = &state->ancillary[i];
+        if (_imc_chunk_before_plte(chunk) == before_plte) {
+            status = _imc_png_write_chunk(&state->sink, chunk->type, chunk->data, chunk->length);
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Writes the PLTE chunk, and a tRNS chunk if any entry is not fully opaque.
+ * tRNS may be shorter than PLTE (missing entries are opaque), so it stops at the last translucent entry.
+ * @since 16-10-2026
+ * @param[in] state The encoder state
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_write_palette(const PngEncState_t* const state) {
+    size_t i, n_trns = 0;
+    uint8_t plte[3 * 256] = {0}, trns[256] = {0};
+    ImcError_t status;
+    const Palette_t *palette = state->palette;
+
+    for (i = 0; i < palette->n_entries; ++i) {
+        plte[3 * i + 0] = palette->entries[i].r;
+        plte[3 * i + 1] = palette->entries[i].g;
+        plte[3 * i + 2] = palette->entries[i].b;
+        trns[i] = palette->entries[i].a;
+        if (trns[i] != 0xFF) {
+            n_trns = i + 1;
+        }
+    }
+
+    status = _imc_png_write_chunk(&state->sink, PLTE, plte, 3 * palette->n_entries);
+    if (status == IMC_EOK && n_trns > 0) {
+        status = _imc_png_write_chunk(&state->sink, TRNS, trns, n_trns);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Writes the PNG signature and every chunk which precedes the first IDAT.
+ * @since 16-10-2026
+ * @param[in] state The encoder state
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_write_header(const PngEncState_t* const state) {
+    ImcError_t status;
+    uint8_t ihdr_buf[13];
+    const PngSink_t *sink = &state->sink;
+    const Ihdr_t *ihdr = &state->ihdr;
+
+    _imc_put_u32(ihdr_buf + 0, ihdr->width);
+    _imc_put_u32(ihdr_buf + 4, ihdr->height);
+    ihdr_buf[8]  = ihdr->bit_depth;
+    ihdr_buf[9]  = ihdr->color_type;
+    ihdr_buf[10] = 0; /* Deflate */
+    ihdr_buf[11] = 0; /* Adaptive filtering */
+    ihdr_buf[12] = 0; /* Non-interlaced */
+
+    status = sink->write(sink->ctx, PNG_MAGIC, sizeof(PNG_MAGIC));
+    if (status == IMC_EOK) {
+        status = _imc_png_write_chunk(sink, IHDR, ihdr_buf, sizeof(ihdr_buf));
+    }
+    if (status == IMC_EOK) {
+        status = _imc_png_write_ancillary(state, true);
+    }
+    if (status == IMC_EOK && state->palette != NULL) {
+        status = _imc_png_write_palette(state);
+    }
+    if (status == IMC_EOK) {
+        status = _imc_png_write_ancillary(state, false);
+    }
+    if (status != IMC_EOK) {
+        IMC_LOG("Failed to write PNG header", IMC_ERROR);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Stages anything the compressor must emit before the first scanline.
+ * zlib writes its own header, but the in-tree compressors emit raw deflate
+ * and need one added when they are producing a zlib stream.
+ * @since 16-10-2026
+ * @param[in,out] state The encoder state
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_enc_start(PngEncState_t *state) {
+    uint8_t zhdr[2];
+
+    if ((!state->fast && !state->in_tree) || !state->wrap) {
+        return IMC_EOK;
+    }
+
+    _imc_zlib_header(state->fast ? 1 : state->lz.level, zhdr);
+    return _imc_png_stage_idat(state, zhdr, sizeof(zhdr));
+}
+
+/**
+ * @brief Initializes __state__ for a serial encode and writes the PNG signature and IHDR.
+ * @since 16-10-2026
+ * @param[out] state The encoder state to be initialized
+ * @param[in] ihdr The header of the image being encoded (n_channels must be set)
+ * @param[in] sink The sink which receives the encoded bytes
+ * @param[in] opts Encoding options
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_enc_init(
+    PngEncState_t *state,
+    const Ihdr_t* const ihdr,
+    const PngSink_t* const sink,
+    const PngEncOpts_t* const opts
+) {
+    ImcError_t status;
+
+    status = _imc_png_enc_alloc(state, ihdr, sink, opts, 15);
+    if (status != IMC_EOK) {
+        return status;
+    }
+
+    status = _imc_png_write_header(state);
+    if (status == IMC_EOK) {
+        status = _imc_png_enc_start(state);
+    }
+    if (status != IMC_EOK) {
+        _imc_png_enc_destroy(state);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Checks that every palette index in a row of the caller's pixels has a palette entry.
+ * Packing an index which does not fit the bit depth would corrupt its neighbours, and at a depth
+ * of 8 it would refer past the end of PLTE, so such rows are rejected rather than encoded.
+ * @since 16-10-2026
+ * @param[in] state The encoder state
+ * @param[in] row A row of the caller's pixels (row_len bytes)
+ * @returns IMC_EINVAL if an index is out of range, otherwise IMC_EOK
+ */
+static ImcError_t _imc_png_check_indices(const PngEncState_t* const state, const uint8_t *row) {
+    size_t x;
+
+    if (state->palette == NULL || state->palette->n_entries == 256) {
+        return IMC_EOK;
+    }
+
+    for (x = 0; x < state->ihdr.width; ++x) {
+        if (row[x] >= state->palette->n_entries) {
+            IMC_LOG("Palette index out of range", IMC_ERROR);
+            return IMC_EINVAL;
+        }
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Copies a row of the caller's pixels into __dst__ as an unfiltered scanline.
+ * Rows of palette indices are packed to the bit depth of the image, leftmost pixel in the
+ * most significant bits. Everything else is stored as is.
+ * @since 16-10-2026
+ * @param[in] state The encoder state
+ * @param[out] dst The output location for the scanline (scanline_len bytes)
+ * @param[in] row A row of the caller's pixels (row_len bytes)
+ */
+static void _imc_png_load_scanline(const PngEncState_t* const state, uint8_t *dst, const uint8_t *row) {
+    size_t x;
+    uint8_t depth = state->ihdr.bit_depth;
+    uint8_t per_byte;
+
+    if (state->palette == NULL || depth == 8) {
+        memcpy((void*)dst, (void*)row, state->scanline_len);
+        return;
+    }
+
+    per_byte = 8 / depth;
+    memset((void*)dst, 0, state->scanline_len);
+    for (x = 0; x < state->ihdr.width; ++x) {
+        dst[x / per_byte] |= row[x] << (8 - depth * (x % per_byte + 1));
+    }
+}
+
+/**
+ * @brief Filters the next unfiltered scanline and makes it the previous scanline of __state__.
+ * @since 16-10-2026
+ * @param[in,out] state The encoder state
+ * @param[in] scanline A row of the caller's pixels (row_len bytes)
+ * @returns A buffer of scanline_len + 1 bytes beginning with the filter type byte
+ */
+static uint8_t *_imc_png_filter_next(PngEncState_t *state, const uint8_t *scanline) {
+    uint8_t *tmp, *filt;
+
+    _imc_png_load_scanline(state, state->curr_scanline, scanline);
+    filt = _imc_png_filter_scanline(state);
+
+    tmp = state->prev_scanline;
+    state->prev_scanline = state->curr_scanline;
+    state->curr_scanline = tmp;
+
+    return filt;
+}
+
+/**
+ * @brief Filters and compresses one unfiltered scanline.
+ * @since 16-10-2026
+ * @param[in,out] state The encoder state
+ * @param[in] scanline A row of the caller's pixels (row_len bytes)
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_enc_scanline(PngEncState_t *state, const uint8_t *scanline) {
+    uint8_t *filt;
+    ImcError_t status;
+
+    status = _imc_png_check_indices(state, scanline);
+    if (status != IMC_EOK) {
+        return status;
+    }
+
+    filt = _imc_png_filter_next(state, scanline);
+    return _imc_png_deflate(state, filt, state->scanline_len + 1, Z_NO_FLUSH);
+}
+
+/**
+ * @brief Terminates the deflate stream, writes the final IDAT and IEND chunks and releases __state__.
+ * @since 16-10-2026
+ * @param[in,out] state The encoder state
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_enc_finish(PngEncState_t *state) {
+    ImcError_t status;
+
+    status = _imc_png_deflate(state, NULL, 0, Z_FINISH);
+    if (status == IMC_EOK) {
+        status = _imc_png_flush_idat(state, state->idat_size - state->stream.avail_out);
+    }
+    if (status == IMC_EOK) {
+        status = _imc_png_write_chunk(&state->sink, IEND, NULL, 0);
+    }
+
+    _imc_png_enc_destroy(state);
+    return status;
+}
+
+/**
+ * @brief PngSink_t callback which writes to a FILE.
+ * @since 16-10-2026
+ * @param[in] ctx The FILE being written to
+ * @param[in] data The bytes to be written
+ * @param[in] len The number of bytes to be written
+ * @returns IMC_EFAIL if the write was short, otherwise IMC_EOK
+ */
+static ImcError_t _imc_file_sink_write(void *ctx, const uint8_t *data, const size_t len) {
+    return (fwrite((void*)data, 1, len, (FILE*)ctx) == len) ? IMC_EOK : IMC_EFAIL;
+}
+
+/**
+ * @brief PngSink_t callback which appends to a growable PngMemBuf_t.
+ * @since 16-10-2026
+ * @param[in] ctx The PngMemBuf_t being appended to
+ * @param[in] data The bytes to be appended
+ * @param[in] len The number of bytes to be appended
+ * @returns IMC_ENOMEM if the buffer could not be grown, otherwise IMC_EOK
+ */
+static ImcError_t _imc_mem_sink_write(void *ctx, const uint8_t *data, const size_t len) {
+    size_t capacity;
+    uint8_t *tmp = NULL;
+    PngMemBuf_t *buf = (PngMemBuf_t*)ctx;
+
+    if (buf->size + len > buf->capacity) {
+        capacity = (buf->capacity > 0) ? buf->capacity : 4096;
+        while (capacity < buf->size + len) {
+            capacity *= 2;
+        }
+
+        tmp = realloc(buf->data, capacity);
+        if (tmp == NULL) {
+            IMC_LOG("Failed to grow memory sink", IMC_ERROR);
+            return IMC_ENOMEM;
+        }
+        buf->data = tmp;
+        buf->capacity = capacity;
+    }
+
+    memcpy((void*)(buf->data + buf->size), (void*)data, len);
+    buf->size += len;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Filters and compresses one band of scanlines into a raw deflate stream held in memory.
+ * The band is primed with the scanline preceding it so its filters match a serial encode, but
+ * it shares no dictionary with its neighbours. Every band except the last ends with a full flush
+ * (byte aligned and without a final block) so that the bands can simply be concatenated.
+ * @since 16-10-2026
+ * @param[in,out] job The shared band job
+ * @param[in] band The index of the band to be compressed
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_enc_band(PngBandJob_t *job, const size_t band) {
+    size_t y, first, last;
+    uint8_t *filt;
+    ImcError_t status;
+    PngEncState_t state;
+    PngSink_t sink = { _imc_mem_sink_write, &job->bands[band] };
+    const Pixmap_t *pixmap = job->pixmap;
+
+    status = _imc_png_enc_alloc(&state, job->ihdr, &sink, job->opts, -15);
+    if (status != IMC_EOK) {
+        return status;
+    }
+    state.framed = false;
+
+    first = band * job->band_rows;
+    last = first + job->band_rows;
+    if (last > pixmap->height) {
+        last = pixmap->height;
+    }
+
+    if (first > 0) {
+        _imc_png_load_scanline(&state, state.prev_scanline, pixmap->data + (first - 1) * state.row_len);
+    }
+
+    status = _imc_png_enc_start(&state);
+    for (y = first; y < last && status == IMC_EOK; ++y) {
+        status = _imc_png_check_indices(&state, pixmap->data + y * state.row_len);
+        if (status == IMC_EOK) {
+            filt = _imc_png_filter_next(&state, pixmap->data + y * state.row_len);
+            status = _imc_png_deflate(&state, filt, state.scanline_len + 1, Z_NO_FLUSH);
+        }
+    }
+
+    if (status == IMC_EOK) {
+        status = _imc_png_deflate(&state, NULL, 0, (last == pixmap->height) ? Z_FINISH : Z_FULL_FLUSH);
+    }
+    if (status == IMC_EOK) {
+        status = _imc_png_flush_idat(&state, state.idat_size - state.stream.avail_out);
+    }
+
+    job->adlers[band] = state.adler;
+    _imc_png_enc_destroy(&state);
+    return status;
+}
+
+/**
+ * @brief Thread entry point which compresses bands until none remain or a worker fails.
+ * @since 16-10-2026
+ * @param[in,out] arg The shared PngBandJob_t
+ * @returns NULL
+ */
+static void *_imc_png_band_worker(void *arg) {
+    size_t band;
+    ImcError_t status;
+    PngBandJob_t *job = (PngBandJob_t*)arg;
+
+    while (true) {
+        pthread_mutex_lock(&job->lock);
+        if (job->status != IMC_EOK || job->next_band >= job->n_bands) {
+            pthread_mutex_unlock(&job->lock);
+            break;
+        }
+        band = job->next_band++;
+        pthread_mutex_unlock(&job->lock);
+
+        status = _imc_png_enc_band(job, band);
+        if (status != IMC_EOK) {
+            pthread_mutex_lock(&job->lock);
+            if (job->status == IMC_EOK) {
+                job->status = status;
+            }
+            pthread_mutex_unlock(&job->lock);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Encodes __pixmap__ by compressing bands of scanlines on separate threads, in the style of pigz.
+ * The raw deflate streams of the bands are concatenated behind a single zlib header and followed by
+ * the Adler-32 of the whole filtered image, combined from the per-band checksums. The result is an
+ * ordinary zlib stream, so any PNG decoder can read it.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap to be encoded
+ * @param[in] ihdr The header of the image being encoded
+ * @param[in] sink The sink which receives the encoded bytes
+ * @param[in] opts Encoding options
+ * @param[in] band_rows The number of scanlines per band
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_write_parallel(
+    const Pixmap_t* const pixmap,
+    const Ihdr_t* const ihdr,
+    const PngSink_t* const sink,
+    const PngEncOpts_t* const opts,
+    const size_t band_rows
+) {
+    size_t b, n_spawned;
+    uint8_t zhdr[2], ztrl[4];
+    uint32_t adler;
+    ImcError_t status;
+    PngEncState_t state;
+    PngBandJob_t job = { 0 };
+    pthread_t *threads = NULL;
+
+    status = _imc_png_enc_alloc(&state, ihdr, sink, opts, 0);
+    if (status != IMC_EOK) {
+        return status;
+    }
+
+    job.pixmap = pixmap;
+    job.ihdr = ihdr;
+    job.opts = opts;
+    job.band_rows = band_rows;
+    job.n_bands = (pixmap->height + band_rows - 1) / band_rows;
+    job.status = IMC_EOK;
+    job.bands = calloc(job.n_bands, sizeof(*job.bands));
+    job.adlers = calloc(job.n_bands, sizeof(*job.adlers));
+    threads = calloc(opts->n_threads, sizeof(*threads));
+    if (job.bands == NULL || job.adlers == NULL || threads == NULL) {
+        IMC_LOG("Failed to allocate memory for band job", IMC_ERROR);
+        status = IMC_ENOMEM;
+        goto cleanup;
+    }
+    pthread_mutex_init(&job.lock, NULL);
+
+    /* The calling thread works too, so spawn one fewer than requested */
+    for (n_spawned = 0; n_spawned + 1 < opts->n_threads && n_spawned + 1 < job.n_bands; ++n_spawned) {
+        if (pthread_create(&threads[n_spawned], NULL, _imc_png_band_worker, &job) != 0) {
+            IMC_LOG("Failed to spawn encoder thread", IMC_WARNING);
+            break;
+        }
+    }
+    _imc_png_band_worker(&job);
+    for (b = 0; b < n_spawned; ++b) {
+        pthread_join(threads[b], NULL);
+    }
+    pthread_mutex_destroy(&job.lock);
+
+    status = job.status;
+    if (status != IMC_EOK) {
+        goto cleanup;
+    }
+
+    _imc_zlib_header(opts->fast ? 1 : opts->level, zhdr);
+
+    adler = 1;
+    for (b = 0; b < job.n_bands; ++b) {
+        adler = adler32_combine(adler, job.adlers[b], (z_off_t)(
+            ((b + 1 < job.n_bands) ? band_rows : pixmap->height - b * band_rows) * (state.scanline_len + 1)
+        ));
+    }
+    _imc_put_u32(ztrl, adler);
+
+    status = _imc_png_write_header(&state);
+    if (status == IMC_EOK) {
+        status = _imc_png_stage_idat(&state, zhdr, sizeof(zhdr));
+    }
+    for (b = 0; b < job.n_bands && status == IMC_EOK; ++b) {
+        status = _imc_png_stage_idat(&state, job.bands[b].data, job.bands[b].size);
+        free(job.bands[b].data);
+        job.bands[b].data = NULL;
+    }
+    if (status == IMC_EOK) {
+        status = _imc_png_stage_idat(&state, ztrl, sizeof(ztrl));
+    }
+    if (status == IMC_EOK) {
+        status = _imc_png_flush_idat(&state, state.idat_size - state.stream.avail_out);
+    }
+    if (status == IMC_EOK) {
+        status = _imc_png_write_chunk(sink, IEND, NULL, 0);
+    }
+
+cleanup:
+    if (job.bands != NULL) {
+        for (b = 0; b < job.n_bands; ++b) {
+            free(job.bands[b].data);
+        }
+    }
+    free(job.bands);
+    free(job.adlers);
+    free(threads);
+    _imc_png_enc_destroy(&state);
+
+    return status;
+}
+
+/**
+ * @brief Filters and compresses every scanline of __pixmap__ into a bare zlib stream held in memory.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap to be compressed
+ * @param[in] opts Encoding options
+ * @param[out] out The output location for the zlib stream
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_png_compress(
+    const Pixmap_t* const pixmap,
+    const PngEncOpts_t* const opts,
+    PngMemBuf_t *out
+) {
+    size_t y;
+    ImcError_t status;
+    Ihdr_t ihdr;
+    PngEncState_t state;
+    PngSink_t sink = { _imc_mem_sink_write, out };
+
+    status = _imc_png_make_ihdr(pixmap->width, pixmap->height, pixmap->n_channels, pixmap->bit_depth, &ihdr);
+    if (status == IMC_EOK) {
+        status = _imc_png_enc_alloc(&state, &ihdr, &sink, opts, 15);
+    }
+    if (status != IMC_EOK) {
+        return status;
+    }
+    state.framed = false;
+
+    status = _imc_png_enc_start(&state);
+    for (y = 0; y < pixmap->height && status == IMC_EOK; ++y) {
+        status = _imc_png_enc_scanline(&state, pixmap->data + y * state.row_len);
+    }
+    if (status == IMC_EOK) {
+        status = _imc_png_deflate(&state, NULL, 0, Z_FINISH);
+    }
+    if (status == IMC_EOK) {
+        status = _imc_png_flush_idat(&state, state.idat_size - state.stream.avail_out);
+    }
+
+    _imc_png_enc_destroy(&state);
+    return status;
+}
+
+/**
+ * @brief Finds the smallest rectangle outside of which __canvas__ and __target__ are identical.
+ * @since 16-10-2026
+ * @param[in] canvas The canvas before the frame is rendered
+ * @param[in] target The complete frame
+ * @param[in] width The width of both images (in pixels)
+ * @param[in] height The height of both images (in pixels)
+ * @param[in] px_size The size of a pixel (in bytes)
+ * @param[out] rect The output location for the x, y, width and height of the rectangle
+ * @returns False if the images are identical (__rect__ is then a single pixel at the origin), otherwise true
+ */
+static bool _imc_apng_diff_rect(
+    const uint8_t *canvas,
+    const uint8_t *target,
+    const size_t width,
+    const size_t height,
+    const size_t px_size,
+    size_t rect[4]
+) {
+    size_t x, y, top, bottom, left = width, right = 0;
+    const size_t row_len = width * px_size;
+
+    for (top = 0; top < height && memcmp(canvas + top * row_len, target + top * row_len, row_len) == 0; ++top);
+    if (top == height) {
+        rect[0] = rect[1] = 0;
+        rect[2] = rect[3] = 1;
+        return false;
+    }
+    for (bottom = height; memcmp(canvas + (bottom - 1) * row_len, target + (bottom - 1) * row_len, row_len) == 0; --bottom);
+
+    for (y = top; y < bottom; ++y) {
+        for (x = 0; x < left; ++x) {
+            if (memcmp(canvas + y * row_len + x * px_size, target + y * row_len + x * px_size, px_size) != 0) {
+                left = x;
+                break;
+            }
+        }
+        for (x = width; x > right; --x) {
+            if (memcmp(canvas + y * row_len + (x - 1) * px_size, target + y * row_len + (x - 1) * px_size, px_size) != 0) {
+                right = x;
+                break;
+            }
+        }
+    }
+
+    rect[0] = left;
+    rect[1] = top;
+    rect[2] = right - left;
+    rect[3] = bottom - top;
+
+    return true;
+}
+
+/**
+ * @brief Extracts the region of frame __target__ to be stored for blend operation __blend__.
+ * With APNG_BLEND_OVER, pixels which already match the canvas are made fully transparent (so they
+ * compress to almost nothing); this is only possible if every changed pixel is either opaque or lands
+ * on a fully transparent part of the canvas, since only then does compositing reproduce it exactly.
+ * @since 16-10-2026
+ * @param[in] canvas The canvas before the frame is rendered
+ * @param[in] target The complete frame
+ * @param[in] rect The region (x, y, width, height)
+ * @param[in] blend APNG_BLEND_SOURCE or APNG_BLEND_OVER
+ * @param[out] sub The output location for the region (width, height and format must already be set)
+ * @returns IMC_EINVAL if APNG_BLEND_OVER cannot reproduce the frame, otherwise an ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_apng_extract(
+    const uint8_t *canvas,
+    const Pixmap_t* const target,
+    const size_t rect[4],
+    const uint8_t blend,
+    Pixmap_t *sub
+) {
+    size_t x, y, a;
+    const uint8_t *src, *dst;
+    uint8_t *out;
+    const size_t px_size = imc_sizeof_px(*target);
+    const size_t a_size = target->bit_depth >> 3;
+    const size_t row_len = target->width * px_size;
+
+    sub->data = malloc(rect[2] * rect[3] * px_size);
+    if (sub->data == NULL) {
+        IMC_LOG("Failed to allocate memory for frame region", IMC_ERROR);
+        return IMC_ENOMEM;
+    }
+
+    for (y = 0; y < rect[3]; ++y) {
+        src = target->data + (rect[1] + y) * row_len + rect[0] * px_size;
+        out = sub->data + y * rect[2] * px_size;
+        if (blend == APNG_BLEND_SOURCE) {
+            memcpy((void*)out, (void*)src, rect[2] * px_size);
+            continue;
+        }
+
+        dst = canvas + (rect[1] + y) * row_len + rect[0] * px_size;
+        for (x = 0; x < rect[2]; ++x, src += px_size, dst += px_size, out += px_size) {
+            if (memcmp((void*)src, (void*)dst, px_size) == 0) {
+                memset((void*)out, 0, px_size);
+                continue;
+            }
+
+            /* The alpha sample is the last of the pixel */
+            for (a = px_size - a_size; a < px_size && src[a] == 0xFF; ++a);
+            if (a < px_size) {
+                for (a = px_size - a_size; a < px_size && dst[a] == 0x00; ++a);
+                /* A fully transparent pixel would leave the canvas untouched */
+                if (a < px_size || memcmp((void*)(src + px_size - a_size), (void*)(dst + px_size - a_size), a_size) == 0) {
+                    free(sub->data);
+                    sub->data = NULL;
+                    return IMC_EINVAL;
+                }
+            }
+            memcpy((void*)out, (void*)src, px_size);
+        }
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Releases the region and compressed data held by every plan.
+ * @since 16-10-2026
+ * @param[in,out] plans The frame plans
+ * @param[in] n_frames The number of plans
+ */
+static void _imc_apng_plans_destroy(ApngPlan_t *plans, const size_t n_frames) {
+    size_t i;
+
+    for (i = 0; i < n_frames; ++i) {
+        if (plans[i].owns_data) {
+            free(plans[i].sub.data);
+        }
+        free(plans[i].zdata.data);
+    }
+}
+
+/**
+ * @brief Thread entry point which extracts and compresses candidate plans until none remain or a worker fails.
+ * @since 16-10-2026
+ * @param[in,out] arg The shared ApngTrialJob_t
+ * @returns NULL
+ */
+static void *_imc_apng_trial_worker(void *arg) {
+    size_t c;
+    ImcError_t status;
+    ApngCand_t *cand;
+    ApngTrialJob_t *job = (ApngTrialJob_t*)arg;
+
+    while (true) {
+        pthread_mutex_lock(&job->lock);
+        if (job->status != IMC_EOK || job->next_cand >= job->n_cands) {
+            pthread_mutex_unlock(&job->lock);
+            break;
+        }
+        c = job->next_cand++;
+        pthread_mutex_unlock(&job->lock);
+
+        cand = &job->cands[c];
+        cand->sub = *job->target;
+        cand->sub.width = cand->rect[2];
+        cand->sub.height = cand->rect[3];
+        status = _imc_apng_extract(cand->canvas, job->target, cand->rect, cand->blend, &cand->sub);
+        if (status == IMC_EINVAL) {
+            continue;
+        } else if (status == IMC_EOK) {
+            status = _imc_png_compress(&cand->sub, job->opts, &cand->zdata);
+        }
+
+        if (status != IMC_EOK) {
+            pthread_mutex_lock(&job->lock);
+            if (job->status == IMC_EOK) {
+                job->status = status;
+            }
+            pthread_mutex_unlock(&job->lock);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Runs every candidate of __job__ on up to __n_threads__ threads (including the calling thread).
+ * @since 16-10-2026
+ * @param[in,out] job The frame's trials
+ * @param[in] n_threads The number of threads to use
+ * @param[out] threads Storage for the handles of up to __n_threads__ - 1 spawned threads
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_apng_run_trials(ApngTrialJob_t *job, const size_t n_threads, pthread_t *threads) {
+    size_t t, n_spawned;
+
+    job->next_cand = 0;
+    job->status = IMC_EOK;
+
+    /* The calling thread works too, so spawn one fewer than requested */
+    for (n_spawned = 0; n_spawned + 1 < n_threads && n_spawned + 1 < job->n_cands; ++n_spawned) {
+        if (pthread_create(&threads[n_spawned], NULL, _imc_apng_trial_worker, job) != 0) {
+            IMC_LOG("Failed to spawn encoder thread", IMC_WARNING);
+            break;
+        }
+    }
+    _imc_apng_trial_worker(job);
+    for (t = 0; t < n_spawned; ++t) {
+        pthread_join(threads[t], NULL);
+    }
+
+    return job->status;
+}
+
+/**
+ * @brief Chooses the region, blend operation and the previous frame's disposal for every frame.
+ * Frames are planned in order. For each frame, every disposal of the previous frame (NONE, BACKGROUND
+ * and PREVIOUS) is paired with every blend operation (SOURCE and OVER); BACKGROUND and OVER need an alpha
+ * channel to be of any use. Each candidate's region is the bounding box of the pixels which differ from
+ * the canvas it would be drawn on, and is sized by compressing it with the fast preset. The candidates of
+ * a frame are tried on up to PngEncOpts_t.n_threads threads, and the smallest wins (the first on a tie).
+ * @since 16-10-2026
+ * @param[in] frames The frames
+ * @param[in] n_frames The number of frames
+ * @param[in] opts Encoding options
+ * @param[out] plans The output location for one plan per frame
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_apng_plan(
+    const ApngFrame_t* const frames,
+    const size_t n_frames,
+    const PngEncOpts_t* const opts,
+    ApngPlan_t *plans
+) {
+    size_t i, c, y, best, prev_rect[4];
+    uint8_t d, b;
+    bool has_alpha;
+    uint8_t *canvas_before = NULL, *cleared = NULL;
+    const uint8_t *canvas;
+    ImcError_t status = IMC_EOK;
+    PngEncOpts_t est_opts = *opts;
+    ApngCand_t cands[6];
+    ApngTrialJob_t job = { 0 };
+    pthread_t *threads = NULL;
+    const Pixmap_t *first = frames[0].pixmap;
+    const size_t px_size = imc_sizeof_px(*first);
+    const size_t row_len = first->width * px_size;
+    const size_t frame_len = row_len * first->height;
+    const size_t n_threads = (opts->n_threads > 0) ? opts->n_threads : 1;
+
+    has_alpha = (first->n_channels == 2 || first->n_channels == 4);
+    est_opts.fast = true;
+    est_opts.n_threads = 1;
+    est_opts.palette = NULL;
+    est_opts.ancillary = NULL;
+    est_opts.n_ancillary = 0;
+
+    /* canvas_before holds the canvas as it was before the previous frame was rendered */
+    canvas_before = calloc(frame_len, 1);
+    cleared = malloc(frame_len);
+    threads = calloc(n_threads, sizeof(*threads));
+    if (canvas_before == NULL || cleared == NULL || threads == NULL) {
+        IMC_LOG("Failed to allocate memory for canvas", IMC_ERROR);
+        free(canvas_before);
+        free(cleared);
+        free(threads);
+        return IMC_ENOMEM;
+    }
+
+    job.cands = cands;
+    job.opts = &est_opts;
+    pthread_mutex_init(&job.lock, NULL);
+
+    /* The first frame is also the default image, so it always covers the whole canvas */
+    plans[0].sub = *first;
+    plans[0].blend = APNG_BLEND_SOURCE;
+
+    for (i = 1; i < n_frames; ++i) {
+        memset((void*)cands, 0, sizeof(cands));
+        job.n_cands = 0;
+        job.target = frames[i].pixmap;
+
+        prev_rect[0] = plans[i - 1].x;
+        prev_rect[1] = plans[i - 1].y;
+        prev_rect[2] = plans[i - 1].sub.width;
+        prev_rect[3] = plans[i - 1].sub.height;
+
+        for (d = APNG_DISPOSE_NONE; d <= APNG_DISPOSE_PREVIOUS; ++d) {
+            if (d == APNG_DISPOSE_NONE) {
+                canvas = frames[i - 1].pixmap->data;
+            } else if (d == APNG_DISPOSE_BACKGROUND && has_alpha) {
+                memcpy((void*)cleared, (void*)frames[i - 1].pixmap->data, frame_len);
+                for (y = prev_rect[1]; y < prev_rect[1] + prev_rect[3]; ++y) {
+                    memset((void*)(cleared + y * row_len + prev_rect[0] * px_size), 0, prev_rect[2] * px_size);
+                }
+                canvas = cleared;
+            } else if (d == APNG_DISPOSE_PREVIOUS && i > 1) {
+                /* PREVIOUS on the first frame means BACKGROUND, which is covered above */
+                canvas = canvas_before;
+            } else {
+                continue;
+            }
+
+            for (b = APNG_BLEND_SOURCE; b <= APNG_BLEND_OVER; ++b) {
+                if (b == APNG_BLEND_OVER && !has_alpha) {
+                    continue;
+                }
+
+                cands[job.n_cands].canvas = canvas;
+                cands[job.n_cands].dispose = d;
+                cands[job.n_cands].blend = b;
+                if (b == APNG_BLEND_SOURCE) {
+                    _imc_apng_diff_rect(canvas, frames[i].pixmap->data, first->width, first->height, px_size,
+                        cands[job.n_cands].rect);
+                } else {
+                    memcpy((void*)cands[job.n_cands].rect, (void*)cands[job.n_cands - 1].rect, sizeof(cands[0].rect));
+                }
+                ++job.n_cands;
+            }
+        }
+
+        status = _imc_apng_run_trials(&job, n_threads, threads);
+
+        /* SOURCE can always reproduce the frame, so at least one candidate has been compressed */
+        for (c = 0, best = job.n_cands; c < job.n_cands && status == IMC_EOK; ++c) {
+            if (cands[c].sub.data != NULL && (best == job.n_cands || cands[c].zdata.size < cands[best].zdata.size)) {
+                best = c;
+            }
+        }
+
+        if (status == IMC_EOK) {
+            plans[i].sub = cands[best].sub;
+            plans[i].owns_data = true;
+            plans[i].x = cands[best].rect[0];
+            plans[i].y = cands[best].rect[1];
+            plans[i].blend = cands[best].blend;
+            plans[i - 1].dispose = cands[best].dispose;
+
+            /* Only the fast preset can keep the estimate as the final compressed data */
+            if (opts->fast) {
+                plans[i].zdata = cands[best].zdata;
+            } else {
+                free(cands[best].zdata.data);
+            }
+            cands[best].sub.data = NULL;
+            cands[best].zdata.data = NULL;
+        }
+
+        for (c = 0; c < job.n_cands; ++c) {
+            free(cands[c].sub.data);
+            free(cands[c].zdata.data);
+        }
+
+        if (status != IMC_EOK) {
+            break;
+        }
+
+        /* Advance canvas_before to the canvas the current frame is rendered onto */
+        if (plans[i - 1].dispose == APNG_DISPOSE_NONE) {
+            memcpy((void*)canvas_before, (void*)frames[i - 1].pixmap->data, frame_len);
+        } else if (plans[i - 1].dispose == APNG_DISPOSE_BACKGROUND) {
+            memcpy((void*)canvas_before, (void*)frames[i - 1].pixmap->data, frame_len);
+            for (y = prev_rect[1]; y < prev_rect[1] + prev_rect[3]; ++y) {
+                memset((void*)(canvas_before + y * row_len + prev_rect[0] * px_size), 0, prev_rect[2] * px_size);
+            }
+        }
+    }
+
+    pthread_mutex_destroy(&job.lock);
+    free(canvas_before);
+    free(cleared);
+    free(threads);
+
+    return status;
+}
+
+/**
+ * @brief Thread entry point which compresses frame regions until none remain or a worker fails.
+ * @since 16-10-2026
+ * @param[in,out] arg The shared ApngJob_t
+ * @returns NULL
+ */
+static void *_imc_apng_worker(void *arg) {
+    size_t i;
+    ImcError_t status;
+    ApngJob_t *job = (ApngJob_t*)arg;
+
+    while (true) {
+        pthread_mutex_lock(&job->lock);
+        if (job->status != IMC_EOK || job->next_frame >= job->n_frames) {
+            pthread_mutex_unlock(&job->lock);
+            break;
+        }
+        i = job->next_frame++;
+        pthread_mutex_unlock(&job->lock);
+
+        if (job->plans[i].zdata.data != NULL) {
+            continue;
+        }
+
+        status = _imc_png_compress(&job->plans[i].sub, job->opts, &job->plans[i].zdata);
+        if (status != IMC_EOK) {
+            pthread_mutex_lock(&job->lock);
+            if (job->status == IMC_EOK) {
+                job->status = status;
+            }
+            pthread_mutex_unlock(&job->lock);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Writes an fcTL chunk.
+ * @since 16-10-2026
+ * @param[in] sink The sink which receives the chunk
+ * @param[in] seq The sequence number of the chunk
+ * @param[in] plan The frame's plan
+ * @param[in] frame The frame
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_apng_write_fctl(
+    const PngSink_t* const sink,
+    const uint32_t seq,
+    const ApngPlan_t* const plan,
+    const ApngFrame_t* const frame
+) {
+    uint8_t fctl[26];
+
+    _imc_put_u32(fctl + 0, seq);
+    _imc_put_u32(fctl + 4, plan->sub.width);
+    _imc_put_u32(fctl + 8, plan->sub.height);
+    _imc_put_u32(fctl + 12, plan->x);
+    _imc_put_u32(fctl + 16, plan->y);
+    fctl[20] = frame->delay_num >> 8;
+    fctl[21] = frame->delay_num;
+    fctl[22] = frame->delay_den >> 8;
+    fctl[23] = frame->delay_den;
+    fctl[24] = plan->dispose;
+    fctl[25] = plan->blend;
+
+    return _imc_png_write_chunk(sink, FCTL, fctl, sizeof(fctl));
+}
+
+/**
+ * @brief Writes a frame's zlib stream as IDAT chunks (the first frame) or fdAT chunks (every other frame).
+ * @since 16-10-2026
+ * @param[in] sink The sink which receives the chunks
+ * @param[in] zdata The frame's zlib stream
+ * @param[in] idat_size The maximum length of a chunk's image data (in bytes)
+ * @param[in] is_default True to write IDAT chunks
+ * @param[in,out] seq The next sequence number, advanced for every fdAT written
+ * @param[in] buf Scratch space of at least idat_size + 4 bytes
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_apng_write_data(
+    const PngSink_t* const sink,
+    const PngMemBuf_t* const zdata,
+    const size_t idat_size,
+    const bool is_default,
+    uint32_t *seq,
+    uint8_t *buf
+) {
+    size_t off, len;
+    ImcError_t status = IMC_EOK;
+
+    for (off = 0; off < zdata->size && status == IMC_EOK; off += len) {
+        len = (zdata->size - off < idat_size) ? zdata->size - off : idat_size;
+        if (is_default) {
+            status = _imc_png_write_chunk(sink, IDAT, zdata->data + off, len);
+        } else {
+            _imc_put_u32(buf, (*seq)++);
+            memcpy((void*)(buf + 4), (void*)(zdata->data + off), len);
+            status = _imc_png_write_chunk(sink, FDAT, buf, len + 4);
+        }
+    }
+
+    return status;
+}
+
+/*
+ * ===============================
+ *       Public Functions
+ * ===============================
+ */
+
+/**
+ * @brief Returns the default PNG encoding options.
+ * @since 16-10-2026
+ * @returns A PngEncOpts_t with zlib's default level and strategy, adaptive filtering, 64 KiB IDAT chunks,
+ * a single thread and the fast preset disabled
+ */
+PngEncOpts_t imc_png_default_opts(void) {
+    PngEncOpts_t opts;
+
+    opts.level = Z_DEFAULT_COMPRESSION;
+    opts.strategy = Z_DEFAULT_STRATEGY;
+    opts.filter = ADAPTIVE;
+    opts.idat_size = PNG_IDAT_SIZE;
+    opts.n_threads = 1;
+    opts.fast = false;
+    opts.in_tree = false;
+    opts.palette = NULL;
+    opts.ancillary = NULL;
+    opts.n_ancillary = 0;
+
+    return opts;
+}
+
+/**
+ * @brief Encodes __pixmap__ as a PNG and passes the encoded bytes to __sink__ as they are produced.
+ * Pixmaps with 1, 2, 3 or 4 channels are written as greyscale, greyscale + alpha, truecolor and
+ * truecolor + alpha respectively. 16-bit samples are expected in network byte order, which is
+ * how imc_png_parse() stores them. When PngEncOpts_t.n_threads is greater than 1 and the image is
+ * large enough, bands of scanlines are compressed in parallel. PngEncOpts_t.fast replaces zlib with
+ * a compressor which only looks for byte and pixel runs, which is several times faster, and
+ * PngEncOpts_t.in_tree replaces it with an LZ77 compressor whose levels extend past zlib's.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap to be encoded
+ * @param[in] sink The sink which receives the encoded bytes
+ * @param[in] opts Encoding options or NULL to use imc_png_default_opts()
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_png_write_sink(
+    const Pixmap_t* const pixmap,
+    const PngSink_t* const sink,
+    const PngEncOpts_t* const opts
+) {
+    size_t y, band_rows;
+    ImcError_t status;
+    Ihdr_t ihdr;
+    PngEncState_t state;
+    PngEncOpts_t def_opts = imc_png_default_opts();
+    const PngEncOpts_t *_opts = (opts != NULL) ? opts : &def_opts;
+
+    if (pixmap == NULL || pixmap->data == NULL || sink == NULL || sink->write == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    status = _imc_png_make_ihdr(pixmap->width, pixmap->height, pixmap->n_channels, pixmap->bit_depth, &ihdr);
+    if (status != IMC_EOK) {
+        return status;
+    }
+
+    if (_opts->n_threads > 1) {
+        /* Several bands per thread balances the load, but small bands lose too much history */
+        band_rows = (pixmap->height + 4 * _opts->n_threads - 1) / (4 * _opts->n_threads);
+        y = (_PNG_MIN_BAND_SIZE + pixmap->width * imc_sizeof_px(*pixmap)) / (pixmap->width * imc_sizeof_px(*pixmap) + 1);
+        band_rows = (band_rows > y) ? band_rows : y;
+        if (band_rows < pixmap->height) {
+            return _imc_png_write_parallel(pixmap, &ihdr, sink, _opts, band_rows);
+        }
+    }
+
+    status = _imc_png_enc_init(&state, &ihdr, sink, _opts);
+    if (status != IMC_EOK) {
+        return status;
+    }
+
+    for (y = 0; y < pixmap->height; ++y) {
+        status = _imc_png_enc_scanline(&state, pixmap->data + y * state.row_len);
+        if (status != IMC_EOK) {
+            _imc_png_enc_destroy(&state);
+            return status;
+        }
+    }
+
+    return _imc_png_enc_finish(&state);
+}
+
+/**
+ * @brief Encodes __pixmap__ as a PNG file.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap to be encoded
+ * @param[in] fname The name of the output file
+ * @param[in] opts Encoding options or NULL to use imc_png_default_opts()
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_png_write(
+    const Pixmap_t* const pixmap,
+    const char* const fname,
+    const PngEncOpts_t* const opts
+) {
+    ImcError_t status;
+    PngSink_t sink;
+    FILE *fp = NULL;
+
+    fp = fopen(fname, "wb");
+    if (fp == NULL) {
+        IMC_LOG("Failed to open file for write", IMC_ERROR);
+        return IMC_EFAIL;
+    }
+
+    sink.write = _imc_file_sink_write;
+    sink.ctx = fp;
+
+    status = imc_png_write_sink(pixmap, &sink, opts);
+    if (fclose(fp) != 0 && status == IMC_EOK) {
+        IMC_LOG("Failed to close file", IMC_ERROR);
+        status = IMC_EFAIL;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Encodes __pixmap__ as a PNG held in memory.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap to be encoded
+ * @param[out] data The output location for the encoded PNG, which the caller must free()
+ * @param[out] size The output location for the size of the encoded PNG (in bytes)
+ * @param[in] opts Encoding options or NULL to use imc_png_default_opts()
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_png_write_mem(
+    const Pixmap_t* const pixmap,
+    uint8_t **data,
+    size_t *size,
+    const PngEncOpts_t* const opts
+) {
+    ImcError_t status;
+    PngSink_t sink;
+    PngMemBuf_t buf = { 0 };
+
+    if (data == NULL || size == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    sink.write = _imc_mem_sink_write;
+    sink.ctx = &buf;
+
+    status = imc_png_write_sink(pixmap, &sink, opts);
+    if (status != IMC_EOK) {
+        free(buf.data);
+        *data = NULL;
+        *size = 0;
+        return status;
+    }
+
+    *data = buf.data;
+    *size = buf.size;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Begins encoding a PNG whose scanlines will be supplied incrementally with imc_png_enc_write_rows().
+ * The PNG signature and IHDR are written to __sink__ immediately. Only the previous scanline (needed for
+ * filtering), the filtered candidates and the compressor state are retained, so memory use is independent
+ * of the image height. PngEncOpts_t.n_threads is ignored, as scanlines arrive in order on a single thread.
+ * @since 16-10-2026
+ * @param[in] width The width of the image (in pixels)
+ * @param[in] height The height of the image (in pixels)
+ * @param[in] n_channels The number of channels per pixel (1 = grey, 2 = grey + alpha, 3 = RGB, 4 = RGBA)
+ * @param[in] bit_depth The number of bits per sample (8 or 16)
+ * @param[in] sink The sink which receives the encoded bytes (must remain valid until imc_png_enc_end())
+ * @param[in] opts Encoding options or NULL to use imc_png_default_opts()
+ * @returns A handle to the encoder, or NULL on failure
+ */
+PngEncHndl_t *imc_png_enc_begin(
+    const size_t width,
+    const size_t height,
+    const uint8_t n_channels,
+    const uint8_t bit_depth,
+    const PngSink_t* const sink,
+    const PngEncOpts_t* const opts
+) {
+    ImcError_t status;
+    Ihdr_t ihdr;
+    PngEncHndl_t *enc = NULL;
+    PngEncOpts_t def_opts = imc_png_default_opts();
+    const PngEncOpts_t *_opts = (opts != NULL) ? opts : &def_opts;
+
+    if (sink == NULL || sink->write == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return NULL;
+    }
+
+    status = _imc_png_make_ihdr(width, height, n_channels, bit_depth, &ihdr);
+    if (status != IMC_EOK) {
+        return NULL;
+    }
+
+    enc = malloc(sizeof(*enc));
+    if (enc == NULL) {
+        IMC_LOG("Failed to allocate memory for PngEncHndl_t", IMC_ERROR);
+        return NULL;
+    }
+
+    status = _imc_png_enc_init(&enc->state, &ihdr, sink, _opts);
+    if (status != IMC_EOK) {
+        free(enc);
+        return NULL;
+    }
+
+    enc->rows_left = height;
+    enc->status = IMC_EOK;
+
+    return enc;
+}
+
+/**
+ * @brief Filters and compresses the next __n_rows__ scanlines of the image being encoded by __enc__.
+ * Complete IDAT chunks are passed to the sink as soon as they fill up. Once an error has occurred,
+ * every later call fails with the same status, and the handle must still be passed to imc_png_enc_end().
+ * @since 16-10-2026
+ * @param[in,out] enc The encoder handle returned by imc_png_enc_begin()
+ * @param[in] rows Packed, unfiltered scanlines in the pixel format given to imc_png_enc_begin()
+ * @param[in] n_rows The number of scanlines in __rows__
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_png_enc_write_rows(PngEncHndl_t *enc, const uint8_t *rows, const size_t n_rows) {
+    size_t y;
+
+    if (enc == NULL || (rows == NULL && n_rows > 0)) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    if (enc->status != IMC_EOK) {
+        return enc->status;
+    }
+
+    if (n_rows > enc->rows_left) {
+        IMC_LOG("More scanlines written than the image height", IMC_ERROR);
+        enc->status = IMC_EOVERFLOW;
+        return enc->status;
+    }
+
+    for (y = 0; y < n_rows; ++y) {
+        enc->status = _imc_png_enc_scanline(&enc->state, rows + y * enc->state.row_len);
+        if (enc->status != IMC_EOK) {
+            return enc->status;
+        }
+    }
+    enc->rows_left -= n_rows;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Finishes the image being encoded by __enc__, writing the final IDAT and IEND chunks, and frees __enc__.
+ * If an earlier call failed or fewer scanlines than the image height were written, the PNG is left
+ * incomplete and an error is returned, but __enc__ is still freed.
+ * @since 16-10-2026
+ * @param[in] enc The encoder handle returned by imc_png_enc_begin()
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_png_enc_end(PngEncHndl_t *enc) {
+    ImcError_t status;
+
+    if (enc == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    if (enc->status == IMC_EOK && enc->rows_left > 0) {
+        IMC_LOG("Fewer scanlines written than the image height", IMC_ERROR);
+        enc->status = IMC_ENODATA;
+    }
+
+    if (enc->status == IMC_EOK) {
+        status = _imc_png_enc_finish(&enc->state);
+    } else {
+        status = enc->status;
+        _imc_png_enc_destroy(&enc->state);
+    }
+
+    free(enc);
+    return status;
+}
+
+/**
+ * @brief Encodes __frames__ as an animated PNG and passes the encoded bytes to __sink__.
+ * The first frame is also stored as the default image, so decoders without APNG support show it as a still.
+ * Every later frame is reduced to the rectangle in which it differs from the canvas it is rendered onto,
+ * and the disposal of the previous frame and the blend operation of the current one are chosen to make
+ * that rectangle compress as small as possible. When PngEncOpts_t.n_threads is greater than 1, the
+ * candidates of each frame are tried, and the frames compressed, in parallel. Indexed-color animations
+ * are not supported.
+ * @since 16-10-2026
+ * @param[in] frames The frames (all must share the same dimensions and pixel format)
+ * @param[in] n_frames The number of frames
+ * @param[in] n_plays The number of times the animation is played (0 to loop forever)
+ * @param[in] sink The sink which receives the encoded bytes
+ * @param[in] opts Encoding options or NULL to use imc_png_default_opts()
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_apng_write_sink(
+    const ApngFrame_t* const frames,
+    const size_t n_frames,
+    const uint32_t n_plays,
+    const PngSink_t* const sink,
+    const PngEncOpts_t* const opts
+) {
+    size_t i, n_spawned;
+    uint32_t seq = 0;
+    uint8_t actl[8];
+    uint8_t *buf = NULL;
+    ImcError_t status;
+    Ihdr_t ihdr;
+    PngEncState_t state;
+    ApngJob_t job = { 0 };
+    pthread_t *threads = NULL;
+    const Pixmap_t *first;
+    PngEncOpts_t def_opts = imc_png_default_opts();
+    const PngEncOpts_t *_opts = (opts != NULL) ? opts : &def_opts;
+
+    if (frames == NULL || n_frames == 0 || n_frames > UINT32_MAX || sink == NULL || sink->write == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    first = frames[0].pixmap;
+    for (i = 0; i < n_frames; ++i) {
+        if (frames[i].pixmap == NULL || frames[i].pixmap->data == NULL ||
+            frames[i].pixmap->width != first->width || frames[i].pixmap->height != first->height ||
+            frames[i].pixmap->n_channels != first->n_channels || frames[i].pixmap->bit_depth != first->bit_depth)
+        {
+            IMC_LOG("All frames must share the same dimensions and pixel format", IMC_ERROR);
+            return IMC_EINVAL;
+        }
+    }
+
+    if (_opts->palette != NULL) {
+        IMC_LOG("Indexed-color animations are not supported", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    status = _imc_png_make_ihdr(first->width, first->height, first->n_channels, first->bit_depth, &ihdr);
+    if (status != IMC_EOK) {
+        return status;
+    }
+
+    status = _imc_png_enc_alloc(&state, &ihdr, sink, _opts, 0);
+    if (status != IMC_EOK) {
+        return status;
+    }
+
+    job.plans = calloc(n_frames, sizeof(*job.plans));
+    threads = calloc((_opts->n_threads > 0) ? _opts->n_threads : 1, sizeof(*threads));
+    buf = malloc(_opts->idat_size + 4);
+    if (job.plans == NULL || threads == NULL || buf == NULL) {
+        IMC_LOG("Failed to allocate memory for animation", IMC_ERROR);
+        status = IMC_ENOMEM;
+        goto cleanup;
+    }
+
+    status = _imc_apng_plan(frames, n_frames, _opts, job.plans);
+    if (status != IMC_EOK) {
+        goto cleanup;
+    }
+
+    job.n_frames = n_frames;
+    job.opts = _opts;
+    job.status = IMC_EOK;
+    pthread_mutex_init(&job.lock, NULL);
+
+    /* The calling thread works too, so spawn one fewer than requested */
+    for (n_spawned = 0; n_spawned + 1 < _opts->n_threads && n_spawned + 1 < n_frames; ++n_spawned) {
+        if (pthread_create(&threads[n_spawned], NULL, _imc_apng_worker, &job) != 0) {
+            IMC_LOG("Failed to spawn encoder thread", IMC_WARNING);
+            break;
+        }
+    }
+    _imc_apng_worker(&job);
+    for (i = 0; i < n_spawned; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_mutex_destroy(&job.lock);
+
+    status = job.status;
+    if (status != IMC_EOK) {
+        goto cleanup;
+    }
+
+    _imc_put_u32(actl + 0, (uint32_t)n_frames);
+    _imc_put_u32(actl + 4, n_plays);
+
+    status = _imc_png_write_header(&state);
+    if (status == IMC_EOK) {
+        status = _imc_png_write_chunk(sink, ACTL, actl, sizeof(actl));
+    }
+    for (i = 0; i < n_frames && status == IMC_EOK; ++i) {
+        status = _imc_apng_write_fctl(sink, seq++, &job.plans[i], &frames[i]);
+        if (status == IMC_EOK) {
+            status = _imc_apng_write_data(sink, &job.plans[i].zdata, _opts->idat_size, i == 0, &seq, buf);
+        }
+    }
+    if (status == IMC_EOK) {
+        status = _imc_png_write_chunk(sink, IEND, NULL, 0);
+    }
+
+cleanup:
+    if (job.plans != NULL) {
+        _imc_apng_plans_destroy(job.plans, n_frames);
+    }
+    free(job.plans);
+    free(threads);
+    free(buf);
+    _imc_png_enc_destroy(&state);
+
+    return status;
+}
+
+/**
+ * @brief Encodes __frames__ as an animated PNG file.
+ * @since 16-10-2026
+ * @param[in] frames The frames (all must share the same dimensions and pixel format)
+ * @param[in] n_frames The number of frames
+ * @param[in] n_plays The number of times the animation is played (0 to loop forever)
+ * @param[in] fname The name of the output file
+ * @param[in] opts Encoding options or NULL to use imc_png_default_opts()
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_apng_write(
+    const ApngFrame_t* const frames,
+    const size_t n_frames,
+    const uint32_t n_plays,
+    const char* const fname,
+    const PngEncOpts_t* const opts
+) {
+    ImcError_t status;
+    PngSink_t sink;
+    FILE *fp = NULL;
+
+    fp = fopen(fname, "wb");
+    if (fp == NULL) {
+        IMC_LOG("Failed to open file for write", IMC_ERROR);
+        return IMC_EFAIL;
+    }
+
+    sink.write = _imc_file_sink_write;
+    sink.ctx = fp;
+
+    status = imc_apng_write_sink(frames, n_frames, n_plays, &sink, opts);
+    if (fclose(fp) != 0 && status == IMC_EOK) {
+        IMC_LOG("Failed to close file", IMC_ERROR);
+        status = IMC_EFAIL;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Encodes __frames__ as an animated PNG held in memory.
+ * @since 16-10-2026
+ * @param[in] frames The frames (all must share the same dimensions and pixel format)
+ * @param[in] n_frames The number of frames
+ * @param[in] n_plays The number of times the animation is played (0 to loop forever)
+ * @param[out] data The output location for the encoded APNG, which the caller must free()
+ * @param[out] size The output location for the size of the encoded APNG (in bytes)
+ * @param[in] opts Encoding options or NULL to use imc_png_default_opts()
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_apng_write_mem(
+    const ApngFrame_t* const frames,
+    const size_t n_frames,
+    const uint32_t n_plays,
+    uint8_t **data,
+    size_t *size,
+    const PngEncOpts_t* const opts
+) {
+    ImcError_t status;
+    PngSink_t sink;
+    PngMemBuf_t buf = { 0 };
+
+    if (data == NULL || size == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    sink.write = _imc_mem_sink_write;
+    sink.ctx = &buf;
+
+    status = imc_apng_write_sink(frames, n_frames, n_plays, &sink, opts);
+    if (status != IMC_EOK) {
+        free(buf.data);
+        *data = NULL;
+        *size = 0;
+        return status;
+    }
+
+    *data = buf.data;
+    *size = buf.size;
+
+    return IMC_EOK;
+}
@@ -0,0 +1,684 @@
+/**
+ * @file png_optimizer.c
+ * @author Neil Kingdom
+ * @since 16-10-2026
+ * @version 1.0
+ * @brief Contains the functions necessary for losslessly recompressing a PNG.
+ *
+ * The image is decoded once, reduced to cheaper color types where that loses
+ * nothing, and then encoded with every combination of filter, zlib level and
+ * zlib strategy on a pool of threads. The smallest encoding wins. Only the
+ * formats the parser can decode (8-bit, non-interlaced truecolor with or
+ * without alpha) are accepted; anything else, including animated PNGs whose
+ * frames would be lost, is rejected up front rather than handed to the parser.
+ */
+
+#include "png_optimizer.h"
+
+/* Filter choices tried for each variant: NONE, SUB, UP, AVG, PAETH and ADAPTIVE */
+#define _OPT_N_FILTERS (ADAPTIVE + 1)
+
+typedef struct {
+    int level;          /* zlib compression level */
+    int strategy;       /* zlib compression strategy */
+} PngOptZlib_t;
+
+/* zlib settings tried for each filter choice */
+static const PngOptZlib_t _imc_opt_zlib[] = {
+    { 9, Z_DEFAULT_STRATEGY },
+    { 9, Z_FILTERED },
+    { 9, Z_RLE },
+    { 6, Z_DEFAULT_STRATEGY }
+};
+
+#define _OPT_N_ZLIB (sizeof(_imc_opt_zlib) / sizeof(_imc_opt_zlib[0]))
+
+typedef struct {
+    Pixmap_t       pixmap;          /* Pixels (or palette indices) to be encoded */
+    Palette_t      palette;         /* Palette of an indexed-color variant */
+    bool           indexed;         /* True if pixmap holds indices into palette */
+    bool           owns_data;       /* True if pixmap.data must be freed */
+    const Chunk_t *ancillary;       /* Ancillary chunks valid for this variant's color type */
+    size_t         n_ancillary;     /* Number of chunks in ancillary */
+} PngOptVariant_t;
+
+typedef struct {
+    const PngOptVariant_t *variants;    /* Image variants being tried */
+    size_t          n_trials;           /* Total number of trials */
+    size_t          next_trial;         /* Next trial to be claimed by a worker */
+    uint8_t        *best;               /* Smallest encoding so far */
+    size_t          best_size;          /* Size of best (in bytes) */
+    size_t          best_trial;         /* Trial which produced best */
+    ImcError_t      status;             /* First error reported by a worker */
+    pthread_mutex_t lock;               /* Guards every member above */
+} PngOptJob_t;
+
+typedef struct {
+    uint32_t key;       /* Packed RGBA color */
+    uint32_t count;     /* Number of pixels of this color */
+    uint8_t  idx;       /* Index of the color in the exact palette */
+} PngOptColor_t;
+
+/*
+ * ===============================
+ *       Private Functions
+ * ===============================
+ */
+
+/**
+ * @brief Reads a big-endian 32-bit integer.
+ * @since 16-10-2026
+ * @param[in] buf The four bytes to be read
+ * @returns The integer
+ */
+static uint32_t _imc_get_u32(const uint8_t *buf) {
+    return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) | ((uint32_t)buf[2] << 8) | buf[3];
+}
+
+/**
+ * @brief Returns true if __type__ is an ancillary chunk which still describes the image once its pixels are re-encoded.
+ * Known chunks are kept, as are unknown chunks marked safe-to-copy (bit 5 of the last type byte).
+ * @since 16-10-2026
+ * @param[in] type The four character chunk type code
+ * @returns True if the chunk should be copied into the output
+ */
+static bool _imc_opt_keep_chunk(const uint8_t *type) {
+    size_t i;
+    static const char* const known[] = {
+        CHRM, GAMA, ICCP, SBIT, SRGB, BKGD, HIST, TRNS, PHYS, SPLT, TIME, TEXT, ZTXT, ITXT
+    };
+
+    if (type[3] & 0x20) {
+        return true;
+    }
+
+    for (i = 0; i < sizeof(known) / sizeof(known[0]); ++i) {
+        if (memcmp((void*)type, (void*)known[i], 4) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Returns true if the contents of chunk __type__ depend on the color type of the image.
+ * @since 16-10-2026
+ * @param[in] type The four character chunk type code
+ * @returns True for bKGD, hIST, sBIT and tRNS, otherwise false
+ */
+static bool _imc_opt_chunk_needs_color_type(const char *type) {
+    return memcmp(type, BKGD, 4) == 0 || memcmp(type, HIST, 4) == 0 ||
+           memcmp(type, SBIT, 4) == 0 || memcmp(type, TRNS, 4) == 0;
+}
+
+/**
+ * @brief Walks the chunks of the PNG held in __png__, verifying their structure and CRCs, and collects its ancillary chunks.
+ * This guards the parser, which exits or asserts on formats it does not support.
+ * @since 16-10-2026
+ * @param[in] png A handle to the PNG in memory
+ * @param[out] chunks The output location for an array of the ancillary chunks to be kept (data points into png->data)
+ * @param[out] n_chunks The output location for the number of chunks in __chunks__
+ * @param[out] has_trns The output location for whether the image has a tRNS chunk
+ * @returns IMC_EINVAL if the PNG is malformed, animated or unsupported, otherwise an ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_opt_scan(
+    const PngHndl_t* const png,
+    Chunk_t **chunks,
+    size_t *n_chunks,
+    bool *has_trns
+) {
+    size_t off, n = 0;
+    uint32_t len;
+    bool seen_idat = false, seen_iend = false;
+    const uint8_t *p, *data = png->data;
+    Chunk_t *tmp = NULL, *out = NULL;
+
+    *chunks = NULL;
+    *n_chunks = 0;
+    *has_trns = false;
+
+    /* Signature followed by a 13 byte IHDR */
+    if (png->size < 8 + 25 || memcmp((void*)data, (void*)PNG_MAGIC, 8) != 0 ||
+        _imc_get_u32(data + 8) != 13 || memcmp((void*)(data + 12), (void*)IHDR, 4) != 0) {
+        IMC_LOG("Not a PNG file", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    p = data + 16;
+    if (_imc_get_u32(p) == 0 || _imc_get_u32(p + 4) == 0 || p[8] != 8 ||
+        (p[9] != COLOR && p[9] != (COLOR | ALPHA)) || p[10] != 0 || p[11] != 0 || p[12] != 0) {
+        IMC_LOG("Only non-interlaced 8-bit truecolor PNGs (with or without alpha) can be optimized", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    for (off = 8; off + 12 <= png->size && !seen_iend; off += 12 + len) {
+        p = data + off;
+        len = _imc_get_u32(p);
+        if (len > png->size - off - 12) {
+            IMC_LOG("Truncated chunk", IMC_ERROR);
+            free(out);
+            return IMC_EINVAL;
+        }
+
+        if (crc32(crc32(0L, Z_NULL, 0), p + 4, len + 4) != _imc_get_u32(p + 8 + len)) {
+            IMC_LOG("Chunk CRC mismatch", IMC_ERROR);
+            free(out);
+            return IMC_EINVAL;
+        }
+
+        if (memcmp((void*)(p + 4), (void*)IDAT, 4) == 0) {
+            seen_idat = true;
+        } else if (memcmp((void*)(p + 4), (void*)IEND, 4) == 0) {
+            seen_iend = true;
+        } else if (memcmp((void*)(p + 4), (void*)ACTL, 4) == 0) {
+            /* Only the default image would survive re-encoding */
+            IMC_LOG("Animated PNGs cannot be optimized", IMC_ERROR);
+            free(out);
+            return IMC_EINVAL;
+        } else if ((p[4] & 0x20) && _imc_opt_keep_chunk(p + 4)) {
+            tmp = realloc(out, (n + 1) * sizeof(*out));
+            if (tmp == NULL) {
+                IMC_LOG("Failed to allocate memory for ancillary chunks", IMC_ERROR);
+                free(out);
+                return IMC_ENOMEM;
+            }
+            out = tmp;
+
+            out[n].length = len;
+            out[n].crc = _imc_get_u32(p + 8 + len);
+            out[n].data = png->data + off + 8;
+            memcpy((void*)out[n].type, (void*)(p + 4), 4);
+            *has_trns |= (memcmp((void*)(p + 4), (void*)TRNS, 4) == 0);
+            ++n;
+        } else if (!(p[4] & 0x20) && memcmp((void*)(p + 4), (void*)IHDR, 4) != 0) {
+            /* PLTE in a truecolor image is only a suggestion, anything else critical is unknown */
+            if (memcmp((void*)(p + 4), (void*)PLTE, 4) != 0) {
+                IMC_LOG("Unknown critical chunk", IMC_ERROR);
+                free(out);
+                return IMC_EINVAL;
+            }
+        }
+    }
+
+    if (!seen_idat || !seen_iend) {
+        IMC_LOG("PNG has no image data or is truncated", IMC_ERROR);
+        free(out);
+        return IMC_EINVAL;
+    }
+
+    *chunks = out;
+    *n_chunks = n;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Returns true if every pixel of the 4 channel __pixmap__ is fully opaque.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap to be checked
+ * @returns True if the alpha channel can be dropped
+ */
+static bool _imc_opt_is_opaque(const Pixmap_t* const pixmap) {
+    size_t i, n = pixmap->width * pixmap->height;
+
+    for (i = 0; i < n; ++i) {
+        if (pixmap->data[4 * i + 3] != 0xFF) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Fills __variant__ with a copy of the 4 channel __pixmap__ without its alpha channel.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap to be reduced
+ * @param[out] variant The output location for the reduced image
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_opt_strip_alpha(const Pixmap_t* const pixmap, PngOptVariant_t *variant) {
+    size_t i, n = pixmap->width * pixmap->height;
+
+    variant->pixmap = *pixmap;
+    variant->pixmap.n_channels = 3;
+    variant->pixmap.data = malloc(3 * n);
+    if (variant->pixmap.data == NULL) {
+        IMC_LOG("Failed to allocate memory for pixmap->data", IMC_ERROR);
+        return IMC_ENOMEM;
+    }
+    variant->owns_data = true;
+
+    for (i = 0; i < n; ++i) {
+        memcpy((void*)(variant->pixmap.data + 3 * i), (void*)(pixmap->data + 4 * i), 3);
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief qsort() comparator which orders translucent colors first, then by descending pixel count.
+ * Translucent colors first keeps tRNS as short as possible.
+ * @since 16-10-2026
+ * @param[in] a A pointer to the first PngOptColor_t
+ * @param[in] b A pointer to the second PngOptColor_t
+ * @returns A negative, zero or positive value if __a__ sorts before, with or after __b__
+ */
+static int _imc_opt_cmp_color(const void *a, const void *b) {
+    const PngOptColor_t *ca = (const PngOptColor_t*)a;
+    const PngOptColor_t *cb = (const PngOptColor_t*)b;
+    bool opaque_a = (ca->key & 0xFF) == 0xFF;
+    bool opaque_b = (cb->key & 0xFF) == 0xFF;
+
+    if (opaque_a != opaque_b) {
+        return opaque_a ? 1 : -1;
+    }
+    if (ca->count != cb->count) {
+        return (ca->count < cb->count) ? 1 : -1;
+    }
+
+    return (ca->key < cb->key) ? -1 : (ca->key > cb->key);
+}
+
+/**
+ * @brief Fills __variant__ with an indexed-color copy of __pixmap__ if it has 256 colors or fewer.
+ * The exact palette from imc_quant_exact() is reordered with _imc_opt_cmp_color() and the indices
+ * remapped to match.
+ * @since 16-10-2026
+ * @param[in] pixmap The 3 or 4 channel pixmap to be reduced
+ * @param[out] variant The output location for the reduced image
+ * @returns IMC_EOVERFLOW if there are more than 256 colors, otherwise an ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_opt_to_palette(const Pixmap_t* const pixmap, PngOptVariant_t *variant) {
+    size_t i, n = pixmap->width * pixmap->height;
+    uint8_t remap[256];
+    uint8_t *indices = NULL;
+    ImcError_t status;
+    Palette_t exact;
+    PngOptColor_t colors[256] = { 0 };
+
+    indices = malloc(n);
+    if (indices == NULL) {
+        IMC_LOG("Failed to allocate memory for pixmap->data", IMC_ERROR);
+        return IMC_ENOMEM;
+    }
+
+    status = imc_quant_exact(pixmap, 256, &exact, indices);
+    if (status != IMC_EOK) {
+        free(indices);
+        return status;
+    }
+
+    for (i = 0; i < exact.n_entries; ++i) {
+        colors[i].key = ((uint32_t)exact.entries[i].r << 24) | ((uint32_t)exact.entries[i].g << 16) |
+                        ((uint32_t)exact.entries[i].b << 8) | exact.entries[i].a;
+        colors[i].idx = i;
+    }
+    for (i = 0; i < n; ++i) {
+        colors[indices[i]].count++;
+    }
+
+    qsort((void*)colors, exact.n_entries, sizeof(*colors), _imc_opt_cmp_color);
+    for (i = 0; i < exact.n_entries; ++i) {
+        remap[colors[i].idx] = i;
+        variant->palette.entries[i] = exact.entries[colors[i].idx];
+    }
+    variant->palette.n_entries = exact.n_entries;
+
+    for (i = 0; i < n; ++i) {
+        indices[i] = remap[indices[i]];
+    }
+
+    variant->pixmap = *pixmap;
+    variant->pixmap.n_channels = 1;
+    variant->pixmap.data = indices;
+    variant->owns_data = true;
+    variant->indexed = true;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Encodes trial __trial__ of __job__ into memory.
+ * @since 16-10-2026
+ * @param[in] job The shared optimization job
+ * @param[in] trial The index of the trial
+ * @param[out] data The output location for the encoded PNG
+ * @param[out] size The output location for the size of the encoded PNG (in bytes)
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_opt_run_trial(const PngOptJob_t* const job, const size_t trial, uint8_t **data, size_t *size) {
+    PngEncOpts_t opts = imc_png_default_opts();
+    const size_t per_variant = _OPT_N_FILTERS * _OPT_N_ZLIB;
+    const PngOptVariant_t *variant = &job->variants[trial / per_variant];
+    const PngOptZlib_t *zlib = &_imc_opt_zlib[trial % _OPT_N_ZLIB];
+
+    opts.filter = (trial % per_variant) / _OPT_N_ZLIB;
+    opts.level = zlib->level;
+    opts.strategy = zlib->strategy;
+    opts.palette = variant->indexed ? &variant->palette : NULL;
+    opts.ancillary = variant->ancillary;
+    opts.n_ancillary = variant->n_ancillary;
+
+    return imc_png_write_mem(&variant->pixmap, data, size, &opts);
+}
+
+/**
+ * @brief Thread entry point which runs trials until none remain or one fails, keeping the smallest result.
+ * Ties go to the lowest numbered trial so that the output does not depend on scheduling.
+ * @since 16-10-2026
+ * @param[in,out] arg The shared PngOptJob_t
+ * @returns NULL
+ */
+static void *_imc_opt_worker(void *arg) {
+    size_t trial, size;
+    uint8_t *data = NULL;
+    ImcError_t status;
+    PngOptJob_t *job = (PngOptJob_t*)arg;
+
+    while (true) {
+        pthread_mutex_lock(&job->lock);
+        if (job->status != IMC_EOK || job->next_trial >= job->n_trials) {
+            pthread_mutex_unlock(&job->lock);
+            break;
+        }
+        trial = job->next_trial++;
+        pthread_mutex_unlock(&job->lock);
+
+        status = _imc_opt_run_trial(job, trial, &data, &size);
+
+        pthread_mutex_lock(&job->lock);
+        if (status != IMC_EOK) {
+            if (job->status == IMC_EOK) {
+                job->status = status;
+            }
+        } else if (job->best == NULL || size < job->best_size ||
+                   (size == job->best_size && trial < job->best_trial)) {
+            free(job->best);
+            job->best = data;
+            job->best_size = size;
+            job->best_trial = trial;
+            data = NULL;
+        }
+        pthread_mutex_unlock(&job->lock);
+
+        free(data);
+        data = NULL;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Runs every trial of __job__ on up to __n_threads__ threads (including the calling thread).
+ * @since 16-10-2026
+ * @param[in,out] job The optimization job
+ * @param[in] n_threads The number of threads to use
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_opt_run(PngOptJob_t *job, const size_t n_threads) {
+    size_t t, n_spawned;
+    pthread_t *threads = NULL;
+
+    threads = calloc(n_threads, sizeof(*threads));
+    if (threads == NULL) {
+        IMC_LOG("Failed to allocate memory for threads", IMC_ERROR);
+        return IMC_ENOMEM;
+    }
+
+    pthread_mutex_init(&job->lock, NULL);
+    for (n_spawned = 0; n_spawned + 1 < n_threads && n_spawned + 1 < job->n_trials; ++n_spawned) {
+        if (pthread_create(&threads[n_spawned], NULL, _imc_opt_worker, job) != 0) {
+            IMC_LOG("Failed to spawn optimizer thread", IMC_WARNING);
+            break;
+        }
+    }
+    _imc_opt_worker(job);
+    for (t = 0; t < n_spawned; ++t) {
+        pthread_join(threads[t], NULL);
+    }
+    pthread_mutex_destroy(&job->lock);
+
+    free(threads);
+    return job->status;
+}
+
+/*
+ * ===============================
+ *       Public Functions
+ * ===============================
+ */
+
+/**
+ * @brief Returns the default optimizer options.
+ * @since 16-10-2026
+ * @returns A PngOptOpts_t which uses one thread per online CPU and keeps ancillary chunks
+ */
+PngOptOpts_t imc_png_opt_default_opts(void) {
+    PngOptOpts_t opts;
+
+    opts.n_threads = 0;
+    opts.strip_ancillary = false;
+
+    return opts;
+}
+
+/**
+ * @brief Losslessly recompresses the PNG held in __in__ into memory.
+ * Trials cover the image as decoded, without its alpha channel when every pixel is opaque, and as
+ * indexed-color when it has 256 colors or fewer, each with every filter choice and several zlib levels
+ * and strategies. Ancillary chunks are copied unless PngOptOpts_t.strip_ancillary is set, which drops
+ * all but tRNS; those whose contents depend on the color type (bKGD, hIST, sBIT, tRNS) are dropped from
+ * reduced variants, and images with tRNS are not reduced at all. Unknown chunks which are not
+ * safe-to-copy are always dropped, and animated PNGs are rejected. If no trial beats the original
+ * (and ancillary chunks are being kept), a copy of the original is returned.
+ * @since 16-10-2026
+ * @param[in] in The PNG to be optimized
+ * @param[in] in_size The size of __in__ (in bytes)
+ * @param[out] data The output location for the optimized PNG, which the caller must free()
+ * @param[out] size The output location for the size of the optimized PNG (in bytes)
+ * @param[in] opts Optimizer options or NULL to use imc_png_opt_default_opts()
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_png_optimize_mem(
+    const uint8_t* const in,
+    const size_t in_size,
+    uint8_t **data,
+    size_t *size,
+    const PngOptOpts_t* const opts
+) {
+    long n_cpus;
+    size_t v, c, n, n_chunks, n_reduced = 0, n_variants = 1, n_threads;
+    bool has_trns;
+    ImcError_t status;
+    PngHndl_t png = { 0 };
+    Pixmap_t *pixmap = NULL;
+    Chunk_t *chunks = NULL, *reduced = NULL;
+    PngOptVariant_t variants[3];
+    PngOptJob_t job = { 0 };
+    PngOptOpts_t def_opts = imc_png_opt_default_opts();
+    const PngOptOpts_t *_opts = (opts != NULL) ? opts : &def_opts;
+
+    if (in == NULL || data == NULL || size == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+    *data = NULL;
+    *size = 0;
+    memset((void*)variants, 0, sizeof(variants));
+
+    /* The parser is only ever handed a PNG which the scan has vetted */
+    png.data = (uint8_t*)in;
+    png.size = in_size;
+    status = _imc_opt_scan(&png, &chunks, &n_chunks, &has_trns);
+    if (status != IMC_EOK) {
+        goto cleanup;
+    }
+    if (_opts->strip_ancillary) {
+        /* tRNS is part of the image rather than metadata about it */
+        for (c = 0, n = 0; c < n_chunks; ++c) {
+            if (memcmp((void*)chunks[c].type, (void*)TRNS, 4) == 0) {
+                chunks[n++] = chunks[c];
+            }
+        }
+        n_chunks = n;
+    }
+
+    /* The parser reads through a stream, positioned past the signature */
+    png.fp = fmemopen((void*)in, in_size, "rb");
+    if (png.fp == NULL || fseek(png.fp, sizeof(PNG_MAGIC), SEEK_SET) != 0) {
+        IMC_LOG("Failed to open PNG data as a stream", IMC_ERROR);
+        status = IMC_EFAIL;
+        goto cleanup;
+    }
+
+    pixmap = imc_png_parse(&png);
+    if (pixmap == NULL || pixmap->data == NULL) {
+        IMC_LOG("Failed to decode PNG", IMC_ERROR);
+        status = IMC_EFAIL;
+        goto cleanup;
+    }
+
+    /* Reduced color types cannot carry chunks that describe the original color type */
+    reduced = malloc((n_chunks + 1) * sizeof(*reduced));
+    if (reduced == NULL) {
+        IMC_LOG("Failed to allocate memory for ancillary chunks", IMC_ERROR);
+        status = IMC_ENOMEM;
+        goto cleanup;
+    }
+    for (c = 0; c < n_chunks; ++c) {
+        if (!_imc_opt_chunk_needs_color_type(chunks[c].type)) {
+            reduced[n_reduced++] = chunks[c];
+        }
+    }
+
+    variants[0].pixmap = *pixmap;
+    variants[0].ancillary = chunks;
+    variants[0].n_ancillary = n_chunks;
+
+    if (!has_trns && pixmap->n_channels == 4 && _imc_opt_is_opaque(pixmap)) {
+        status = _imc_opt_strip_alpha(pixmap, &variants[n_variants]);
+        if (status != IMC_EOK) {
+            goto cleanup;
+        }
+        variants[n_variants].ancillary = reduced;
+        variants[n_variants].n_ancillary = n_reduced;
+        ++n_variants;
+    }
+
+    if (!has_trns) {
+        status = _imc_opt_to_palette(pixmap, &variants[n_variants]);
+        if (status == IMC_EOK) {
+            variants[n_variants].ancillary = reduced;
+            variants[n_variants].n_ancillary = n_reduced;
+            ++n_variants;
+        } else if (status != IMC_EOVERFLOW) {
+            goto cleanup;
+        }
+    }
+
+    n_threads = _opts->n_threads;
+    if (n_threads == 0) {
+        n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        n_threads = (n_cpus > 0) ? (size_t)n_cpus : 1;
+    }
+
+    job.variants = variants;
+    job.n_trials = n_variants * _OPT_N_FILTERS * _OPT_N_ZLIB;
+    job.status = IMC_EOK;
+    status = _imc_opt_run(&job, n_threads);
+    if (status != IMC_EOK) {
+        free(job.best);
+        goto cleanup;
+    }
+
+    if (!_opts->strip_ancillary && job.best_size >= in_size) {
+        /* Nothing beat the original, so hand it back unchanged */
+        free(job.best);
+        job.best = malloc(in_size);
+        if (job.best == NULL) {
+            IMC_LOG("Failed to allocate memory for output", IMC_ERROR);
+            status = IMC_ENOMEM;
+            goto cleanup;
+        }
+        memcpy((void*)job.best, (void*)in, in_size);
+        job.best_size = in_size;
+    }
+
+    *data = job.best;
+    *size = job.best_size;
+
+cleanup:
+    for (v = 0; v < sizeof(variants) / sizeof(variants[0]); ++v) {
+        if (variants[v].owns_data) {
+            free(variants[v].pixmap.data);
+        }
+    }
+    free(reduced);
+    free(chunks);
+    if (pixmap != NULL) {
+        imc_pixmap_destroy(pixmap);
+    }
+    if (png.fp != NULL) {
+        fclose(png.fp);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Losslessly recompresses the PNG at __in_path__ and writes the result to __out_path__.
+ * The input is fully read before the output is opened, so both paths may name the same file.
+ * @since 16-10-2026
+ * @param[in] in_path The path to the PNG to be optimized
+ * @param[in] out_path The path of the output file
+ * @param[in] opts Optimizer options or NULL to use imc_png_opt_default_opts()
+ * @returns An ImcError_t indicating the exit status code
+ */
+ImcError_t imc_png_optimize(
+    const char* const in_path,
+    const char* const out_path,
+    const PngOptOpts_t* const opts
+) {
+    size_t size;
+    uint8_t *data = NULL;
+    ImcError_t status;
+    PngHndl_t *png = NULL;
+    FILE *fp = NULL;
+
+    if (in_path == NULL || out_path == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    png = imc_png_open(in_path);
+    if (png == NULL) {
+        return IMC_EFAIL;
+    }
+
+    status = imc_png_optimize_mem(png->data, png->size, &data, &size, opts);
+    imc_png_close(png);
+    if (status != IMC_EOK) {
+        return status;
+    }
+
+    fp = fopen(out_path, "wb");
+    if (fp == NULL) {
+        IMC_LOG("Failed to open file for write", IMC_ERROR);
+        free(data);
+        return IMC_EFAIL;
+    }
+
+    if (fwrite((void*)data, 1, size, fp) != size) {
+        IMC_LOG("Failed to write file", IMC_ERROR);
+        status = IMC_EFAIL;
+    }
+    if (fclose(fp) != 0 && status == IMC_EOK) {
+        IMC_LOG("Failed to close file", IMC_ERROR);
+        status = IMC_EFAIL;
+    }
+
+    free(data);
+    return status;
+}
@@ -302,7 +302,8 @@ static ImcError_t _imc_destroy_chunk_data(Chunk_t *chunk) {
  * @param[out] ihdr The output location for the converted chunk data
  */
 static void _imc_chunk_to_ihdr(const Chunk_t* const chunk, Ihdr_t *ihdr) {
-    memcpy((void*)ihdr, (void*)chunk->data, sizeof(*ihdr));
+    /* The 13 bytes of IHDR data map onto every field before n_channels */
+    memcpy((void*)ihdr, (void*)chunk->data, 13);
     _IMC_FLIP_ENDIAN(&ihdr->width);
     _IMC_FLIP_ENDIAN(&ihdr->height);
     _IMC_FLIP_ENDIAN(&ihdr->bit_depth);
@@ -0,0 +1,766 @@
+/**
+ * @file quantize.c
+ * @author Neil Kingdom
+ * @since 16-10-2026
+ * @version 1.0
+ * @brief Contains the functions necessary for reducing a pixmap to a palette of 256 colors or fewer.
+ *
+ * Pixels are first counted on a reduced-precision grid (5 bits of red, green
+ * and blue and 3 bits of alpha), which bounds the work of every later stage by
+ * the number of occupied grid cells rather than the number of pixels. The
+ * cells are split by median cut, the resulting palette is optionally refined
+ * with k-means, and finally each pixel is mapped to its nearest palette entry
+ * (with optional Floyd-Steinberg dithering). The output is a 1 channel pixmap
+ * of indices which, together with its palette, can be passed straight to the
+ * PNG encoder through PngEncOpts_t.palette.
+ */
+
+#include "quantize.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* Bits kept of each channel when building the histogram */
+#define _QUANT_RGB_BITS 5
+#define _QUANT_A_BITS   3
+
+/* Number of cells in the histogram grid */
+#define _QUANT_N_CELLS (1 << (3 * _QUANT_RGB_BITS + _QUANT_A_BITS))
+
+/* Slots in the exact color hash table (a power of two comfortably above 256) */
+#define _QUANT_HASH_SIZE 1024
+
+/* Entries in the direct-mapped nearest color cache */
+#define _QUANT_CACHE_SIZE 4096
+
+/* Marks an empty cache entry */
+#define _QUANT_CACHE_EMPTY 0xFFFF
+
+typedef struct {
+    uint32_t count;     /* Number of pixels in the cell */
+    uint64_t sum[4];    /* Sums of the exact R, G, B and A values of those pixels */
+    uint8_t  mean[4];   /* Rounded mean of the exact values */
+} QuantCell_t;
+
+typedef struct {
+    size_t   start;     /* First cell of the box */
+    size_t   end;       /* One past the last cell of the box */
+    double   score;     /* Weighted variance along axis (how much splitting would help) */
+    uint8_t  axis;      /* Channel with the largest variance */
+} QuantBox_t;
+
+typedef struct {
+    uint32_t key;       /* Packed RGBA color */
+    uint16_t idx;       /* Nearest palette index or _QUANT_CACHE_EMPTY */
+} QuantCacheEntry_t;
+
+typedef struct {
+    int16_t *rg;        /* Red and green of each entry, interleaved, padded to a multiple of 4 entries */
+    int16_t *ba;        /* Blue and alpha of each entry, interleaved, padded likewise */
+    size_t   n_groups;  /* Number of groups of 4 entries */
+    QuantCacheEntry_t cache[_QUANT_CACHE_SIZE]; /* Recent lookups */
+} QuantMap_t;
+
+typedef struct {
+    uint32_t key;       /* Packed RGBA color */
+    uint16_t idx;       /* Palette index */
+    bool     used;      /* True if the slot holds a color */
+} QuantColor_t;
+
+/*
+ * ===============================
+ *       Private Functions
+ * ===============================
+ */
+
+/**
+ * @brief Reads pixel __i__ of an 8-bit pixmap with 1 to 4 channels as RGBA.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap
+ * @param[in] i The index of the pixel
+ * @param[out] rgba The output location for the four samples
+ */
+static inline void _imc_quant_fetch(const Pixmap_t* const pixmap, const size_t i, uint8_t *rgba) {
+    const uint8_t *px = pixmap->data + i * pixmap->n_channels;
+
+    switch (pixmap->n_channels) {
+        case 1:
+            rgba[0] = rgba[1] = rgba[2] = px[0];
+            rgba[3] = 0xFF;
+            break;
+        case 2:
+            rgba[0] = rgba[1] = rgba[2] = px[0];
+            rgba[3] = px[1];
+            break;
+        case 3:
+            memcpy((void*)rgba, (void*)px, 3);
+            rgba[3] = 0xFF;
+            break;
+        default:
+            memcpy((void*)rgba, (void*)px, 4);
+            break;
+    }
+}
+
+/**
+ * @brief Packs four samples into a single 32-bit key.
+ * @since 16-10-2026
+ * @param[in] rgba The four samples
+ * @returns The packed color
+ */
+static inline uint32_t _imc_quant_key(const uint8_t *rgba) {
+    return ((uint32_t)rgba[0] << 24) | ((uint32_t)rgba[1] << 16) | ((uint32_t)rgba[2] << 8) | rgba[3];
+}
+
+/**
+ * @brief Counts the pixels of __pixmap__ on the reduced-precision grid.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap to be quantized
+ * @param[out] cells The output location for an array of the occupied cells, which the caller must free()
+ * @param[out] n_cells The output location for the number of occupied cells
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_quant_histogram(const Pixmap_t* const pixmap, QuantCell_t **cells, size_t *n_cells) {
+    size_t i, c, n = pixmap->width * pixmap->height, max_cells;
+    uint32_t grid, *cell_of = NULL;
+    uint8_t rgba[4];
+    QuantCell_t *cell, *out = NULL;
+
+    max_cells = (n < _QUANT_N_CELLS) ? n : _QUANT_N_CELLS;
+    cell_of = calloc(_QUANT_N_CELLS, sizeof(*cell_of));
+    out = calloc(max_cells, sizeof(*out));
+    if (cell_of == NULL || out == NULL) {
+        IMC_LOG("Failed to allocate memory for histogram", IMC_ERROR);
+        free(cell_of);
+        free(out);
+        return IMC_ENOMEM;
+    }
+
+    /* cell_of holds the index of each grid cell's entry in out, plus one (0 if unoccupied) */
+    *n_cells = 0;
+    for (i = 0; i < n; ++i) {
+        _imc_quant_fetch(pixmap, i, rgba);
+        grid = ((uint32_t)(rgba[0] >> (8 - _QUANT_RGB_BITS)) << (2 * _QUANT_RGB_BITS + _QUANT_A_BITS)) |
+               ((uint32_t)(rgba[1] >> (8 - _QUANT_RGB_BITS)) << (_QUANT_RGB_BITS + _QUANT_A_BITS)) |
+               ((uint32_t)(rgba[2] >> (8 - _QUANT_RGB_BITS)) << _QUANT_A_BITS) |
+               (rgba[3] >> (8 - _QUANT_A_BITS));
+
+        if (cell_of[grid] == 0) {
+            cell_of[grid] = ++(*n_cells);
+        }
+        cell = &out[cell_of[grid] - 1];
+        cell->count++;
+        for (c = 0; c < 4; ++c) {
+            cell->sum[c] += rgba[c];
+        }
+    }
+
+    for (i = 0; i < *n_cells; ++i) {
+        for (c = 0; c < 4; ++c) {
+            out[i].mean[c] = (out[i].sum[c] + out[i].count / 2) / out[i].count;
+        }
+    }
+
+    free(cell_of);
+    *cells = out;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Computes the channel of largest pixel-weighted variance over the cells of __box__.
+ * @since 16-10-2026
+ * @param[in] cells The occupied cells
+ * @param[in,out] box The box whose axis and score are computed
+ */
+static void _imc_quant_box_stats(const QuantCell_t *cells, QuantBox_t *box) {
+    size_t i, c;
+    double w, mean, var, total = 0.0, sum[4] = { 0.0 }, sum_sq[4] = { 0.0 };
+
+    for (i = box->start; i < box->end; ++i) {
+        w = cells[i].count;
+        total += w;
+        for (c = 0; c < 4; ++c) {
+            sum[c] += w * cells[i].mean[c];
+            sum_sq[c] += w * cells[i].mean[c] * cells[i].mean[c];
+        }
+    }
+
+    box->axis = 0;
+    box->score = -1.0;
+    for (c = 0; c < 4; ++c) {
+        mean = sum[c] / total;
+        var = sum_sq[c] - mean * sum[c];
+        if (var > box->score) {
+            box->score = var;
+            box->axis = c;
+        }
+    }
+
+    /* A box of one cell cannot be split */
+    if (box->end - box->start < 2) {
+        box->score = 0.0;
+    }
+}
+
+/**
+ * @brief Splits __box__ at the pixel-weighted median of its axis, leaving the lower half in __box__.
+ * Cells are ordered along the axis with a counting sort (the key is an 8-bit mean), so no comparator state is needed.
+ * @since 16-10-2026
+ * @param[in,out] cells The occupied cells (the box's range is reordered)
+ * @param[in,out] box The box to be split
+ * @param[out] upper The output location for the upper half
+ * @param[in] tmp Scratch space of at least as many cells as the box holds
+ */
+static void _imc_quant_box_split(QuantCell_t *cells, QuantBox_t *box, QuantBox_t *upper, QuantCell_t *tmp) {
+    size_t i, v, split, n = box->end - box->start;
+    size_t offsets[257] = { 0 };
+    uint64_t total = 0, half, acc = 0;
+    const uint8_t axis = box->axis;
+
+    for (i = box->start; i < box->end; ++i) {
+        offsets[cells[i].mean[axis] + 1]++;
+        total += cells[i].count;
+    }
+    for (v = 1; v < 257; ++v) {
+        offsets[v] += offsets[v - 1];
+    }
+    for (i = box->start; i < box->end; ++i) {
+        tmp[offsets[cells[i].mean[axis]]++] = cells[i];
+    }
+    memcpy((void*)(cells + box->start), (void*)tmp, n * sizeof(*cells));
+
+    /* First cell past the median, but leave at least one cell on each side */
+    half = total / 2;
+    for (split = box->start; split < box->end - 1; ++split) {
+        acc += cells[split].count;
+        if (acc >= half) {
+            break;
+        }
+    }
+    ++split;
+    if (split >= box->end) {
+        split = box->end - 1;
+    }
+
+    upper->start = split;
+    upper->end = box->end;
+    box->end = split;
+
+    _imc_quant_box_stats(cells, box);
+    _imc_quant_box_stats(cells, upper);
+}
+
+/**
+ * @brief Builds a palette of up to __max_colors__ entries from the histogram by median cut.
+ * The box with the largest weighted variance is split until enough boxes exist or none can be split.
+ * @since 16-10-2026
+ * @param[in,out] cells The occupied cells (reordered)
+ * @param[in] n_cells The number of occupied cells
+ * @param[in] max_colors The largest palette permitted
+ * @param[out] palette The output location for the palette
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_quant_median_cut(
+    QuantCell_t *cells,
+    const size_t n_cells,
+    const uint16_t max_colors,
+    Palette_t *palette
+) {
+    size_t b, i, c, n_boxes = 1, best;
+    uint64_t count, sum[4];
+    QuantBox_t boxes[256];
+    QuantCell_t *tmp = NULL;
+
+    tmp = malloc(n_cells * sizeof(*tmp));
+    if (tmp == NULL) {
+        IMC_LOG("Failed to allocate memory for median cut", IMC_ERROR);
+        return IMC_ENOMEM;
+    }
+
+    boxes[0].start = 0;
+    boxes[0].end = n_cells;
+    _imc_quant_box_stats(cells, &boxes[0]);
+
+    while (n_boxes < max_colors) {
+        best = 0;
+        for (b = 1; b < n_boxes; ++b) {
+            if (boxes[b].score > boxes[best].score) {
+                best = b;
+            }
+        }
+        if (boxes[best].score <= 0.0) {
+            break;
+        }
+        _imc_quant_box_split(cells, &boxes[best], &boxes[n_boxes++], tmp);
+    }
+
+    for (b = 0; b < n_boxes; ++b) {
+        count = 0;
+        memset((void*)sum, 0, sizeof(sum));
+        for (i = boxes[b].start; i < boxes[b].end; ++i) {
+            count += cells[i].count;
+            for (c = 0; c < 4; ++c) {
+                sum[c] += cells[i].sum[c];
+            }
+        }
+        palette->entries[b].r = (sum[0] + count / 2) / count;
+        palette->entries[b].g = (sum[1] + count / 2) / count;
+        palette->entries[b].b = (sum[2] + count / 2) / count;
+        palette->entries[b].a = (sum[3] + count / 2) / count;
+    }
+    palette->n_entries = n_boxes;
+
+    free(tmp);
+    return IMC_EOK;
+}
+
+/**
+ * @brief Lays out __palette__ for the vectorized nearest color search and empties the cache.
+ * @since 16-10-2026
+ * @param[in] palette The palette to be searched
+ * @param[out] map The output location for the search structure
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_quant_map_init(const Palette_t* const palette, QuantMap_t *map) {
+    size_t i, src;
+
+    map->n_groups = (palette->n_entries + 3) / 4;
+    map->rg = malloc(8 * map->n_groups * sizeof(*map->rg));
+    map->ba = malloc(8 * map->n_groups * sizeof(*map->ba));
+    if (map->rg == NULL || map->ba == NULL) {
+        IMC_LOG("Failed to allocate memory for palette map", IMC_ERROR);
+        free(map->rg);
+        free(map->ba);
+        return IMC_ENOMEM;
+    }
+
+    /* Padding repeats the last entry, which can never win a tie against it */
+    for (i = 0; i < 4 * map->n_groups; ++i) {
+        src = (i < palette->n_entries) ? i : palette->n_entries - 1u;
+        map->rg[2 * i + 0] = palette->entries[src].r;
+        map->rg[2 * i + 1] = palette->entries[src].g;
+        map->ba[2 * i + 0] = palette->entries[src].b;
+        map->ba[2 * i + 1] = palette->entries[src].a;
+    }
+
+    for (i = 0; i < _QUANT_CACHE_SIZE; ++i) {
+        map->cache[i].idx = _QUANT_CACHE_EMPTY;
+    }
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Releases the search structure built by _imc_quant_map_init().
+ * @since 16-10-2026
+ * @param[in,out] map The search structure
+ */
+static void _imc_quant_map_destroy(QuantMap_t *map) {
+    free(map->rg);
+    free(map->ba);
+    map->rg = NULL;
+    map->ba = NULL;
+}
+
+/**
+ * @brief Finds the palette entry nearest to __rgba__ (squared Euclidean distance over all four channels).
+ * The SSE2 path measures four entries at once: with red/green and blue/alpha interleaved as 16-bit
+ * pairs, _mm_madd_epi16() of a difference with itself yields dr² + dg² (or db² + da²) per entry.
+ * Ties go to the lowest index.
+ * @since 16-10-2026
+ * @param[in] map The search structure
+ * @param[in] rgba The color to be matched
+ * @returns The index of the nearest entry
+ */
+static uint8_t _imc_quant_search(const QuantMap_t* const map, const uint8_t *rgba) {
+    size_t g, i, best_i = 0;
+    int32_t best_d = INT32_MAX;
+#if defined(__SSE2__)
+    int32_t dists[4], idxs[4];
+    __m128i vrg, vba, dist, lt, prg, pba, vbest_d, vbest_i, vidx;
+    const __m128i four = _mm_set1_epi32(4);
+
+    prg = _mm_set1_epi32(rgba[0] | ((int32_t)rgba[1] << 16));
+    pba = _mm_set1_epi32(rgba[2] | ((int32_t)rgba[3] << 16));
+    vbest_d = _mm_set1_epi32(INT32_MAX);
+    vbest_i = _mm_setzero_si128();
+    vidx = _mm_setr_epi32(0, 1, 2, 3);
+
+    for (g = 0; g < map->n_groups; ++g) {
+        vrg = _mm_sub_epi16(_mm_loadu_si128((const __m128i*)(map->rg + 8 * g)), prg);
+        vba = _mm_sub_epi16(_mm_loadu_si128((const __m128i*)(map->ba + 8 * g)), pba);
+        dist = _mm_add_epi32(_mm_madd_epi16(vrg, vrg), _mm_madd_epi16(vba, vba));
+
+        lt = _mm_cmplt_epi32(dist, vbest_d);
+        vbest_d = _mm_or_si128(_mm_and_si128(lt, dist), _mm_andnot_si128(lt, vbest_d));
+        vbest_i = _mm_or_si128(_mm_and_si128(lt, vidx), _mm_andnot_si128(lt, vbest_i));
+        vidx = _mm_add_epi32(vidx, four);
+    }
+
+    _mm_storeu_si128((__m128i*)dists, vbest_d);
+    _mm_storeu_si128((__m128i*)idxs, vbest_i);
+    for (i = 0; i < 4; ++i) {
+        if (dists[i] < best_d || (dists[i] == best_d && (size_t)idxs[i] < best_i)) {
+            best_d = dists[i];
+            best_i = idxs[i];
+        }
+    }
+#else
+    int32_t d, dr, dg, db, da;
+
+    for (g = 0; g < map->n_groups; ++g) {
+        for (i = 4 * g; i < 4 * g + 4; ++i) {
+            dr = map->rg[2 * i + 0] - rgba[0];
+            dg = map->rg[2 * i + 1] - rgba[1];
+            db = map->ba[2 * i + 0] - rgba[2];
+            da = map->ba[2 * i + 1] - rgba[3];
+            d = dr * dr + dg * dg + db * db + da * da;
+            if (d < best_d) {
+                best_d = d;
+                best_i = i;
+            }
+        }
+    }
+#endif
+
+    return best_i;
+}
+
+/**
+ * @brief Returns the palette entry nearest to __rgba__, consulting the cache first.
+ * @since 16-10-2026
+ * @param[in,out] map The search structure
+ * @param[in] rgba The color to be matched
+ * @returns The index of the nearest entry
+ */
+static inline uint8_t _imc_quant_nearest(QuantMap_t *map, const uint8_t *rgba) {
+    uint32_t key = _imc_quant_key(rgba);
+    QuantCacheEntry_t *entry = &map->cache[(key * 2654435761u) >> (32 - 12)];
+
+    if (entry->idx == _QUANT_CACHE_EMPTY || entry->key != key) {
+        entry->key = key;
+        entry->idx = _imc_quant_search(map, rgba);
+    }
+
+    return entry->idx;
+}
+
+/**
+ * @brief Refines __palette__ with k-means over the histogram cells, weighted by their pixel counts.
+ * Entries which attract no cells keep their previous color.
+ * @since 16-10-2026
+ * @param[in] cells The occupied cells
+ * @param[in] n_cells The number of occupied cells
+ * @param[in] n_iters The number of passes
+ * @param[in,out] palette The palette to be refined
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_quant_kmeans(
+    const QuantCell_t *cells,
+    const size_t n_cells,
+    const size_t n_iters,
+    Palette_t *palette
+) {
+    size_t it, i, c, k;
+    uint64_t count[256], sum[256][4];
+    ImcError_t status;
+    QuantMap_t *map = NULL;
+
+    map = malloc(sizeof(*map));
+    if (map == NULL) {
+        IMC_LOG("Failed to allocate memory for palette map", IMC_ERROR);
+        return IMC_ENOMEM;
+    }
+
+    for (it = 0; it < n_iters; ++it) {
+        status = _imc_quant_map_init(palette, map);
+        if (status != IMC_EOK) {
+            free(map);
+            return status;
+        }
+
+        memset((void*)count, 0, sizeof(count));
+        memset((void*)sum, 0, sizeof(sum));
+        for (i = 0; i < n_cells; ++i) {
+            k = _imc_quant_search(map, cells[i].mean);
+            count[k] += cells[i].count;
+            for (c = 0; c < 4; ++c) {
+                sum[k][c] += cells[i].sum[c];
+            }
+        }
+        _imc_quant_map_destroy(map);
+
+        for (k = 0; k < palette->n_entries; ++k) {
+            if (count[k] > 0) {
+                palette->entries[k].r = (sum[k][0] + count[k] / 2) / count[k];
+                palette->entries[k].g = (sum[k][1] + count[k] / 2) / count[k];
+                palette->entries[k].b = (sum[k][2] + count[k] / 2) / count[k];
+                palette->entries[k].a = (sum[k][3] + count[k] / 2) / count[k];
+            }
+        }
+    }
+
+    free(map);
+    return IMC_EOK;
+}
+
+/**
+ * @brief Maps every pixel of __pixmap__ to its nearest palette entry.
+ * With dithering, the quantization error of each pixel is diffused to its unvisited neighbours
+ * (7/16 right, 3/16 below left, 5/16 below, 1/16 below right), so only two rows of error are held.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap to be quantized
+ * @param[in] palette The palette
+ * @param[in] dither True to apply Floyd-Steinberg dithering
+ * @param[out] indices The output location for the index of each pixel
+ * @returns An ImcError_t indicating the exit status code
+ */
+static ImcError_t _imc_quant_remap(
+    const Pixmap_t* const pixmap,
+    const Palette_t* const palette,
+    const bool dither,
+    uint8_t *indices
+) {
+    size_t x, y, c, i;
+    int32_t v, e, *err_curr = NULL, *err_next = NULL, *tmp;
+    uint8_t k, rgba[4];
+    ImcError_t status;
+    QuantMap_t *map = NULL;
+    const Rgba_t *entry;
+
+    map = malloc(sizeof(*map));
+    if (map == NULL) {
+        IMC_LOG("Failed to allocate memory for palette map", IMC_ERROR);
+        return IMC_ENOMEM;
+    }
+
+    status = _imc_quant_map_init(palette, map);
+    if (status != IMC_EOK) {
+        free(map);
+        return status;
+    }
+
+    if (dither) {
+        /* One guard pixel either side so neighbours never need bounds checks */
+        err_curr = calloc(4 * (pixmap->width + 2), sizeof(*err_curr));
+        err_next = calloc(4 * (pixmap->width + 2), sizeof(*err_next));
+        if (err_curr == NULL || err_next == NULL) {
+            IMC_LOG("Failed to allocate memory for dithering", IMC_ERROR);
+            status = IMC_ENOMEM;
+            goto cleanup;
+        }
+    }
+
+    for (y = 0; y < pixmap->height; ++y) {
+        for (x = 0; x < pixmap->width; ++x) {
+            i = y * pixmap->width + x;
+            _imc_quant_fetch(pixmap, i, rgba);
+
+            if (!dither) {
+                indices[i] = _imc_quant_nearest(map, rgba);
+                continue;
+            }
+
+            for (c = 0; c < 4; ++c) {
+                v = rgba[c] + err_curr[4 * (x + 1) + c] / 16;
+                rgba[c] = (v < 0) ? 0 : (v > 255) ? 255 : v;
+            }
+
+            k = _imc_quant_nearest(map, rgba);
+            indices[i] = k;
+            entry = &palette->entries[k];
+
+            for (c = 0; c < 4; ++c) {
+                e = rgba[c] - ((c == 0) ? entry->r : (c == 1) ? entry->g : (c == 2) ? entry->b : entry->a);
+                err_curr[4 * (x + 2) + c] += 7 * e;
+                err_next[4 * (x + 0) + c] += 3 * e;
+                err_next[4 * (x + 1) + c] += 5 * e;
+                err_next[4 * (x + 2) + c] += 1 * e;
+            }
+        }
+
+        if (dither) {
+            tmp = err_curr;
+            err_curr = err_next;
+            err_next = tmp;
+            memset((void*)err_next, 0, 4 * (pixmap->width + 2) * sizeof(*err_next));
+        }
+    }
+
+cleanup:
+    free(err_curr);
+    free(err_next);
+    _imc_quant_map_destroy(map);
+    free(map);
+
+    return status;
+}
+
+/*
+ * ===============================
+ *       Public Functions
+ * ===============================
+ */
+
+/**
+ * @brief Returns the default quantization options.
+ * @since 16-10-2026
+ * @returns A QuantOpts_t for a 256 color palette, four k-means passes and no dithering
+ */
+QuantOpts_t imc_quant_default_opts(void) {
+    QuantOpts_t opts;
+
+    opts.max_colors = 256;
+    opts.kmeans_iters = 4;
+    opts.dither = false;
+
+    return opts;
+}
+
+/**
+ * @brief Builds an exact palette if __pixmap__ has __max_colors__ distinct colors or fewer.
+ * Palette entries are in the order their colors first appear. Nothing is logged when there are
+ * too many colors, since callers use that to decide whether an approximate palette is needed.
+ * @since 16-10-2026
+ * @param[in] pixmap An 8-bit pixmap with 1 to 4 channels
+ * @param[in] max_colors The largest palette permitted (1-256)
+ * @param[out] palette The output location for the palette
+ * @param[out] indices The output location for the index of each pixel (width * height bytes)
+ * @returns IMC_EOVERFLOW if there are too many colors, otherwise an ImcError_t indicating the exit status code
+ */
+ImcError_t imc_quant_exact(
+    const Pixmap_t* const pixmap,
+    const uint16_t max_colors,
+    Palette_t *palette,
+    uint8_t *indices
+) {
+    size_t i, slot, n;
+    uint32_t key;
+    uint8_t rgba[4];
+    QuantColor_t *table = NULL;
+
+    if (pixmap == NULL || pixmap->data == NULL || palette == NULL || indices == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+
+    /* Both the palette and the color table are sized for at most 256 entries */
+    if (max_colors < 1 || max_colors > 256) {
+        IMC_LOG("Palettes must hold between 1 and 256 colors", IMC_ERROR);
+        return IMC_EINVAL;
+    }
+    n = pixmap->width * pixmap->height;
+
+    table = calloc(_QUANT_HASH_SIZE, sizeof(*table));
+    if (table == NULL) {
+        IMC_LOG("Failed to allocate memory for color table", IMC_ERROR);
+        return IMC_ENOMEM;
+    }
+
+    palette->n_entries = 0;
+    for (i = 0; i < n; ++i) {
+        _imc_quant_fetch(pixmap, i, rgba);
+        key = _imc_quant_key(rgba);
+
+        slot = (key * 2654435761u) >> (32 - 10);
+        while (table[slot].used && table[slot].key != key) {
+            slot = (slot + 1) & (_QUANT_HASH_SIZE - 1);
+        }
+
+        if (!table[slot].used) {
+            if (palette->n_entries == max_colors) {
+                free(table);
+                return IMC_EOVERFLOW;
+            }
+            table[slot].used = true;
+            table[slot].key = key;
+            table[slot].idx = palette->n_entries;
+            palette->entries[palette->n_entries++] = (Rgba_t){ rgba[0], rgba[1], rgba[2], rgba[3] };
+        }
+        indices[i] = table[slot].idx;
+    }
+
+    free(table);
+    return IMC_EOK;
+}
+
+/**
+ * @brief Reduces __pixmap__ to a palette of at most QuantOpts_t.max_colors colors.
+ * Images which already have few enough colors are converted exactly. The result can be written as an
+ * indexed-color PNG by passing __palette__ as PngEncOpts_t.palette when encoding the returned pixmap.
+ * @since 16-10-2026
+ * @param[in] pixmap An 8-bit pixmap with 1 to 4 channels (grey, grey + alpha, RGB or RGBA)
+ * @param[out] palette The output location for the palette
+ * @param[in] opts Quantization options or NULL to use imc_quant_default_opts()
+ * @returns A 1 channel, 8-bit pixmap of palette indices (free with imc_pixmap_destroy()), or NULL on failure
+ */
+Pixmap_t *imc_pixmap_quantize(
+    const Pixmap_t* const pixmap,
+    Palette_t *palette,
+    const QuantOpts_t* const opts
+) {
+    size_t n_cells;
+    ImcError_t status;
+    Pixmap_t *indexed = NULL;
+    QuantCell_t *cells = NULL;
+    QuantOpts_t def_opts = imc_quant_default_opts();
+    const QuantOpts_t *_opts = (opts != NULL) ? opts : &def_opts;
+
+    if (pixmap == NULL || pixmap->data == NULL || palette == NULL) {
+        IMC_LOG("Invalid argument", IMC_ERROR);
+        return NULL;
+    }
+
+    if (pixmap->bit_depth != 8 || pixmap->n_channels < 1 || pixmap->n_channels > 4 ||
+        pixmap->width == 0 || pixmap->height == 0) {
+        IMC_LOG("Only 8-bit pixmaps with 1 to 4 channels can be quantized", IMC_ERROR);
+        return NULL;
+    }
+
+    if (_opts->max_colors < 2 || _opts->max_colors > 256) {
+        IMC_LOG("Palettes must hold between 2 and 256 colors", IMC_ERROR);
+        return NULL;
+    }
+
+    indexed = malloc(sizeof(Pixmap_t));
+    if (indexed == NULL) {
+        IMC_LOG("Failed to allocate memory for Pixmap_t", IMC_ERROR);
+        return NULL;
+    }
+
+    indexed->width = pixmap->width;
+    indexed->height = pixmap->height;
+    indexed->offset = 0;
+    indexed->n_channels = 1;
+    indexed->bit_depth = 8;
+    indexed->data = malloc(pixmap->width * pixmap->height);
+    if (indexed->data == NULL) {
+        IMC_LOG("Failed to allocate memory for pixmap->data", IMC_ERROR);
+        free(indexed);
+        return NULL;
+    }
+
+    status = imc_quant_exact(pixmap, _opts->max_colors, palette, indexed->data);
+    if (status == IMC_EOVERFLOW) {
+        status = _imc_quant_histogram(pixmap, &cells, &n_cells);
+        if (status == IMC_EOK) {
+            status = _imc_quant_median_cut(cells, n_cells, _opts->max_colors, palette);
+        }
+        if (status == IMC_EOK && _opts->kmeans_iters > 0) {
+            status = _imc_quant_kmeans(cells, n_cells, _opts->kmeans_iters, palette);
+        }
+        if (status == IMC_EOK) {
+            status = _imc_quant_remap(pixmap, palette, _opts->dither, indexed->data);
+        }
+        free(cells);
+    }
+
+    if (status != IMC_EOK) {
+        imc_pixmap_destroy(indexed);
+        return NULL;
+    }
+
+    return indexed;
+}
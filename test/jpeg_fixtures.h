@@ -0,0 +1,629 @@
+/**
+ * @file jpeg_fixtures.h
+ * @author Neil Kingdom
+ * @since 16-10-2026
+ * @version 1.0
+ * @brief JPEG files written by libjpeg-turbo 2.1.5 (quality 90) for testing the decoder against a
+ * reference implementation. Each __rgb__ array holds the pixels libjpeg decodes its file to, with the
+ * islow IDCT and fancy upsampling. The 23x13 images leave partial MCUs on both edges at every sampling.
+ */
+
+#ifndef TEST_JPEG_FIXTURES_H
+#define TEST_JPEG_FIXTURES_H
+
+#include <stdint.h>
+
+#define _TEST_JPEG_WIDTH  23
+#define _TEST_JPEG_HEIGHT 13
+
+/* Baseline, 4:4:4 */
+static const uint8_t _test_jpeg_444[901] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x03, 0x02, 0x02, 0x03, 0x02, 0x02, 0x03, 0x03, 0x03, 0x03, 0x04,
+    0x03, 0x03, 0x04, 0x05, 0x08, 0x05, 0x05, 0x04, 0x04, 0x05, 0x0A, 0x07,
+    0x07, 0x06, 0x08, 0x0C, 0x0A, 0x0C, 0x0C, 0x0B, 0x0A, 0x0B, 0x0B, 0x0D,
+    0x0E, 0x12, 0x10, 0x0D, 0x0E, 0x11, 0x0E, 0x0B, 0x0B, 0x10, 0x16, 0x10,
+    0x11, 0x13, 0x14, 0x15, 0x15, 0x15, 0x0C, 0x0F, 0x17, 0x18, 0x16, 0x14,
+    0x18, 0x12, 0x14, 0x15, 0x14, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x03, 0x04,
+    0x04, 0x05, 0x04, 0x05, 0x09, 0x05, 0x05, 0x09, 0x14, 0x0D, 0x0B, 0x0D,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x0D, 0x00, 0x17, 0x03,
+    0x01, 0x11, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDA, 0x00,
+    0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xF9,
+    0x1F, 0xC2, 0x9F, 0x04, 0xB5, 0x4F, 0x0D, 0x5E, 0xDB, 0x6A, 0x97, 0x33,
+    0xDA, 0x7D, 0x9B, 0x4E, 0x75, 0xBB, 0x98, 0x43, 0x23, 0xE5, 0x95, 0x0E,
+    0xE6, 0xC0, 0x28, 0x01, 0x38, 0x53, 0x8C, 0x90, 0x33, 0x5D, 0xAE, 0x9B,
+    0x7A, 0xBF, 0xEB, 0xFA, 0xB1, 0xC8, 0xEA, 0x25, 0xAB, 0x3D, 0x6A, 0xD6,
+    0xFA, 0xC3, 0xE2, 0x05, 0x8B, 0xE8, 0x3A, 0x74, 0x77, 0x30, 0x5C, 0x5D,
+    0xED, 0x31, 0xBD, 0xCA, 0x2A, 0xC5, 0xF2, 0xB0, 0x73, 0x92, 0x09, 0x39,
+    0xDA, 0x9E, 0x87, 0xAF, 0xA5, 0x25, 0x49, 0xC9, 0x13, 0x2A, 0xCF, 0xEC,
+    0xEB, 0xFD, 0x7F, 0x5F, 0xAD, 0x8E, 0xC3, 0xC1, 0xDE, 0x04, 0x9B, 0xE1,
+    0x5D, 0xD0, 0xD5, 0x75, 0x56, 0x86, 0xE6, 0xD2, 0xE2, 0x33, 0x6A, 0xA9,
+    0x6A, 0x4B, 0xBE, 0xE3, 0x87, 0xCF, 0xCC, 0x14, 0x63, 0xE4, 0x3D, 0xFB,
+    0x8F, 0xC0, 0xF6, 0x37, 0xD6, 0xDF, 0xD7, 0xE8, 0x37, 0x3F, 0x71, 0xEB,
+    0xAF, 0xFC, 0x37, 0xF5, 0xE8, 0x79, 0x77, 0x83, 0xFC, 0x47, 0xAA, 0xEB,
+    0x9A, 0x95, 0x9E, 0x99, 0x7D, 0x79, 0xE7, 0x5A, 0x5D, 0xCB, 0x1C, 0x13,
+    0xC6, 0x22, 0x44, 0xDE, 0x8C, 0xDB, 0x18, 0x65, 0x40, 0x23, 0x20, 0x9E,
+    0x41, 0xCD, 0x7B, 0xAE, 0x9F, 0x2A, 0x5D, 0x75, 0x47, 0x89, 0x3A, 0xCE,
+    0x2D, 0xDD, 0x5F, 0xFA, 0xFF, 0x00, 0x82, 0x7B, 0x9C, 0xFE, 0x04, 0xD2,
+    0x7C, 0x23, 0xA2, 0xDC, 0x6A, 0xFA, 0x4C, 0x06, 0xD3, 0x51, 0xB4, 0x08,
+    0xD1, 0x4C, 0x1D, 0x9F, 0x1B, 0xD9, 0x55, 0xBE, 0x56, 0x24, 0x72, 0x19,
+    0x87, 0x20, 0xF5, 0xAC, 0xA5, 0x08, 0xDE, 0xC9, 0x1A, 0x2A, 0x97, 0x77,
+    0xB6, 0xFF, 0x00, 0xA5, 0xCD, 0xFF, 0x00, 0x85, 0xAF, 0x27, 0xC4, 0x3D,
+    0x51, 0x74, 0xFD, 0x79, 0xC5, 0xED, 0x98, 0x81, 0xAE, 0x16, 0x30, 0x8B,
+    0x19, 0x12, 0x02, 0x06, 0xEC, 0xA0, 0x52, 0x78, 0x66, 0xE3, 0xDE, 0xAE,
+    0x50, 0x54, 0xD3, 0x6B, 0x7F, 0xF8, 0x28, 0xB8, 0xD4, 0x69, 0xD8, 0xFF,
+    0xD9
+};
+
+static const uint8_t _test_jpeg_444_rgb[897] = {
+    0x08, 0x06, 0x13, 0x06, 0x05, 0x15, 0x0C, 0x10, 0x0F, 0x11, 0x15, 0x21,
+    0x1C, 0x24, 0x19, 0x20, 0x24, 0x2D, 0x1B, 0x20, 0x1A, 0x61, 0x65, 0x68,
+    0x60, 0x5B, 0x61, 0x62, 0x5F, 0x66, 0x5C, 0x59, 0x60, 0x72, 0x6F, 0x76,
+    0x71, 0x72, 0x76, 0x6D, 0x6E, 0x70, 0x36, 0x38, 0x37, 0x33, 0x37, 0x36,
+    0x3C, 0x3E, 0x3B, 0x44, 0x3B, 0x40, 0x3B, 0x4B, 0x4A, 0x4A, 0x44, 0x46,
+    0x40, 0x46, 0x3C, 0x8B, 0x8D, 0x82, 0x84, 0x85, 0x80, 0x0F, 0x0F, 0x19,
+    0x0F, 0x0E, 0x1C, 0x0E, 0x12, 0x11, 0x1B, 0x1F, 0x2A, 0x10, 0x17, 0x0F,
+    0x0B, 0x0F, 0x18, 0x21, 0x26, 0x22, 0x64, 0x65, 0x6A, 0x5C, 0x60, 0x63,
+    0x65, 0x63, 0x68, 0x6F, 0x70, 0x75, 0x6B, 0x70, 0x74, 0x66, 0x63, 0x6A,
+    0x76, 0x77, 0x7B, 0x2E, 0x34, 0x34, 0x42, 0x42, 0x42, 0x3B, 0x3D, 0x4A,
+    0x34, 0x3E, 0x3D, 0x45, 0x4C, 0x44, 0x46, 0x47, 0x42, 0x49, 0x54, 0x56,
+    0x92, 0x86, 0x94, 0x82, 0x95, 0x93, 0x07, 0x0A, 0x11, 0x17, 0x1A, 0x23,
+    0x18, 0x1E, 0x1E, 0x17, 0x1B, 0x24, 0x0F, 0x15, 0x11, 0x1A, 0x1D, 0x26,
+    0x29, 0x2D, 0x2E, 0x5F, 0x60, 0x65, 0x62, 0x67, 0x6A, 0x67, 0x6F, 0x71,
+    0x5C, 0x61, 0x65, 0x66, 0x6B, 0x6F, 0x66, 0x6B, 0x6F, 0x73, 0x77, 0x7A,
+    0x38, 0x3C, 0x3F, 0x38, 0x3C, 0x3D, 0x39, 0x44, 0x48, 0x3F, 0x4C, 0x52,
+    0x3D, 0x44, 0x4C, 0x4E, 0x4D, 0x55, 0x41, 0x4D, 0x4D, 0x99, 0x8F, 0x97,
+    0x80, 0x99, 0x96, 0x11, 0x16, 0x1A, 0x14, 0x19, 0x1F, 0x1A, 0x1F, 0x22,
+    0x1D, 0x22, 0x28, 0x29, 0x2E, 0x31, 0x2B, 0x2E, 0x35, 0x1C, 0x1F, 0x24,
+    0x6A, 0x6D, 0x74, 0x6F, 0x70, 0x74, 0x61, 0x6D, 0x6D, 0x74, 0x79, 0x7D,
+    0x71, 0x74, 0x7B, 0x69, 0x78, 0x7B, 0x70, 0x7E, 0x81, 0x35, 0x3D, 0x40,
+    0x43, 0x53, 0x52, 0x3A, 0x4E, 0x4C, 0x53, 0x53, 0x5F, 0x40, 0x52, 0x5E,
+    0x51, 0x46, 0x57, 0x4D, 0x51, 0x54, 0x86, 0x8A, 0x89, 0x8E, 0x99, 0x9D,
+    0x0C, 0x13, 0x19, 0x14, 0x1C, 0x1F, 0x1D, 0x24, 0x2C, 0x14, 0x1B, 0x21,
+    0x19, 0x20, 0x2A, 0x1F, 0x26, 0x2C, 0x26, 0x2D, 0x37, 0x6B, 0x72, 0x7A,
+    0x6E, 0x78, 0x79, 0x6E, 0x62, 0x6C, 0x72, 0x7B, 0x80, 0x65, 0x7A, 0x7D,
+    0x81, 0x84, 0x8D, 0x74, 0x83, 0x88, 0x34, 0x58, 0x56, 0x41, 0x50, 0x55,
+    0x3C, 0x4D, 0x55, 0x55, 0x56, 0x5B, 0x3A, 0x4D, 0x47, 0x5F, 0x54, 0x5C,
+    0x55, 0x54, 0x62, 0x84, 0x83, 0x95, 0x8E, 0x97, 0x9E, 0x58, 0x61, 0x6A,
+    0x5B, 0x64, 0x69, 0x57, 0x5E, 0x6E, 0x57, 0x60, 0x65, 0x62, 0x69, 0x7B,
+    0x69, 0x74, 0x78, 0x64, 0x6E, 0x7A, 0x31, 0x3E, 0x44, 0x3E, 0x36, 0x41,
+    0x32, 0x4A, 0x4A, 0x3E, 0x42, 0x4B, 0x37, 0x33, 0x42, 0x2F, 0x4E, 0x51,
+    0x3D, 0x54, 0x5A, 0x77, 0x7D, 0x89, 0x70, 0x93, 0x95, 0x86, 0x8F, 0x96,
+    0x81, 0x8F, 0x92, 0x93, 0x9A, 0xA0, 0x94, 0x91, 0x9C, 0x93, 0x9B, 0xA6,
+    0x69, 0x5C, 0x6E, 0x5B, 0x70, 0x75, 0x59, 0x63, 0x6F, 0x53, 0x5E, 0x64,
+    0x57, 0x5D, 0x73, 0x5B, 0x64, 0x6B, 0x60, 0x68, 0x7F, 0x59, 0x68, 0x6B,
+    0x6B, 0x7B, 0x88, 0x30, 0x43, 0x47, 0x27, 0x3C, 0x3F, 0x38, 0x36, 0x41,
+    0x37, 0x48, 0x50, 0x25, 0x40, 0x47, 0x42, 0x43, 0x55, 0x4C, 0x58, 0x66,
+    0x6E, 0x8C, 0x94, 0x86, 0x8D, 0x9D, 0x8A, 0x94, 0x95, 0x87, 0x95, 0xA0,
+    0x8B, 0x93, 0xA8, 0x96, 0x98, 0xAD, 0x88, 0x99, 0xA0, 0x5F, 0x59, 0x63,
+    0x57, 0x6E, 0x74, 0x5B, 0x64, 0x73, 0x5A, 0x64, 0x6D, 0x65, 0x6C, 0x86,
+    0x58, 0x63, 0x69, 0x68, 0x72, 0x8B, 0x66, 0x78, 0x7A, 0x65, 0x78, 0x86,
+    0x20, 0x38, 0x3C, 0x27, 0x3A, 0x3E, 0x31, 0x4D, 0x50, 0x31, 0x43, 0x4D,
+    0x46, 0x52, 0x60, 0x40, 0x52, 0x60, 0x3C, 0x47, 0x59, 0x88, 0x89, 0x9E,
+    0x82, 0x8A, 0x9D, 0x7D, 0x8A, 0x9A, 0x94, 0x96, 0xA5, 0x83, 0xA0, 0xA4,
+    0x9A, 0xA0, 0xB0, 0x88, 0x97, 0xAC, 0x54, 0x5E, 0x77, 0x5E, 0x69, 0x7B,
+    0x5F, 0x64, 0x7A, 0x55, 0x65, 0x7E, 0x5B, 0x66, 0x7A, 0x56, 0x75, 0x87,
+    0x6D, 0x76, 0x97, 0x59, 0x77, 0x7F, 0x6B, 0x80, 0x83, 0x27, 0x43, 0x59,
+    0x3B, 0x4C, 0x56, 0x32, 0x40, 0x4D, 0x3B, 0x53, 0x5D, 0x31, 0x5E, 0x61,
+    0x49, 0x4F, 0x5F, 0x3B, 0x52, 0x5A, 0x87, 0xA0, 0xA7, 0x81, 0x95, 0x9E,
+    0x8A, 0x9C, 0xB0, 0x7D, 0x91, 0x9A, 0x8A, 0x9D, 0xA4, 0x8C, 0x9C, 0xAB,
+    0x97, 0xA6, 0xAD, 0x5C, 0x64, 0x89, 0x66, 0x71, 0x83, 0x5A, 0x66, 0x76,
+    0x64, 0x79, 0x8C, 0x64, 0x74, 0x84, 0x53, 0x70, 0x82, 0x70, 0x76, 0x9A,
+    0x64, 0x7B, 0x89, 0x60, 0x6E, 0x79, 0x25, 0x38, 0x59, 0x3D, 0x4A, 0x5D,
+    0x3D, 0x4A, 0x5D, 0x40, 0x55, 0x66, 0x33, 0x5B, 0x65, 0x44, 0x49, 0x5D,
+    0x48, 0x5B, 0x6A, 0x78, 0x8B, 0x9A, 0x8F, 0x9F, 0xAE, 0x8F, 0xA4, 0xB7,
+    0x8D, 0xA1, 0xAC, 0x98, 0xAA, 0xB8, 0x9A, 0xAB, 0xBD, 0x91, 0xA2, 0xAC,
+    0x6B, 0x74, 0x9B, 0x67, 0x74, 0x84, 0x1F, 0x33, 0x3E, 0x22, 0x3E, 0x4C,
+    0x23, 0x39, 0x47, 0x23, 0x40, 0x52, 0x3A, 0x44, 0x68, 0x2E, 0x40, 0x54,
+    0x46, 0x52, 0x62, 0x76, 0x82, 0xAA, 0x77, 0x82, 0xA0, 0x78, 0x86, 0xA1,
+    0x74, 0x84, 0x9E, 0x73, 0x94, 0xA7, 0x87, 0x8D, 0xA7, 0x82, 0x94, 0xA8,
+    0x4F, 0x60, 0x74, 0x4E, 0x5D, 0x72, 0x46, 0x5C, 0x71, 0x53, 0x69, 0x77,
+    0x55, 0x6A, 0x7D, 0x5B, 0x6C, 0x86, 0x65, 0x78, 0x87, 0x94, 0xA2, 0xC9,
+    0xA2, 0xB2, 0xBF, 0x1A, 0x31, 0x41, 0x23, 0x3E, 0x53, 0x28, 0x43, 0x54,
+    0x27, 0x46, 0x5B, 0x36, 0x49, 0x6A, 0x2F, 0x46, 0x58, 0x31, 0x47, 0x52,
+    0x73, 0x87, 0xAA, 0x6F, 0x7E, 0x9F, 0x7E, 0x93, 0xB0, 0x80, 0x8F, 0xAC,
+    0x7D, 0x9C, 0xB1, 0x84, 0x90, 0xAA, 0x82, 0x9B, 0xAF, 0x4C, 0x5C, 0x73,
+    0x5C, 0x6E, 0x84, 0x52, 0x68, 0x80, 0x60, 0x76, 0x8B, 0x5B, 0x71, 0x89,
+    0x54, 0x68, 0x89, 0x57, 0x6D, 0x82, 0xA1, 0xB3, 0xDB, 0xA8, 0xBC, 0xC3,
+    0x28, 0x3C, 0x57, 0x29, 0x40, 0x5F, 0x27, 0x47, 0x5C, 0x20, 0x3E, 0x58,
+    0x26, 0x47, 0x66, 0x3A, 0x5A, 0x65, 0x31, 0x59, 0x59, 0x69, 0x8F, 0xA6,
+    0x77, 0x8F, 0xAB, 0x79, 0x99, 0xB0, 0x75, 0x89, 0xA2, 0x7A, 0x9B, 0xAC,
+    0x89, 0xA0, 0xB2, 0x8C, 0xAD, 0xBC, 0x56, 0x68, 0x7C, 0x4F, 0x69, 0x7A,
+    0x47, 0x5F, 0x7B, 0x4F, 0x67, 0x7F, 0x59, 0x73, 0x8E, 0x5D, 0x75, 0x97,
+    0x5D, 0x76, 0x8C, 0x9A, 0xAD, 0xD5, 0xA5, 0xBC, 0xC2
+};
+
+/* Baseline, 4:2:0 */
+static const uint8_t _test_jpeg_420[841] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x03, 0x02, 0x02, 0x03, 0x02, 0x02, 0x03, 0x03, 0x03, 0x03, 0x04,
+    0x03, 0x03, 0x04, 0x05, 0x08, 0x05, 0x05, 0x04, 0x04, 0x05, 0x0A, 0x07,
+    0x07, 0x06, 0x08, 0x0C, 0x0A, 0x0C, 0x0C, 0x0B, 0x0A, 0x0B, 0x0B, 0x0D,
+    0x0E, 0x12, 0x10, 0x0D, 0x0E, 0x11, 0x0E, 0x0B, 0x0B, 0x10, 0x16, 0x10,
+    0x11, 0x13, 0x14, 0x15, 0x15, 0x15, 0x0C, 0x0F, 0x17, 0x18, 0x16, 0x14,
+    0x18, 0x12, 0x14, 0x15, 0x14, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x03, 0x04,
+    0x04, 0x05, 0x04, 0x05, 0x09, 0x05, 0x05, 0x09, 0x14, 0x0D, 0x0B, 0x0D,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x0D, 0x00, 0x17, 0x03,
+    0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDA, 0x00,
+    0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xF9,
+    0x23, 0xC3, 0xDF, 0x05, 0x75, 0x4F, 0x0D, 0x5E, 0x41, 0xAC, 0xCF, 0x2D,
+    0xAC, 0x90, 0x69, 0xEE, 0xB7, 0x52, 0x88, 0xDD, 0x83, 0x15, 0x8C, 0xEE,
+    0x20, 0x65, 0x40, 0x2C, 0x40, 0xC0, 0xE4, 0x7D, 0x71, 0x5E, 0xAF, 0x0E,
+    0xA7, 0x65, 0xE3, 0xFD, 0x38, 0xF8, 0x7E, 0xC6, 0xD6, 0xE2, 0x1B, 0xBB,
+    0x9D, 0xA2, 0x37, 0xBA, 0x40, 0x91, 0x8D, 0x9F, 0x39, 0xC9, 0x04, 0x9E,
+    0x8A, 0xDD, 0x07, 0x5A, 0xC1, 0xF0, 0x7F, 0x88, 0xF5, 0x6D, 0x63, 0x55,
+    0xB3, 0xD3, 0x6F, 0x6F, 0x44, 0xD6, 0x97, 0x33, 0x25, 0xBC, 0xA8, 0x20,
+    0x8D, 0x0B, 0xA3, 0x01, 0xB8, 0x6E, 0x0A, 0x08, 0xC8, 0x24, 0x70, 0x73,
+    0xEF, 0x5E, 0xDD, 0xA8, 0x78, 0x1F, 0x45, 0xF0, 0x7E, 0x85, 0x3E, 0xB1,
+    0xA4, 0x59, 0x2D, 0xA6, 0xA5, 0x6A, 0x8A, 0x22, 0x9F, 0x7B, 0x49, 0xB3,
+    0x73, 0x2A, 0x1F, 0x95, 0xC9, 0x1F, 0x75, 0xC8, 0xE4, 0x1C, 0x57, 0xB5,
+    0xF5, 0x48, 0xE8, 0xCF, 0x25, 0x62, 0xB4, 0x4E, 0xE7, 0x3F, 0xE1, 0x0F,
+    0x03, 0x4B, 0xF0, 0xB2, 0x53, 0xAB, 0x6A, 0xCB, 0x0C, 0xF0, 0xCB, 0x1F,
+    0xD9, 0x42, 0xD9, 0x92, 0xEC, 0x18, 0xE1, 0xB2, 0x43, 0x05, 0xE3, 0x09,
+    0xD4, 0x77, 0x23, 0x8E, 0xB4, 0x57, 0xA2, 0xFC, 0x34, 0x49, 0x3C, 0x7D,
+    0xAB, 0x1D, 0x37, 0x5E, 0x94, 0x5F, 0xDA, 0x24, 0x2F, 0x70, 0xB1, 0xF9,
+    0x6B, 0x17, 0xCE, 0xA5, 0x54, 0x12, 0x50, 0x29, 0x3C, 0x33, 0x75, 0x38,
+    0xE6, 0x8A, 0x1E, 0x1E, 0x31, 0xE8, 0x47, 0xD6, 0xDA, 0xD2, 0xE7, 0xFF,
+    0xD9
+};
+
+static const uint8_t _test_jpeg_420_rgb[897] = {
+    0x0C, 0x10, 0x0F, 0x15, 0x19, 0x18, 0x07, 0x07, 0x09, 0x14, 0x14, 0x16,
+    0x1F, 0x1D, 0x22, 0x13, 0x11, 0x14, 0x22, 0x22, 0x24, 0x67, 0x67, 0x65,
+    0x58, 0x5A, 0x57, 0x61, 0x63, 0x5E, 0x70, 0x72, 0x6D, 0x64, 0x66, 0x63,
+    0x70, 0x70, 0x70, 0x67, 0x67, 0x69, 0x35, 0x30, 0x37, 0x39, 0x37, 0x3C,
+    0x38, 0x39, 0x3B, 0x3B, 0x3F, 0x3E, 0x40, 0x42, 0x41, 0x43, 0x45, 0x44,
+    0x42, 0x42, 0x44, 0x84, 0x84, 0x86, 0x84, 0x82, 0x85, 0x0F, 0x15, 0x15,
+    0x12, 0x16, 0x17, 0x20, 0x21, 0x23, 0x0E, 0x0F, 0x13, 0x12, 0x11, 0x16,
+    0x26, 0x25, 0x2A, 0x20, 0x20, 0x22, 0x5D, 0x5F, 0x5E, 0x5E, 0x60, 0x5D,
+    0x6B, 0x70, 0x6C, 0x66, 0x6B, 0x67, 0x6B, 0x6D, 0x6A, 0x77, 0x78, 0x7A,
+    0x6C, 0x6B, 0x70, 0x3D, 0x3A, 0x41, 0x36, 0x35, 0x3B, 0x3D, 0x41, 0x44,
+    0x48, 0x4E, 0x4E, 0x38, 0x3C, 0x3D, 0x49, 0x4D, 0x4E, 0x49, 0x4A, 0x4E,
+    0x89, 0x8A, 0x8E, 0x8F, 0x8E, 0x93, 0x0A, 0x12, 0x14, 0x11, 0x19, 0x1B,
+    0x16, 0x1B, 0x1E, 0x18, 0x1B, 0x20, 0x1F, 0x20, 0x25, 0x18, 0x19, 0x1E,
+    0x22, 0x23, 0x27, 0x69, 0x6D, 0x6E, 0x5A, 0x60, 0x60, 0x6E, 0x74, 0x72,
+    0x6A, 0x70, 0x6E, 0x70, 0x76, 0x76, 0x72, 0x76, 0x79, 0x6D, 0x6E, 0x73,
+    0x40, 0x40, 0x48, 0x44, 0x44, 0x4C, 0x37, 0x3C, 0x40, 0x4A, 0x52, 0x55,
+    0x50, 0x55, 0x59, 0x47, 0x4C, 0x50, 0x51, 0x54, 0x59, 0x83, 0x86, 0x8B,
+    0x97, 0x98, 0x9D, 0x13, 0x1E, 0x20, 0x13, 0x1D, 0x1F, 0x19, 0x20, 0x26,
+    0x0F, 0x16, 0x1C, 0x28, 0x2C, 0x35, 0x2C, 0x31, 0x37, 0x1D, 0x22, 0x26,
+    0x61, 0x66, 0x6A, 0x65, 0x6D, 0x6F, 0x66, 0x70, 0x71, 0x67, 0x71, 0x72,
+    0x6C, 0x74, 0x76, 0x74, 0x79, 0x7D, 0x7B, 0x80, 0x86, 0x3F, 0x42, 0x4B,
+    0x40, 0x44, 0x4F, 0x46, 0x4F, 0x56, 0x41, 0x4C, 0x52, 0x42, 0x4B, 0x52,
+    0x4F, 0x58, 0x5F, 0x53, 0x5A, 0x62, 0x8E, 0x95, 0x9D, 0x82, 0x86, 0x8F,
+    0x19, 0x27, 0x2A, 0x13, 0x20, 0x26, 0x1E, 0x28, 0x31, 0x22, 0x2B, 0x34,
+    0x22, 0x29, 0x33, 0x18, 0x1F, 0x29, 0x27, 0x2E, 0x36, 0x5E, 0x67, 0x6E,
+    0x61, 0x6A, 0x6F, 0x64, 0x6F, 0x73, 0x6B, 0x76, 0x78, 0x71, 0x7C, 0x80,
+    0x71, 0x7A, 0x81, 0x6E, 0x77, 0x80, 0x43, 0x49, 0x55, 0x3E, 0x44, 0x50,
+    0x34, 0x3E, 0x48, 0x42, 0x4F, 0x58, 0x4C, 0x58, 0x64, 0x44, 0x50, 0x5C,
+    0x55, 0x5F, 0x6B, 0x8D, 0x97, 0xA3, 0x8C, 0x94, 0xA1, 0x4B, 0x5A, 0x61,
+    0x58, 0x67, 0x6E, 0x57, 0x64, 0x6D, 0x5E, 0x68, 0x74, 0x56, 0x60, 0x6C,
+    0x5C, 0x64, 0x71, 0x67, 0x6F, 0x7A, 0x1F, 0x29, 0x33, 0x2E, 0x38, 0x41,
+    0x37, 0x44, 0x4C, 0x2E, 0x3B, 0x41, 0x35, 0x42, 0x48, 0x37, 0x44, 0x4D,
+    0x3F, 0x49, 0x53, 0x70, 0x78, 0x85, 0x7E, 0x87, 0x96, 0x84, 0x90, 0x9E,
+    0x7D, 0x8D, 0x9A, 0x8B, 0x99, 0xA6, 0x82, 0x90, 0x9D, 0x89, 0x96, 0xA6,
+    0x48, 0x56, 0x63, 0x5C, 0x68, 0x78, 0x58, 0x69, 0x73, 0x49, 0x5A, 0x64,
+    0x59, 0x67, 0x74, 0x58, 0x64, 0x72, 0x59, 0x62, 0x73, 0x6E, 0x77, 0x88,
+    0x6C, 0x75, 0x86, 0x32, 0x3B, 0x4A, 0x2A, 0x36, 0x42, 0x2D, 0x3B, 0x46,
+    0x28, 0x36, 0x3F, 0x33, 0x41, 0x4A, 0x3E, 0x4C, 0x59, 0x3A, 0x46, 0x54,
+    0x82, 0x8B, 0x9C, 0x7B, 0x87, 0x97, 0x81, 0x8E, 0x9E, 0x84, 0x96, 0xA4,
+    0x7D, 0x8D, 0x9C, 0x93, 0xA3, 0xB2, 0x90, 0xA0, 0xB0, 0x55, 0x65, 0x74,
+    0x57, 0x64, 0x75, 0x54, 0x66, 0x74, 0x59, 0x6B, 0x79, 0x57, 0x67, 0x76,
+    0x61, 0x6E, 0x7F, 0x6D, 0x78, 0x8C, 0x67, 0x6F, 0x84, 0x60, 0x68, 0x7D,
+    0x2A, 0x35, 0x47, 0x3B, 0x48, 0x58, 0x35, 0x43, 0x50, 0x3F, 0x4F, 0x5C,
+    0x3B, 0x4B, 0x58, 0x43, 0x50, 0x60, 0x39, 0x46, 0x57, 0x82, 0x8D, 0x9F,
+    0x7E, 0x89, 0x9D, 0x83, 0x92, 0xA5, 0x89, 0x9A, 0xAA, 0x85, 0x96, 0xA8,
+    0x8A, 0x9B, 0xAB, 0x85, 0x96, 0xA6, 0x5B, 0x6C, 0x7C, 0x57, 0x68, 0x78,
+    0x54, 0x67, 0x76, 0x55, 0x68, 0x77, 0x58, 0x67, 0x7A, 0x61, 0x6D, 0x83,
+    0x60, 0x6A, 0x83, 0x61, 0x6B, 0x84, 0x72, 0x7D, 0x93, 0x3B, 0x46, 0x5C,
+    0x2E, 0x3B, 0x4E, 0x45, 0x52, 0x63, 0x37, 0x47, 0x57, 0x37, 0x47, 0x57,
+    0x3D, 0x4D, 0x5D, 0x38, 0x45, 0x58, 0x82, 0x8E, 0xA4, 0x7D, 0x89, 0x9F,
+    0x8A, 0x99, 0xAE, 0x86, 0x97, 0xA9, 0x81, 0x93, 0xA7, 0x85, 0x98, 0xA9,
+    0x95, 0xA8, 0xB9, 0x5C, 0x6F, 0x80, 0x60, 0x73, 0x84, 0x52, 0x67, 0x78,
+    0x62, 0x77, 0x88, 0x6A, 0x7B, 0x8F, 0x67, 0x76, 0x8D, 0x70, 0x7C, 0x96,
+    0x76, 0x80, 0x9B, 0x66, 0x70, 0x8B, 0x37, 0x43, 0x5B, 0x38, 0x44, 0x5A,
+    0x3B, 0x4A, 0x5D, 0x44, 0x53, 0x66, 0x41, 0x52, 0x64, 0x3C, 0x4B, 0x5E,
+    0x4C, 0x5B, 0x70, 0x89, 0x98, 0xAF, 0x8A, 0x99, 0xB0, 0x8A, 0x9A, 0xB1,
+    0x93, 0xA5, 0xB9, 0x98, 0xAA, 0xBE, 0xA0, 0xB2, 0xC6, 0x8E, 0xA0, 0xB4,
+    0x5F, 0x72, 0x83, 0x5E, 0x71, 0x82, 0x1F, 0x36, 0x48, 0x1C, 0x33, 0x45,
+    0x20, 0x35, 0x4A, 0x2C, 0x3E, 0x56, 0x32, 0x40, 0x5B, 0x2F, 0x3A, 0x56,
+    0x39, 0x44, 0x60, 0x76, 0x82, 0x9C, 0x80, 0x8E, 0xA8, 0x7A, 0x8A, 0xA1,
+    0x81, 0x92, 0xA6, 0x7E, 0x90, 0xA4, 0x87, 0x98, 0xAC, 0x85, 0x95, 0xAC,
+    0x59, 0x69, 0x80, 0x42, 0x52, 0x69, 0x4C, 0x5C, 0x73, 0x56, 0x68, 0x7E,
+    0x4E, 0x60, 0x76, 0x56, 0x6B, 0x7E, 0x5B, 0x70, 0x83, 0x8F, 0xA4, 0xB7,
+    0xA0, 0xB5, 0xC6, 0x16, 0x31, 0x42, 0x2C, 0x46, 0x57, 0x2B, 0x41, 0x58,
+    0x28, 0x3C, 0x54, 0x2E, 0x3D, 0x5A, 0x3B, 0x4A, 0x67, 0x3F, 0x4D, 0x68,
+    0x75, 0x83, 0x9E, 0x74, 0x84, 0x9E, 0x80, 0x92, 0xAA, 0x8A, 0x9C, 0xB2,
+    0x81, 0x96, 0xA9, 0x81, 0x96, 0xAB, 0x86, 0x9B, 0xB0, 0x4B, 0x5D, 0x75,
+    0x53, 0x65, 0x7D, 0x58, 0x6A, 0x82, 0x56, 0x6B, 0x80, 0x55, 0x6A, 0x7F,
+    0x64, 0x7A, 0x8F, 0x5E, 0x74, 0x89, 0x9B, 0xB2, 0xC4, 0x9D, 0xB4, 0xC6,
+    0x26, 0x46, 0x55, 0x27, 0x44, 0x54, 0x17, 0x32, 0x47, 0x2F, 0x48, 0x5E,
+    0x38, 0x4C, 0x67, 0x37, 0x48, 0x64, 0x41, 0x50, 0x6D, 0x78, 0x89, 0xA3,
+    0x7A, 0x8E, 0xA7, 0x76, 0x8C, 0xA3, 0x7B, 0x91, 0xA6, 0x83, 0x99, 0xAE,
+    0x7E, 0x94, 0xAB, 0x8F, 0xA5, 0xBC, 0x51, 0x67, 0x7F, 0x4A, 0x60, 0x78,
+    0x5A, 0x70, 0x88, 0x56, 0x6C, 0x83, 0x5D, 0x73, 0x8A, 0x62, 0x7B, 0x91,
+    0x57, 0x70, 0x86, 0x9A, 0xB5, 0xC8, 0xA4, 0xBF, 0xD2
+};
+
+/* Baseline, 4:1:1 */
+static const uint8_t _test_jpeg_411[850] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x03, 0x02, 0x02, 0x03, 0x02, 0x02, 0x03, 0x03, 0x03, 0x03, 0x04,
+    0x03, 0x03, 0x04, 0x05, 0x08, 0x05, 0x05, 0x04, 0x04, 0x05, 0x0A, 0x07,
+    0x07, 0x06, 0x08, 0x0C, 0x0A, 0x0C, 0x0C, 0x0B, 0x0A, 0x0B, 0x0B, 0x0D,
+    0x0E, 0x12, 0x10, 0x0D, 0x0E, 0x11, 0x0E, 0x0B, 0x0B, 0x10, 0x16, 0x10,
+    0x11, 0x13, 0x14, 0x15, 0x15, 0x15, 0x0C, 0x0F, 0x17, 0x18, 0x16, 0x14,
+    0x18, 0x12, 0x14, 0x15, 0x14, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x03, 0x04,
+    0x04, 0x05, 0x04, 0x05, 0x09, 0x05, 0x05, 0x09, 0x14, 0x0D, 0x0B, 0x0D,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x0D, 0x00, 0x17, 0x03,
+    0x01, 0x41, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDA, 0x00,
+    0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0xF9,
+    0x23, 0xC3, 0x5F, 0x04, 0x75, 0x5F, 0x0D, 0x5E, 0x5B, 0x6A, 0x57, 0x53,
+    0xD9, 0xCB, 0x0E, 0x9D, 0x20, 0xB9, 0x92, 0x28, 0x99, 0xCB, 0xB2, 0xA6,
+    0x18, 0x81, 0xF2, 0x81, 0x9C, 0x67, 0x19, 0xC7, 0xD7, 0xBD, 0x7A, 0xB4,
+    0x3A, 0x9D, 0x8F, 0xC4, 0x0B, 0x17, 0xD0, 0xB4, 0xF8, 0x67, 0x82, 0xEE,
+    0xF8, 0x8F, 0x2A, 0x6B, 0xCD, 0xAA, 0x83, 0x69, 0xDE, 0x72, 0x55, 0x89,
+    0xE8, 0xA7, 0xB1, 0xEA, 0x3E, 0xB5, 0xD9, 0xF8, 0x37, 0xC0, 0xB7, 0x3F,
+    0x0A, 0xA6, 0xFE, 0xD7, 0xD5, 0x4C, 0x37, 0x16, 0xD3, 0x47, 0xF6, 0x44,
+    0x16, 0x44, 0x97, 0x56, 0x38, 0x60, 0x4E, 0xE0, 0xBC, 0x61, 0x0F, 0x39,
+    0xCE, 0x71, 0xEF, 0x45, 0x76, 0xFB, 0x1E, 0x6F, 0x23, 0x93, 0xDB, 0x2E,
+    0xAA, 0xFF, 0x00, 0xD7, 0x99, 0xE6, 0x3E, 0x0E, 0xF1, 0x1E, 0xAF, 0xAC,
+    0xEA, 0x56, 0xBA, 0x7D, 0xED, 0xF9, 0x9E, 0xCE, 0xE2, 0x64, 0x86, 0x68,
+    0xFC, 0x94, 0x53, 0x24, 0x6C, 0xDB, 0x59, 0x49, 0x03, 0x23, 0x20, 0xE3,
+    0x23, 0x15, 0xED, 0xD7, 0xDE, 0x04, 0xD1, 0xFC, 0x11, 0xE1, 0xFB, 0x9D,
+    0x6F, 0x46, 0xB6, 0x36, 0x7A, 0x8D, 0xAB, 0x2C, 0x71, 0x4A, 0x24, 0x67,
+    0xDB, 0xB9, 0xD5, 0x58, 0xE1, 0x89, 0x07, 0x86, 0x3D, 0x45, 0x74, 0x3F,
+    0x0C, 0x60, 0x6F, 0x88, 0xBA, 0x8C, 0xDA, 0x67, 0x88, 0x24, 0x37, 0xF6,
+    0x31, 0x5B, 0xB5, 0xCA, 0x44, 0x15, 0x62, 0xC3, 0x86, 0x8D, 0x41, 0xCA,
+    0x05, 0x27, 0x86, 0x6E, 0x3A, 0x73, 0xD2, 0x8A, 0xF6, 0xE1, 0x4F, 0xF9,
+    0x5D, 0x8F, 0x12, 0x55, 0x9C, 0x63, 0x7B, 0x1F, 0xFF, 0xD9
+};
+
+static const uint8_t _test_jpeg_411_rgb[897] = {
+    0x0E, 0x05, 0x08, 0x17, 0x0E, 0x11, 0x1B, 0x12, 0x15, 0x1B, 0x12, 0x15,
+    0x26, 0x20, 0x22, 0x19, 0x13, 0x15, 0x21, 0x1B, 0x1D, 0x63, 0x5D, 0x5F,
+    0x6B, 0x69, 0x6A, 0x62, 0x60, 0x61, 0x66, 0x64, 0x65, 0x65, 0x63, 0x64,
+    0x6A, 0x6B, 0x6D, 0x6C, 0x6D, 0x6F, 0x39, 0x3A, 0x3C, 0x38, 0x39, 0x3B,
+    0x36, 0x3C, 0x3C, 0x3D, 0x43, 0x43, 0x3C, 0x42, 0x42, 0x3F, 0x45, 0x45,
+    0x3F, 0x49, 0x48, 0x7F, 0x89, 0x88, 0x81, 0x8B, 0x8A, 0x06, 0x0F, 0x14,
+    0x10, 0x19, 0x1E, 0x13, 0x1C, 0x21, 0x13, 0x1C, 0x21, 0x0E, 0x18, 0x1A,
+    0x0E, 0x18, 0x1A, 0x25, 0x2F, 0x31, 0x52, 0x5C, 0x5E, 0x5C, 0x61, 0x65,
+    0x60, 0x65, 0x69, 0x66, 0x6B, 0x6F, 0x67, 0x6C, 0x70, 0x6E, 0x72, 0x75,
+    0x63, 0x67, 0x6A, 0x37, 0x3B, 0x3E, 0x33, 0x37, 0x3A, 0x32, 0x32, 0x34,
+    0x54, 0x54, 0x56, 0x4B, 0x4B, 0x4D, 0x4D, 0x4D, 0x4F, 0x4D, 0x49, 0x4A,
+    0x91, 0x8D, 0x8E, 0x95, 0x91, 0x92, 0x11, 0x0D, 0x1C, 0x07, 0x03, 0x12,
+    0x1C, 0x18, 0x27, 0x28, 0x24, 0x33, 0x20, 0x1C, 0x2A, 0x22, 0x1E, 0x2C,
+    0x27, 0x23, 0x31, 0x6D, 0x69, 0x77, 0x6B, 0x68, 0x73, 0x60, 0x5D, 0x68,
+    0x6B, 0x68, 0x73, 0x6E, 0x6B, 0x76, 0x79, 0x78, 0x7E, 0x82, 0x81, 0x87,
+    0x3D, 0x3C, 0x42, 0x3D, 0x3C, 0x42, 0x47, 0x46, 0x4B, 0x45, 0x44, 0x49,
+    0x45, 0x44, 0x49, 0x47, 0x46, 0x4B, 0x59, 0x59, 0x59, 0x82, 0x82, 0x82,
+    0x97, 0x97, 0x97, 0x0D, 0x17, 0x20, 0x1B, 0x25, 0x2E, 0x0A, 0x14, 0x1D,
+    0x11, 0x1B, 0x24, 0x13, 0x1D, 0x26, 0x16, 0x20, 0x29, 0x25, 0x2F, 0x38,
+    0x5D, 0x67, 0x70, 0x67, 0x6E, 0x76, 0x70, 0x77, 0x7F, 0x64, 0x6B, 0x73,
+    0x74, 0x7B, 0x83, 0x6F, 0x74, 0x7A, 0x6D, 0x72, 0x78, 0x3E, 0x43, 0x49,
+    0x3A, 0x3F, 0x45, 0x43, 0x43, 0x4B, 0x46, 0x46, 0x4E, 0x47, 0x47, 0x4F,
+    0x4E, 0x4E, 0x56, 0x50, 0x4D, 0x54, 0x9C, 0x99, 0xA0, 0x90, 0x8D, 0x94,
+    0x11, 0x1C, 0x20, 0x10, 0x1B, 0x1F, 0x1A, 0x25, 0x29, 0x24, 0x2F, 0x33,
+    0x20, 0x2B, 0x2F, 0x25, 0x30, 0x34, 0x21, 0x2C, 0x30, 0x5D, 0x68, 0x6C,
+    0x6E, 0x79, 0x7D, 0x63, 0x6E, 0x72, 0x6C, 0x77, 0x7B, 0x6C, 0x77, 0x7B,
+    0x72, 0x7B, 0x82, 0x73, 0x7C, 0x83, 0x42, 0x4B, 0x52, 0x3D, 0x46, 0x4D,
+    0x3F, 0x48, 0x51, 0x47, 0x50, 0x59, 0x49, 0x52, 0x5B, 0x4A, 0x53, 0x5C,
+    0x4D, 0x53, 0x5F, 0x8A, 0x90, 0x9C, 0x8B, 0x91, 0x9D, 0x5C, 0x5D, 0x62,
+    0x63, 0x64, 0x69, 0x57, 0x58, 0x5D, 0x66, 0x67, 0x6C, 0x63, 0x66, 0x6D,
+    0x71, 0x74, 0x7B, 0x68, 0x6B, 0x72, 0x30, 0x33, 0x3A, 0x2B, 0x32, 0x3A,
+    0x31, 0x38, 0x40, 0x35, 0x3C, 0x44, 0x2F, 0x36, 0x3E, 0x3C, 0x46, 0x4F,
+    0x3A, 0x44, 0x4D, 0x74, 0x7E, 0x87, 0x83, 0x8D, 0x96, 0x83, 0x94, 0x9E,
+    0x7F, 0x90, 0x9A, 0x87, 0x98, 0xA2, 0x89, 0x9A, 0xA4, 0x85, 0x9B, 0xA8,
+    0x49, 0x5F, 0x6C, 0x52, 0x68, 0x75, 0x55, 0x6D, 0x71, 0x50, 0x68, 0x6C,
+    0x55, 0x6D, 0x71, 0x5D, 0x75, 0x79, 0x4F, 0x64, 0x69, 0x58, 0x6D, 0x72,
+    0x5B, 0x70, 0x75, 0x2E, 0x43, 0x48, 0x2C, 0x3F, 0x46, 0x2A, 0x3D, 0x44,
+    0x3B, 0x4E, 0x55, 0x33, 0x46, 0x4D, 0x40, 0x51, 0x5B, 0x3E, 0x4F, 0x59,
+    0x79, 0x8A, 0x94, 0x82, 0x93, 0x9D, 0x7D, 0x8B, 0x98, 0x8A, 0x98, 0xA5,
+    0x85, 0x93, 0xA0, 0x96, 0xA4, 0xB1, 0x92, 0x9B, 0xAC, 0x56, 0x5F, 0x70,
+    0x5E, 0x67, 0x78, 0x60, 0x6C, 0x7C, 0x62, 0x6E, 0x7E, 0x50, 0x5C, 0x6C,
+    0x5D, 0x69, 0x79, 0x62, 0x6E, 0x7E, 0x63, 0x6F, 0x7F, 0x6C, 0x78, 0x88,
+    0x36, 0x42, 0x52, 0x29, 0x37, 0x44, 0x36, 0x44, 0x51, 0x36, 0x44, 0x51,
+    0x42, 0x50, 0x5D, 0x38, 0x46, 0x53, 0x35, 0x43, 0x50, 0x78, 0x86, 0x93,
+    0x7B, 0x89, 0x96, 0x83, 0x91, 0x9E, 0x8B, 0x99, 0xA6, 0x8E, 0x9C, 0xA9,
+    0x8E, 0x9C, 0xA9, 0x96, 0xA4, 0xB1, 0x5B, 0x69, 0x76, 0x59, 0x67, 0x74,
+    0x58, 0x6F, 0x75, 0x5B, 0x72, 0x78, 0x5A, 0x71, 0x77, 0x61, 0x78, 0x7E,
+    0x63, 0x77, 0x80, 0x65, 0x79, 0x82, 0x71, 0x85, 0x8E, 0x2F, 0x43, 0x4C,
+    0x31, 0x44, 0x52, 0x2E, 0x41, 0x4F, 0x39, 0x4C, 0x5A, 0x3A, 0x4D, 0x5B,
+    0x3A, 0x4B, 0x5D, 0x4B, 0x5C, 0x6E, 0x83, 0x94, 0xA6, 0x89, 0x9A, 0xAC,
+    0x7E, 0x8E, 0xA7, 0x88, 0x98, 0xB1, 0x8B, 0x9B, 0xB4, 0x90, 0xA0, 0xB9,
+    0x8E, 0x9D, 0xBC, 0x5E, 0x6D, 0x8C, 0x59, 0x68, 0x87, 0x55, 0x68, 0x76,
+    0x59, 0x6C, 0x7A, 0x5C, 0x6F, 0x7D, 0x5D, 0x70, 0x7E, 0x6A, 0x7D, 0x8B,
+    0x6A, 0x7D, 0x8B, 0x60, 0x73, 0x81, 0x3B, 0x4E, 0x5C, 0x32, 0x43, 0x53,
+    0x38, 0x49, 0x59, 0x43, 0x54, 0x64, 0x3E, 0x4F, 0x5F, 0x3B, 0x4A, 0x5D,
+    0x50, 0x5F, 0x72, 0x7B, 0x8A, 0x9D, 0x8A, 0x99, 0xAC, 0x94, 0xA3, 0xB8,
+    0x8D, 0x9C, 0xB1, 0x8A, 0x99, 0xAE, 0xA3, 0xB2, 0xC7, 0x8D, 0x9D, 0xB4,
+    0x60, 0x70, 0x87, 0x51, 0x61, 0x78, 0x1C, 0x2E, 0x44, 0x23, 0x35, 0x4B,
+    0x36, 0x48, 0x5E, 0x2F, 0x41, 0x57, 0x31, 0x43, 0x59, 0x28, 0x3A, 0x50,
+    0x35, 0x47, 0x5D, 0x72, 0x84, 0x9A, 0x75, 0x86, 0x9A, 0x78, 0x89, 0x9D,
+    0x7B, 0x8C, 0xA0, 0x7C, 0x8D, 0xA1, 0x7E, 0x8F, 0xA1, 0x7E, 0x8F, 0xA1,
+    0x59, 0x6A, 0x7C, 0x47, 0x58, 0x6A, 0x44, 0x55, 0x65, 0x5A, 0x6B, 0x7B,
+    0x52, 0x63, 0x73, 0x5A, 0x6B, 0x7B, 0x58, 0x69, 0x79, 0x9D, 0xAE, 0xBE,
+    0xA1, 0xB2, 0xC2, 0x27, 0x3F, 0x57, 0x18, 0x30, 0x48, 0x1C, 0x34, 0x4C,
+    0x20, 0x38, 0x50, 0x37, 0x4D, 0x64, 0x31, 0x47, 0x5E, 0x32, 0x48, 0x5F,
+    0x7A, 0x90, 0xA7, 0x7C, 0x90, 0xA8, 0x7D, 0x91, 0xA9, 0x7B, 0x8F, 0xA7,
+    0x7F, 0x93, 0xAB, 0x84, 0x99, 0xAE, 0x89, 0x9E, 0xB3, 0x4F, 0x64, 0x79,
+    0x4F, 0x64, 0x79, 0x5E, 0x73, 0x86, 0x59, 0x6E, 0x81, 0x4E, 0x63, 0x76,
+    0x63, 0x78, 0x8B, 0x5A, 0x71, 0x81, 0xA6, 0xBD, 0xCD, 0xA0, 0xB7, 0xC7,
+    0x26, 0x45, 0x59, 0x26, 0x45, 0x59, 0x2B, 0x4A, 0x5E, 0x28, 0x47, 0x5B,
+    0x34, 0x50, 0x65, 0x37, 0x53, 0x68, 0x38, 0x54, 0x69, 0x6B, 0x87, 0x9C,
+    0x73, 0x8D, 0xA4, 0x78, 0x92, 0xA9, 0x7D, 0x97, 0xAE, 0x88, 0xA2, 0xB9,
+    0x88, 0xA2, 0xB9, 0x85, 0x9F, 0xB6, 0x40, 0x5A, 0x71, 0x4F, 0x69, 0x80,
+    0x4D, 0x67, 0x80, 0x52, 0x6C, 0x85, 0x57, 0x71, 0x8A, 0x62, 0x7C, 0x95,
+    0x53, 0x71, 0x89, 0xA6, 0xC4, 0xDC, 0x9F, 0xBD, 0xD5
+};
+/* Baseline, 4:4:4, a restart marker after every MCU (the coefficients of _test_jpeg_444) */
+static const uint8_t _test_jpeg_444_rst[925] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x03, 0x02, 0x02, 0x03, 0x02, 0x02, 0x03, 0x03, 0x03, 0x03, 0x04,
+    0x03, 0x03, 0x04, 0x05, 0x08, 0x05, 0x05, 0x04, 0x04, 0x05, 0x0A, 0x07,
+    0x07, 0x06, 0x08, 0x0C, 0x0A, 0x0C, 0x0C, 0x0B, 0x0A, 0x0B, 0x0B, 0x0D,
+    0x0E, 0x12, 0x10, 0x0D, 0x0E, 0x11, 0x0E, 0x0B, 0x0B, 0x10, 0x16, 0x10,
+    0x11, 0x13, 0x14, 0x15, 0x15, 0x15, 0x0C, 0x0F, 0x17, 0x18, 0x16, 0x14,
+    0x18, 0x12, 0x14, 0x15, 0x14, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x03, 0x04,
+    0x04, 0x05, 0x04, 0x05, 0x09, 0x05, 0x05, 0x09, 0x14, 0x0D, 0x0B, 0x0D,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x0D, 0x00, 0x17, 0x03,
+    0x01, 0x11, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x1F, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00,
+    0x00, 0x01, 0x7D, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+    0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24,
+    0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56,
+    0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3,
+    0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6,
+    0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9,
+    0xDA, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xC4, 0x00,
+    0x1F, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+    0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0xFF, 0xC4, 0x00, 0xB5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00,
+    0x01, 0x02, 0x77, 0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31,
+    0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15,
+    0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18,
+    0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55,
+    0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA,
+    0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4,
+    0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7,
+    0xD8, 0xD9, 0xDA, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
+    0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFF, 0xDD, 0x00,
+    0x04, 0x00, 0x01, 0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x11,
+    0x03, 0x11, 0x00, 0x3F, 0x00, 0xF9, 0x1F, 0xC2, 0x9F, 0x04, 0xB5, 0x4F,
+    0x0D, 0x5E, 0xDB, 0x6A, 0x97, 0x33, 0xDA, 0x7D, 0x9B, 0x4E, 0x75, 0xBB,
+    0x98, 0x43, 0x23, 0xE5, 0x95, 0x0E, 0xE6, 0xC0, 0x28, 0x01, 0x38, 0x53,
+    0x8C, 0x90, 0x33, 0x5D, 0xAE, 0x9B, 0x7A, 0xBF, 0xEB, 0xFA, 0xB1, 0xC8,
+    0xEA, 0x25, 0xAB, 0x3F, 0xFF, 0xD0, 0xF2, 0x1B, 0x5B, 0xEB, 0x0F, 0x88,
+    0x16, 0x2F, 0xA0, 0xE9, 0xD1, 0xDC, 0xC1, 0x71, 0x77, 0xB4, 0xC6, 0xF7,
+    0x28, 0xAB, 0x17, 0xCA, 0xC1, 0xCE, 0x48, 0x24, 0xE7, 0x6A, 0x7A, 0x1E,
+    0xBE, 0x95, 0xD8, 0xA9, 0x39, 0x23, 0x8A, 0x55, 0x9F, 0xD9, 0xD7, 0xFA,
+    0xFE, 0xBF, 0x5B, 0x1F, 0xFF, 0xD1, 0xE4, 0x7C, 0x1D, 0xE0, 0x49, 0xBE,
+    0x15, 0xDD, 0x0D, 0x57, 0x55, 0x68, 0x6E, 0x6D, 0x2E, 0x23, 0x36, 0xAA,
+    0x96, 0xA4, 0xBB, 0xEE, 0x38, 0x7C, 0xFC, 0xC1, 0x46, 0x3E, 0x43, 0xDF,
+    0xB8, 0xFC, 0x3B, 0x3D, 0x8D, 0xF5, 0xB7, 0xF5, 0xFA, 0x1C, 0x6E, 0x7E,
+    0xE3, 0xD7, 0x5F, 0xF8, 0x6F, 0xEB, 0xD0, 0xFF, 0xD2, 0xF0, 0x0F, 0x07,
+    0xF8, 0x8F, 0x55, 0xD7, 0x35, 0x2B, 0x3D, 0x32, 0xFA, 0xF3, 0xCE, 0xB4,
+    0xBB, 0x96, 0x38, 0x27, 0x8C, 0x44, 0x89, 0xBD, 0x19, 0xB6, 0x30, 0xCA,
+    0x80, 0x46, 0x41, 0x3C, 0x83, 0x9A, 0xFA, 0x97, 0x4F, 0x95, 0x2E, 0xBA,
+    0xA3, 0xE6, 0x27, 0x59, 0xC5, 0xBB, 0xAB, 0xFF, 0x00, 0x5F, 0xF0, 0x4F,
+    0xFF, 0xD3, 0xA7, 0x3F, 0x81, 0x34, 0x9F, 0x08, 0xE8, 0xB7, 0x1A, 0xBE,
+    0x93, 0x01, 0xB4, 0xD4, 0x6D, 0x02, 0x34, 0x53, 0x07, 0x67, 0xC6, 0xF6,
+    0x55, 0x6F, 0x95, 0x89, 0x1C, 0x86, 0x61, 0xC8, 0x3D, 0x6B, 0xE9, 0x25,
+    0x08, 0xDE, 0xC9, 0x1F, 0x38, 0xAA, 0x5D, 0xDE, 0xDB, 0xFE, 0x97, 0x3F,
+    0xFF, 0xD4, 0xD3, 0xF8, 0x5A, 0xF2, 0x7C, 0x43, 0xD5, 0x17, 0x4F, 0xD7,
+    0x9C, 0x5E, 0xD9, 0x88, 0x1A, 0xE1, 0x63, 0x08, 0xB1, 0x91, 0x20, 0x20,
+    0x6E, 0xCA, 0x05, 0x27, 0x86, 0x6E, 0x3D, 0xEB, 0xE9, 0xE5, 0x05, 0x4D,
+    0x36, 0xB7, 0xFF, 0x00, 0x82, 0x8F, 0x9F, 0x8D, 0x46, 0x9D, 0x8F, 0xFF,
+    0xD9
+};
+/* Progressive with libjpeg's default scan script, 4:2:0 (the coefficients of _test_jpeg_420) */
+static const uint8_t _test_jpeg_420_prog[738] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43,
+    0x00, 0x03, 0x02, 0x02, 0x03, 0x02, 0x02, 0x03, 0x03, 0x03, 0x03, 0x04,
+    0x03, 0x03, 0x04, 0x05, 0x08, 0x05, 0x05, 0x04, 0x04, 0x05, 0x0A, 0x07,
+    0x07, 0x06, 0x08, 0x0C, 0x0A, 0x0C, 0x0C, 0x0B, 0x0A, 0x0B, 0x0B, 0x0D,
+    0x0E, 0x12, 0x10, 0x0D, 0x0E, 0x11, 0x0E, 0x0B, 0x0B, 0x10, 0x16, 0x10,
+    0x11, 0x13, 0x14, 0x15, 0x15, 0x15, 0x0C, 0x0F, 0x17, 0x18, 0x16, 0x14,
+    0x18, 0x12, 0x14, 0x15, 0x14, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x03, 0x04,
+    0x04, 0x05, 0x04, 0x05, 0x09, 0x05, 0x05, 0x09, 0x14, 0x0D, 0x0B, 0x0D,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+    0x14, 0x14, 0xFF, 0xC2, 0x00, 0x11, 0x08, 0x00, 0x0D, 0x00, 0x17, 0x03,
+    0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF, 0xC4, 0x00,
+    0x18, 0x00, 0x00, 0x02, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x04, 0x05, 0x07, 0xFF,
+    0xC4, 0x00, 0x16, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x02, 0xFF,
+    0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x10, 0x03, 0x10, 0x00, 0x00,
+    0x01, 0xC8, 0xDB, 0x20, 0x3B, 0xB4, 0x95, 0xE3, 0x11, 0x67, 0xFF, 0xC4,
+    0x00, 0x19, 0x10, 0x01, 0x01, 0x00, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x01, 0x02, 0x05,
+    0x11, 0xFF, 0xDA, 0x00, 0x08, 0x01, 0x01, 0x00, 0x01, 0x05, 0x02, 0x9F,
+    0x8A, 0xB3, 0x6F, 0x84, 0xD2, 0xF3, 0x92, 0x1C, 0xF2, 0xF3, 0x1D, 0x0A,
+    0xCA, 0x90, 0x8C, 0x61, 0xCD, 0xF6, 0xF5, 0xFF, 0xC4, 0x00, 0x15, 0x11,
+    0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x13, 0xFF, 0xDA, 0x00, 0x08, 0x01, 0x03,
+    0x01, 0x01, 0x3F, 0x01, 0xAA, 0xAF, 0xFF, 0xC4, 0x00, 0x16, 0x11, 0x01,
+    0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x13, 0xFF, 0xDA, 0x00, 0x08, 0x01, 0x02,
+    0x01, 0x01, 0x3F, 0x01, 0xC8, 0xB3, 0x0B, 0xFF, 0xC4, 0x00, 0x1F, 0x10,
+    0x00, 0x02, 0x01, 0x04, 0x02, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x00, 0x11, 0x12, 0x31, 0x13,
+    0x22, 0x14, 0x21, 0x61, 0xFF, 0xDA, 0x00, 0x08, 0x01, 0x01, 0x00, 0x06,
+    0x3F, 0x02, 0x13, 0x12, 0xA4, 0x47, 0xD8, 0xDB, 0xE5, 0x78, 0xE8, 0xAC,
+    0x19, 0xB5, 0x96, 0xAB, 0x96, 0x5B, 0x10, 0x46, 0x3D, 0x29, 0x23, 0x77,
+    0xBA, 0xB1, 0xC4, 0xFA, 0x14, 0x66, 0x89, 0x31, 0x91, 0x74, 0x77, 0x5C,
+    0x73, 0x9C, 0xD6, 0xD9, 0x5A, 0xD6, 0xAF, 0xFF, 0xC4, 0x00, 0x1C, 0x10,
+    0x00, 0x02, 0x02, 0x03, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x11, 0x00, 0x21, 0x31, 0x41, 0x51, 0x61,
+    0xC1, 0xFF, 0xDA, 0x00, 0x08, 0x01, 0x01, 0x00, 0x01, 0x3F, 0x21, 0x28,
+    0xAA, 0x0E, 0x16, 0xAD, 0xCC, 0xCA, 0xD3, 0x66, 0x15, 0x4B, 0xF8, 0x62,
+    0x97, 0x5C, 0xD8, 0xBC, 0xED, 0x72, 0x26, 0x26, 0x81, 0x4C, 0x1C, 0xDA,
+    0x80, 0x94, 0x38, 0xB4, 0xA3, 0x20, 0x60, 0xF8, 0x60, 0xD3, 0xD9, 0x82,
+    0x2C, 0x10, 0xD2, 0xE9, 0x9F, 0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00,
+    0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x10, 0x80, 0xDF, 0xFF, 0xC4, 0x00,
+    0x17, 0x11, 0x00, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x11, 0x21, 0xFF, 0xDA,
+    0x00, 0x08, 0x01, 0x03, 0x01, 0x01, 0x3F, 0x10, 0x58, 0x4E, 0x96, 0xB2,
+    0x9F, 0xFF, 0xC4, 0x00, 0x17, 0x11, 0x00, 0x03, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0x31, 0x41, 0xFF, 0xDA, 0x00, 0x08, 0x01, 0x02, 0x01, 0x01, 0x3F, 0x10,
+    0x93, 0x1E, 0x03, 0xFF, 0xC4, 0x00, 0x1B, 0x10, 0x01, 0x00, 0x03, 0x01,
+    0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x11, 0x21, 0x31, 0x00, 0x41, 0x61, 0x71, 0xFF, 0xDA, 0x00, 0x08,
+    0x01, 0x01, 0x00, 0x01, 0x3F, 0x10, 0x25, 0xE5, 0x22, 0x49, 0x20, 0x90,
+    0x28, 0x20, 0xB3, 0xEC, 0x72, 0xF8, 0x06, 0x14, 0xB7, 0x94, 0x57, 0x30,
+    0x37, 0x9F, 0xC0, 0x51, 0x12, 0x51, 0x24, 0x14, 0x8D, 0x9E, 0x52, 0xB7,
+    0x84, 0x98, 0xD6, 0xD3, 0x10, 0x80, 0x49, 0x14, 0xA6, 0x7D, 0xF0, 0x1B,
+    0x4B, 0x79, 0x1B, 0x53, 0x52, 0xC6, 0x39, 0xC0, 0x77, 0xA0, 0xC0, 0xA9,
+    0x4D, 0x68, 0xC5, 0xF7, 0xFF, 0xD9
+};
+
+#endif /* TEST_JPEG_FIXTURES_H */
@@ -0,0 +1,2759 @@
+/**
+ * @file test.c
+ * @author Neil Kingdom
+ * @since 16-10-2026
+ * @version 1.0
+ * @brief Unit tests for libimc, run with the check framework (make test).
+ */
+
+/* Required for mkdtemp() */
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
+#include <check.h>
+#include <zlib.h>
+
+#include "png_encoder.h"
+#include "png_optimizer.h"
+#include "quantize.h"
+#include "imc_deflate.h"
+#include "jfif_parser.h"
+#include "imc_strip.h"
+#include "imc_scan.h"
+
+#include "jpeg_fixtures.h"
+
+/**
+ * @brief Deterministic pseudo-random numbers, so that every run sees the same images.
+ * @since 16-10-2026
+ * @param[in,out] seed The generator state
+ * @returns The next 16 bit pseudo-random number
+ */
+static uint32_t _test_rand(uint32_t *seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 16;
+}
+
+/**
+ * @brief Fills an RGBA pixmap with a flat background and randomly placed flat rectangles.
+ * @since 16-10-2026
+ * @param[in] width Width of the pixmap (in pixels)
+ * @param[in] height Height of the pixmap (in pixels)
+ * @param[in] n_rects Number of rectangles to draw
+ * @param[in] seed Seed of the rectangles' placement and colors
+ * @returns The pixmap, whose data must be freed by the caller
+ */
+static Pixmap_t _test_rects(
+    const size_t width,
+    const size_t height,
+    const size_t n_rects,
+    uint32_t seed
+) {
+    Pixmap_t pixmap = { width, height, 0, 4, 8, NULL };
+    size_t i, x, y;
+
+    pixmap.data = malloc(width * height * 4);
+    ck_assert_ptr_nonnull(pixmap.data);
+
+    for (i = 0; i < width * height; ++i) {
+        pixmap.data[4 * i + 0] = 40;
+        pixmap.data[4 * i + 1] = 80;
+        pixmap.data[4 * i + 2] = 120;
+        pixmap.data[4 * i + 3] = 255;
+    }
+
+    for (i = 0; i < n_rects; ++i) {
+        size_t x0 = _test_rand(&seed) % width;
+        size_t y0 = _test_rand(&seed) % height;
+        size_t w  = _test_rand(&seed) % (width / 4) + 1;
+        size_t h  = _test_rand(&seed) % (height / 4) + 1;
+        uint8_t col[4];
+
+        col[0] = (uint8_t)_test_rand(&seed);
+        col[1] = (uint8_t)_test_rand(&seed);
+        col[2] = (uint8_t)_test_rand(&seed);
+        col[3] = 255;
+
+        for (y = y0; y < y0 + h && y < height; ++y) {
+            for (x = x0; x < x0 + w && x < width; ++x) {
+                memcpy(pixmap.data + 4 * (y * width + x), col, 4);
+            }
+        }
+    }
+
+    return pixmap;
+}
+
+/**
+ * @brief Generates an RGB checkerboard of black and white squares.
+ * @since 16-10-2026
+ * @param[in] width Width of the pixmap (in pixels)
+ * @param[in] height Height of the pixmap (in pixels)
+ * @param[in] square Side of each square (in pixels)
+ * @returns The pixmap, whose data must be freed by the caller
+ */
+static Pixmap_t _test_checker(const size_t width, const size_t height, const size_t square) {
+    Pixmap_t pixmap = { width, height, 0, 3, 8, NULL };
+    size_t x, y;
+
+    pixmap.data = malloc(width * height * 3);
+    ck_assert_ptr_nonnull(pixmap.data);
+
+    for (y = 0; y < height; ++y) {
+        for (x = 0; x < width; ++x) {
+            memset(pixmap.data + 3 * (y * width + x), (((x / square) + (y / square)) & 1) ? 255 : 0, 3);
+        }
+    }
+
+    return pixmap;
+}
+
+/**
+ * @brief Encodes a pixmap to memory and returns the size of the PNG.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap to encode
+ * @param[in] opts The encoder options
+ * @returns The size of the PNG (in bytes)
+ */
+static size_t _test_png_size(const Pixmap_t* const pixmap, const PngEncOpts_t* const opts) {
+    uint8_t *data = NULL;
+    size_t size = 0;
+
+    ck_assert_int_eq(imc_png_write_mem(pixmap, &data, &size, opts), IMC_EOK);
+    free(data);
+
+    return size;
+}
+
+/**
+ * @brief Compresses a buffer with the in-tree compressor, fed in pieces, and checks that zlib
+ * inflates it back to the original.
+ * @since 16-10-2026
+ * @param[in] in The data to compress
+ * @param[in] len Length of in (in bytes)
+ * @param[in] level Compression level
+ * @param[in] step Length of each piece passed to imc_deflate_write() (in bytes)
+ */
+static void _test_deflate_round_trip(
+    const uint8_t *in,
+    const size_t len,
+    const int level,
+    const size_t step
+) {
+    DeflateLz_t lz;
+    z_stream strm;
+    uint8_t *out, *dec;
+    size_t i, n, n_out = 0;
+
+    out = malloc(imc_deflate_bound(len) + imc_deflate_bound(0) + (len / step + 1) * imc_deflate_bound(step));
+    dec = malloc(len + 1);
+    ck_assert_ptr_nonnull(out);
+    ck_assert_ptr_nonnull(dec);
+    ck_assert_int_eq(imc_deflate_init(&lz, level, 4), IMC_EOK);
+
+    for (i = 0; i < len; i += step) {
+        n = (len - i < step) ? len - i : step;
+        n_out += imc_deflate_write(&lz, in + i, n, out + n_out);
+    }
+    n_out += imc_deflate_end(&lz, out + n_out, true);
+    imc_deflate_destroy(&lz);
+
+    memset(&strm, 0, sizeof(strm));
+    ck_assert_int_eq(inflateInit2(&strm, -MAX_WBITS), Z_OK);
+    strm.next_in   = out;
+    strm.avail_in  = (uInt)n_out;
+    strm.next_out  = dec;
+    strm.avail_out = (uInt)(len + 1);
+    ck_assert_int_eq(inflate(&strm, Z_FINISH), Z_STREAM_END);
+    ck_assert_uint_eq(strm.total_out, len);
+    ck_assert_mem_eq(dec, in, len);
+    inflateEnd(&strm);
+
+    free(out);
+    free(dec);
+}
+
+START_TEST(test_deflate_round_trip) {
+    const size_t len = 300000;
+    uint8_t *in = malloc(len);
+    uint32_t seed = 1;
+    size_t i;
+    int level;
+
+    ck_assert_ptr_nonnull(in);
+
+    /* Runs of noise between runs of short repeating patterns */
+    for (i = 0; i < len; ++i) {
+        in[i] = ((i / 5000) % 3 == 0) ? (uint8_t)_test_rand(&seed) : (uint8_t)(((i / 37) % 7) * 9);
+    }
+
+    for (level = DEFLATE_MIN_LEVEL; level <= DEFLATE_MAX_LEVEL; ++level) {
+        _test_deflate_round_trip(in, len, level, 8193);
+        _test_deflate_round_trip(in, len, level, len);
+    }
+
+    free(in);
+}
+END_TEST
+
+START_TEST(test_deflate_levels) {
+    Pixmap_t pixmaps[2];
+    PngEncOpts_t opts = imc_png_default_opts();
+    const uint8_t filters[2] = { ADAPTIVE, NONE };
+    size_t i, in_tree_size, zlib_size;
+    int level;
+
+    pixmaps[0] = _test_rects(256, 256, 40, 1);
+    pixmaps[1] = _test_checker(640, 480, 8);
+
+    /* Each level is at least as small as zlib's at the same level */
+    for (i = 0; i < 2; ++i) {
+        opts.filter = filters[i];
+        for (level = 1; level <= 9; ++level) {
+            opts.level = level;
+            opts.in_tree = false;
+            zlib_size = _test_png_size(&pixmaps[i], &opts);
+            opts.in_tree = true;
+            in_tree_size = _test_png_size(&pixmaps[i], &opts);
+            ck_assert_uint_le(in_tree_size, zlib_size);
+        }
+        free(pixmaps[i].data);
+    }
+}
+END_TEST
+
+START_TEST(test_deflate_optimal_levels) {
+    Pixmap_t pixmap = _test_rects(256, 256, 40, 1);
+    PngEncOpts_t opts = imc_png_default_opts();
+    size_t size[DEFLATE_MAX_LEVEL + 1], zlib_size;
+    int level;
+
+    opts.level = 9;
+    zlib_size = _test_png_size(&pixmap, &opts);
+
+    /* Levels 1-9 trade size for speed in steps (as zlib's do) and need not shrink monotonically */
+    opts.in_tree = true;
+    for (level = 9; level <= DEFLATE_MAX_LEVEL; ++level) {
+        opts.level = level;
+        size[level] = _test_png_size(&pixmap, &opts);
+    }
+
+    for (level = 9; level < DEFLATE_MAX_LEVEL; ++level) {
+        ck_assert_uint_le(size[level + 1], size[level]);
+    }
+    ck_assert_uint_le(size[DEFLATE_MAX_LEVEL], zlib_size);
+
+    free(pixmap.data);
+}
+END_TEST
+
+/**
+ * @brief Computes the quantized forward DCT of an 8x8 block of samples in floating point, which
+ * gives coefficients like those of a valid JPEG.
+ * @since 16-10-2026
+ * @param[in] samples The 64 samples in row order
+ * @param[in] qt The quantization table in natural order
+ * @param[out] coefs The 64 quantized coefficients in natural order
+ */
+static void _test_fdct(const uint8_t* const samples, const uint16_t* const qt, int16_t *coefs) {
+    const double pi = 3.14159265358979323846;
+    double sum;
+    int u, v, x, y;
+
+    for (v = 0; v < 8; ++v) {
+        for (u = 0; u < 8; ++u) {
+            sum = 0.0;
+            for (y = 0; y < 8; ++y) {
+                for (x = 0; x < 8; ++x) {
+                    sum += (samples[8 * y + x] - 128.0) *
+                        cos((2 * x + 1) * u * pi / 16.0) * cos((2 * y + 1) * v * pi / 16.0);
+                }
+            }
+            sum *= ((u == 0) ? sqrt(0.5) : 1.0) * ((v == 0) ? sqrt(0.5) : 1.0) / 4.0;
+            coefs[8 * v + u] = (int16_t)lround(sum / qt[8 * v + u]);
+        }
+    }
+}
+
+/**
+ * @brief Checks that a SIMD inverse DCT kernel matches the scalar one exactly.
+ * @since 16-10-2026
+ * @param[in] kernel The SIMD kernel to compare
+ */
+static void _test_idct_kernel(const JpegIdct_t kernel) {
+    idct_func scalar = imc_jpeg_idct_kernel(JPEG_IDCT_SCALAR);
+    idct_func simd = imc_jpeg_idct_kernel(kernel);
+    uint8_t samples[64], expect[64], actual[64];
+    int16_t coefs[64];
+    uint16_t qt[64];
+    uint32_t seed = 1;
+    int i, n, dc, q;
+
+    ck_assert_ptr_nonnull(scalar);
+    if (simd == NULL) {
+        fprintf(stderr, "Skipping IDCT kernel %d, which the CPU does not support\n", (int)kernel);
+        return;
+    }
+
+    /* Random samples (the worst case for high frequencies) under tables from all ones to coarse */
+    for (n = 0; n < 4000; ++n) {
+        for (i = 0; i < 64; ++i) {
+            samples[i] = (uint8_t)_test_rand(&seed);
+            qt[i] = (n % 4 == 0) ? 1 : (uint16_t)(_test_rand(&seed) % (n % 4 * 40) + 1);
+        }
+        _test_fdct(samples, qt, coefs);
+
+        scalar(coefs, qt, expect, 8);
+        simd(coefs, qt, actual, 8);
+        ck_assert_mem_eq(actual, expect, sizeof(expect));
+    }
+
+    /* Blocks with nothing but a DC coefficient, over its whole range */
+    memset(coefs, 0, sizeof(coefs));
+    for (q = 1; q <= 16; q *= 2) {
+        for (i = 0; i < 64; ++i) {
+            qt[i] = (uint16_t)q;
+        }
+        for (dc = -1024 / q; dc <= 1023 / q; ++dc) {
+            coefs[0] = (int16_t)dc;
+            scalar(coefs, qt, expect, 8);
+            simd(coefs, qt, actual, 8);
+            ck_assert_mem_eq(actual, expect, sizeof(expect));
+        }
+    }
+}
+
+START_TEST(test_jpeg_idct_sse2) {
+    _test_idct_kernel(JPEG_IDCT_SSE2);
+}
+END_TEST
+
+START_TEST(test_jpeg_idct_avx2) {
+    _test_idct_kernel(JPEG_IDCT_AVX2);
+}
+END_TEST
+
+typedef struct {
+    const uint8_t *jpeg;    /* The JPEG file */
+    size_t         size;    /* The size of jpeg (in bytes) */
+    const uint8_t *rgb;     /* The pixels libjpeg decodes it to */
+} TestJpegRef_t;
+
+/* The libjpeg fixtures at each chroma sampling */
+static const TestJpegRef_t _test_jpeg_refs[3] = {
+    { _test_jpeg_444, sizeof(_test_jpeg_444), _test_jpeg_444_rgb },
+    { _test_jpeg_420, sizeof(_test_jpeg_420), _test_jpeg_420_rgb },
+    { _test_jpeg_411, sizeof(_test_jpeg_411), _test_jpeg_411_rgb }
+};
+
+START_TEST(test_jpeg_decode) {
+    JpegDecOpts_t opts = imc_jpeg_default_opts();
+    Pixmap_t *pixmap;
+    size_t i;
+    int simd;
+
+    /* Pixels match libjpeg's exactly with the scalar and SIMD kernels */
+    for (i = 0; i < sizeof(_test_jpeg_refs) / sizeof(_test_jpeg_refs[0]); ++i) {
+        for (simd = 0; simd <= 1; ++simd) {
+            opts.simd = simd;
+            pixmap = imc_jpeg_decode_mem(_test_jpeg_refs[i].jpeg, _test_jpeg_refs[i].size, &opts);
+            ck_assert_ptr_nonnull(pixmap);
+            ck_assert_uint_eq(pixmap->width, _TEST_JPEG_WIDTH);
+            ck_assert_uint_eq(pixmap->height, _TEST_JPEG_HEIGHT);
+            ck_assert_uint_eq(pixmap->n_channels, 3);
+            ck_assert_uint_eq(pixmap->bit_depth, 8);
+            ck_assert_mem_eq(pixmap->data, _test_jpeg_refs[i].rgb, _TEST_JPEG_WIDTH * _TEST_JPEG_HEIGHT * 3);
+            imc_pixmap_destroy(pixmap);
+        }
+    }
+
+    /* A truncated file is rejected */
+    ck_assert_ptr_null(imc_jpeg_decode_mem(_test_jpeg_444, 100, &opts));
+}
+END_TEST
+
+/**
+ * @brief Checks that a reduced decode is close to the average of each __block__ x __block__ block
+ * of the full decode, with blocks cut short at the right and bottom edges.
+ * @since 16-10-2026
+ * @param[in] full The full-size RGB decode
+ * @param[in] reduced The reduced RGB decode, one pixel per block
+ * @param[in] block The side of a block (in pixels)
+ * @param[in] max_mean The largest mean absolute difference allowed
+ * @param[in] max_diff The largest absolute difference allowed in any sample
+ */
+static void _test_jpeg_box_check(
+    const Pixmap_t* const full,
+    const Pixmap_t* const reduced,
+    const size_t block,
+    const double max_mean,
+    const int max_diff
+) {
+    size_t x, y, bx, by, n;
+    int c, sum, diff, total = 0;
+
+    ck_assert_uint_eq(reduced->width, (full->width + block - 1) / block);
+    ck_assert_uint_eq(reduced->height, (full->height + block - 1) / block);
+    ck_assert_uint_eq(reduced->n_channels, 3);
+
+    for (y = 0; y < reduced->height; ++y) {
+        for (x = 0; x < reduced->width; ++x) {
+            for (c = 0; c < 3; ++c) {
+                sum = 0;
+                n = 0;
+                for (by = y * block; by < (y + 1) * block && by < full->height; ++by) {
+                    for (bx = x * block; bx < (x + 1) * block && bx < full->width; ++bx) {
+                        sum += full->data[(by * full->width + bx) * 3 + c];
+                        ++n;
+                    }
+                }
+                diff = abs(reduced->data[(y * reduced->width + x) * 3 + c] - (int)((sum + n / 2) / n));
+                ck_assert_int_le(diff, max_diff);
+                total += diff;
+            }
+        }
+    }
+    ck_assert(total <= max_mean * reduced->width * reduced->height * 3);
+}
+
+START_TEST(test_jpeg_scaled) {
+    JpegDecOpts_t opts = imc_jpeg_default_opts();
+    Pixmap_t *full, *scaled, *simd;
+    size_t i;
+    uint8_t denom;
+
+    /* Every scale keeps to the box average of the full decode, rounding its size up */
+    for (i = 0; i < sizeof(_test_jpeg_refs) / sizeof(_test_jpeg_refs[0]); ++i) {
+        opts.scale_denom = 1;
+        full = imc_jpeg_decode_mem(_test_jpeg_refs[i].jpeg, _test_jpeg_refs[i].size, &opts);
+        ck_assert_ptr_nonnull(full);
+
+        for (denom = 2; denom <= 8; denom *= 2) {
+            opts.scale_denom = denom;
+            opts.simd = false;
+            scaled = imc_jpeg_decode_mem(_test_jpeg_refs[i].jpeg, _test_jpeg_refs[i].size, &opts);
+            ck_assert_ptr_nonnull(scaled);
+            _test_jpeg_box_check(full, scaled, denom, 4.0, 16);
+
+            opts.simd = true;
+            simd = imc_jpeg_decode_mem(_test_jpeg_refs[i].jpeg, _test_jpeg_refs[i].size, &opts);
+            ck_assert_ptr_nonnull(simd);
+            ck_assert_mem_eq(simd->data, scaled->data, scaled->width * scaled->height * 3);
+
+            imc_pixmap_destroy(simd);
+            imc_pixmap_destroy(scaled);
+        }
+        imc_pixmap_destroy(full);
+    }
+
+    /* Other denominators are rejected */
+    opts.scale_denom = 3;
+    ck_assert_ptr_null(imc_jpeg_decode_mem(_test_jpeg_444, sizeof(_test_jpeg_444), &opts));
+}
+END_TEST
+
+START_TEST(test_jpeg_restart) {
+    static const size_t n_threads[4] = { 1, 2, 4, 0 };
+    JpegDecOpts_t opts = imc_jpeg_default_opts();
+    Pixmap_t *pixmap, *serial;
+    size_t i;
+
+    /* Restart markers change nothing but the entropy coding, on any number of threads */
+    for (i = 0; i < sizeof(n_threads) / sizeof(n_threads[0]); ++i) {
+        opts.n_threads = n_threads[i];
+        opts.scale_denom = 1;
+        pixmap = imc_jpeg_decode_mem(_test_jpeg_444_rst, sizeof(_test_jpeg_444_rst), &opts);
+        ck_assert_ptr_nonnull(pixmap);
+        ck_assert_uint_eq(pixmap->width, _TEST_JPEG_WIDTH);
+        ck_assert_uint_eq(pixmap->height, _TEST_JPEG_HEIGHT);
+        ck_assert_mem_eq(pixmap->data, _test_jpeg_444_rgb, _TEST_JPEG_WIDTH * _TEST_JPEG_HEIGHT * 3);
+        imc_pixmap_destroy(pixmap);
+
+        /* And likewise for a scaled decode */
+        opts.scale_denom = 2;
+        pixmap = imc_jpeg_decode_mem(_test_jpeg_444_rst, sizeof(_test_jpeg_444_rst), &opts);
+        serial = imc_jpeg_decode_mem(_test_jpeg_444, sizeof(_test_jpeg_444), &opts);
+        ck_assert_ptr_nonnull(pixmap);
+        ck_assert_ptr_nonnull(serial);
+        ck_assert_uint_eq(pixmap->width, serial->width);
+        ck_assert_uint_eq(pixmap->height, serial->height);
+        ck_assert_mem_eq(pixmap->data, serial->data, serial->width * serial->height * 3);
+        imc_pixmap_destroy(serial);
+        imc_pixmap_destroy(pixmap);
+    }
+}
+END_TEST
+
+START_TEST(test_jpeg_progressive) {
+    JpegDecOpts_t opts = imc_jpeg_default_opts();
+    Pixmap_t *pixmap, *baseline, *dc;
+    int simd;
+
+    /* Once every scan is in, the pixels are those of the baseline file */
+    for (simd = 0; simd <= 1; ++simd) {
+        opts.simd = simd;
+        opts.fancy_upsampling = true;
+        pixmap = imc_jpeg_decode_mem(_test_jpeg_420_prog, sizeof(_test_jpeg_420_prog), &opts);
+        ck_assert_ptr_nonnull(pixmap);
+        ck_assert_uint_eq(pixmap->width, _TEST_JPEG_WIDTH);
+        ck_assert_uint_eq(pixmap->height, _TEST_JPEG_HEIGHT);
+        ck_assert_mem_eq(pixmap->data, _test_jpeg_420_rgb, _TEST_JPEG_WIDTH * _TEST_JPEG_HEIGHT * 3);
+        imc_pixmap_destroy(pixmap);
+
+        opts.fancy_upsampling = false;
+        pixmap = imc_jpeg_decode_mem(_test_jpeg_420_prog, sizeof(_test_jpeg_420_prog), &opts);
+        baseline = imc_jpeg_decode_mem(_test_jpeg_420, sizeof(_test_jpeg_420), &opts);
+        ck_assert_ptr_nonnull(pixmap);
+        ck_assert_ptr_nonnull(baseline);
+        ck_assert_mem_eq(pixmap->data, baseline->data, _TEST_JPEG_WIDTH * _TEST_JPEG_HEIGHT * 3);
+        imc_pixmap_destroy(baseline);
+        imc_pixmap_destroy(pixmap);
+    }
+    opts = imc_jpeg_default_opts();
+
+    /* A preview is full size, but holds no more than the DC coefficients */
+    opts.dc_only = true;
+    dc = imc_jpeg_decode_mem(_test_jpeg_420, sizeof(_test_jpeg_420), &opts);
+    ck_assert_ptr_nonnull(dc);
+    opts.dc_only = false;
+    opts.preview = true;
+    pixmap = imc_jpeg_decode_mem(_test_jpeg_420_prog, sizeof(_test_jpeg_420_prog), &opts);
+    ck_assert_ptr_nonnull(pixmap);
+    ck_assert_uint_eq(pixmap->width, _TEST_JPEG_WIDTH);
+    ck_assert_uint_eq(pixmap->height, _TEST_JPEG_HEIGHT);
+    ck_assert_mem_ne(pixmap->data, _test_jpeg_420_rgb, _TEST_JPEG_WIDTH * _TEST_JPEG_HEIGHT * 3);
+    _test_jpeg_box_check(pixmap, dc, 8, 0.5, 1);
+    imc_pixmap_destroy(pixmap);
+    imc_pixmap_destroy(dc);
+
+    /* A baseline file has nothing to preview, so it decodes in full */
+    pixmap = imc_jpeg_decode_mem(_test_jpeg_420, sizeof(_test_jpeg_420), &opts);
+    ck_assert_ptr_nonnull(pixmap);
+    ck_assert_mem_eq(pixmap->data, _test_jpeg_420_rgb, _TEST_JPEG_WIDTH * _TEST_JPEG_HEIGHT * 3);
+    imc_pixmap_destroy(pixmap);
+}
+END_TEST
+
+START_TEST(test_jpeg_dc_only) {
+    JpegDecOpts_t opts = imc_jpeg_default_opts();
+    Pixmap_t *full, *dc, *other;
+    size_t i;
+
+    /* One pixel per block, near the block's average in the full decode, whatever the scale asked for */
+    for (i = 0; i < sizeof(_test_jpeg_refs) / sizeof(_test_jpeg_refs[0]); ++i) {
+        opts.dc_only = false;
+        opts.scale_denom = 1;
+        full = imc_jpeg_decode_mem(_test_jpeg_refs[i].jpeg, _test_jpeg_refs[i].size, &opts);
+        ck_assert_ptr_nonnull(full);
+
+        opts.dc_only = true;
+        dc = imc_jpeg_decode_mem(_test_jpeg_refs[i].jpeg, _test_jpeg_refs[i].size, &opts);
+        ck_assert_ptr_nonnull(dc);
+        _test_jpeg_box_check(full, dc, 8, 6.0, 16);
+
+        opts.scale_denom = 2;
+        other = imc_jpeg_decode_mem(_test_jpeg_refs[i].jpeg, _test_jpeg_refs[i].size, &opts);
+        ck_assert_ptr_nonnull(other);
+        ck_assert_uint_eq(other->width, dc->width);
+        ck_assert_uint_eq(other->height, dc->height);
+        ck_assert_mem_eq(other->data, dc->data, dc->width * dc->height * 3);
+
+        imc_pixmap_destroy(other);
+        imc_pixmap_destroy(dc);
+        imc_pixmap_destroy(full);
+    }
+
+    /* The DC coefficients of the restart and progressive files are those of their baseline files */
+    opts.scale_denom = 1;
+    opts.n_threads = 4;
+    dc = imc_jpeg_decode_mem(_test_jpeg_444, sizeof(_test_jpeg_444), &opts);
+    other = imc_jpeg_decode_mem(_test_jpeg_444_rst, sizeof(_test_jpeg_444_rst), &opts);
+    ck_assert_ptr_nonnull(dc);
+    ck_assert_ptr_nonnull(other);
+    ck_assert_mem_eq(other->data, dc->data, dc->width * dc->height * 3);
+    imc_pixmap_destroy(other);
+    imc_pixmap_destroy(dc);
+
+    dc = imc_jpeg_decode_mem(_test_jpeg_420, sizeof(_test_jpeg_420), &opts);
+    other = imc_jpeg_decode_mem(_test_jpeg_420_prog, sizeof(_test_jpeg_420_prog), &opts);
+    ck_assert_ptr_nonnull(dc);
+    ck_assert_ptr_nonnull(other);
+    ck_assert_mem_eq(other->data, dc->data, dc->width * dc->height * 3);
+    imc_pixmap_destroy(other);
+    imc_pixmap_destroy(dc);
+}
+END_TEST
+
+typedef struct {
+    const Pixmap_t *whole;      /* The image decoded whole */
+    size_t          next_y;     /* Row the next band must start at */
+    size_t          n_bands;    /* Number of bands received */
+    size_t          stop_after; /* Number of bands after which the sink stops the decode (0 never) */
+} TestBands_t;
+
+/**
+ * @brief jpeg_band_func which checks that each band continues the image where the last one ended
+ * and matches the rows of the whole decode.
+ * @since 16-10-2026
+ * @param[in,out] ctx The TestBands_t
+ * @param[in] band The band of rows
+ * @param[in] y The row of the image the band starts at
+ * @returns IMC_EOK, or IMC_EFAULT once TestBands_t.stop_after bands have been received
+ */
+static ImcError_t _test_jpeg_band(void *ctx, const Pixmap_t* const band, const size_t y) {
+    TestBands_t *bands = (TestBands_t*)ctx;
+    const Pixmap_t *whole = bands->whole;
+    const size_t row_size = whole->width * whole->n_channels;
+
+    ck_assert_uint_eq(y, bands->next_y);
+    ck_assert_uint_eq(band->width, whole->width);
+    ck_assert_uint_eq(band->n_channels, whole->n_channels);
+    ck_assert_uint_gt(band->height, 0);
+    ck_assert_uint_le(y + band->height, whole->height);
+    ck_assert_mem_eq(band->data, whole->data + y * row_size, band->height * row_size);
+
+    bands->next_y += band->height;
+    ++bands->n_bands;
+
+    return (bands->n_bands == bands->stop_after) ? IMC_EFAULT : IMC_EOK;
+}
+
+/**
+ * @brief Decodes a JPEG a band at a time and checks that the bands reassemble into the whole decode.
+ * @since 16-10-2026
+ * @param[in] data The JPEG file
+ * @param[in] size The size of __data__ (in bytes)
+ * @param[in] opts The decoding options
+ * @returns The number of bands the image was streamed in
+ */
+static size_t _test_jpeg_stream(const uint8_t* const data, const size_t size, const JpegDecOpts_t* const opts) {
+    TestBands_t bands = { 0 };
+    JpegBandSink_t sink = { _test_jpeg_band, NULL };
+    Pixmap_t *whole = imc_jpeg_decode_mem(data, size, opts);
+
+    ck_assert_ptr_nonnull(whole);
+    bands.whole = whole;
+    sink.ctx = &bands;
+    ck_assert_int_eq(imc_jpeg_decode_stream_mem(data, size, &sink, opts), IMC_EOK);
+    ck_assert_uint_eq(bands.next_y, whole->height);
+    imc_pixmap_destroy(whole);
+
+    return bands.n_bands;
+}
+
+START_TEST(test_jpeg_stream) {
+    static const JpegFormat_t formats[4] = { JPEG_FMT_RGB, JPEG_FMT_RGBA, JPEG_FMT_BGRA, JPEG_FMT_LUMA };
+    JpegDecOpts_t opts = imc_jpeg_default_opts();
+    TestBands_t bands = { 0 };
+    JpegBandSink_t sink = { _test_jpeg_band, NULL };
+    Pixmap_t *whole;
+    size_t i, f;
+
+    /* The bands of every fixture, in every format, reassemble into the whole image */
+    for (i = 0; i < sizeof(_test_jpeg_refs) / sizeof(_test_jpeg_refs[0]); ++i) {
+        for (f = 0; f < sizeof(formats) / sizeof(formats[0]); ++f) {
+            opts.format = formats[f];
+            opts.fancy_upsampling = true;
+            _test_jpeg_stream(_test_jpeg_refs[i].jpeg, _test_jpeg_refs[i].size, &opts);
+            opts.fancy_upsampling = false;
+            _test_jpeg_stream(_test_jpeg_refs[i].jpeg, _test_jpeg_refs[i].size, &opts);
+        }
+    }
+    opts = imc_jpeg_default_opts();
+
+    /* A row of MCUs at a time for a baseline file */
+    ck_assert_uint_eq(_test_jpeg_stream(_test_jpeg_444, sizeof(_test_jpeg_444), &opts), 2);
+    opts.scale_denom = 2;
+    _test_jpeg_stream(_test_jpeg_444, sizeof(_test_jpeg_444), &opts);
+    opts.scale_denom = 1;
+    opts.dc_only = true;
+    _test_jpeg_stream(_test_jpeg_411, sizeof(_test_jpeg_411), &opts);
+    opts.dc_only = false;
+
+    /* Restart markers and progressive files, which are decoded whole first */
+    opts.n_threads = 4;
+    _test_jpeg_stream(_test_jpeg_444_rst, sizeof(_test_jpeg_444_rst), &opts);
+    _test_jpeg_stream(_test_jpeg_420_prog, sizeof(_test_jpeg_420_prog), &opts);
+    opts.preview = true;
+    _test_jpeg_stream(_test_jpeg_420_prog, sizeof(_test_jpeg_420_prog), &opts);
+    opts = imc_jpeg_default_opts();
+
+    /* The sink's status stops the decode */
+    whole = imc_jpeg_decode_mem(_test_jpeg_444, sizeof(_test_jpeg_444), &opts);
+    ck_assert_ptr_nonnull(whole);
+    bands.whole = whole;
+    bands.stop_after = 1;
+    sink.ctx = &bands;
+    ck_assert_int_eq(imc_jpeg_decode_stream_mem(_test_jpeg_444, sizeof(_test_jpeg_444), &sink, &opts), IMC_EFAULT);
+    ck_assert_uint_eq(bands.n_bands, 1);
+    imc_pixmap_destroy(whole);
+}
+END_TEST
+
+/**
+ * @brief Decodes a JPEG into planes of its native components, each with a stride a few bytes
+ * longer than its width.
+ * @since 16-10-2026
+ * @param[in] data The JPEG file
+ * @param[in] size The size of __data__ (in bytes)
+ * @param[in] opts The decoding options
+ * @param[out] planes The planes, whose data must be freed by the caller
+ */
+static void _test_jpeg_planes(
+    const uint8_t* const data,
+    const size_t size,
+    const JpegDecOpts_t* const opts,
+    JpegPlanes_t *planes
+) {
+    uint8_t i;
+
+    memset((void*)planes, 0, sizeof(*planes));
+    ck_assert_int_eq(imc_jpeg_planes_info(data, size, opts, planes), IMC_EOK);
+    for (i = 0; i < planes->n_planes; ++i) {
+        planes->stride[i] = planes->width[i] + 5;
+        planes->data[i] = malloc(planes->stride[i] * planes->height[i]);
+        ck_assert_ptr_nonnull(planes->data[i]);
+    }
+    ck_assert_int_eq(imc_jpeg_decode_planes(data, size, opts, planes), IMC_EOK);
+}
+
+/**
+ * @brief Checks that the luma-only decode of a JPEG is the Y plane of its native decode.
+ * @since 16-10-2026
+ * @param[in] data The JPEG file
+ * @param[in] size The size of __data__ (in bytes)
+ * @param[in] opts The decoding options, whose format is ignored
+ */
+static void _test_jpeg_luma(const uint8_t* const data, const size_t size, const JpegDecOpts_t* const opts) {
+    JpegDecOpts_t luma_opts = *opts;
+    JpegPlanes_t planes;
+    Pixmap_t *luma;
+    size_t y;
+    uint8_t i;
+
+    luma_opts.format = JPEG_FMT_LUMA;
+    luma = imc_jpeg_decode_mem(data, size, &luma_opts);
+    ck_assert_ptr_nonnull(luma);
+    _test_jpeg_planes(data, size, opts, &planes);
+
+    ck_assert_uint_eq(luma->n_channels, 1);
+    ck_assert_uint_eq(luma->width, planes.width[0]);
+    ck_assert_uint_eq(luma->height, planes.height[0]);
+    for (y = 0; y < luma->height; ++y) {
+        ck_assert_mem_eq(luma->data + y * luma->width, planes.data[0] + y * planes.stride[0], luma->width);
+    }
+
+    for (i = 0; i < planes.n_planes; ++i) {
+        free(planes.data[i]);
+    }
+    imc_pixmap_destroy(luma);
+}
+
+START_TEST(test_jpeg_luma) {
+    JpegDecOpts_t opts = imc_jpeg_default_opts();
+    JpegEncOpts_t enc_opts = imc_jpeg_enc_default_opts();
+    Pixmap_t grey = { 37, 23, 0, 1, 8, NULL };
+    Pixmap_t *native, *luma;
+    uint8_t *jpeg = NULL;
+    uint32_t seed = 5;
+    size_t i, size;
+    uint8_t denom;
+
+    /* The Y plane of every fixture, at every scale */
+    for (denom = 1; denom <= 8; denom *= 2) {
+        opts.scale_denom = denom;
+        for (i = 0; i < sizeof(_test_jpeg_refs) / sizeof(_test_jpeg_refs[0]); ++i) {
+            _test_jpeg_luma(_test_jpeg_refs[i].jpeg, _test_jpeg_refs[i].size, &opts);
+        }
+        _test_jpeg_luma(_test_jpeg_444_rst, sizeof(_test_jpeg_444_rst), &opts);
+        _test_jpeg_luma(_test_jpeg_420_prog, sizeof(_test_jpeg_420_prog), &opts);
+    }
+    opts = imc_jpeg_default_opts();
+
+    /* A greyscale JPEG has nothing but luma to decode */
+    grey.data = malloc(grey.width * grey.height);
+    ck_assert_ptr_nonnull(grey.data);
+    for (i = 0; i < grey.width * grey.height; ++i) {
+        grey.data[i] = (uint8_t)(i % grey.width * 6 + _test_rand(&seed) % 16);
+    }
+    ck_assert_int_eq(imc_jpeg_write_mem(&grey, &jpeg, &size, &enc_opts), IMC_EOK);
+    native = imc_jpeg_decode_mem(jpeg, size, &opts);
+    opts.format = JPEG_FMT_LUMA;
+    luma = imc_jpeg_decode_mem(jpeg, size, &opts);
+    ck_assert_ptr_nonnull(native);
+    ck_assert_ptr_nonnull(luma);
+    ck_assert_uint_eq(native->n_channels, 1);
+    ck_assert_uint_eq(luma->n_channels, 1);
+    ck_assert_mem_eq(luma->data, native->data, grey.width * grey.height);
+
+    imc_pixmap_destroy(luma);
+    imc_pixmap_destroy(native);
+    free(jpeg);
+    free(grey.data);
+}
+END_TEST
+
+/**
+ * @brief Checks that native planes, with their chroma replicated over the pixels it covers and
+ * converted to RGB with libjpeg's fixed-point arithmetic, give the pixels of a whole decode.
+ * @since 16-10-2026
+ * @param[in] planes The Y, Cb and Cr planes
+ * @param[in] rgb The pixels of the whole decode
+ * @param[in] width Width of the image (in pixels)
+ * @param[in] height Height of the image (in pixels)
+ */
+static void _test_jpeg_planes_rgb(
+    const JpegPlanes_t* const planes,
+    const uint8_t* const rgb,
+    const size_t width,
+    const size_t height
+) {
+    size_t x, y, cx, cy, hs, vs;
+    int luma, cb, cr, px[3], c;
+
+    /* Pixels per chroma sample along each axis */
+    ck_assert_uint_eq(planes->n_planes, 3);
+    hs = (planes->width[0] + planes->width[1] - 1) / planes->width[1];
+    vs = (planes->height[0] + planes->height[1] - 1) / planes->height[1];
+    for (y = 0; y < height; ++y) {
+        for (x = 0; x < width; ++x) {
+            cx = x / hs;
+            cy = y / vs;
+            luma = planes->data[0][y * planes->stride[0] + x];
+            cb = planes->data[1][cy * planes->stride[1] + cx] - 128;
+            cr = planes->data[2][cy * planes->stride[2] + cx] - 128;
+
+            px[0] = luma + ((91881 * cr + 32768) >> 16);
+            px[1] = luma + ((-22554 * cb - 46802 * cr + 32768) >> 16);
+            px[2] = luma + ((116130 * cb + 32768) >> 16);
+            for (c = 0; c < 3; ++c) {
+                px[c] = (px[c] < 0) ? 0 : (px[c] > 255) ? 255 : px[c];
+                ck_assert_int_eq(px[c], rgb[(y * width + x) * 3 + c]);
+            }
+        }
+    }
+}
+
+START_TEST(test_jpeg_planes) {
+    static const size_t chroma[3][2] = { { 23, 13 }, { 12, 7 }, { 6, 13 } };
+    JpegDecOpts_t opts = imc_jpeg_default_opts();
+    JpegPlanes_t planes, other;
+    Pixmap_t *pixmap;
+    uint8_t *data;
+    size_t i, y;
+    uint8_t p;
+
+    /* Each component at its own sampling, giving the whole decode once upsampled and converted */
+    opts.fancy_upsampling = false;
+    for (i = 0; i < sizeof(_test_jpeg_refs) / sizeof(_test_jpeg_refs[0]); ++i) {
+        _test_jpeg_planes(_test_jpeg_refs[i].jpeg, _test_jpeg_refs[i].size, &opts, &planes);
+        ck_assert_uint_eq(planes.n_planes, 3);
+        ck_assert_uint_eq(planes.width[0], _TEST_JPEG_WIDTH);
+        ck_assert_uint_eq(planes.height[0], _TEST_JPEG_HEIGHT);
+        for (p = 1; p < 3; ++p) {
+            ck_assert_uint_eq(planes.width[p], chroma[i][0]);
+            ck_assert_uint_eq(planes.height[p], chroma[i][1]);
+        }
+
+        pixmap = imc_jpeg_decode_mem(_test_jpeg_refs[i].jpeg, _test_jpeg_refs[i].size, &opts);
+        ck_assert_ptr_nonnull(pixmap);
+        _test_jpeg_planes_rgb(&planes, pixmap->data, pixmap->width, pixmap->height);
+        imc_pixmap_destroy(pixmap);
+
+        for (p = 0; p < planes.n_planes; ++p) {
+            free(planes.data[p]);
+        }
+    }
+    opts = imc_jpeg_default_opts();
+
+    /* The restart and progressive files give the planes of their baseline files */
+    opts.n_threads = 4;
+    _test_jpeg_planes(_test_jpeg_444, sizeof(_test_jpeg_444), &opts, &planes);
+    _test_jpeg_planes(_test_jpeg_444_rst, sizeof(_test_jpeg_444_rst), &opts, &other);
+    for (p = 0; p < 3; ++p) {
+        for (y = 0; y < planes.height[p]; ++y) {
+            ck_assert_mem_eq(other.data[p] + y * other.stride[p], planes.data[p] + y * planes.stride[p], planes.width[p]);
+        }
+        free(other.data[p]);
+        free(planes.data[p]);
+    }
+    _test_jpeg_planes(_test_jpeg_420, sizeof(_test_jpeg_420), &opts, &planes);
+    _test_jpeg_planes(_test_jpeg_420_prog, sizeof(_test_jpeg_420_prog), &opts, &other);
+    for (p = 0; p < 3; ++p) {
+        for (y = 0; y < planes.height[p]; ++y) {
+            ck_assert_mem_eq(other.data[p] + y * other.stride[p], planes.data[p] + y * planes.stride[p], planes.width[p]);
+        }
+        free(other.data[p]);
+    }
+
+    /* A plane which is missing or whose stride is shorter than its width is rejected */
+    data = planes.data[2];
+    planes.data[2] = NULL;
+    ck_assert_int_eq(imc_jpeg_decode_planes(_test_jpeg_420, sizeof(_test_jpeg_420), &opts, &planes), IMC_EINVAL);
+    planes.data[2] = data;
+    planes.stride[1] = planes.width[1] - 1;
+    ck_assert_int_eq(imc_jpeg_decode_planes(_test_jpeg_420, sizeof(_test_jpeg_420), &opts, &planes), IMC_EINVAL);
+    for (p = 0; p < 3; ++p) {
+        free(planes.data[p]);
+    }
+}
+END_TEST
+
+/**
+ * @brief Computes the peak signal-to-noise ratio of a decoded JPEG against the pixmap it was
+ * encoded from, over the color channels of both.
+ * @since 16-10-2026
+ * @param[in] src The encoded pixmap (1, 3 or 4 channels)
+ * @param[in] dec The decoded pixmap (1 channel for greyscale, 3 otherwise)
+ * @returns The PSNR (in dB)
+ */
+static double _test_jpeg_psnr(const Pixmap_t* const src, const Pixmap_t* const dec) {
+    const size_t n_ch = (src->n_channels >= 3) ? 3 : 1;
+    double diff, sse = 0.0;
+    size_t i, c;
+
+    ck_assert_uint_eq(dec->width, src->width);
+    ck_assert_uint_eq(dec->height, src->height);
+    ck_assert_uint_eq(dec->n_channels, n_ch);
+
+    for (i = 0; i < src->width * src->height; ++i) {
+        for (c = 0; c < n_ch; ++c) {
+            diff = (double)src->data[i * src->n_channels + c] - dec->data[i * n_ch + c];
+            sse += diff * diff;
+        }
+    }
+
+    return 10.0 * log10(255.0 * 255.0 * src->width * src->height * n_ch / sse);
+}
+
+START_TEST(test_jpeg_encode) {
+    static const uint8_t qualities[3] = { 50, 75, 90 };
+    static const double min_psnr[3] = { 35.0, 30.0, 28.0 };
+    JpegEncOpts_t opts = imc_jpeg_enc_default_opts();
+    JpegDecOpts_t dec_opts = imc_jpeg_default_opts();
+    Pixmap_t pixmap = _test_rects(64, 48, 12, 3);
+    Pixmap_t grey = _test_rects(64, 48, 12, 3);
+    Pixmap_t *decoded, *optimized;
+    uint8_t *jpeg, *other;
+    size_t q, size, other_size, i;
+    double psnr, last;
+    int s;
+
+    for (s = JPEG_SUBSAMPLE_444; s <= JPEG_SUBSAMPLE_420; ++s) {
+        opts.subsampling = (JpegSubsampling_t)s;
+        last = 0.0;
+        for (q = 0; q < sizeof(qualities); ++q) {
+            opts.quality = qualities[q];
+            opts.optimize = false;
+            opts.simd = true;
+            jpeg = NULL;
+            ck_assert_int_eq(imc_jpeg_write_mem(&pixmap, &jpeg, &size, &opts), IMC_EOK);
+
+            /* Quality buys fidelity, with a floor at quality 90 for each sampling */
+            decoded = imc_jpeg_decode_mem(jpeg, size, &dec_opts);
+            ck_assert_ptr_nonnull(decoded);
+            psnr = _test_jpeg_psnr(&pixmap, decoded);
+            ck_assert(psnr > last);
+            last = psnr;
+
+            /* The scalar kernels write the same file */
+            opts.simd = false;
+            other = NULL;
+            ck_assert_int_eq(imc_jpeg_write_mem(&pixmap, &other, &other_size, &opts), IMC_EOK);
+            ck_assert_uint_eq(other_size, size);
+            ck_assert_mem_eq(other, jpeg, size);
+            free(other);
+
+            /* Optimal Huffman tables shrink the file without changing a pixel */
+            opts.optimize = true;
+            other = NULL;
+            ck_assert_int_eq(imc_jpeg_write_mem(&pixmap, &other, &other_size, &opts), IMC_EOK);
+            ck_assert_uint_lt(other_size, size);
+            optimized = imc_jpeg_decode_mem(other, other_size, &dec_opts);
+            ck_assert_ptr_nonnull(optimized);
+            ck_assert_mem_eq(optimized->data, decoded->data, pixmap.width * pixmap.height * 3);
+            imc_pixmap_destroy(optimized);
+            free(other);
+
+            imc_pixmap_destroy(decoded);
+            free(jpeg);
+        }
+        ck_assert(last >= min_psnr[s]);
+    }
+
+    /* Greyscale round trip */
+    for (i = 0; i < grey.width * grey.height; ++i) {
+        grey.data[i] = grey.data[4 * i + 1];
+    }
+    grey.n_channels = 1;
+    opts.quality = 90;
+    opts.optimize = false;
+    jpeg = NULL;
+    ck_assert_int_eq(imc_jpeg_write_mem(&grey, &jpeg, &size, &opts), IMC_EOK);
+    decoded = imc_jpeg_decode_mem(jpeg, size, &dec_opts);
+    ck_assert_ptr_nonnull(decoded);
+    ck_assert(_test_jpeg_psnr(&grey, decoded) >= 35.0);
+    imc_pixmap_destroy(decoded);
+    free(jpeg);
+
+    /* Qualities outside 1-100 are rejected */
+    opts.quality = 0;
+    jpeg = NULL;
+    ck_assert_int_ne(imc_jpeg_write_mem(&pixmap, &jpeg, &size, &opts), IMC_EOK);
+
+    free(grey.data);
+    free(pixmap.data);
+}
+END_TEST
+
+/**
+ * @brief Checks that decoding each lossless transform of a JPEG gives its decode rotated or
+ * mirrored the same way, after dropping the partial MCUs which the transform moves. Chroma is
+ * replicated, since fancy upsampling would blend in the samples past a dropped edge. Mirroring is
+ * then exact, while transposing is off by the rounding of the inverse DCT, which is not the same
+ * along rows as along columns.
+ * @since 16-10-2026
+ * @param[in] data The JPEG file
+ * @param[in] size The size of __data__ (in bytes)
+ * @param[in] mcu_w Width of an MCU of the JPEG (in pixels)
+ * @param[in] mcu_h Height of an MCU of the JPEG (in pixels)
+ */
+static void _test_jpeg_xform(
+    const uint8_t* const data,
+    const size_t size,
+    const size_t mcu_w,
+    const size_t mcu_h
+) {
+    JpegDecOpts_t opts = imc_jpeg_default_opts();
+    Pixmap_t *plain, *xformed;
+    uint8_t *out;
+    size_t out_size, x, y, sx, sy, w, h, c;
+    int diff, total, xform;
+    bool swap;
+
+    opts.fancy_upsampling = false;
+    plain = imc_jpeg_decode_mem(data, size, &opts);
+    ck_assert_ptr_nonnull(plain);
+
+    for (xform = JPEG_XFORM_NONE; xform <= JPEG_XFORM_ROT_270; ++xform) {
+        out = NULL;
+        ck_assert_int_eq(imc_jpeg_transform_mem(data, size, (JpegTransform_t)xform, &out, &out_size), IMC_EOK);
+        xformed = imc_jpeg_decode_mem(out, out_size, &opts);
+        ck_assert_ptr_nonnull(xformed);
+
+        /* The part of the source which is kept */
+        swap = (xform == JPEG_XFORM_TRANSPOSE || xform == JPEG_XFORM_TRANSVERSE
+            || xform == JPEG_XFORM_ROT_90 || xform == JPEG_XFORM_ROT_270);
+        w = plain->width;
+        h = plain->height;
+        if (xform == JPEG_XFORM_FLIP_H || xform == JPEG_XFORM_ROT_180
+                || xform == JPEG_XFORM_ROT_270 || xform == JPEG_XFORM_TRANSVERSE) {
+            w -= w % mcu_w;
+        }
+        if (xform == JPEG_XFORM_FLIP_V || xform == JPEG_XFORM_ROT_180
+                || xform == JPEG_XFORM_ROT_90 || xform == JPEG_XFORM_TRANSVERSE) {
+            h -= h % mcu_h;
+        }
+        ck_assert_uint_eq(xformed->width, swap ? h : w);
+        ck_assert_uint_eq(xformed->height, swap ? w : h);
+
+        total = 0;
+        for (y = 0; y < xformed->height; ++y) {
+            for (x = 0; x < xformed->width; ++x) {
+                switch (xform) {
+                    case JPEG_XFORM_FLIP_H:     sx = w - 1 - x; sy = y;         break;
+                    case JPEG_XFORM_FLIP_V:     sx = x;         sy = h - 1 - y; break;
+                    case JPEG_XFORM_TRANSPOSE:  sx = y;         sy = x;         break;
+                    case JPEG_XFORM_TRANSVERSE: sx = w - 1 - y; sy = h - 1 - x; break;
+                    case JPEG_XFORM_ROT_90:     sx = y;         sy = h - 1 - x; break;
+                    case JPEG_XFORM_ROT_180:    sx = w - 1 - x; sy = h - 1 - y; break;
+                    case JPEG_XFORM_ROT_270:    sx = w - 1 - y; sy = x;         break;
+                    default:                    sx = x;         sy = y;         break;
+                }
+                for (c = 0; c < 3; ++c) {
+                    diff = abs(xformed->data[(y * xformed->width + x) * 3 + c] - plain->data[(sy * plain->width + sx) * 3 + c]);
+                    ck_assert_int_le(diff, swap ? 2 : 0);
+                    total += diff;
+                }
+            }
+        }
+        ck_assert(total <= 0.1 * xformed->width * xformed->height * 3);
+
+        imc_pixmap_destroy(xformed);
+        free(out);
+    }
+
+    imc_pixmap_destroy(plain);
+}
+
+START_TEST(test_jpeg_transform) {
+    static const size_t mcu[3][2] = { { 8, 8 }, { 16, 8 }, { 16, 16 } };
+    JpegEncOpts_t opts = imc_jpeg_enc_default_opts();
+    Pixmap_t pixmap = _test_rects(53, 37, 12, 9);
+    uint8_t *jpeg, *out;
+    size_t size, out_size;
+    int s;
+
+    /* Every sampling our encoder writes, with partial MCUs on both edges */
+    for (s = JPEG_SUBSAMPLE_444; s <= JPEG_SUBSAMPLE_420; ++s) {
+        opts.subsampling = (JpegSubsampling_t)s;
+        jpeg = NULL;
+        ck_assert_int_eq(imc_jpeg_write_mem(&pixmap, &jpeg, &size, &opts), IMC_EOK);
+        _test_jpeg_xform(jpeg, size, mcu[s][0], mcu[s][1]);
+        free(jpeg);
+    }
+
+    /* libjpeg's 4:4:4 files, with and without restart markers */
+    _test_jpeg_xform(_test_jpeg_444, sizeof(_test_jpeg_444), 8, 8);
+    _test_jpeg_xform(_test_jpeg_444_rst, sizeof(_test_jpeg_444_rst), 8, 8);
+
+    /* Images narrower or shorter than an MCU along a mirrored axis are rejected */
+    out = NULL;
+    ck_assert_int_eq(imc_jpeg_transform_mem(_test_jpeg_420, sizeof(_test_jpeg_420), JPEG_XFORM_FLIP_V, &out, &out_size), IMC_EINVAL);
+    ck_assert_int_eq(imc_jpeg_transform_mem(_test_jpeg_420, sizeof(_test_jpeg_420), JPEG_XFORM_ROT_90, &out, &out_size), IMC_EINVAL);
+    ck_assert_int_eq(imc_jpeg_transform_mem(_test_jpeg_411, sizeof(_test_jpeg_411), JPEG_XFORM_FLIP_H, &out, &out_size), IMC_EINVAL);
+    ck_assert_int_eq(imc_jpeg_transform_mem(_test_jpeg_411, sizeof(_test_jpeg_411), JPEG_XFORM_ROT_270, &out, &out_size), IMC_EINVAL);
+    ck_assert_ptr_null(out);
+
+    /* But not along an axis which keeps its place */
+    ck_assert_int_eq(imc_jpeg_transform_mem(_test_jpeg_420, sizeof(_test_jpeg_420), JPEG_XFORM_FLIP_H, &out, &out_size), IMC_EOK);
+    free(out);
+    out = NULL;
+    ck_assert_int_eq(imc_jpeg_transform_mem(_test_jpeg_411, sizeof(_test_jpeg_411), JPEG_XFORM_FLIP_V, &out, &out_size), IMC_EOK);
+    free(out);
+
+    free(pixmap.data);
+}
+END_TEST
+
+/* Samples per pixel of each PNG color type (indexed by color type) */
+static const uint8_t _test_png_channels[7] = { 1, 0, 3, 1, 2, 0, 4 };
+
+typedef struct {
+    uint8_t *data;  /* Bytes written so far */
+    size_t   size;  /* Number of bytes written */
+    size_t   cap;   /* Capacity of data (in bytes) */
+} TestBuf_t;
+
+/**
+ * @brief png_write_func which appends to a TestBuf_t.
+ * @since 16-10-2026
+ * @param[in,out] ctx The TestBuf_t
+ * @param[in] data The bytes to append
+ * @param[in] len The number of bytes in __data__
+ * @returns IMC_EOK, or IMC_ENOMEM if the buffer could not grow
+ */
+static ImcError_t _test_buf_write(void *ctx, const uint8_t *data, const size_t len) {
+    TestBuf_t *buf = (TestBuf_t*)ctx;
+    uint8_t *grown;
+
+    if (buf->size + len > buf->cap) {
+        buf->cap = 2 * (buf->size + len);
+        grown = realloc(buf->data, buf->cap);
+        if (grown == NULL) {
+            return IMC_ENOMEM;
+        }
+        buf->data = grown;
+    }
+    memcpy(buf->data + buf->size, data, len);
+    buf->size += len;
+
+    return IMC_EOK;
+}
+
+/**
+ * @brief Reads a big-endian 32-bit value.
+ * @since 16-10-2026
+ * @param[in] buf The location of 4 bytes
+ * @returns The value
+ */
+static uint32_t _test_u32(const uint8_t* const buf) {
+    return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) | ((uint32_t)buf[2] << 8) | buf[3];
+}
+
+/**
+ * @brief Steps to the next chunk of a PNG and checks its CRC.
+ * @since 16-10-2026
+ * @param[in] png The PNG
+ * @param[in] size The size of __png__ (in bytes)
+ * @param[in,out] pos The offset of the chunk, advanced to the offset of the next
+ * @param[out] type The chunk's type
+ * @param[out] len The length of the chunk's data
+ * @returns The chunk's data, or NULL once IEND has been passed
+ */
+static const uint8_t *_test_png_chunk(
+    const uint8_t *png,
+    const size_t size,
+    size_t *pos,
+    char type[4],
+    uint32_t *len
+) {
+    const uint8_t *chunk = png + *pos;
+
+    if (*pos == size) {
+        return NULL;
+    }
+
+    ck_assert_uint_ge(size - *pos, 12);
+    *len = _test_u32(chunk);
+    ck_assert_uint_le(*len, size - *pos - 12);
+    ck_assert_uint_eq(crc32(0, chunk + 4, *len + 4), _test_u32(chunk + 8 + *len));
+
+    memcpy(type, chunk + 4, 4);
+    *pos += (size_t)*len + 12;
+
+    return chunk + 8;
+}
+
+/**
+ * @brief Inflates a zlib stream of filtered scanlines and reverses the filters.
+ * @since 16-10-2026
+ * @param[in] zdata The zlib stream
+ * @param[in] zlen The length of __zdata__ (in bytes)
+ * @param[in] width The width of the image (in pixels)
+ * @param[in] height The height of the image (in pixels)
+ * @param[in] px_bits The number of bits per pixel
+ * @param[in] filter The filter every scanline must use, or ADAPTIVE for any
+ * @returns The scanlines without their filter type bytes, which must be freed by the caller
+ */
+static uint8_t *_test_png_unfilter(
+    const uint8_t *zdata,
+    const size_t zlen,
+    const size_t width,
+    const size_t height,
+    const size_t px_bits,
+    const uint8_t filter
+) {
+    const size_t row_len = (width * px_bits + 7) / 8;
+    const size_t bpp = (px_bits + 7) / 8;
+    uLongf raw_len = (uLongf)((row_len + 1) * height);
+    uint8_t *raw, *out, *row, *up;
+    size_t x, y;
+    int a, b, c, p, pa, pb, pc;
+
+    raw = malloc(raw_len + 1);
+    out = malloc(row_len * height + 1);
+    ck_assert_ptr_nonnull(raw);
+    ck_assert_ptr_nonnull(out);
+    ck_assert_int_eq(uncompress(raw, &raw_len, zdata, (uLong)zlen), Z_OK);
+    ck_assert_uint_eq(raw_len, (row_len + 1) * height);
+
+    for (y = 0; y < height; ++y) {
+        const uint8_t type = raw[y * (row_len + 1)];
+        const uint8_t *in = raw + y * (row_len + 1) + 1;
+
+        ck_assert_uint_le(type, PAETH);
+        if (filter != ADAPTIVE) {
+            ck_assert_uint_eq(type, filter);
+        }
+
+        row = out + y * row_len;
+        up = (y > 0) ? row - row_len : NULL;
+        for (x = 0; x < row_len; ++x) {
+            a = (x >= bpp) ? row[x - bpp] : 0;
+            b = (up != NULL) ? up[x] : 0;
+            c = (x >= bpp && up != NULL) ? up[x - bpp] : 0;
+            switch (type) {
+                case NONE:
+                    p = 0;
+                    break;
+                case SUB:
+                    p = a;
+                    break;
+                case UP:
+                    p = b;
+                    break;
+                case AVG:
+                    p = (a + b) / 2;
+                    break;
+                default:
+                    pa = abs(b - c);
+                    pb = abs(a - c);
+                    pc = abs(a + b - 2 * c);
+                    p = (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c;
+                    break;
+            }
+            row[x] = (uint8_t)(in[x] + p);
+        }
+    }
+
+    free(raw);
+
+    return out;
+}
+
+/**
+ * @brief Decodes the default image of a non-interlaced PNG.
+ * @since 16-10-2026
+ * @param[in] png The PNG
+ * @param[in] size The size of __png__ (in bytes)
+ * @param[in] filter The filter every scanline must use, or ADAPTIVE for any
+ * @param[out] ihdr The output location for the 13 bytes of IHDR data
+ * @param[out] plte The output location for the palette as RGBA (opaque where tRNS does not say otherwise)
+ * @param[out] n_plte The number of palette entries (0 if there is no PLTE chunk)
+ * @returns The packed scanlines, which must be freed by the caller
+ */
+static uint8_t *_test_png_decode(
+    const uint8_t *png,
+    const size_t size,
+    const uint8_t filter,
+    uint8_t ihdr[13],
+    Rgba_t plte[256],
+    size_t *n_plte
+) {
+    TestBuf_t idat = { NULL, 0, 0 };
+    const uint8_t *data;
+    uint8_t *out;
+    size_t i, pos = 8;
+    uint32_t len;
+    char type[4];
+
+    ck_assert_uint_ge(size, 8);
+    ck_assert_mem_eq(png, PNG_MAGIC, 8);
+
+    *n_plte = 0;
+    while ((data = _test_png_chunk(png, size, &pos, type, &len)) != NULL) {
+        if (memcmp(type, IHDR, 4) == 0) {
+            ck_assert_uint_eq(len, 13);
+            memcpy(ihdr, data, 13);
+        } else if (memcmp(type, PLTE, 4) == 0) {
+            *n_plte = len / 3;
+            for (i = 0; i < *n_plte; ++i) {
+                plte[i].r = data[3 * i + 0];
+                plte[i].g = data[3 * i + 1];
+                plte[i].b = data[3 * i + 2];
+                plte[i].a = 0xFF;
+            }
+        } else if (memcmp(type, TRNS, 4) == 0 && ihdr[9] == 3) {
+            ck_assert_uint_le(len, *n_plte);
+            for (i = 0; i < len; ++i) {
+                plte[i].a = data[i];
+            }
+        } else if (memcmp(type, IDAT, 4) == 0) {
+            ck_assert_int_eq(_test_buf_write(&idat, data, len), IMC_EOK);
+        }
+    }
+
+    /* No compression, filter or interlace method other than 0 */
+    ck_assert_uint_eq(ihdr[10], 0);
+    ck_assert_uint_eq(ihdr[11], 0);
+    ck_assert_uint_eq(ihdr[12], 0);
+
+    out = _test_png_unfilter(idat.data, idat.size, _test_u32(ihdr), _test_u32(ihdr + 4),
+        (size_t)_test_png_channels[ihdr[9]] * ihdr[8], filter);
+    free(idat.data);
+
+    return out;
+}
+
+/**
+ * @brief Fills a pixmap with a mix of gradients, flat runs and noise, so that every filter has
+ * something to do.
+ * @since 16-10-2026
+ * @param[in] width Width of the pixmap (in pixels)
+ * @param[in] height Height of the pixmap (in pixels)
+ * @param[in] n_channels Number of channels
+ * @param[in] bit_depth 8 or 16
+ * @param[in] seed Seed of the noise
+ * @returns The pixmap, whose data must be freed by the caller
+ */
+static Pixmap_t _test_pixmap(
+    const size_t width,
+    const size_t height,
+    const uint8_t n_channels,
+    const uint8_t bit_depth,
+    uint32_t seed
+) {
+    Pixmap_t pixmap = { width, height, 0, n_channels, bit_depth, NULL };
+    const size_t px_size = (size_t)n_channels * bit_depth / 8;
+    size_t x, y, i;
+    uint8_t *px;
+
+    pixmap.data = malloc(width * height * px_size);
+    ck_assert_ptr_nonnull(pixmap.data);
+
+    for (y = 0; y < height; ++y) {
+        for (x = 0; x < width; ++x) {
+            px = pixmap.data + (y * width + x) * px_size;
+            for (i = 0; i < px_size; ++i) {
+                if (x < width / 3) {
+                    px[i] = (uint8_t)(x * 7 + y * 3 + i * 50);
+                } else if (x < 2 * width / 3) {
+                    px[i] = (uint8_t)((y / 4) * 40 + i);
+                } else {
+                    px[i] = (uint8_t)_test_rand(&seed);
+                }
+            }
+        }
+    }
+
+    return pixmap;
+}
+
+/**
+ * @brief Encodes a pixmap with imc_png_write_mem(), decodes it and checks that the header and
+ * samples survive unchanged.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap
+ * @param[in] opts The encoder options
+ * @param[in] filter The filter every scanline must use, or ADAPTIVE for any
+ */
+static void _test_png_round_trip(const Pixmap_t* const pixmap, const PngEncOpts_t* const opts, const uint8_t filter) {
+    static const uint8_t color_types[5] = { 0, 0, 4, 2, 6 };
+    uint8_t *png = NULL, *pixels, ihdr[13];
+    size_t size = 0, n_plte;
+    Rgba_t plte[256];
+
+    ck_assert_int_eq(imc_png_write_mem(pixmap, &png, &size, opts), IMC_EOK);
+    pixels = _test_png_decode(png, size, filter, ihdr, plte, &n_plte);
+
+    ck_assert_uint_eq(_test_u32(ihdr), pixmap->width);
+    ck_assert_uint_eq(_test_u32(ihdr + 4), pixmap->height);
+    ck_assert_uint_eq(ihdr[8], pixmap->bit_depth);
+    ck_assert_uint_eq(ihdr[9], color_types[pixmap->n_channels]);
+    ck_assert_uint_eq(n_plte, 0);
+    ck_assert_mem_eq(pixels, pixmap->data, pixmap->width * pixmap->height * imc_sizeof_px(*pixmap));
+
+    free(pixels);
+    free(png);
+}
+
+START_TEST(test_png_round_trip) {
+    PngEncOpts_t opts = imc_png_default_opts();
+    Pixmap_t pixmap;
+    uint8_t n_channels, bit_depth, filter;
+    int level;
+
+    for (n_channels = 1; n_channels <= 4; ++n_channels) {
+        for (bit_depth = 8; bit_depth <= 16; bit_depth += 8) {
+            pixmap = _test_pixmap(37, 23, n_channels, bit_depth, n_channels * bit_depth);
+            for (filter = NONE; filter <= ADAPTIVE; ++filter) {
+                opts = imc_png_default_opts();
+                opts.filter = filter;
+                _test_png_round_trip(&pixmap, &opts, filter);
+
+                opts.in_tree = true;
+                _test_png_round_trip(&pixmap, &opts, filter);
+            }
+            free(pixmap.data);
+        }
+    }
+
+    /* Every level of the in-tree compressor, with IDAT chunks short enough to split the stream */
+    pixmap = _test_pixmap(64, 48, 4, 8, 7);
+    opts = imc_png_default_opts();
+    opts.in_tree = true;
+    opts.idat_size = 100;
+    for (level = DEFLATE_MIN_LEVEL; level <= DEFLATE_MAX_LEVEL; ++level) {
+        opts.level = level;
+        _test_png_round_trip(&pixmap, &opts, ADAPTIVE);
+    }
+    free(pixmap.data);
+}
+END_TEST
+
+START_TEST(test_png_stream) {
+    static const size_t batches[4] = { 1, 3, 7, 23 };
+    PngEncOpts_t opts = imc_png_default_opts();
+    PngSink_t sink;
+    PngEncHndl_t *enc;
+    TestBuf_t buf;
+    Pixmap_t pixmap;
+    uint8_t *png = NULL;
+    size_t i, y, n, size = 0, row_len;
+    uint8_t n_channels;
+
+    for (n_channels = 1; n_channels <= 4; ++n_channels) {
+        pixmap = _test_pixmap(37, 23, n_channels, 8, n_channels);
+        row_len = pixmap.width * imc_sizeof_px(pixmap);
+        ck_assert_int_eq(imc_png_write_mem(&pixmap, &png, &size, &opts), IMC_EOK);
+
+        /* Rows arriving in batches of any size give the same file as the whole pixmap at once */
+        for (i = 0; i < sizeof(batches) / sizeof(batches[0]); ++i) {
+            memset(&buf, 0, sizeof(buf));
+            sink.write = _test_buf_write;
+            sink.ctx = &buf;
+
+            enc = imc_png_enc_begin(pixmap.width, pixmap.height, n_channels, 8, &sink, &opts);
+            ck_assert_ptr_nonnull(enc);
+            for (y = 0; y < pixmap.height; y += n) {
+                n = (pixmap.height - y < batches[i]) ? pixmap.height - y : batches[i];
+                ck_assert_int_eq(imc_png_enc_write_rows(enc, pixmap.data + y * row_len, n), IMC_EOK);
+            }
+            ck_assert_int_eq(imc_png_enc_end(enc), IMC_EOK);
+
+            ck_assert_uint_eq(buf.size, size);
+            ck_assert_mem_eq(buf.data, png, size);
+            free(buf.data);
+        }
+
+        free(png);
+        free(pixmap.data);
+    }
+}
+END_TEST
+
+START_TEST(test_png_threads) {
+    PngEncOpts_t opts = imc_png_default_opts();
+    Pixmap_t pixmap = _test_pixmap(640, 480, 4, 8, 3);
+    size_t n_threads;
+
+    /* Large enough to be split into several bands */
+    for (n_threads = 1; n_threads <= 4; ++n_threads) {
+        opts = imc_png_default_opts();
+        opts.n_threads = n_threads;
+        _test_png_round_trip(&pixmap, &opts, ADAPTIVE);
+
+        opts.in_tree = true;
+        _test_png_round_trip(&pixmap, &opts, ADAPTIVE);
+
+        opts.in_tree = false;
+        opts.fast = true;
+        _test_png_round_trip(&pixmap, &opts, PNG_FAST_FILTER);
+    }
+
+    free(pixmap.data);
+}
+END_TEST
+
+START_TEST(test_png_fast) {
+    PngEncOpts_t opts = imc_png_default_opts();
+    Pixmap_t pixmap;
+    uint8_t n_channels, bit_depth, filter;
+
+    opts.fast = true;
+    for (n_channels = 1; n_channels <= 4; ++n_channels) {
+        for (bit_depth = 8; bit_depth <= 16; bit_depth += 8) {
+            pixmap = _test_pixmap(37, 23, n_channels, bit_depth, n_channels + bit_depth);
+
+            /* Adaptive filtering gives way to the fast preset's fixed filter, but fixed filters are kept */
+            for (filter = NONE; filter <= ADAPTIVE; ++filter) {
+                opts.filter = filter;
+                _test_png_round_trip(&pixmap, &opts, (filter == ADAPTIVE) ? PNG_FAST_FILTER : filter);
+            }
+            free(pixmap.data);
+        }
+    }
+}
+END_TEST
+
+START_TEST(test_png_palette) {
+    static const uint16_t n_entries[5] = { 2, 3, 16, 17, 256 };
+    static const uint8_t bit_depths[5] = { 1, 2, 4, 8, 8 };
+    PngEncOpts_t opts = imc_png_default_opts();
+    Palette_t palette;
+    Pixmap_t pixmap;
+    Rgba_t plte[256];
+    uint8_t *png, *pixels, ihdr[13], depth;
+    uint32_t seed = 5;
+    size_t i, x, y, size, n_plte, row_len;
+
+    for (i = 0; i < sizeof(n_entries) / sizeof(n_entries[0]); ++i) {
+        palette.n_entries = n_entries[i];
+        for (x = 0; x < palette.n_entries; ++x) {
+            palette.entries[x].r = (uint8_t)_test_rand(&seed);
+            palette.entries[x].g = (uint8_t)_test_rand(&seed);
+            palette.entries[x].b = (uint8_t)_test_rand(&seed);
+            palette.entries[x].a = (x % 3 == 1) ? (uint8_t)(x * 13) : 0xFF;
+        }
+
+        pixmap = _test_pixmap(37, 23, 1, 8, (uint32_t)i);
+        for (x = 0; x < pixmap.width * pixmap.height; ++x) {
+            pixmap.data[x] %= palette.n_entries;
+        }
+
+        opts.palette = &palette;
+        png = NULL;
+        ck_assert_int_eq(imc_png_write_mem(&pixmap, &png, &size, &opts), IMC_EOK);
+        pixels = _test_png_decode(png, size, ADAPTIVE, ihdr, plte, &n_plte);
+
+        depth = bit_depths[i];
+        ck_assert_uint_eq(ihdr[8], depth);
+        ck_assert_uint_eq(ihdr[9], 3);
+        ck_assert_uint_eq(n_plte, palette.n_entries);
+        ck_assert_mem_eq(plte, palette.entries, n_plte * sizeof(Rgba_t));
+
+        /* Indices are packed leftmost pixel first */
+        row_len = (pixmap.width * depth + 7) / 8;
+        for (y = 0; y < pixmap.height; ++y) {
+            for (x = 0; x < pixmap.width; ++x) {
+                ck_assert_uint_eq((pixels[y * row_len + x * depth / 8] >> (8 - depth - x * depth % 8)) & ((1 << depth) - 1),
+                    pixmap.data[y * pixmap.width + x]);
+            }
+        }
+
+        free(pixels);
+        free(png);
+        free(pixmap.data);
+    }
+
+    /* An index past the end of the palette is rejected */
+    palette.n_entries = 4;
+    pixmap = _test_pixmap(8, 8, 1, 8, 1);
+    memset(pixmap.data, 0, 64);
+    pixmap.data[63] = 4;
+    png = NULL;
+    ck_assert_int_ne(imc_png_write_mem(&pixmap, &png, &size, &opts), IMC_EOK);
+    free(png);
+    free(pixmap.data);
+}
+END_TEST
+
+/**
+ * @brief Reads a pixel of an 8-bit pixmap with 1 to 4 channels as RGBA.
+ * @since 16-10-2026
+ * @param[in] pixmap The pixmap
+ * @param[in] i The index of the pixel
+ * @returns The pixel, opaque if the pixmap has no alpha channel
+ */
+static Rgba_t _test_px_rgba(const Pixmap_t* const pixmap, const size_t i) {
+    const uint8_t *px = pixmap->data + i * pixmap->n_channels;
+
+    switch (pixmap->n_channels) {
+        case 1:
+            return (Rgba_t){ px[0], px[0], px[0], 0xFF };
+        case 2:
+            return (Rgba_t){ px[0], px[0], px[0], px[1] };
+        case 3:
+            return (Rgba_t){ px[0], px[1], px[2], 0xFF };
+        default:
+            return (Rgba_t){ px[0], px[1], px[2], px[3] };
+    }
+}
+
+START_TEST(test_quant_exact) {
+    Pixmap_t pixmap;
+    Palette_t palette;
+    Rgba_t px;
+    uint8_t *indices;
+    uint8_t n_channels;
+    size_t i, j;
+
+    /* Every pixel maps to its own color, and no color appears twice */
+    for (n_channels = 1; n_channels <= 4; ++n_channels) {
+        pixmap = _test_pixmap(40, 30, n_channels, 8, n_channels);
+        for (i = 0; i < pixmap.width * pixmap.height * n_channels; ++i) {
+            pixmap.data[i] &= 0xC0;
+        }
+        indices = malloc(pixmap.width * pixmap.height);
+        ck_assert_ptr_nonnull(indices);
+
+        ck_assert_int_eq(imc_quant_exact(&pixmap, 256, &palette, indices), IMC_EOK);
+        ck_assert_uint_ge(palette.n_entries, 1);
+        ck_assert_uint_le(palette.n_entries, 256);
+        for (i = 0; i < pixmap.width * pixmap.height; ++i) {
+            ck_assert_uint_lt(indices[i], palette.n_entries);
+            px = _test_px_rgba(&pixmap, i);
+            ck_assert_mem_eq(&palette.entries[indices[i]], &px, sizeof(px));
+        }
+        for (i = 0; i < palette.n_entries; ++i) {
+            for (j = i + 1; j < palette.n_entries; ++j) {
+                ck_assert_mem_ne(&palette.entries[i], &palette.entries[j], sizeof(Rgba_t));
+            }
+        }
+
+        /* One color fewer than the image has overflows */
+        if (palette.n_entries > 1) {
+            ck_assert_int_eq(imc_quant_exact(&pixmap, palette.n_entries - 1, &palette, indices), IMC_EOVERFLOW);
+        }
+
+        free(indices);
+        free(pixmap.data);
+    }
+
+    /* Exactly 256 grey levels fit, and palettes outside 1-256 colors are rejected */
+    pixmap = _test_pixmap(16, 16, 1, 8, 0);
+    for (i = 0; i < 256; ++i) {
+        pixmap.data[i] = (uint8_t)(255 - i);
+    }
+    indices = malloc(256);
+    ck_assert_ptr_nonnull(indices);
+    ck_assert_int_eq(imc_quant_exact(&pixmap, 256, &palette, indices), IMC_EOK);
+    ck_assert_uint_eq(palette.n_entries, 256);
+    ck_assert_int_eq(imc_quant_exact(&pixmap, 255, &palette, indices), IMC_EOVERFLOW);
+    ck_assert_int_eq(imc_quant_exact(&pixmap, 0, &palette, indices), IMC_EINVAL);
+    ck_assert_int_eq(imc_quant_exact(&pixmap, 257, &palette, indices), IMC_EINVAL);
+    free(indices);
+    free(pixmap.data);
+}
+END_TEST
+
+START_TEST(test_quant_approx) {
+    QuantOpts_t opts = imc_quant_default_opts();
+    Pixmap_t pixmap, *indexed;
+    Palette_t palette;
+    size_t i, variant;
+
+    pixmap = _test_pixmap(64, 48, 4, 8, 21);
+
+    /* Median cut alone, refined by k-means, and dithered, each into a palette of 16 */
+    for (variant = 0; variant < 3; ++variant) {
+        opts.max_colors = 16;
+        opts.kmeans_iters = (variant >= 1) ? 4 : 0;
+        opts.dither = (variant == 2);
+
+        indexed = imc_pixmap_quantize(&pixmap, &palette, &opts);
+        ck_assert_ptr_nonnull(indexed);
+        ck_assert_uint_eq(indexed->width, pixmap.width);
+        ck_assert_uint_eq(indexed->height, pixmap.height);
+        ck_assert_uint_eq(indexed->n_channels, 1);
+        ck_assert_uint_ge(palette.n_entries, 1);
+        ck_assert_uint_le(palette.n_entries, 16);
+        for (i = 0; i < pixmap.width * pixmap.height; ++i) {
+            ck_assert_uint_lt(indexed->data[i], palette.n_entries);
+        }
+        imc_pixmap_destroy(indexed);
+    }
+
+    /* Palettes outside 2-256 colors are rejected */
+    opts.max_colors = 1;
+    ck_assert_ptr_null(imc_pixmap_quantize(&pixmap, &palette, &opts));
+    opts.max_colors = 257;
+    ck_assert_ptr_null(imc_pixmap_quantize(&pixmap, &palette, &opts));
+
+    free(pixmap.data);
+}
+END_TEST
+
+/**
+ * @brief Decodes an APNG and renders every frame onto a canvas as a viewer would, checking each
+ * rendered frame against the frame which was encoded.
+ * @since 16-10-2026
+ * @param[in] png The APNG
+ * @param[in] size The size of __png__ (in bytes)
+ * @param[in] frames The frames which were encoded
+ * @param[in] n_frames The number of frames
+ * @param[in] n_plays The number of plays which was encoded
+ */
+static void _test_apng_render(
+    const uint8_t *png,
+    const size_t size,
+    const ApngFrame_t* const frames,
+    const size_t n_frames,
+    const uint32_t n_plays
+) {
+    const Pixmap_t *first = frames[0].pixmap;
+    const size_t px_size = imc_sizeof_px(*first);
+    const size_t a_size = (first->n_channels % 2 == 0) ? first->bit_depth / 8 : 0;
+    const size_t row_len = first->width * px_size;
+    TestBuf_t zdata = { NULL, 0, 0 };
+    const uint8_t *data, *fctl = NULL;
+    uint8_t *canvas, *saved, *region, *src, *dst;
+    size_t pos = 8, n_rendered = 0, x, y, a;
+    uint32_t len, seq = 0, rect[4];
+    char type[4];
+    bool opaque, clear;
+
+    canvas = calloc(first->height, row_len);
+    saved = malloc(first->height * row_len);
+    ck_assert_ptr_nonnull(canvas);
+    ck_assert_ptr_nonnull(saved);
+
+    /* Each frame is rendered once all of its data has been seen, at the next fcTL or IEND */
+    while (true) {
+        data = _test_png_chunk(png, size, &pos, type, &len);
+        if (fctl != NULL && (data == NULL || memcmp(type, FCTL, 4) == 0 || memcmp(type, IEND, 4) == 0)) {
+            rect[0] = _test_u32(fctl + 12);
+            rect[1] = _test_u32(fctl + 16);
+            rect[2] = _test_u32(fctl + 4);
+            rect[3] = _test_u32(fctl + 8);
+            ck_assert_uint_le(rect[0] + rect[2], first->width);
+            ck_assert_uint_le(rect[1] + rect[3], first->height);
+            ck_assert_uint_eq((fctl[20] << 8) | fctl[21], frames[n_rendered].delay_num);
+            ck_assert_uint_eq((fctl[22] << 8) | fctl[23], frames[n_rendered].delay_den);
+            ck_assert_uint_le(fctl[24], APNG_DISPOSE_PREVIOUS);
+            ck_assert_uint_le(fctl[25], APNG_BLEND_OVER);
+
+            region = _test_png_unfilter(zdata.data, zdata.size, rect[2], rect[3], px_size * 8, ADAPTIVE);
+            memcpy(saved, canvas, first->height * row_len);
+
+            for (y = 0; y < rect[3]; ++y) {
+                for (x = 0; x < rect[2]; ++x) {
+                    src = region + (y * rect[2] + x) * px_size;
+                    dst = canvas + (rect[1] + y) * row_len + (rect[0] + x) * px_size;
+                    if (fctl[25] == APNG_BLEND_OVER) {
+                        /* The encoder relies on compositing only where it is exact */
+                        for (a = px_size - a_size, opaque = true, clear = true; a < px_size; ++a) {
+                            opaque = opaque && src[a] == 0xFF;
+                            clear = clear && src[a] == 0x00;
+                        }
+                        if (clear) {
+                            continue;
+                        }
+                        for (a = px_size - a_size; !opaque && a < px_size; ++a) {
+                            ck_assert_uint_eq(dst[a], 0);
+                        }
+                    }
+                    memcpy(dst, src, px_size);
+                }
+            }
+            ck_assert_mem_eq(canvas, frames[n_rendered].pixmap->data, first->height * row_len);
+
+            /* PREVIOUS on the first frame is treated as BACKGROUND */
+            if (fctl[24] == APNG_DISPOSE_BACKGROUND || (fctl[24] == APNG_DISPOSE_PREVIOUS && n_rendered == 0)) {
+                for (y = 0; y < rect[3]; ++y) {
+                    memset(canvas + (rect[1] + y) * row_len + rect[0] * px_size, 0, rect[2] * px_size);
+                }
+            } else if (fctl[24] == APNG_DISPOSE_PREVIOUS) {
+                memcpy(canvas, saved, first->height * row_len);
+            }
+
+            free(region);
+            zdata.size = 0;
+            fctl = NULL;
+            n_rendered++;
+        }
+        if (data == NULL) {
+            break;
+        }
+
+        if (memcmp(type, ACTL, 4) == 0) {
+            ck_assert_uint_eq(len, 8);
+            ck_assert_uint_eq(_test_u32(data), n_frames);
+            ck_assert_uint_eq(_test_u32(data + 4), n_plays);
+        } else if (memcmp(type, FCTL, 4) == 0) {
+            ck_assert_uint_eq(len, 26);
+            ck_assert_uint_eq(_test_u32(data), seq++);
+            fctl = data;
+        } else if (memcmp(type, IDAT, 4) == 0) {
+            /* The first frame is the default image */
+            ck_assert_uint_eq(n_rendered, 0);
+            ck_assert_ptr_nonnull(fctl);
+            ck_assert_int_eq(_test_buf_write(&zdata, data, len), IMC_EOK);
+        } else if (memcmp(type, FDAT, 4) == 0) {
+            ck_assert_uint_eq(_test_u32(data), seq++);
+            ck_assert_int_eq(_test_buf_write(&zdata, data + 4, len - 4), IMC_EOK);
+        }
+    }
+    ck_assert_uint_eq(n_rendered, n_frames);
+
+    free(zdata.data);
+    free(saved);
+    free(canvas);
+}
+
+START_TEST(test_apng_frames) {
+    PngEncOpts_t opts;
+    ApngFrame_t frames[5];
+    Pixmap_t pixmaps[5];
+    uint8_t *png, *serial, n_channels;
+    size_t i, x, y, size, serial_size, px_size, n_threads;
+
+    for (n_channels = 3; n_channels <= 4; ++n_channels) {
+        /*
+         * A background, a sprite drawn over it and taken away again (PREVIOUS disposal), specks in
+         * opposite corners (OVER blending) and, with alpha, a cleared canvas (BACKGROUND disposal)
+         */
+        for (i = 0; i < 5; ++i) {
+            pixmaps[i] = _test_pixmap(48, 32, n_channels, 8, 9);
+            frames[i].pixmap = &pixmaps[i];
+            frames[i].delay_num = (uint16_t)(i + 1);
+            frames[i].delay_den = 30;
+        }
+        px_size = imc_sizeof_px(pixmaps[0]);
+        for (y = 4; y < 12; ++y) {
+            memset(pixmaps[1].data + (y * 48 + 4) * px_size, 0xFF, 8 * px_size);
+        }
+        for (y = 0; y < 2; ++y) {
+            for (x = 0; x < 2; ++x) {
+                memset(pixmaps[3].data + (y * 48 + x) * px_size, 0xFF, px_size);
+                memset(pixmaps[3].data + ((31 - y) * 48 + 47 - x) * px_size, 0xFF, px_size);
+            }
+        }
+        if (n_channels == 4) {
+            memset(pixmaps[4].data, 0, 48 * 32 * px_size);
+        }
+
+        for (n_threads = 1; n_threads <= 3; n_threads += 2) {
+            opts = imc_png_default_opts();
+            opts.n_threads = n_threads;
+            png = NULL;
+            ck_assert_int_eq(imc_apng_write_mem(frames, 5, 2, &png, &size, &opts), IMC_EOK);
+            _test_apng_render(png, size, frames, 5, 2);
+
+            /* Frame planning and compression on several threads choose exactly what one thread does */
+            if (n_threads == 1) {
+                serial = png;
+                serial_size = size;
+            } else {
+                ck_assert_uint_eq(size, serial_size);
+                ck_assert_mem_eq(png, serial, size);
+                free(serial);
+                free(png);
+            }
+
+            opts.fast = true;
+            png = NULL;
+            ck_assert_int_eq(imc_apng_write_mem(frames, 5, 0, &png, &size, &opts), IMC_EOK);
+            _test_apng_render(png, size, frames, 5, 0);
+            free(png);
+        }
+
+        for (i = 0; i < 5; ++i) {
+            free(pixmaps[i].data);
+        }
+    }
+}
+END_TEST
+
+/**
+ * @brief Decodes an 8-bit truecolor or indexed-color PNG to RGBA.
+ * @since 16-10-2026
+ * @param[in] png The PNG
+ * @param[in] size The size of __png__ (in bytes)
+ * @param[out] ihdr The output location for the 13 bytes of IHDR data
+ * @returns The RGBA pixels (opaque unless the PNG says otherwise), which must be freed by the caller
+ */
+static uint8_t *_test_png_rgba(const uint8_t *png, const size_t size, uint8_t ihdr[13]) {
+    uint8_t *pixels, *rgba, depth, idx;
+    size_t i, x, y, width, height, row_len, n_plte;
+    Rgba_t plte[256];
+
+    pixels = _test_png_decode(png, size, ADAPTIVE, ihdr, plte, &n_plte);
+    width = _test_u32(ihdr);
+    height = _test_u32(ihdr + 4);
+    depth = ihdr[8];
+    rgba = malloc(width * height * 4);
+    ck_assert_ptr_nonnull(rgba);
+
+    row_len = (width * _test_png_channels[ihdr[9]] * depth + 7) / 8;
+    for (y = 0; y < height; ++y) {
+        for (x = 0; x < width; ++x) {
+            i = y * width + x;
+            if (ihdr[9] == 3) {
+                idx = (pixels[y * row_len + x * depth / 8] >> (8 - depth - x * depth % 8)) & ((1 << depth) - 1);
+                ck_assert_uint_lt(idx, n_plte);
+                memcpy(rgba + 4 * i, &plte[idx], 4);
+            } else if (ihdr[9] == 6) {
+                ck_assert_uint_eq(depth, 8);
+                memcpy(rgba + 4 * i, pixels + 4 * i, 4);
+            } else {
+                ck_assert_uint_eq(ihdr[9], 2);
+                ck_assert_uint_eq(depth, 8);
+                memcpy(rgba + 4 * i, pixels + 3 * i, 3);
+                rgba[4 * i + 3] = 0xFF;
+            }
+        }
+    }
+
+    free(pixels);
+
+    return rgba;
+}
+
+/**
+ * @brief Encodes a pixmap, optimizes the PNG and checks that the optimized PNG decodes to the same pixels.
+ * @since 16-10-2026
+ * @param[in] pixmap The 3 or 4 channel pixmap
+ * @param[in] enc_opts The encoder options of the PNG to be optimized
+ * @param[in] opt_opts The optimizer options
+ * @param[out] out The output location for the optimized PNG, which must be freed by the caller
+ * @param[out] out_size The output location for the size of the optimized PNG (in bytes)
+ * @returns The size of the PNG before optimization (in bytes)
+ */
+static size_t _test_png_optimize(
+    const Pixmap_t* const pixmap,
+    const PngEncOpts_t* const enc_opts,
+    const PngOptOpts_t* const opt_opts,
+    uint8_t **out,
+    size_t *out_size
+) {
+    uint8_t *png = NULL, *before, *after, ihdr[13];
+    size_t size = 0;
+
+    ck_assert_int_eq(imc_png_write_mem(pixmap, &png, &size, enc_opts), IMC_EOK);
+    ck_assert_int_eq(imc_png_optimize_mem(png, size, out, out_size, opt_opts), IMC_EOK);
+
+    before = _test_png_rgba(png, size, ihdr);
+    after = _test_png_rgba(*out, *out_size, ihdr);
+    ck_assert_uint_eq(_test_u32(ihdr), pixmap->width);
+    ck_assert_uint_eq(_test_u32(ihdr + 4), pixmap->height);
+    ck_assert_mem_eq(after, before, pixmap->width * pixmap->height * 4);
+
+    free(after);
+    free(before);
+    free(png);
+
+    return size;
+}
+
+START_TEST(test_png_optimize) {
+    PngEncOpts_t enc_opts = imc_png_default_opts();
+    PngOptOpts_t opt_opts = imc_png_opt_default_opts();
+    ApngFrame_t frames[2];
+    Pixmap_t pixmap;
+    Chunk_t chunks[2];
+    const uint8_t *data;
+    uint8_t *png, *out, key[6] = { 0, 1, 0, 2, 0, 3 };
+    char type[4], text[] = "Comment\0Kept unless stripped";
+    size_t size, orig_size, pos, n_trns, n_text;
+    uint32_t len;
+
+    /* Opaque RGBA with few colors is reduced to a palette and shrinks */
+    pixmap = _test_rects(64, 48, 12, 3);
+    enc_opts.level = 1;
+    enc_opts.filter = NONE;
+    png = NULL;
+    orig_size = _test_png_optimize(&pixmap, &enc_opts, &opt_opts, &png, &size);
+    ck_assert_uint_lt(size, orig_size);
+    ck_assert_uint_eq(png[16 + 9], 3);
+    free(png);
+    free(pixmap.data);
+
+    /* Translucent noise cannot be reduced, and the output is never larger than the input */
+    pixmap = _test_pixmap(37, 23, 4, 8, 4);
+    enc_opts = imc_png_default_opts();
+    enc_opts.level = 9;
+    png = NULL;
+    orig_size = _test_png_optimize(&pixmap, &enc_opts, &opt_opts, &png, &size);
+    ck_assert_uint_le(size, orig_size);
+    free(png);
+    free(pixmap.data);
+
+    /* Stripping drops metadata but keeps tRNS, which stops the image being reduced */
+    pixmap = _test_pixmap(37, 23, 3, 8, 12);
+    chunks[0].length = sizeof(key);
+    chunks[0].crc = 0;
+    chunks[0].data = key;
+    memcpy(chunks[0].type, TRNS, 4);
+    chunks[1].length = sizeof(text) - 1;
+    chunks[1].crc = 0;
+    chunks[1].data = (uint8_t*)text;
+    memcpy(chunks[1].type, TEXT, 4);
+    enc_opts = imc_png_default_opts();
+    enc_opts.ancillary = chunks;
+    enc_opts.n_ancillary = 2;
+
+    for (opt_opts.strip_ancillary = false; ; opt_opts.strip_ancillary = true) {
+        png = NULL;
+        _test_png_optimize(&pixmap, &enc_opts, &opt_opts, &png, &size);
+        ck_assert_uint_eq(png[16 + 9], 2);
+        for (pos = 8, n_trns = n_text = 0; (data = _test_png_chunk(png, size, &pos, type, &len)) != NULL;) {
+            if (memcmp(type, TRNS, 4) == 0) {
+                ck_assert_uint_eq(len, sizeof(key));
+                ck_assert_mem_eq(data, key, sizeof(key));
+                ++n_trns;
+            } else if (memcmp(type, TEXT, 4) == 0) {
+                ++n_text;
+            }
+        }
+        ck_assert_uint_eq(n_trns, 1);
+        ck_assert_uint_eq(n_text, opt_opts.strip_ancillary ? 0 : 1);
+        free(png);
+
+        if (opt_opts.strip_ancillary) {
+            break;
+        }
+    }
+    free(pixmap.data);
+
+    /* Animated PNGs are refused rather than flattened to their default image */
+    pixmap = _test_pixmap(16, 16, 3, 8, 6);
+    frames[0].pixmap = &pixmap;
+    frames[1].pixmap = &pixmap;
+    frames[0].delay_num = frames[1].delay_num = 1;
+    frames[0].delay_den = frames[1].delay_den = 10;
+    enc_opts = imc_png_default_opts();
+    png = NULL;
+    ck_assert_int_eq(imc_apng_write_mem(frames, 2, 0, &png, &size, &enc_opts), IMC_EOK);
+    orig_size = size;
+    ck_assert_int_eq(imc_png_optimize_mem(png, orig_size, &out, &size, &opt_opts), IMC_EINVAL);
+    ck_assert_ptr_null(out);
+    free(png);
+    free(pixmap.data);
+}
+END_TEST
+
+/**
+ * @brief Writes a 16-bit value in the given byte order.
+ * @since 16-10-2026
+ * @param[out] buf The location of 2 bytes
+ * @param[in] value The value
+ * @param[in] big_endian True to write the most significant byte first
+ */
+static void _test_put16(uint8_t *buf, const uint16_t value, const bool big_endian) {
+    buf[big_endian ? 0 : 1] = (uint8_t)(value >> 8);
+    buf[big_endian ? 1 : 0] = (uint8_t)value;
+}
+
+/**
+ * @brief Writes a 32-bit value in the given byte order.
+ * @since 16-10-2026
+ * @param[out] buf The location of 4 bytes
+ * @param[in] value The value
+ * @param[in] big_endian True to write the most significant byte first
+ */
+static void _test_put32(uint8_t *buf, const uint32_t value, const bool big_endian) {
+    _test_put16(buf + (big_endian ? 0 : 2), (uint16_t)(value >> 16), big_endian);
+    _test_put16(buf + (big_endian ? 2 : 0), (uint16_t)value, big_endian);
+}
+
+/**
+ * @brief Writes the tag, type and count of an IFD entry, leaving its value for the caller.
+ * @since 16-10-2026
+ * @param[out] entry The location of the 12 byte entry
+ * @param[in] tag The tag
+ * @param[in] type The type of each value
+ * @param[in] count The number of values
+ * @param[in] big_endian True for "MM" byte order
+ * @returns The location of the entry's value or offset
+ */
+static uint8_t *_test_ifd_entry(
+    uint8_t *entry,
+    const uint16_t tag,
+    const ExifType_t type,
+    const uint32_t count,
+    const bool big_endian
+) {
+    _test_put16(entry, tag, big_endian);
+    _test_put16(entry + 2, (uint16_t)type, big_endian);
+    _test_put32(entry + 4, count, big_endian);
+
+    return entry + 8;
+}
+
+/* Size of the EXIF fixture, including its "Exif\0\0" identifier */
+#define _TEST_EXIF_SIZE (6 + 236)
+
+/* Contents of the fixture's maker note */
+#define _TEST_MAKER_NOTE "ACME-MAKER-NOTE!"
+
+/**
+ * @brief Builds EXIF data with a camera make, an orientation, a capture time, a maker note and a
+ * GPS location of 45 30' 36" N, 73 34' 12" W, all in the given byte order:
+ *
+ *   0   TIFF header        62  Make            98  DateTimeOriginal    134 GPS IFD (4 entries)
+ *   8   IFD0 (4 entries)   68  Exif IFD (2)    118 MakerNote           188 latitude, 212 longitude
+ *
+ * @since 16-10-2026
+ * @param[in] big_endian True for "MM" byte order, false for "II"
+ * @param[out] buf The output location for _TEST_EXIF_SIZE bytes, starting with "Exif\0\0"
+ */
+static void _test_exif_fixture(const bool big_endian, uint8_t *buf) {
+    static const uint32_t dms[2][3] = { { 45, 30, 36 }, { 73, 34, 12 } };
+    uint8_t *tiff = buf + 6;
+    uint8_t *value;
+    size_t i, j;
+
+    memset(buf, 0, _TEST_EXIF_SIZE);
+    memcpy(buf, "Exif\0\0", 6);
+    memcpy(tiff, big_endian ? "MM" : "II", 2);
+    _test_put16(tiff + 2, 42, big_endian);
+    _test_put32(tiff + 4, 8, big_endian);
+
+    _test_put16(tiff + 8, 4, big_endian);
+    _test_put32(_test_ifd_entry(tiff + 10, EXIF_TAG_MAKE, EXIF_ASCII, 6, big_endian), 62, big_endian);
+    _test_put16(_test_ifd_entry(tiff + 22, EXIF_TAG_ORIENTATION, EXIF_SHORT, 1, big_endian), 6, big_endian);
+    _test_put32(_test_ifd_entry(tiff + 34, EXIF_TAG_EXIF_IFD, EXIF_LONG, 1, big_endian), 68, big_endian);
+    _test_put32(_test_ifd_entry(tiff + 46, EXIF_TAG_GPS_IFD, EXIF_LONG, 1, big_endian), 134, big_endian);
+    memcpy(tiff + 62, "Canon", 6);
+
+    _test_put16(tiff + 68, 2, big_endian);
+    _test_put32(_test_ifd_entry(tiff + 70, EXIF_TAG_DATETIME_ORIGINAL, EXIF_ASCII, 20, big_endian), 98, big_endian);
+    _test_put32(_test_ifd_entry(tiff + 82, EXIF_TAG_MAKER_NOTE, EXIF_UNDEFINED, 16, big_endian), 118, big_endian);
+    memcpy(tiff + 98, "2026:10:16 12:34:56", 20);
+    memcpy(tiff + 118, _TEST_MAKER_NOTE, 16);
+
+    _test_put16(tiff + 134, 4, big_endian);
+    memcpy(_test_ifd_entry(tiff + 136, EXIF_TAG_GPS_LATITUDE_REF, EXIF_ASCII, 2, big_endian), "N", 2);
+    _test_put32(_test_ifd_entry(tiff + 148, EXIF_TAG_GPS_LATITUDE, EXIF_RATIONAL, 3, big_endian), 188, big_endian);
+    memcpy(_test_ifd_entry(tiff + 160, EXIF_TAG_GPS_LONGITUDE_REF, EXIF_ASCII, 2, big_endian), "W", 2);
+    _test_put32(_test_ifd_entry(tiff + 172, EXIF_TAG_GPS_LONGITUDE, EXIF_RATIONAL, 3, big_endian), 212, big_endian);
+    for (i = 0; i < 2; ++i) {
+        value = tiff + 188 + 24 * i;
+        for (j = 0; j < 3; ++j) {
+            _test_put32(value + 8 * j, dms[i][j], big_endian);
+            _test_put32(value + 8 * j + 4, 1, big_endian);
+        }
+    }
+}
+
+/**
+ * @brief Checks every field of the EXIF fixture, with or without its GPS IFD and maker note.
+ * @since 16-10-2026
+ * @param[in] exif The parsed fixture
+ * @param[in] big_endian The byte order the fixture was built with
+ * @param[in] stripped True if the GPS IFD and maker note should be gone
+ */
+static void _test_exif_check(const Exif_t* const exif, const bool big_endian, const bool stripped) {
+    ExifEntry_t entry;
+    const char *str;
+    size_t len;
+    uint16_t orientation;
+    double latitude, longitude;
+
+    ck_assert(exif->big_endian == big_endian);
+
+    ck_assert_int_eq(imc_exif_orientation(exif, &orientation), IMC_EOK);
+    ck_assert_uint_eq(orientation, 6);
+
+    ck_assert_int_eq(imc_exif_find(exif, EXIF_IFD_0, EXIF_TAG_MAKE, &entry), IMC_EOK);
+    ck_assert_int_eq(imc_exif_string(&entry, &str, &len), IMC_EOK);
+    ck_assert_uint_eq(len, 5);
+    ck_assert_mem_eq(str, "Canon", 5);
+
+    ck_assert_int_eq(imc_exif_find(exif, EXIF_IFD_EXIF, EXIF_TAG_DATETIME_ORIGINAL, &entry), IMC_EOK);
+    ck_assert_int_eq(imc_exif_string(&entry, &str, &len), IMC_EOK);
+    ck_assert_uint_eq(len, 19);
+    ck_assert_mem_eq(str, "2026:10:16 12:34:56", 19);
+
+    if (stripped) {
+        ck_assert_uint_eq(imc_exif_count(exif, EXIF_IFD_GPS), 0);
+        ck_assert_int_ne(imc_exif_gps(exif, &latitude, &longitude), IMC_EOK);
+        ck_assert_int_ne(imc_exif_find(exif, EXIF_IFD_EXIF, EXIF_TAG_MAKER_NOTE, &entry), IMC_EOK);
+        return;
+    }
+
+    ck_assert_uint_eq(imc_exif_count(exif, EXIF_IFD_GPS), 4);
+    ck_assert_int_eq(imc_exif_gps(exif, &latitude, &longitude), IMC_EOK);
+    ck_assert(fabs(latitude - 45.51) < 1e-9);
+    ck_assert(fabs(longitude + 73.57) < 1e-9);
+
+    ck_assert_int_eq(imc_exif_find(exif, EXIF_IFD_EXIF, EXIF_TAG_MAKER_NOTE, &entry), IMC_EOK);
+    ck_assert_uint_eq(entry.size, 16);
+    ck_assert_mem_eq(entry.data, _TEST_MAKER_NOTE, 16);
+}
+
+START_TEST(test_exif_parse) {
+    uint8_t buf[_TEST_EXIF_SIZE];
+    Exif_t exif;
+    int big_endian;
+
+    for (big_endian = 0; big_endian <= 1; ++big_endian) {
+        _test_exif_fixture(big_endian, buf);
+
+        /* With and without the APP1 identifier */
+        ck_assert_int_eq(imc_exif_parse(buf, sizeof(buf), &exif), IMC_EOK);
+        _test_exif_check(&exif, big_endian, false);
+        ck_assert_int_eq(imc_exif_parse(buf + 6, sizeof(buf) - 6, &exif), IMC_EOK);
+        _test_exif_check(&exif, big_endian, false);
+
+        /* Truncated data never reads past the end */
+        ck_assert_int_ne(imc_exif_parse(buf + 6, 7, &exif), IMC_EOK);
+    }
+}
+END_TEST
+
+/**
+ * @brief Checks that no trace of the fixture's GPS IFD or maker note is left in a file.
+ * @since 16-10-2026
+ * @param[in] data The file
+ * @param[in] size The size of __data__ (in bytes)
+ */
+static void _test_strip_gone(const uint8_t *data, const size_t size) {
+    size_t i;
+
+    for (i = 0; i + 16 <= size; ++i) {
+        ck_assert_msg(memcmp(data + i, _TEST_MAKER_NOTE, 16) != 0, "Maker note left at offset %zu", i);
+    }
+}
+
+START_TEST(test_strip_png) {
+    PngEncOpts_t opts = imc_png_default_opts();
+    ImcStripOpts_t strip = imc_strip_default_opts();
+    Pixmap_t pixmap = _test_pixmap(37, 23, 3, 8, 11);
+    uint8_t buf[_TEST_EXIF_SIZE], *png, *orig;
+    size_t size, orig_size, pos, exif_pos, exif_end;
+    uint32_t len;
+    char type[4];
+    Chunk_t chunk;
+    Exif_t exif;
+    int big_endian;
+
+    for (big_endian = 0; big_endian <= 1; ++big_endian) {
+        _test_exif_fixture(big_endian, buf);
+        chunk.length = _TEST_EXIF_SIZE - 6;
+        chunk.crc = 0;
+        chunk.data = buf + 6;
+        memcpy(chunk.type, EXIF, 4);
+        opts.ancillary = &chunk;
+        opts.n_ancillary = 1;
+
+        png = NULL;
+        ck_assert_int_eq(imc_png_write_mem(&pixmap, &png, &size, &opts), IMC_EOK);
+        ck_assert_int_eq(imc_exif_from_png(png, size, &exif), IMC_EOK);
+        _test_exif_check(&exif, big_endian, false);
+
+        orig = malloc(size);
+        ck_assert_ptr_nonnull(orig);
+        memcpy(orig, png, size);
+        orig_size = size;
+
+        /* The GPS IFD and maker note go, the rest of the EXIF data stays */
+        ck_assert_int_eq(imc_strip_mem(png, &size, &strip), IMC_EOK);
+        ck_assert_uint_eq(size, orig_size);
+        ck_assert_int_eq(imc_exif_from_png(png, size, &exif), IMC_EOK);
+        _test_exif_check(&exif, big_endian, true);
+        _test_strip_gone(png, size);
+
+        /* Every chunk but eXIf is byte-identical, and every CRC is valid */
+        for (pos = 8, exif_pos = exif_end = 0; _test_png_chunk(png, size, &pos, type, &len) != NULL;) {
+            if (memcmp(type, EXIF, 4) == 0) {
+                exif_end = pos;
+                exif_pos = pos - len - 12;
+            }
+        }
+        ck_assert_uint_gt(exif_end, 0);
+        ck_assert_mem_eq(png, orig, exif_pos);
+        ck_assert_mem_eq(png + exif_end, orig + exif_end, size - exif_end);
+
+        /* Dropping EXIF entirely leaves the file as if it had never been added */
+        strip.exif = true;
+        ck_assert_int_eq(imc_strip_mem(png, &size, &strip), IMC_EOK);
+        strip.exif = false;
+        ck_assert_uint_eq(size, orig_size - (exif_end - exif_pos));
+        ck_assert_mem_eq(png, orig, exif_pos);
+        ck_assert_mem_eq(png + exif_pos, orig + exif_end, size - exif_pos);
+        ck_assert_int_eq(imc_exif_from_png(png, size, &exif), IMC_ENODATA);
+
+        free(orig);
+        free(png);
+    }
+
+    free(pixmap.data);
+}
+END_TEST
+
+START_TEST(test_strip_jpeg) {
+    JpegEncOpts_t opts = imc_jpeg_enc_default_opts();
+    ImcStripOpts_t strip = imc_strip_default_opts();
+    Pixmap_t pixmap = _test_pixmap(37, 23, 3, 8, 13);
+    uint8_t buf[_TEST_EXIF_SIZE], *plain, *jpeg;
+    size_t size, plain_size, seg_size = 4 + _TEST_EXIF_SIZE;
+    Exif_t exif;
+    int big_endian;
+
+    plain = NULL;
+    ck_assert_int_eq(imc_jpeg_write_mem(&pixmap, &plain, &plain_size, &opts), IMC_EOK);
+
+    for (big_endian = 0; big_endian <= 1; ++big_endian) {
+        /* An APP1 segment holding the fixture, straight after SOI */
+        _test_exif_fixture(big_endian, buf);
+        size = plain_size + seg_size;
+        jpeg = malloc(size);
+        ck_assert_ptr_nonnull(jpeg);
+        memcpy(jpeg, plain, 2);
+        jpeg[2] = 0xFF;
+        jpeg[3] = JPEG_APP1;
+        jpeg[4] = (uint8_t)((seg_size - 2) >> 8);
+        jpeg[5] = (uint8_t)(seg_size - 2);
+        memcpy(jpeg + 6, buf, _TEST_EXIF_SIZE);
+        memcpy(jpeg + 2 + seg_size, plain + 2, plain_size - 2);
+
+        ck_assert_int_eq(imc_exif_from_jpeg(jpeg, size, &exif), IMC_EOK);
+        _test_exif_check(&exif, big_endian, false);
+
+        /* The segment keeps its size and everything around it is byte-identical */
+        ck_assert_int_eq(imc_strip_mem(jpeg, &size, &strip), IMC_EOK);
+        ck_assert_uint_eq(size, plain_size + seg_size);
+        ck_assert_int_eq(imc_exif_from_jpeg(jpeg, size, &exif), IMC_EOK);
+        _test_exif_check(&exif, big_endian, true);
+        _test_strip_gone(jpeg, size);
+        ck_assert_mem_eq(jpeg, plain, 2);
+        ck_assert_mem_eq(jpeg + 2 + seg_size, plain + 2, plain_size - 2);
+
+        /* Dropping EXIF entirely gives back the JPEG as it was encoded */
+        strip.exif = true;
+        ck_assert_int_eq(imc_strip_mem(jpeg, &size, &strip), IMC_EOK);
+        strip.exif = false;
+        ck_assert_uint_eq(size, plain_size);
+        ck_assert_mem_eq(jpeg, plain, plain_size);
+
+        free(jpeg);
+    }
+
+    free(plain);
+    free(pixmap.data);
+}
+END_TEST
+
+/**
+ * @brief Checks that decoding a JPEG with each EXIF orientation and JpegDecOpts_t.auto_orient set
+ * gives its plain decode turned upright.
+ * @since 16-10-2026
+ * @param[in] plain The JPEG, without EXIF data
+ * @param[in] plain_size The size of __plain__ (in bytes)
+ * @param[in] opts The decoding options, whose auto_orient is ignored
+ */
+static void _test_jpeg_orient(const uint8_t* const plain, const size_t plain_size, const JpegDecOpts_t* const opts) {
+    JpegDecOpts_t orient_opts = *opts;
+    Pixmap_t *upright, *stored;
+    uint8_t *jpeg, *expect, *actual;
+    size_t size = plain_size + 4 + _TEST_EXIF_SIZE;
+    size_t x, y, sx, sy, w, h, n_ch;
+    uint16_t orientation;
+
+    jpeg = malloc(size);
+    ck_assert_ptr_nonnull(jpeg);
+    orient_opts.auto_orient = false;
+    stored = imc_jpeg_decode_mem(plain, plain_size, &orient_opts);
+    ck_assert_ptr_nonnull(stored);
+    w = stored->width;
+    h = stored->height;
+    n_ch = stored->n_channels;
+
+    for (orientation = 1; orientation <= 8; ++orientation) {
+        /* An APP1 segment holding the fixture, straight after SOI, with the value of its Orientation
+         * entry (at offset 30 of the TIFF header) set to this orientation */
+        memcpy(jpeg, plain, 2);
+        jpeg[2] = 0xFF;
+        jpeg[3] = JPEG_APP1;
+        jpeg[4] = (uint8_t)((_TEST_EXIF_SIZE + 2) >> 8);
+        jpeg[5] = (uint8_t)(_TEST_EXIF_SIZE + 2);
+        _test_exif_fixture(orientation % 2 == 0, jpeg + 6);
+        _test_put16(jpeg + 6 + 6 + 30, orientation, orientation % 2 == 0);
+        memcpy(jpeg + 6 + _TEST_EXIF_SIZE, plain + 2, plain_size - 2);
+
+        orient_opts.auto_orient = true;
+        upright = imc_jpeg_decode_mem(jpeg, size, &orient_opts);
+        ck_assert_ptr_nonnull(upright);
+        ck_assert_uint_eq(upright->n_channels, n_ch);
+        ck_assert_uint_eq(upright->width, (orientation >= 5) ? h : w);
+        ck_assert_uint_eq(upright->height, (orientation >= 5) ? w : h);
+
+        /* Each upright pixel comes from where the orientation says it is stored */
+        for (y = 0; y < upright->height; ++y) {
+            for (x = 0; x < upright->width; ++x) {
+                switch (orientation) {
+                    case 2:  sx = w - 1 - x; sy = y;         break;
+                    case 3:  sx = w - 1 - x; sy = h - 1 - y; break;
+                    case 4:  sx = x;         sy = h - 1 - y; break;
+                    case 5:  sx = y;         sy = x;         break;
+                    case 6:  sx = y;         sy = h - 1 - x; break;
+                    case 7:  sx = w - 1 - y; sy = h - 1 - x; break;
+                    case 8:  sx = w - 1 - y; sy = x;         break;
+                    default: sx = x;         sy = y;         break;
+                }
+                actual = upright->data + (y * upright->width + x) * n_ch;
+                expect = stored->data + (sy * w + sx) * n_ch;
+                ck_assert_mem_eq(actual, expect, n_ch);
+            }
+        }
+        imc_pixmap_destroy(upright);
+
+        /* The tag is ignored unless asked for */
+        orient_opts.auto_orient = false;
+        upright = imc_jpeg_decode_mem(jpeg, size, &orient_opts);
+        ck_assert_ptr_nonnull(upright);
+        ck_assert_uint_eq(upright->width, w);
+        ck_assert_mem_eq(upright->data, stored->data, w * h * n_ch);
+        imc_pixmap_destroy(upright);
+    }
+
+    imc_pixmap_destroy(stored);
+    free(jpeg);
+}
+
+START_TEST(test_jpeg_auto_orient) {
+    JpegDecOpts_t opts = imc_jpeg_default_opts();
+    JpegEncOpts_t enc_opts = imc_jpeg_enc_default_opts();
+    Pixmap_t pixmap = _test_pixmap(37, 77, 3, 8, 17);
+    uint8_t *jpeg = NULL;
+    size_t i, size;
+
+    /* Every sampling, in several output formats and at a reduced scale */
+    for (i = 0; i < sizeof(_test_jpeg_refs) / sizeof(_test_jpeg_refs[0]); ++i) {
+        _test_jpeg_orient(_test_jpeg_refs[i].jpeg, _test_jpeg_refs[i].size, &opts);
+    }
+    opts.format = JPEG_FMT_BGRA;
+    _test_jpeg_orient(_test_jpeg_420, sizeof(_test_jpeg_420), &opts);
+    opts.format = JPEG_FMT_LUMA;
+    _test_jpeg_orient(_test_jpeg_420_prog, sizeof(_test_jpeg_420_prog), &opts);
+    opts.format = JPEG_FMT_RGB;
+    opts.scale_denom = 2;
+    _test_jpeg_orient(_test_jpeg_411, sizeof(_test_jpeg_411), &opts);
+    opts.scale_denom = 1;
+
+    /* An image taller than a band of oriented rows */
+    ck_assert_int_eq(imc_jpeg_write_mem(&pixmap, &jpeg, &size, &enc_opts), IMC_EOK);
+    _test_jpeg_orient(jpeg, size, &opts);
+
+    free(jpeg);
+    free(pixmap.data);
+}
+END_TEST
+
+#define _TEST_SCAN_MAX 8
+
+typedef struct {
+    ImcMetadata_t meta[_TEST_SCAN_MAX];         /* Records received, in order */
+    char          names[_TEST_SCAN_MAX][16];    /* Name of each record's file, without its directory */
+    size_t        n;                            /* Number of records received */
+    size_t        stop_after;                   /* Number of records after which the sink stops the scan (0 never) */
+} TestScan_t;
+
+/**
+ * @brief imc_meta_func which copies each record into a TestScan_t.
+ * @since 16-10-2026
+ * @param[in,out] ctx The TestScan_t
+ * @param[in] meta The record
+ * @returns IMC_EOK, or IMC_EFAULT once TestScan_t.stop_after records have been received
+ */
+static ImcError_t _test_scan_record(void *ctx, const ImcMetadata_t* const meta) {
+    TestScan_t *scan = (TestScan_t*)ctx;
+    const char *name = strrchr(meta->path, '/');
+
+    ck_assert_uint_lt(scan->n, _TEST_SCAN_MAX);
+    name = (name != NULL) ? name + 1 : meta->path;
+    ck_assert_uint_lt(strlen(name), sizeof(scan->names[0]));
+    strcpy(scan->names[scan->n], name);
+    scan->meta[scan->n] = *meta;
+    scan->meta[scan->n].path = NULL;
+    scan->n++;
+
+    return (scan->stop_after > 0 && scan->n >= scan->stop_after) ? IMC_EFAULT : IMC_EOK;
+}
+
+/**
+ * @brief Returns the record of the file named __name__.
+ * @since 16-10-2026
+ * @param[in] scan The records received
+ * @param[in] name The name of the file, without its directory
+ * @returns The record, or NULL if the file was not passed on
+ */
+static const ImcMetadata_t *_test_scan_find(const TestScan_t* const scan, const char* const name) {
+    size_t i;
+
+    for (i = 0; i < scan->n; ++i) {
+        if (strcmp(scan->names[i], name) == 0) {
+            return &scan->meta[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Checks that a record carries the fields of _test_exif_fixture().
+ * @since 16-10-2026
+ * @param[in] meta The record
+ */
+static void _test_scan_exif(const ImcMetadata_t* const meta) {
+    ck_assert(meta->has_exif);
+    ck_assert_uint_eq(meta->orientation, 6);
+    ck_assert_str_eq(meta->datetime, "2026:10:16 12:34:56");
+    ck_assert_str_eq(meta->make, "Canon");
+    ck_assert_str_eq(meta->model, "");
+    ck_assert(meta->has_gps);
+    ck_assert(fabs(meta->latitude - 45.51) < 1e-9);
+    ck_assert(fabs(meta->longitude + 73.57) < 1e-9);
+}
+
+START_TEST(test_scan_metadata) {
+    PngEncOpts_t png_opts = imc_png_default_opts();
+    JpegEncOpts_t jpeg_opts = imc_jpeg_enc_default_opts();
+    ImcScanOpts_t opts = imc_scan_default_opts();
+    TestScan_t scan;
+    ImcMetaSink_t sink = { _test_scan_record, &scan };
+    Pixmap_t rgba = _test_pixmap(37, 23, 4, 8, 17);
+    Pixmap_t grey = _test_pixmap(5, 7, 1, 16, 18);
+    Pixmap_t rgb = _test_pixmap(40, 30, 3, 8, 19);
+    const ImcMetadata_t *meta;
+    const char *paths[2];
+    char dir[] = "/tmp/imc_test_XXXXXX", sub[64], a_png[64], b_jpg[64], c_png[64], notes[64], missing[64];
+    uint8_t buf[_TEST_EXIF_SIZE], *jpeg = NULL, *plain = NULL;
+    size_t size, plain_size, seg_size = 4 + _TEST_EXIF_SIZE;
+    Chunk_t chunk;
+    FILE *fp;
+
+    /* dir holds a.png (EXIF), notes.txt and sub/, which holds b.jpg (EXIF) and c.png */
+    ck_assert_ptr_nonnull(mkdtemp(dir));
+    snprintf(sub, sizeof(sub), "%s/sub", dir);
+    snprintf(a_png, sizeof(a_png), "%s/a.png", dir);
+    snprintf(notes, sizeof(notes), "%s/notes.txt", dir);
+    snprintf(missing, sizeof(missing), "%s/missing.png", dir);
+    snprintf(b_jpg, sizeof(b_jpg), "%s/sub/b.jpg", dir);
+    snprintf(c_png, sizeof(c_png), "%s/sub/c.png", dir);
+    ck_assert_int_eq(mkdir(sub, 0700), 0);
+
+    _test_exif_fixture(false, buf);
+    chunk.length = _TEST_EXIF_SIZE - 6;
+    chunk.crc = 0;
+    chunk.data = buf + 6;
+    memcpy(chunk.type, EXIF, 4);
+    png_opts.ancillary = &chunk;
+    png_opts.n_ancillary = 1;
+    ck_assert_int_eq(imc_png_write(&rgba, a_png, &png_opts), IMC_EOK);
+    png_opts = imc_png_default_opts();
+    ck_assert_int_eq(imc_png_write(&grey, c_png, &png_opts), IMC_EOK);
+
+    /* An APP1 segment holding the big-endian fixture, straight after SOI */
+    _test_exif_fixture(true, buf);
+    ck_assert_int_eq(imc_jpeg_write_mem(&rgb, &plain, &plain_size, &jpeg_opts), IMC_EOK);
+    size = plain_size + seg_size;
+    jpeg = malloc(size);
+    ck_assert_ptr_nonnull(jpeg);
+    memcpy(jpeg, plain, 2);
+    jpeg[2] = 0xFF;
+    jpeg[3] = JPEG_APP1;
+    jpeg[4] = (uint8_t)((seg_size - 2) >> 8);
+    jpeg[5] = (uint8_t)(seg_size - 2);
+    memcpy(jpeg + 6, buf, _TEST_EXIF_SIZE);
+    memcpy(jpeg + 2 + seg_size, plain + 2, plain_size - 2);
+
+    fp = fopen(b_jpg, "wb");
+    ck_assert_ptr_nonnull(fp);
+    ck_assert_uint_eq(fwrite(jpeg, 1, size, fp), size);
+    ck_assert_int_eq(fclose(fp), 0);
+    fp = fopen(notes, "wb");
+    ck_assert_ptr_nonnull(fp);
+    ck_assert_int_ge(fputs("Neither a PNG nor a JPEG\n", fp), 0);
+    ck_assert_int_eq(fclose(fp), 0);
+
+    /* The whole tree on two workers */
+    memset(&scan, 0, sizeof(scan));
+    opts.n_threads = 2;
+    paths[0] = dir;
+    ck_assert_int_eq(imc_scan_metadata(paths, 1, &sink, &opts), IMC_EOK);
+    ck_assert_uint_eq(scan.n, 3);
+
+    meta = _test_scan_find(&scan, "a.png");
+    ck_assert_ptr_nonnull(meta);
+    ck_assert_int_eq(meta->status, IMC_EOK);
+    ck_assert_int_eq(meta->format, IMC_FORMAT_PNG);
+    ck_assert_uint_eq(meta->width, 37);
+    ck_assert_uint_eq(meta->height, 23);
+    ck_assert_uint_eq(meta->n_channels, 4);
+    ck_assert_uint_eq(meta->bit_depth, 8);
+    ck_assert(!meta->progressive);
+    _test_scan_exif(meta);
+
+    meta = _test_scan_find(&scan, "b.jpg");
+    ck_assert_ptr_nonnull(meta);
+    ck_assert_int_eq(meta->status, IMC_EOK);
+    ck_assert_int_eq(meta->format, IMC_FORMAT_JPEG);
+    ck_assert_uint_eq(meta->width, 40);
+    ck_assert_uint_eq(meta->height, 30);
+    ck_assert_uint_eq(meta->n_channels, 3);
+    ck_assert_uint_eq(meta->bit_depth, 8);
+    ck_assert(!meta->progressive);
+    _test_scan_exif(meta);
+
+    meta = _test_scan_find(&scan, "c.png");
+    ck_assert_ptr_nonnull(meta);
+    ck_assert_int_eq(meta->status, IMC_EOK);
+    ck_assert_int_eq(meta->format, IMC_FORMAT_PNG);
+    ck_assert_uint_eq(meta->width, 5);
+    ck_assert_uint_eq(meta->height, 7);
+    ck_assert_uint_eq(meta->n_channels, 1);
+    ck_assert_uint_eq(meta->bit_depth, 16);
+    ck_assert(!meta->has_exif);
+    ck_assert(!meta->has_gps);
+    ck_assert_uint_eq(meta->orientation, 1);
+    ck_assert_str_eq(meta->datetime, "");
+
+    /* Without recursion or with every file passed on */
+    memset(&scan, 0, sizeof(scan));
+    opts.recursive = false;
+    opts.all_files = true;
+    ck_assert_int_eq(imc_scan_metadata(paths, 1, &sink, &opts), IMC_EOK);
+    ck_assert_uint_eq(scan.n, 2);
+    ck_assert_ptr_nonnull(_test_scan_find(&scan, "a.png"));
+    meta = _test_scan_find(&scan, "notes.txt");
+    ck_assert_ptr_nonnull(meta);
+    ck_assert_int_eq(meta->status, IMC_ENODATA);
+    ck_assert_int_eq(meta->format, IMC_FORMAT_UNKNOWN);
+
+    /* Files named directly, one of which does not exist */
+    memset(&scan, 0, sizeof(scan));
+    paths[0] = b_jpg;
+    paths[1] = missing;
+    ck_assert_int_eq(imc_scan_metadata(paths, 2, &sink, &opts), IMC_EOK);
+    ck_assert_uint_eq(scan.n, 2);
+    ck_assert_int_eq(_test_scan_find(&scan, "b.jpg")->status, IMC_EOK);
+    ck_assert_int_eq(_test_scan_find(&scan, "missing.png")->status, IMC_EFAIL);
+
+    /* A sink which stops the scan has its error returned */
+    memset(&scan, 0, sizeof(scan));
+    scan.stop_after = 1;
+    opts.n_threads = 1;
+    opts.recursive = true;
+    paths[0] = dir;
+    ck_assert_int_eq(imc_scan_metadata(paths, 1, &sink, &opts), IMC_EFAULT);
+    ck_assert_uint_eq(scan.n, 1);
+
+    /* imc_read_metadata() reads a single file the same way */
+    ck_assert_int_eq(imc_read_metadata(a_png, &scan.meta[0]), IMC_EOK);
+    _test_scan_exif(&scan.meta[0]);
+    ck_assert_int_eq(imc_read_metadata(notes, &scan.meta[0]), IMC_ENODATA);
+
+    ck_assert_int_eq(unlink(c_png), 0);
+    ck_assert_int_eq(unlink(b_jpg), 0);
+    ck_assert_int_eq(rmdir(sub), 0);
+    ck_assert_int_eq(unlink(notes), 0);
+    ck_assert_int_eq(unlink(a_png), 0);
+    ck_assert_int_eq(rmdir(dir), 0);
+
+    free(jpeg);
+    free(plain);
+    free(rgb.data);
+    free(grey.data);
+    free(rgba.data);
+}
+END_TEST
+
+/**
+ * @brief Builds the suite of all tests.
+ * @since 16-10-2026
+ * @returns The suite
+ */
+static Suite *_test_suite(void) {
+    Suite *suite = suite_create("libimc");
+    TCase *tc_deflate = tcase_create("deflate");
+    TCase *tc_png = tcase_create("png");
+    TCase *tc_jpeg = tcase_create("jpeg");
+    TCase *tc_exif = tcase_create("exif");
+
+    tcase_set_timeout(tc_deflate, 60);
+    tcase_add_test(tc_deflate, test_deflate_round_trip);
+    tcase_add_test(tc_deflate, test_deflate_levels);
+    tcase_add_test(tc_deflate, test_deflate_optimal_levels);
+    suite_add_tcase(suite, tc_deflate);
+
+    tcase_set_timeout(tc_png, 60);
+    tcase_add_test(tc_png, test_png_round_trip);
+    tcase_add_test(tc_png, test_png_stream);
+    tcase_add_test(tc_png, test_png_threads);
+    tcase_add_test(tc_png, test_png_fast);
+    tcase_add_test(tc_png, test_png_palette);
+    tcase_add_test(tc_png, test_quant_exact);
+    tcase_add_test(tc_png, test_quant_approx);
+    tcase_add_test(tc_png, test_apng_frames);
+    tcase_add_test(tc_png, test_png_optimize);
+    suite_add_tcase(suite, tc_png);
+
+    tcase_add_test(tc_jpeg, test_jpeg_idct_sse2);
+    tcase_add_test(tc_jpeg, test_jpeg_idct_avx2);
+    tcase_add_test(tc_jpeg, test_jpeg_decode);
+    tcase_add_test(tc_jpeg, test_jpeg_scaled);
+    tcase_add_test(tc_jpeg, test_jpeg_restart);
+    tcase_add_test(tc_jpeg, test_jpeg_progressive);
+    tcase_add_test(tc_jpeg, test_jpeg_dc_only);
+    tcase_add_test(tc_jpeg, test_jpeg_stream);
+    tcase_add_test(tc_jpeg, test_jpeg_luma);
+    tcase_add_test(tc_jpeg, test_jpeg_planes);
+    tcase_add_test(tc_jpeg, test_jpeg_auto_orient);
+    tcase_add_test(tc_jpeg, test_jpeg_encode);
+    tcase_add_test(tc_jpeg, test_jpeg_transform);
+    suite_add_tcase(suite, tc_jpeg);
+
+    tcase_add_test(tc_exif, test_exif_parse);
+    tcase_add_test(tc_exif, test_strip_png);
+    tcase_add_test(tc_exif, test_strip_jpeg);
+    tcase_add_test(tc_exif, test_scan_metadata);
+    suite_add_tcase(suite, tc_exif);
+
+    return suite;
+}
+
+int main(void) {
+    SRunner *runner = srunner_create(_test_suite());
+    int n_failed;
+
+    srunner_run_all(runner, CK_NORMAL);
+    n_failed = srunner_ntests_failed(runner);
+    srunner_free(runner);
+
+    return (n_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}